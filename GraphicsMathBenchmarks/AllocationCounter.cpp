@@ -0,0 +1,59 @@
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include "AllocationCounter.h"
+
+namespace GraphicsMathBenchmarks
+{
+	static std::atomic<std::size_t> allocations{ 0 };
+
+	std::size_t AllocationCounter::count()
+	{
+		return allocations.load(std::memory_order_relaxed);
+	}
+
+	void AllocationCounter::increment()
+	{
+		allocations.fetch_add(1, std::memory_order_relaxed);
+	}
+}
+
+#pragma region Global Allocation Overrides
+
+void* operator new(std::size_t size)
+{
+	GraphicsMathBenchmarks::AllocationCounter::increment();
+
+	if (void* p = std::malloc(size ? size : 1))
+		return p;
+
+	throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+	return operator new(size);
+}
+
+void operator delete(void* p) noexcept
+{
+	std::free(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+	std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+	std::free(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept
+{
+	std::free(p);
+}
+
+#pragma endregion
@@ -0,0 +1,32 @@
+#ifndef ALLOCATION_COUNTER_H
+#define ALLOCATION_COUNTER_H
+
+#include <cstddef>
+
+#include <benchmark/benchmark.h>
+
+namespace GraphicsMathBenchmarks
+{
+	/* -------------------------------------------------------------------------------------------------
+		AllocationCounter counts calls to the global operator new made by the benchmark executable.
+
+		Usage:
+			auto start = AllocationCounter::count();
+			for (auto _ : state) { ... }
+			state.counters["allocs/op"] = AllocationCounter::perIteration(start);
+	*/
+
+	class AllocationCounter
+	{
+	public:
+		static std::size_t count();
+		static void increment();
+
+		static benchmark::Counter perIteration(std::size_t start)
+		{
+			return benchmark::Counter(static_cast<double>(count() - start), benchmark::Counter::kAvgIterations);
+		}
+	};
+}
+
+#endif
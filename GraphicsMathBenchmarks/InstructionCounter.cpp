@@ -0,0 +1,72 @@
+#include "InstructionCounter.h"
+
+#if defined(__linux__)
+	#include <cstring>
+	#include <linux/perf_event.h>
+	#include <sys/syscall.h>
+	#include <unistd.h>
+#endif
+
+namespace GraphicsMathBenchmarks
+{
+
+#if defined(__linux__)
+
+	InstructionCounter::InstructionCounter()
+	{
+		perf_event_attr attr;
+		std::memset(&attr, 0, sizeof(attr));
+		attr.size = sizeof(attr);
+		attr.type = PERF_TYPE_HARDWARE;
+		attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+		attr.exclude_kernel = 1;
+		attr.exclude_hv = 1;
+
+		m_fd = static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+	}
+
+	InstructionCounter::~InstructionCounter()
+	{
+		if (m_fd >= 0)
+			close(m_fd);
+	}
+
+	bool InstructionCounter::available() const
+	{
+		return m_fd >= 0;
+	}
+
+	long long InstructionCounter::read() const
+	{
+		long long value = 0;
+
+		if (m_fd < 0 || ::read(m_fd, &value, sizeof(value)) != sizeof(value))
+			return 0;
+
+		return value;
+	}
+
+#else
+
+	InstructionCounter::InstructionCounter()
+		: m_fd(-1)
+	{
+	}
+
+	InstructionCounter::~InstructionCounter()
+	{
+	}
+
+	bool InstructionCounter::available() const
+	{
+		return false;
+	}
+
+	long long InstructionCounter::read() const
+	{
+		return 0;
+	}
+
+#endif
+
+}
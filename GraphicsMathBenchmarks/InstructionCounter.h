@@ -0,0 +1,32 @@
+#ifndef INSTRUCTION_COUNTER_H
+#define INSTRUCTION_COUNTER_H
+
+namespace GraphicsMathBenchmarks
+{
+	/* -------------------------------------------------------------------------------------------------
+		InstructionCounter reads the hardware retired-instruction counter for the calling thread.
+
+		Notes:
+			- Only implemented on Linux through perf_event_open. On other platforms, or when the
+			  kernel refuses access (see /proc/sys/kernel/perf_event_paranoid), available() is false
+			  and read() returns 0.
+	*/
+
+	class InstructionCounter
+	{
+	private:
+		int m_fd;
+
+	public:
+		InstructionCounter();
+		~InstructionCounter();
+
+		InstructionCounter(const InstructionCounter&) = delete;
+		InstructionCounter& operator=(const InstructionCounter&) = delete;
+
+		bool available() const;
+		long long read() const;
+	};
+}
+
+#endif
@@ -0,0 +1,68 @@
+#ifndef OPERATION_COUNTERS_H
+#define OPERATION_COUNTERS_H
+
+#include <cstddef>
+
+#include <benchmark/benchmark.h>
+
+#include "AllocationCounter.h"
+#include "InstructionCounter.h"
+
+namespace GraphicsMathBenchmarks
+{
+	/* -------------------------------------------------------------------------------------------------
+		OperationCounters adds per-iteration counters to a benchmark: allocs/op always, and
+		instructions/op when the hardware counter is available.
+
+		Usage:
+			static void Some_Benchmark(benchmark::State& state)
+			{
+				OperationCounters counters(state);
+				for (auto _ : state) { ... }
+			}
+
+		Notes:
+			- Construct it right before the timing loop; the counters are written when it goes out
+			  of scope, so they cover exactly the loop and nothing the benchmark set up before.
+			- instructions/op includes the few instructions of loop overhead Google Benchmark adds.
+			- Benchmarks whose iterations each run a loop of n operations pass n as the second
+			  argument, so the counters stay per operation rather than per iteration.
+	*/
+
+	class OperationCounters
+	{
+	private:
+		benchmark::State& m_state;
+		InstructionCounter m_instructions;
+		std::size_t m_allocationStart;
+		long long m_instructionStart;
+		double m_operationsPerIteration;
+
+	public:
+		explicit OperationCounters(benchmark::State& state, std::size_t operationsPerIteration = 1)
+			: m_state(state), m_allocationStart(AllocationCounter::count()), m_instructionStart(m_instructions.read()),
+			  m_operationsPerIteration(static_cast<double>(operationsPerIteration))
+		{
+		}
+
+		~OperationCounters()
+		{
+			long long instructions = m_instructions.read() - m_instructionStart;
+
+			benchmark::Counter allocations = AllocationCounter::perIteration(m_allocationStart);
+			allocations.value /= m_operationsPerIteration;
+			m_state.counters["allocs/op"] = allocations;
+
+			if (m_instructions.available())
+			{
+				m_state.counters["instructions/op"] =
+					benchmark::Counter(static_cast<double>(instructions) / m_operationsPerIteration, benchmark::Counter::kAvgIterations);
+			}
+		}
+
+		OperationCounters(const OperationCounters&) = delete;
+		OperationCounters& operator=(const OperationCounters&) = delete;
+	};
+}
+
+#endif
@@ -0,0 +1,98 @@
+#include <memory>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "../GraphicsMathLib/Allocator.h"
+#include "../GraphicsMathLib/Matrix.h"
+#include "OperationCounters.h"
+
+using namespace GraphicsMath;
+
+namespace GraphicsMathBenchmarks
+{
+
+#pragma region Frame Workload
+
+	const size_t RaysPerFrame = 4096;
+
+	// The containers a ray tracer builds for every ray: the hits along the ray and the instance
+	// transforms visited on the way down. Most rays hit a handful of things, a few hit many.
+	template<typename HitList, typename TransformList>
+	static float traceFrame(HitList makeHits, TransformList makeTransforms)
+	{
+		const Matrix<4, 4> instance = Matrix<4, 4>::Translation(Vector<3>{ 1, 2, 3 });
+		float sum = 0;
+
+		for (size_t ray = 0; ray < RaysPerFrame; ++ray)
+		{
+			auto hits = makeHits();
+			auto transforms = makeTransforms();
+			size_t count = (ray * 7) % 13 == 0 ? 40 : ray % 6 + 1;
+
+			for (size_t i = 0; i < count; ++i)
+			{
+				transforms.push_back(instance);
+				hits.push_back(transforms.back() * Vector<4>{ (float)i, (float)ray, 0, 1 });
+			}
+
+			sum += hits.back()[0];
+		}
+
+		return sum;
+	}
+
+	static void Frame_Allocations_Malloc(benchmark::State& state)
+	{
+		OperationCounters counters(state, RaysPerFrame);
+
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(traceFrame([] { return std::vector<Vector<4>>(); },
+												[] { return std::vector<Matrix<4, 4>>(); }));
+		}
+
+		state.SetItemsProcessed(state.iterations() * RaysPerFrame);
+	}
+	BENCHMARK(Frame_Allocations_Malloc);
+
+	static void Frame_Allocations_Pool(benchmark::State& state)
+	{
+		PoolAllocator pool;
+		OperationCounters counters(state, RaysPerFrame);
+
+		typedef std::vector<Vector<4>, ResourceAllocator<Vector<4>, PoolAllocator>> Hits;
+		typedef std::vector<Matrix<4, 4>, ResourceAllocator<Matrix<4, 4>, PoolAllocator>> Transforms;
+
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(traceFrame([&] { return Hits(ResourceAllocator<Vector<4>, PoolAllocator>(pool)); },
+												[&] { return Transforms(ResourceAllocator<Matrix<4, 4>, PoolAllocator>(pool)); }));
+		}
+
+		state.SetItemsProcessed(state.iterations() * RaysPerFrame);
+	}
+	BENCHMARK(Frame_Allocations_Pool);
+
+	static void Frame_Allocations_Arena(benchmark::State& state)
+	{
+		FrameArena& arena = FrameArena::threadLocal();
+		OperationCounters counters(state, RaysPerFrame);
+
+		typedef std::vector<Vector<4>, ResourceAllocator<Vector<4>, FrameArena>> Hits;
+		typedef std::vector<Matrix<4, 4>, ResourceAllocator<Matrix<4, 4>, FrameArena>> Transforms;
+
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(traceFrame([&] { return Hits(ResourceAllocator<Vector<4>, FrameArena>(arena)); },
+												[&] { return Transforms(ResourceAllocator<Matrix<4, 4>, FrameArena>(arena)); }));
+			arena.reset();
+		}
+
+		state.SetItemsProcessed(state.iterations() * RaysPerFrame);
+	}
+	BENCHMARK(Frame_Allocations_Arena);
+
+#pragma endregion
+
+}
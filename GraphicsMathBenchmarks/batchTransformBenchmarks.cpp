@@ -0,0 +1,67 @@
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "../GraphicsMathLib/BatchTransform.h"
+
+using namespace GraphicsMath;
+
+namespace GraphicsMathBenchmarks
+{
+
+#pragma region Point Cloud Transforms
+
+	static Matrix<4, 4> cameraTransform()
+	{
+		return Matrix<4, 4>::PerspectiveProjection(60, 1.5f, 0.1f, 100) *
+			   Matrix<4, 4>::Rotation(Vector<3>{ 0, 1, 0 }, 0.5f) *
+			   Matrix<4, 4>::Translation(Vector<3>{ 1, -2, 3 });
+	}
+
+	// One Matrix * Vector call per point, the way a point cloud had to be transformed before
+	static void Transform_Points_Per_Vector(benchmark::State& state)
+	{
+		const size_t count = static_cast<size_t>(state.range(0));
+		auto m = cameraTransform();
+		std::vector<Vector<4>> in(count, Vector<4>{ 1, 2, 3, 1 });
+		std::vector<Vector<4>> out(count);
+
+		for (auto _ : state)
+		{
+			for (size_t i = 0; i < count; ++i)
+			{
+				out[i] = m * in[i];
+				out[i].homogenize();
+			}
+
+			benchmark::ClobberMemory();
+		}
+
+		state.SetItemsProcessed(state.iterations() * count);
+		state.SetBytesProcessed(state.iterations() * count * 2 * sizeof(Vector<4>));
+	}
+	BENCHMARK(Transform_Points_Per_Vector)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 20);
+
+	static void Transform_Points_Batch(benchmark::State& state)
+	{
+		const size_t count = static_cast<size_t>(state.range(0));
+		auto m = cameraTransform();
+		std::vector<float> x(count, 1), y(count, 2), z(count, 3), w(count, 1);
+		std::vector<float> ox(count), oy(count), oz(count), ow(count);
+
+		for (auto _ : state)
+		{
+			transformPoints(m, ConstPointStreams{ x.data(), y.data(), z.data(), w.data() },
+							PointStreams{ ox.data(), oy.data(), oz.data(), ow.data() }, count, true);
+
+			benchmark::ClobberMemory();
+		}
+
+		state.SetItemsProcessed(state.iterations() * count);
+		state.SetBytesProcessed(state.iterations() * count * 8 * sizeof(float));
+	}
+	BENCHMARK(Transform_Points_Batch)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 20);
+
+#pragma endregion
+
+}
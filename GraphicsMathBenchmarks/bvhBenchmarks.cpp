@@ -0,0 +1,167 @@
+#include <cmath>
+#include <map>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "../GraphicsMathLib/BVH.h"
+
+using namespace GraphicsMath;
+
+namespace GraphicsMathBenchmarks
+{
+
+#pragma region BVH Workload
+
+	struct Mesh
+	{
+		std::vector<Vector<3>> vertices;
+		std::vector<std::uint32_t> indices;
+	};
+
+	// A bumpy sphere of about triangleCount triangles, twice as many segments around as rings
+	static Mesh makeMesh(int triangleCount)
+	{
+		const int rings = static_cast<int>(std::sqrt(triangleCount / 4.0));
+		const int segments = 2 * rings;
+		Mesh mesh;
+
+		for (int r = 0; r <= rings; ++r)
+		{
+			float theta = PI * r / rings;
+			for (int s = 0; s < segments; ++s)
+			{
+				float phi = 2.0f * PI * s / segments;
+				float radius = 1.0f + 0.05f * sinf(13.0f * theta) * cosf(17.0f * phi);
+				mesh.vertices.push_back(Vector<3>{ radius * sinf(theta) * cosf(phi), radius * cosf(theta), radius * sinf(theta) * sinf(phi) });
+			}
+		}
+
+		for (int r = 0; r < rings; ++r)
+		{
+			for (int s = 0; s < segments; ++s)
+			{
+				std::uint32_t a = r * segments + s, b = r * segments + (s + 1) % segments;
+				std::uint32_t c = a + segments, d = b + segments;
+				mesh.indices.insert(mesh.indices.end(), { a, c, b, b, c, d });
+			}
+		}
+
+		return mesh;
+	}
+
+	static const Mesh& mesh(int triangleCount)
+	{
+		static std::map<int, Mesh> meshes;
+
+		auto found = meshes.find(triangleCount);
+		if (found == meshes.end())
+			found = meshes.emplace(triangleCount, makeMesh(triangleCount)).first;
+
+		return found->second;
+	}
+
+	static const BVH& bvh(int triangleCount)
+	{
+		static std::map<int, BVH> hierarchies;
+
+		auto found = hierarchies.find(triangleCount);
+		if (found == hierarchies.end())
+			found = hierarchies.emplace(triangleCount, BVH::FromTriangles(mesh(triangleCount).vertices, mesh(triangleCount).indices)).first;
+
+		return found->second;
+	}
+
+	// A 128 x 128 grid of camera rays over the sphere; about three quarters of them hit it
+	static std::vector<Ray> makeCameraRays()
+	{
+		std::vector<Ray> rays;
+		const Vector<3> camera{ 0.3f, 0.2f, -4 };
+
+		for (int y = 0; y < 128; ++y)
+		{
+			for (int x = 0; x < 128; ++x)
+				rays.push_back(Ray(camera, Vector<3>{ (x - 64) / 220.0f, (y - 64) / 220.0f, 1 }));
+		}
+
+		return rays;
+	}
+
+#pragma endregion
+
+#pragma region BVH Benchmarks
+
+	static void BVH_Build(benchmark::State& state)
+	{
+		const Mesh& m = mesh(static_cast<int>(state.range(0)));
+
+		for (auto _ : state)
+			benchmark::DoNotOptimize(BVH::FromTriangles(m.vertices, m.indices));
+
+		state.counters["triangles"] = benchmark::Counter(static_cast<double>(m.indices.size() / 3) * static_cast<double>(state.iterations()), benchmark::Counter::kIsRate);
+	}
+	BENCHMARK(BVH_Build)->Arg(100000)->Arg(1000000)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+	static void BVH_Closest_Hit(benchmark::State& state)
+	{
+		const BVH& b = bvh(static_cast<int>(state.range(0)));
+		std::vector<Ray> rays = makeCameraRays();
+		std::vector<float> distances(rays.size());
+
+		for (auto _ : state)
+		{
+			for (std::size_t i = 0; i < rays.size(); ++i)
+				distances[i] = b.intersect(rays[i]).distance;
+
+			benchmark::ClobberMemory();
+		}
+
+		state.counters["rays"] = benchmark::Counter(static_cast<double>(rays.size()) * static_cast<double>(state.iterations()), benchmark::Counter::kIsRate);
+	}
+	BENCHMARK(BVH_Closest_Hit)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMillisecond);
+
+	static void BVH_Any_Hit(benchmark::State& state)
+	{
+		const BVH& b = bvh(static_cast<int>(state.range(0)));
+		std::vector<Ray> rays = makeCameraRays();
+		std::vector<char> occluded(rays.size());
+
+		for (auto _ : state)
+		{
+			for (std::size_t i = 0; i < rays.size(); ++i)
+				occluded[i] = b.occluded(rays[i]);
+
+			benchmark::ClobberMemory();
+		}
+
+		state.counters["rays"] = benchmark::Counter(static_cast<double>(rays.size()) * static_cast<double>(state.iterations()), benchmark::Counter::kIsRate);
+	}
+	BENCHMARK(BVH_Any_Hit)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMillisecond);
+
+	// A grid of 10 x 10 copies of the 100000 triangle mesh, ten million triangles in all
+	static void BVH_Instanced_Closest_Hit(benchmark::State& state)
+	{
+		const BVH& b = bvh(100000);
+		std::vector<BVHInstance> instances;
+		for (int i = 0; i < 100; ++i)
+			instances.push_back({ &b, Matrix<4, 4>::Translation(Vector<3>{ (float)(i % 10) * 0.25f - 1.25f, (float)(i / 10) * 0.25f - 1.25f, (float)(i % 7) * 0.5f }) * Matrix<4, 4>::Scale(Vector<3>{ 0.12f, 0.12f, 0.12f }) });
+
+		InstancedBVH scene = InstancedBVH::FromInstances(instances);
+		std::vector<Ray> rays = makeCameraRays();
+		std::vector<float> distances(rays.size());
+
+		for (auto _ : state)
+		{
+			for (std::size_t i = 0; i < rays.size(); ++i)
+				distances[i] = scene.intersect(rays[i]).distance;
+
+			benchmark::ClobberMemory();
+		}
+
+		state.counters["rays"] = benchmark::Counter(static_cast<double>(rays.size()) * static_cast<double>(state.iterations()), benchmark::Counter::kIsRate);
+	}
+	BENCHMARK(BVH_Instanced_Closest_Hit)->Unit(benchmark::kMillisecond);
+
+#pragma endregion
+
+}
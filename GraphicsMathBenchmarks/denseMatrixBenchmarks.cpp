@@ -0,0 +1,132 @@
+#include <benchmark/benchmark.h>
+
+#include "../GraphicsMathLib/DenseMatrix.h"
+#include "OperationCounters.h"
+
+using namespace GraphicsMath;
+
+namespace GraphicsMathBenchmarks
+{
+
+#pragma region Dense Matrices
+
+	static DenseMatrix sampleDense(int n, int seed)
+	{
+		DenseMatrix result(n, n);
+
+		for (int c = 0; c < n; ++c)
+		{
+			for (int r = 0; r < n; ++r)
+				result(r, c) = (float)((r * 7 + c * 3 + seed) % 11) * 0.25f - 1.25f + (r == c ? (float)n : 0.0f);
+		}
+
+		return result;
+	}
+
+	static void setFlops(benchmark::State& state, double flopsPerIteration)
+	{
+		state.counters["FLOPS"] = benchmark::Counter(flopsPerIteration * static_cast<double>(state.iterations()), benchmark::Counter::kIsRate);
+	}
+
+	// The textbook triple loop over the same column-major storage, as the baseline
+	static void Dense_GEMM_Naive(benchmark::State& state)
+	{
+		const int n = static_cast<int>(state.range(0));
+		DenseMatrix a = sampleDense(n, 1), b = sampleDense(n, 2), out(n, n);
+		OperationCounters counters(state);
+
+		for (auto _ : state)
+		{
+			for (int i = 0; i < n; ++i)
+			{
+				for (int j = 0; j < n; ++j)
+				{
+					float sum = 0;
+					for (int k = 0; k < n; ++k)
+						sum += a(i, k) * b(k, j);
+
+					out(i, j) = sum;
+				}
+			}
+			benchmark::ClobberMemory();
+		}
+
+		setFlops(state, 2.0 * n * n * n);
+	}
+	BENCHMARK(Dense_GEMM_Naive)->Arg(64)->Arg(256)->Arg(512);
+
+	// state.range(1) threads, 1 being the packed kernel alone on the calling thread
+	static void Dense_GEMM(benchmark::State& state)
+	{
+		const int n = static_cast<int>(state.range(0));
+		ThreadPool pool(static_cast<unsigned>(state.range(1)));
+		DenseMatrix a = sampleDense(n, 1), b = sampleDense(n, 2), out(n, n);
+		OperationCounters counters(state);
+
+		for (auto _ : state)
+		{
+			multiply(a, b, out, pool);
+			benchmark::ClobberMemory();
+		}
+
+		setFlops(state, 2.0 * n * n * n);
+	}
+	BENCHMARK(Dense_GEMM)->ArgNames({ "n", "threads" })->ArgsProduct({ { 64, 256, 512 }, { 1, 4 } })->UseRealTime();
+
+	static void Dense_GEMV(benchmark::State& state)
+	{
+		const int n = static_cast<int>(state.range(0));
+		DenseMatrix a = sampleDense(n, 1);
+		DenseVector x(n), out(n);
+		OperationCounters counters(state);
+
+		for (auto _ : state)
+		{
+			multiply(a, x, out);
+			benchmark::ClobberMemory();
+		}
+
+		setFlops(state, 2.0 * n * n);
+	}
+	BENCHMARK(Dense_GEMV)->Arg(256)->Arg(2048)->UseRealTime();
+
+	static void Dense_Transposition(benchmark::State& state)
+	{
+		const int n = static_cast<int>(state.range(0));
+		DenseMatrix a = sampleDense(n, 1);
+
+		for (auto _ : state)
+			benchmark::DoNotOptimize(a.transposition());
+
+		state.SetBytesProcessed(state.iterations() * 2 * static_cast<int64_t>(n) * n * sizeof(float));
+	}
+	BENCHMARK(Dense_Transposition)->Arg(256)->Arg(2048)->UseRealTime();
+
+	static void Dense_LU(benchmark::State& state)
+	{
+		const int n = static_cast<int>(state.range(0));
+		DenseMatrix a = sampleDense(n, 1);
+
+		for (auto _ : state)
+			benchmark::DoNotOptimize(LUDecomposition(a).factors().data());
+
+		setFlops(state, 2.0 / 3.0 * n * n * n);
+	}
+	BENCHMARK(Dense_LU)->Arg(64)->Arg(256)->Arg(512)->UseRealTime();
+
+	static void Dense_Cholesky(benchmark::State& state)
+	{
+		const int n = static_cast<int>(state.range(0));
+		DenseMatrix a = sampleDense(n, 1);
+		a = a + a.transposition();
+
+		for (auto _ : state)
+			benchmark::DoNotOptimize(CholeskyDecomposition(a).lower().data());
+
+		setFlops(state, 1.0 / 3.0 * n * n * n);
+	}
+	BENCHMARK(Dense_Cholesky)->Arg(64)->Arg(256)->Arg(512)->UseRealTime();
+
+#pragma endregion
+
+}
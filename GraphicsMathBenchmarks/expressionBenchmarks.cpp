@@ -0,0 +1,107 @@
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "../GraphicsMathLib/Expression.h"
+#include "OperationCounters.h"
+
+using namespace GraphicsMath;
+
+namespace GraphicsMathBenchmarks
+{
+
+#pragma region Shading Expressions
+
+	// Per pixel inputs of a simple shading pass
+	struct ShadingInputs
+	{
+		std::vector<Vector<4>> albedo, diffuse, specular, fog;
+		std::vector<Vector<4>> color;
+
+		explicit ShadingInputs(size_t count)
+			: albedo(count, Vector<4>{ 0.8f, 0.6f, 0.4f, 1 }), diffuse(count, Vector<4>{ 0.5f, 0.5f, 0.6f, 1 }),
+			  specular(count, Vector<4>{ 0.2f, 0.2f, 0.2f, 0 }), fog(count, Vector<4>{ 0.1f, 0.1f, 0.15f, 0 }),
+			  color(count)
+		{
+		}
+	};
+
+	// color = albedo * (diffuse * 0.9 + 0.1) + specular * 0.5 - fog, one temporary per operator
+	static void Shade_Eager(benchmark::State& state)
+	{
+		const size_t count = static_cast<size_t>(state.range(0));
+		ShadingInputs in(count);
+		OperationCounters counters(state, count);
+
+		for (auto _ : state)
+		{
+			for (size_t i = 0; i < count; ++i)
+				in.color[i] = in.albedo[i] * (in.diffuse[i] * 0.9f + 0.1f) + in.specular[i] * 0.5f - in.fog[i];
+
+			benchmark::ClobberMemory();
+		}
+
+		state.SetItemsProcessed(state.iterations() * count);
+	}
+	BENCHMARK(Shade_Eager)->Arg(1 << 12);
+
+	// The same expression fused into one loop per pixel
+	static void Shade_Lazy(benchmark::State& state)
+	{
+		const size_t count = static_cast<size_t>(state.range(0));
+		ShadingInputs in(count);
+		OperationCounters counters(state, count);
+
+		for (auto _ : state)
+		{
+			for (size_t i = 0; i < count; ++i)
+				in.color[i] = lazy(in.albedo[i]) * (lazy(in.diffuse[i]) * 0.9f + 0.1f) + lazy(in.specular[i]) * 0.5f - in.fog[i];
+
+			benchmark::ClobberMemory();
+		}
+
+		state.SetItemsProcessed(state.iterations() * count);
+	}
+	BENCHMARK(Shade_Lazy)->Arg(1 << 12);
+
+#pragma endregion
+
+#pragma region Matrix Blending
+
+	template<int size>
+	static void Matrix_Blend_Eager(benchmark::State& state)
+	{
+		Matrix<size, size> a, b, c;
+		OperationCounters counters(state);
+
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(a);
+			benchmark::DoNotOptimize(b);
+			benchmark::DoNotOptimize(c);
+			benchmark::DoNotOptimize(Matrix<size, size>(a * 0.25f + b * 0.75f - c));
+		}
+	}
+	BENCHMARK_TEMPLATE(Matrix_Blend_Eager, 3);
+	BENCHMARK_TEMPLATE(Matrix_Blend_Eager, 4);
+
+	template<int size>
+	static void Matrix_Blend_Lazy(benchmark::State& state)
+	{
+		Matrix<size, size> a, b, c;
+		OperationCounters counters(state);
+
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(a);
+			benchmark::DoNotOptimize(b);
+			benchmark::DoNotOptimize(c);
+			benchmark::DoNotOptimize(Matrix<size, size>(lazy(a) * 0.25f + lazy(b) * 0.75f - c));
+		}
+	}
+	BENCHMARK_TEMPLATE(Matrix_Blend_Lazy, 3);
+	BENCHMARK_TEMPLATE(Matrix_Blend_Lazy, 4);
+
+#pragma endregion
+
+}
@@ -0,0 +1,118 @@
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "../GraphicsMathLib/VectorStream.h"
+
+using namespace GraphicsMath;
+
+namespace GraphicsMathBenchmarks
+{
+
+#pragma region Lighting Workload
+
+	static const int SampleCount = 1 << 12;
+
+	struct Surface
+	{
+		std::vector<Vector<3>> positions;
+		std::vector<Vector<3>> normals;
+		std::vector<float> diffuse;
+
+		Surface()
+			: positions(SampleCount), normals(SampleCount), diffuse(SampleCount)
+		{
+			for (int i = 0; i < SampleCount; ++i)
+			{
+				positions[i] = Vector<3>{ (float)(i % 64), 0.0f, (float)(i / 64) };
+				normals[i] = Vector<3>{ (float)(i % 5) - 2.0f, 3.0f, (float)(i % 3) - 1.0f };
+			}
+		}
+	};
+
+	// Lambert diffuse from a point light: both the interpolated normal and the light direction
+	// are renormalized for every sample
+	template<MathPolicy policy>
+	static void shade(Surface& surface, const Vector<3>& light)
+	{
+		for (int i = 0; i < SampleCount; ++i)
+		{
+			Vector<3> n = surface.normals[i].normal<policy>();
+			Vector<3> l = (light - surface.positions[i]).normal<policy>();
+			float d = n.dotProduct(l);
+			surface.diffuse[i] = d > 0 ? d : 0;
+		}
+	}
+
+#pragma endregion
+
+#pragma region Fast Math Benchmarks
+
+	template<MathPolicy policy>
+	static void FastMath_Lighting(benchmark::State& state)
+	{
+		Surface surface;
+		const Vector<3> light{ 20, 15, 30 };
+
+		for (auto _ : state)
+		{
+			shade<policy>(surface, light);
+			benchmark::ClobberMemory();
+		}
+
+		state.SetItemsProcessed(state.iterations() * SampleCount);
+	}
+	BENCHMARK_TEMPLATE(FastMath_Lighting, MathPolicy::Precise);
+	BENCHMARK_TEMPLATE(FastMath_Lighting, MathPolicy::Fast);
+
+	// The same lighting over structure-of-arrays streams, where both square roots and divides
+	// are packed and the policy makes the larger difference
+	template<MathPolicy policy>
+	static void FastMath_Lighting_Stream(benchmark::State& state)
+	{
+		Surface surface;
+		const Vector<3> light{ 20, 15, 30 };
+
+		std::vector<Vector<3>> toLight(SampleCount);
+		for (int i = 0; i < SampleCount; ++i)
+			toLight[i] = light - surface.positions[i];
+
+		VectorStream<3> normals(surface.normals.data(), SampleCount), lights(toLight.data(), SampleCount);
+
+		for (auto _ : state)
+		{
+			// The cost doesn't depend on the values, so renormalizing in place times the same work
+			normals.normalize<policy>();
+			lights.normalize<policy>();
+			normals.dotProduct(lights, surface.diffuse.data());
+			for (float& d : surface.diffuse)
+				d = d > 0 ? d : 0;
+
+			benchmark::ClobberMemory();
+		}
+
+		state.SetItemsProcessed(state.iterations() * SampleCount);
+	}
+	BENCHMARK_TEMPLATE(FastMath_Lighting_Stream, MathPolicy::Precise);
+	BENCHMARK_TEMPLATE(FastMath_Lighting_Stream, MathPolicy::Fast);
+
+	template<MathPolicy policy>
+	static void FastMath_Rotation(benchmark::State& state)
+	{
+		const Vector<3> axis{ 0, 0.6f, 0.8f };
+		float theta = 0.1f;
+
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(Matrix<4, 4>::Rotation<policy>(axis, theta));
+			theta += 0.01f;
+		}
+
+		state.SetItemsProcessed(state.iterations());
+	}
+	BENCHMARK_TEMPLATE(FastMath_Rotation, MathPolicy::Precise);
+	BENCHMARK_TEMPLATE(FastMath_Rotation, MathPolicy::Fast);
+
+#pragma endregion
+
+}
@@ -0,0 +1,133 @@
+#include <cmath>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "../GraphicsMathLib/Frustum.h"
+
+using namespace GraphicsMath;
+
+namespace GraphicsMathBenchmarks
+{
+
+#pragma region Frustum Workload
+
+	static const int CullObjectCount = 1 << 20;
+
+	// A million objects spread over a cube of 200 units around a camera with a 60 degree view, about
+	// a tenth of them visible
+	struct CullScene
+	{
+		Frustum frustum = Frustum::FromMatrix(Matrix<4, 4>::PerspectiveProjection(60.0f, 16.0f / 9.0f, 0.1f, 100.0f));
+		std::vector<float> x, y, z, radius;
+		std::vector<float> minimumX, minimumY, minimumZ, maximumX, maximumY, maximumZ;
+
+		CullScene()
+		{
+			for (int i = 0; i < CullObjectCount; ++i)
+			{
+				float cx = 100.0f * sinf(1.3f * i), cy = 100.0f * cosf(0.7f * i), cz = 100.0f * sinf(0.37f * i + 1.0f);
+				float half = 0.5f + fabsf(sinf(2.1f * i));
+
+				x.push_back(cx);
+				y.push_back(cy);
+				z.push_back(cz);
+				radius.push_back(half * 1.7320508f);
+				minimumX.push_back(cx - half);
+				minimumY.push_back(cy - half);
+				minimumZ.push_back(cz - half);
+				maximumX.push_back(cx + half);
+				maximumY.push_back(cy + half);
+				maximumZ.push_back(cz + half);
+			}
+		}
+	};
+
+	static const CullScene& cullScene()
+	{
+		static CullScene scene;
+		return scene;
+	}
+
+#pragma endregion
+
+#pragma region Frustum Benchmarks
+
+	// intersects() on one sphere at a time, the baseline for the batch versions
+	static void Frustum_Cull_Spheres_Scalar(benchmark::State& state)
+	{
+		const CullScene& scene = cullScene();
+		std::vector<std::uint32_t> visible;
+		visible.reserve(CullObjectCount);
+
+		for (auto _ : state)
+		{
+			visible.clear();
+			for (int i = 0; i < CullObjectCount; ++i)
+			{
+				if (scene.frustum.intersects(Vector<3>{ scene.x[i], scene.y[i], scene.z[i] }, scene.radius[i]))
+					visible.push_back(i);
+			}
+
+			benchmark::DoNotOptimize(visible.data());
+		}
+
+		state.counters["objects"] = benchmark::Counter(static_cast<double>(CullObjectCount) * static_cast<double>(state.iterations()), benchmark::Counter::kIsRate);
+	}
+	BENCHMARK(Frustum_Cull_Spheres_Scalar)->UseRealTime()->Unit(benchmark::kMicrosecond);
+
+	static void Frustum_Cull_Spheres(benchmark::State& state)
+	{
+		const CullScene& scene = cullScene();
+		ThreadPool pool(static_cast<unsigned>(state.range(0)));
+		std::vector<std::uint32_t> visible(CullObjectCount);
+
+		for (auto _ : state)
+			benchmark::DoNotOptimize(scene.frustum.cullSpheres({ scene.x.data(), scene.y.data(), scene.z.data(), scene.radius.data() }, CullObjectCount, visible.data(), pool));
+
+		state.counters["objects"] = benchmark::Counter(static_cast<double>(CullObjectCount) * static_cast<double>(state.iterations()), benchmark::Counter::kIsRate);
+	}
+	BENCHMARK(Frustum_Cull_Spheres)->Arg(1)->Arg(4)->UseRealTime()->Unit(benchmark::kMicrosecond);
+
+	static void Frustum_Cull_Boxes_Scalar(benchmark::State& state)
+	{
+		const CullScene& scene = cullScene();
+		std::vector<std::uint32_t> visible;
+		visible.reserve(CullObjectCount);
+
+		for (auto _ : state)
+		{
+			visible.clear();
+			for (int i = 0; i < CullObjectCount; ++i)
+			{
+				AABB box(Vector<3>{ scene.minimumX[i], scene.minimumY[i], scene.minimumZ[i] }, Vector<3>{ scene.maximumX[i], scene.maximumY[i], scene.maximumZ[i] });
+				if (scene.frustum.intersects(box))
+					visible.push_back(i);
+			}
+
+			benchmark::DoNotOptimize(visible.data());
+		}
+
+		state.counters["objects"] = benchmark::Counter(static_cast<double>(CullObjectCount) * static_cast<double>(state.iterations()), benchmark::Counter::kIsRate);
+	}
+	BENCHMARK(Frustum_Cull_Boxes_Scalar)->UseRealTime()->Unit(benchmark::kMicrosecond);
+
+	static void Frustum_Cull_Boxes(benchmark::State& state)
+	{
+		const CullScene& scene = cullScene();
+		ThreadPool pool(static_cast<unsigned>(state.range(0)));
+		std::vector<std::uint32_t> visible(CullObjectCount);
+
+		for (auto _ : state)
+		{
+			BoxStreams boxes = { scene.minimumX.data(), scene.minimumY.data(), scene.minimumZ.data(), scene.maximumX.data(), scene.maximumY.data(), scene.maximumZ.data() };
+			benchmark::DoNotOptimize(scene.frustum.cullBoxes(boxes, CullObjectCount, visible.data(), pool));
+		}
+
+		state.counters["objects"] = benchmark::Counter(static_cast<double>(CullObjectCount) * static_cast<double>(state.iterations()), benchmark::Counter::kIsRate);
+	}
+	BENCHMARK(Frustum_Cull_Boxes)->Arg(1)->Arg(4)->UseRealTime()->Unit(benchmark::kMicrosecond);
+
+#pragma endregion
+
+}
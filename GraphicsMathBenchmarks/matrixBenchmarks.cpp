@@ -0,0 +1,473 @@
+#include <memory>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "../GraphicsMathLib/Matrix.h"
+#include "OperationCounters.h"
+
+using namespace GraphicsMath;
+
+// Registers a square Matrix<size, size> benchmark for every supported dimension
+#define MATRIX_BENCHMARK(name) \
+	BENCHMARK_TEMPLATE(name, 2); \
+	BENCHMARK_TEMPLATE(name, 3); \
+	BENCHMARK_TEMPLATE(name, 4)
+
+namespace GraphicsMathBenchmarks
+{
+
+#pragma region Helpers
+
+	// A diagonally dominant, and therefore invertible, matrix with no zero entries
+	template<int size>
+	static Matrix<size, size> sampleMatrix(float seed)
+	{
+		Matrix<size, size> m;
+		for (int i = 0; i < size; ++i)
+		{
+			for (int j = 0; j < size; ++j)
+				m[i][j] = (i == j ? 4.0f : 0.0f) + seed * 0.1f * static_cast<float>((i + 1) * (j + 2));
+		}
+
+		return m;
+	}
+
+	// Times a binary operation on two sample matrices
+	template<int size, typename Operation>
+	static void measureBinary(benchmark::State& state, Operation operation)
+	{
+		auto a = sampleMatrix<size>(1.0f);
+		auto b = sampleMatrix<size>(2.0f);
+		OperationCounters counters(state);
+
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(a);
+			benchmark::DoNotOptimize(b);
+			benchmark::DoNotOptimize(operation(a, b));
+		}
+	}
+
+	// Times a mutating operation applied to a sample matrix
+	template<int size, typename Operation>
+	static void measureMutating(benchmark::State& state, Operation operation)
+	{
+		auto a = sampleMatrix<size>(1.0f);
+		auto b = sampleMatrix<size>(2.0f);
+		OperationCounters counters(state);
+
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(b);
+			operation(a, b);
+			benchmark::DoNotOptimize(a);
+		}
+	}
+
+#pragma endregion
+
+#pragma region Construction & Copy
+
+	template<int size>
+	static void Matrix_Default_Construction(benchmark::State& state)
+	{
+		OperationCounters counters(state);
+
+		for (auto _ : state)
+		{
+			Matrix<size, size> m;
+			benchmark::DoNotOptimize(m);
+		}
+	}
+	MATRIX_BENCHMARK(Matrix_Default_Construction);
+
+	static void Matrix_List_Construction(benchmark::State& state)
+	{
+		Vector<4> c0{ 1, 2, 3, 4 };
+		Vector<4> c1{ 5, 6, 7, 8 };
+		OperationCounters counters(state);
+
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(c0);
+			Matrix<4, 4> m{ c0, c1, c0, c1 };
+			benchmark::DoNotOptimize(m);
+		}
+	}
+	BENCHMARK(Matrix_List_Construction);
+
+	template<int size>
+	static void Matrix_Copy(benchmark::State& state)
+	{
+		measureBinary<size>(state, [](const Matrix<size, size>& a, const Matrix<size, size>&) { return Matrix<size, size>{ a }; });
+	}
+	MATRIX_BENCHMARK(Matrix_Copy);
+
+	template<int size>
+	static void Matrix_Equality(benchmark::State& state)
+	{
+		measureBinary<size>(state, [](const Matrix<size, size>& a, const Matrix<size, size>& b) { return a == b; });
+	}
+	MATRIX_BENCHMARK(Matrix_Equality);
+
+#pragma endregion
+
+#pragma region Arithmetic
+
+	template<int size>
+	static void Matrix_Addition(benchmark::State& state)
+	{
+		measureBinary<size>(state, [](const Matrix<size, size>& a, const Matrix<size, size>& b) { return a + b; });
+	}
+	MATRIX_BENCHMARK(Matrix_Addition);
+
+	template<int size>
+	static void Matrix_Subtraction(benchmark::State& state)
+	{
+		measureBinary<size>(state, [](const Matrix<size, size>& a, const Matrix<size, size>& b) { return a - b; });
+	}
+	MATRIX_BENCHMARK(Matrix_Subtraction);
+
+	template<int size>
+	static void Matrix_Multiplication(benchmark::State& state)
+	{
+		measureBinary<size>(state, [](const Matrix<size, size>& a, const Matrix<size, size>& b) { return a * b; });
+	}
+	MATRIX_BENCHMARK(Matrix_Multiplication);
+
+	template<int size>
+	static void Matrix_Scalar_Multiplication(benchmark::State& state)
+	{
+		measureBinary<size>(state, [](const Matrix<size, size>& a, const Matrix<size, size>&) { return a * 2.0f; });
+	}
+	MATRIX_BENCHMARK(Matrix_Scalar_Multiplication);
+
+	template<int size>
+	static void Matrix_Vector_Multiplication(benchmark::State& state)
+	{
+		measureBinary<size>(state, [](const Matrix<size, size>& a, const Matrix<size, size>& b) { return a * b[0]; });
+	}
+	MATRIX_BENCHMARK(Matrix_Vector_Multiplication);
+
+	template<int size>
+	static void Matrix_Mutating_Addition(benchmark::State& state)
+	{
+		measureMutating<size>(state, [](Matrix<size, size>& a, const Matrix<size, size>& b) { a += b; });
+	}
+	MATRIX_BENCHMARK(Matrix_Mutating_Addition);
+
+	template<int size>
+	static void Matrix_Mutating_Subtraction(benchmark::State& state)
+	{
+		measureMutating<size>(state, [](Matrix<size, size>& a, const Matrix<size, size>& b) { a -= b; });
+	}
+	MATRIX_BENCHMARK(Matrix_Mutating_Subtraction);
+
+	template<int size>
+	static void Matrix_Mutating_Multiplication(benchmark::State& state)
+	{
+		measureMutating<size>(state, [](Matrix<size, size>& a, const Matrix<size, size>& b) { a = b; a *= b; });
+	}
+	MATRIX_BENCHMARK(Matrix_Mutating_Multiplication);
+
+	template<int size>
+	static void Matrix_Mutating_Scalar_Multiplication(benchmark::State& state)
+	{
+		measureMutating<size>(state, [](Matrix<size, size>& a, const Matrix<size, size>&) { a *= 1.0f; });
+	}
+	MATRIX_BENCHMARK(Matrix_Mutating_Scalar_Multiplication);
+
+#pragma endregion
+
+#pragma region Determinant, Inverse & Transpose
+
+	template<int size>
+	static void Matrix_Determinant(benchmark::State& state)
+	{
+		measureBinary<size>(state, [](const Matrix<size, size>& a, const Matrix<size, size>&) { return a.determinant(); });
+	}
+	MATRIX_BENCHMARK(Matrix_Determinant);
+
+	template<int size>
+	static void Matrix_Inverse(benchmark::State& state)
+	{
+		measureBinary<size>(state, [](const Matrix<size, size>& a, const Matrix<size, size>&) { return a.inverse(); });
+	}
+	MATRIX_BENCHMARK(Matrix_Inverse);
+
+	template<int size>
+	static void Matrix_Invert(benchmark::State& state)
+	{
+		measureMutating<size>(state, [](Matrix<size, size>& a, const Matrix<size, size>& b) { a = b; a.invert(); });
+	}
+	MATRIX_BENCHMARK(Matrix_Invert);
+
+	template<int size>
+	static void Matrix_Transposition(benchmark::State& state)
+	{
+		measureBinary<size>(state, [](const Matrix<size, size>& a, const Matrix<size, size>&) { return a.transposition(); });
+	}
+	MATRIX_BENCHMARK(Matrix_Transposition);
+
+	template<int size>
+	static void Matrix_Transpose(benchmark::State& state)
+	{
+		measureMutating<size>(state, [](Matrix<size, size>& a, const Matrix<size, size>&) { a.transpose(); });
+	}
+	MATRIX_BENCHMARK(Matrix_Transpose);
+
+	template<int size>
+	static void Matrix_To_String(benchmark::State& state)
+	{
+		measureBinary<size>(state, [](const Matrix<size, size>& a, const Matrix<size, size>&) { return a.to_string(); });
+	}
+	MATRIX_BENCHMARK(Matrix_To_String);
+
+#pragma endregion
+
+#pragma region Transformation Matrices
+
+	static void Matrix4_Scale(benchmark::State& state)
+	{
+		Vector<3> v{ 2, 4, 8 };
+		OperationCounters counters(state);
+
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(v);
+			benchmark::DoNotOptimize(Matrix<4, 4>::Scale(v));
+		}
+	}
+	BENCHMARK(Matrix4_Scale);
+
+	static void Matrix4_Translation(benchmark::State& state)
+	{
+		Vector<3> v{ 1, 2, 3 };
+		OperationCounters counters(state);
+
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(v);
+			benchmark::DoNotOptimize(Matrix<4, 4>::Translation(v));
+		}
+	}
+	BENCHMARK(Matrix4_Translation);
+
+	static void Matrix4_Rotation(benchmark::State& state)
+	{
+		Vector<3> axis{ 0.267f, 0.535f, 0.802f };
+		float theta = 0.7f;
+		OperationCounters counters(state);
+
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(theta);
+			benchmark::DoNotOptimize(Matrix<4, 4>::Rotation(axis, theta));
+		}
+	}
+	BENCHMARK(Matrix4_Rotation);
+
+	static void Matrix4_Orthographic_Projection(benchmark::State& state)
+	{
+		float zNear = 0.1f;
+		OperationCounters counters(state);
+
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(zNear);
+			benchmark::DoNotOptimize(Matrix<4, 4>::OrthographicProjection(-1, 1, 1, -1, zNear, 100));
+		}
+	}
+	BENCHMARK(Matrix4_Orthographic_Projection);
+
+	static void Matrix4_Perspective_Projection(benchmark::State& state)
+	{
+		float fovy = 60;
+		OperationCounters counters(state);
+
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(fovy);
+			benchmark::DoNotOptimize(Matrix<4, 4>::PerspectiveProjection(fovy, 1.5f, 0.1f, 100));
+		}
+	}
+	BENCHMARK(Matrix4_Perspective_Projection);
+
+	static void Matrix4_Scale_Inverse(benchmark::State& state)
+	{
+		auto m = Matrix<4, 4>::Scale(Vector<3>{ 2, 4, 8 });
+		OperationCounters counters(state);
+
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(m);
+			benchmark::DoNotOptimize(Matrix<4, 4>::ScaleInverse(m));
+		}
+	}
+	BENCHMARK(Matrix4_Scale_Inverse);
+
+	static void Matrix4_Translation_Inverse(benchmark::State& state)
+	{
+		auto m = Matrix<4, 4>::Translation(Vector<3>{ 1, 2, 3 });
+		OperationCounters counters(state);
+
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(m);
+			benchmark::DoNotOptimize(Matrix<4, 4>::TranslationInverse(m));
+		}
+	}
+	BENCHMARK(Matrix4_Translation_Inverse);
+
+	static void Matrix4_Rotation_Inverse(benchmark::State& state)
+	{
+		auto m = Matrix<4, 4>::Rotation(Vector<3>{ 0, 0, 1 }, 0.7f);
+		OperationCounters counters(state);
+
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(m);
+			benchmark::DoNotOptimize(Matrix<4, 4>::RotationInverse(m));
+		}
+	}
+	BENCHMARK(Matrix4_Rotation_Inverse);
+
+	static void Matrix4_Affine_Inverse(benchmark::State& state)
+	{
+		auto m = Matrix<4, 4>::Translation(Vector<3>{ 1, 2, 3 }) * Matrix<4, 4>::Rotation(Vector<3>{ 0, 0, 1 }, 0.7f);
+		OperationCounters counters(state);
+
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(m);
+			benchmark::DoNotOptimize(m.affineInverse());
+		}
+	}
+	BENCHMARK(Matrix4_Affine_Inverse);
+
+#pragma endregion
+
+#pragma region Kernel Throughput
+
+	// Multiplies arrays of independent matrices so the result is throughput, not latency, bound
+	template<void(*kernel)(const float*, const float*, float*)>
+	static void Matrix4_Multiply_Kernel(benchmark::State& state)
+	{
+		const int count = 1024;
+		std::vector<Matrix<4, 4>> a(count, Matrix<4, 4>::Rotation(Vector<3>{ 0, 1, 0 }, 0.5f));
+		std::vector<Matrix<4, 4>> b(count, Matrix<4, 4>::Translation(Vector<3>{ 1, 2, 3 }));
+		std::vector<Matrix<4, 4>> out(count);
+
+		for (auto _ : state)
+		{
+			for (int i = 0; i < count; ++i)
+				kernel(a[i].data(), b[i].data(), out[i].data());
+
+			benchmark::ClobberMemory();
+		}
+
+		state.SetItemsProcessed(state.iterations() * count);
+	}
+	BENCHMARK_TEMPLATE(Matrix4_Multiply_Kernel, SIMD::Scalar::multiply4x4)->Name("Matrix4_Multiply_Kernel/Scalar");
+	BENCHMARK_TEMPLATE(Matrix4_Multiply_Kernel, SIMD::multiply4x4)->Name("Matrix4_Multiply_Kernel/SIMD");
+
+	template<void(*kernel)(const float*, const float*, float*)>
+	static void Matrix4_Transform_Kernel(benchmark::State& state)
+	{
+		const int count = 4096;
+		auto m = Matrix<4, 4>::Rotation(Vector<3>{ 0, 1, 0 }, 0.5f);
+		std::vector<Vector<4>> in(count, Vector<4>{ 1, 2, 3, 1 });
+		std::vector<Vector<4>> out(count);
+
+		for (auto _ : state)
+		{
+			for (int i = 0; i < count; ++i)
+				kernel(m.data(), in[i].begin(), out[i].begin());
+
+			benchmark::ClobberMemory();
+		}
+
+		state.SetItemsProcessed(state.iterations() * count);
+	}
+	BENCHMARK_TEMPLATE(Matrix4_Transform_Kernel, SIMD::Scalar::transform4x4)->Name("Matrix4_Transform_Kernel/Scalar");
+	BENCHMARK_TEMPLATE(Matrix4_Transform_Kernel, SIMD::transform4x4)->Name("Matrix4_Transform_Kernel/SIMD");
+
+	// Inverts an array of world matrices, the per object per frame workload
+	template<float(*kernel)(const float*, float*)>
+	static void Matrix4_Inverse_Kernel(benchmark::State& state)
+	{
+		const int count = 1024;
+		std::vector<Matrix<4, 4>> in(count, Matrix<4, 4>::Translation(Vector<3>{ 1, 2, 3 }) * Matrix<4, 4>::Rotation(Vector<3>{ 0, 1, 0 }, 0.5f));
+		std::vector<Matrix<4, 4>> out(count);
+
+		for (auto _ : state)
+		{
+			for (int i = 0; i < count; ++i)
+				benchmark::DoNotOptimize(kernel(in[i].data(), out[i].data()));
+
+			benchmark::ClobberMemory();
+		}
+
+		state.SetItemsProcessed(state.iterations() * count);
+	}
+	BENCHMARK_TEMPLATE(Matrix4_Inverse_Kernel, SIMD::Scalar::inverse4x4)->Name("Matrix4_Inverse_Kernel/Scalar");
+	BENCHMARK_TEMPLATE(Matrix4_Inverse_Kernel, SIMD::inverse4x4)->Name("Matrix4_Inverse_Kernel/SIMD");
+	BENCHMARK_TEMPLATE(Matrix4_Inverse_Kernel, SIMD::Scalar::affineInverse4x4)->Name("Matrix4_Affine_Inverse_Kernel/Scalar");
+	BENCHMARK_TEMPLATE(Matrix4_Inverse_Kernel, SIMD::affineInverse4x4)->Name("Matrix4_Affine_Inverse_Kernel/SIMD");
+
+#pragma endregion
+
+#pragma region Large Matrices
+
+	// Square products of state.range(0) sized matrices through a multiplication kernel, reported in
+	// floating point operations per second
+	template<void(*kernel)(const float*, const float*, float*, int, int, int)>
+	static void Matrix_GEMM_Kernel(benchmark::State& state)
+	{
+		const int n = static_cast<int>(state.range(0));
+		std::vector<float> a(n * n), b(n * n), out(n * n);
+
+		for (int i = 0; i < n * n; ++i)
+		{
+			a[i] = static_cast<float>(i % 7) * 0.25f;
+			b[i] = static_cast<float>(i % 5) * 0.5f;
+		}
+
+		OperationCounters counters(state);
+
+		for (auto _ : state)
+		{
+			kernel(a.data(), b.data(), out.data(), n, n, n);
+			benchmark::ClobberMemory();
+		}
+
+		state.counters["FLOPS"] = benchmark::Counter(2.0 * n * n * n * static_cast<double>(state.iterations()), benchmark::Counter::kIsRate);
+	}
+	BENCHMARK_TEMPLATE(Matrix_GEMM_Kernel, SIMD::Scalar::multiply)->Name("Matrix_GEMM_Kernel/Scalar")->Arg(16)->Arg(64)->Arg(256);
+	BENCHMARK_TEMPLATE(Matrix_GEMM_Kernel, SIMD::multiplyBlocked)->Name("Matrix_GEMM_Kernel/Blocked")->Arg(16)->Arg(64)->Arg(256);
+
+	// The same through Matrix<size, size>::operator *, kept on the heap
+	template<int size>
+	static void Matrix_Large_Multiplication(benchmark::State& state)
+	{
+		auto a = std::make_unique<Matrix<size, size>>(sampleMatrix<size>(1.0f));
+		auto b = std::make_unique<Matrix<size, size>>(sampleMatrix<size>(2.0f));
+		auto out = std::make_unique<Matrix<size, size>>();
+		OperationCounters counters(state);
+
+		for (auto _ : state)
+		{
+			*out = *a * *b;
+			benchmark::ClobberMemory();
+		}
+
+		state.counters["FLOPS"] = benchmark::Counter(2.0 * size * size * size * static_cast<double>(state.iterations()), benchmark::Counter::kIsRate);
+	}
+	BENCHMARK_TEMPLATE(Matrix_Large_Multiplication, 8);
+	BENCHMARK_TEMPLATE(Matrix_Large_Multiplication, 16);
+	BENCHMARK_TEMPLATE(Matrix_Large_Multiplication, 64);
+
+#pragma endregion
+
+}
@@ -0,0 +1,125 @@
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "../GraphicsMathLib/Packet.h"
+
+using namespace GraphicsMath;
+
+namespace GraphicsMathBenchmarks
+{
+
+#pragma region Ray Workload
+
+	static const int RayCount = 1 << 12;
+
+	static std::vector<Vector<3>> makeRayDirections()
+	{
+		std::vector<Vector<3>> result(RayCount);
+
+		for (int i = 0; i < RayCount; ++i)
+			result[i] = Vector<3>{ (float)(i % 64) / 32.0f - 1.0f, (float)(i / 64) / 32.0f - 1.0f, 1.0f };
+
+		return result;
+	}
+
+#pragma endregion
+
+#pragma region Packet Benchmarks
+
+	// Distance along each ray to a sphere, or -1 on a miss, one ray at a time
+	static void Packet_Ray_Sphere_Scalar(benchmark::State& state)
+	{
+		std::vector<Vector<3>> directions = makeRayDirections();
+		std::vector<float> distances(RayCount);
+		const Vector<3> origin{ 0, 0, -5 }, center{ 0.2f, -0.1f, 0 };
+		const float radius = 1.5f;
+
+		for (auto _ : state)
+		{
+			for (int i = 0; i < RayCount; ++i)
+			{
+				Vector<3> d = directions[i].normal();
+				Vector<3> oc = center - origin;
+				float b = oc.dotProduct(d);
+				float discriminant = b * b - oc.dotProduct(oc) + radius * radius;
+				distances[i] = discriminant >= 0 ? b - sqrtf(discriminant) : -1.0f;
+			}
+
+			benchmark::ClobberMemory();
+		}
+
+		state.SetItemsProcessed(state.iterations() * RayCount);
+	}
+	BENCHMARK(Packet_Ray_Sphere_Scalar);
+
+	static void Packet_Ray_Sphere_Vector3x8(benchmark::State& state)
+	{
+		std::vector<Vector<3>> directions = makeRayDirections();
+		std::vector<float> distances(RayCount);
+		const Vector3x8 origin(Vector<3>{ 0, 0, -5 }), center(Vector<3>{ 0.2f, -0.1f, 0 });
+		const Float8 radius(1.5f);
+
+		for (auto _ : state)
+		{
+			for (int i = 0; i < RayCount; i += 8)
+			{
+				Vector3x8 d = Vector3x8::Load(&directions[i]).normal();
+				Vector3x8 oc = center - origin;
+				Float8 b = oc.dotProduct(d);
+				Float8 discriminant = b * b - oc.dotProduct(oc) + radius * radius;
+				Mask8 hit = discriminant >= Float8(0.0f);
+				select(hit, b - squareRoot(discriminant), Float8(-1.0f)).store(&distances[i]);
+			}
+
+			benchmark::ClobberMemory();
+		}
+
+		state.SetItemsProcessed(state.iterations() * RayCount);
+	}
+	BENCHMARK(Packet_Ray_Sphere_Vector3x8);
+
+	// Eight object transforms applied to eight points, one Matrix<4, 4> at a time
+	static void Packet_Transform_Scalar(benchmark::State& state)
+	{
+		std::vector<Matrix<4, 4>> matrices(RayCount, Matrix<4, 4>::Translation(Vector<3>{ 1, 2, 3 }));
+		std::vector<Vector<3>> points = makeRayDirections(), out(RayCount);
+
+		for (auto _ : state)
+		{
+			for (int i = 0; i < RayCount; ++i)
+			{
+				Vector<4> p = matrices[i] * Vector<4>{ points[i][0], points[i][1], points[i][2], 1 };
+				out[i] = Vector<3>{ p[0], p[1], p[2] };
+			}
+
+			benchmark::ClobberMemory();
+		}
+
+		state.SetItemsProcessed(state.iterations() * RayCount);
+	}
+	BENCHMARK(Packet_Transform_Scalar);
+
+	static void Packet_Transform_Matrix4x4Batch(benchmark::State& state)
+	{
+		std::vector<Matrix<4, 4>> matrices(RayCount, Matrix<4, 4>::Translation(Vector<3>{ 1, 2, 3 }));
+		std::vector<Vector<3>> points = makeRayDirections(), out(RayCount);
+
+		for (auto _ : state)
+		{
+			for (int i = 0; i < RayCount; i += 8)
+			{
+				Matrix4x4Batch m = Matrix4x4Batch::Load(&matrices[i]);
+				m.transformPoint(Vector3x8::Load(&points[i])).store(&out[i]);
+			}
+
+			benchmark::ClobberMemory();
+		}
+
+		state.SetItemsProcessed(state.iterations() * RayCount);
+	}
+	BENCHMARK(Packet_Transform_Matrix4x4Batch);
+
+#pragma endregion
+
+}
@@ -0,0 +1,116 @@
+#include <chrono>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "../GraphicsMathLib/Parallel.h"
+
+using namespace GraphicsMath;
+
+namespace GraphicsMathBenchmarks
+{
+
+#pragma region Scaling Helpers
+
+	const size_t ScalingCount = 1 << 22;
+
+	// Best of a few runs of work on a single thread, used as the baseline for the speedup counter
+	template<typename Work>
+	static double serialSeconds(Work work)
+	{
+		ThreadPool serial(1);
+		double best = 1e30;
+
+		for (int run = 0; run < 3; ++run)
+		{
+			auto start = std::chrono::steady_clock::now();
+			work(serial);
+			std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+			if (elapsed.count() < best)
+				best = elapsed.count();
+		}
+
+		return best;
+	}
+
+	// Runs work on a pool with state.range(0) threads and reports the speedup over one thread
+	template<typename Work>
+	static void measureScaling(benchmark::State& state, Work work)
+	{
+		ThreadPool pool(static_cast<unsigned>(state.range(0)));
+		double serial = serialSeconds(work);
+		double total = 0;
+
+		for (auto _ : state)
+		{
+			auto start = std::chrono::steady_clock::now();
+			work(pool);
+			std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+			total += elapsed.count();
+			state.SetIterationTime(elapsed.count());
+		}
+
+		state.SetItemsProcessed(state.iterations() * ScalingCount);
+		state.counters["threads"] = static_cast<double>(pool.threadCount());
+		state.counters["speedup"] = serial / (total / static_cast<double>(state.iterations()));
+	}
+
+#pragma endregion
+
+#pragma region Scaling Benchmarks
+
+	static void Parallel_Transform_Points(benchmark::State& state)
+	{
+		auto m = Matrix<4, 4>::PerspectiveProjection(60, 1.5f, 0.1f, 100);
+		std::vector<float> x(ScalingCount, 1), y(ScalingCount, 2), z(ScalingCount, 3);
+		std::vector<float> ox(ScalingCount), oy(ScalingCount), oz(ScalingCount), ow(ScalingCount);
+
+		measureScaling(state, [&](ThreadPool& pool)
+		{
+			parallelTransformPoints(m, ConstPointStreams{ x.data(), y.data(), z.data(), nullptr },
+									PointStreams{ ox.data(), oy.data(), oz.data(), ow.data() }, ScalingCount, true, pool);
+		});
+	}
+	BENCHMARK(Parallel_Transform_Points)->RangeMultiplier(2)->Range(1, 32)->UseManualTime();
+
+	static void Parallel_Transform_Vectors(benchmark::State& state)
+	{
+		auto m = Matrix<4, 4>::Rotation(Vector<3>{ 0, 1, 0 }, 0.5f);
+		std::vector<Vector<4>> in(ScalingCount, Vector<4>{ 1, 2, 3, 1 });
+		std::vector<Vector<4>> out(ScalingCount);
+
+		measureScaling(state, [&](ThreadPool& pool)
+		{
+			parallelTransform(m, in.data(), out.data(), ScalingCount, pool);
+		});
+	}
+	BENCHMARK(Parallel_Transform_Vectors)->RangeMultiplier(2)->Range(1, 32)->UseManualTime();
+
+	static void Parallel_Normalize(benchmark::State& state)
+	{
+		std::vector<Vector<3>> v(ScalingCount, Vector<3>{ 1, 2, 3 });
+
+		measureScaling(state, [&](ThreadPool& pool)
+		{
+			parallelNormalize(v.data(), ScalingCount, pool);
+		});
+	}
+	BENCHMARK(Parallel_Normalize)->RangeMultiplier(2)->Range(1, 32)->UseManualTime();
+
+	static void Parallel_Dot_Product(benchmark::State& state)
+	{
+		std::vector<Vector<3>> a(ScalingCount, Vector<3>{ 1, 2, 3 });
+		std::vector<Vector<3>> b(ScalingCount, Vector<3>{ 0.5f, 0.25f, 0.125f });
+
+		measureScaling(state, [&](ThreadPool& pool)
+		{
+			benchmark::DoNotOptimize(parallelDotProduct(a.data(), b.data(), ScalingCount, pool));
+		});
+	}
+	BENCHMARK(Parallel_Dot_Product)->RangeMultiplier(2)->Range(1, 32)->UseManualTime();
+
+#pragma endregion
+
+}
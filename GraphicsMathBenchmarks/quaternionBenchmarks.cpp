@@ -0,0 +1,167 @@
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "../GraphicsMathLib/Quaternion.h"
+#include "OperationCounters.h"
+
+using namespace GraphicsMath;
+
+namespace GraphicsMathBenchmarks
+{
+
+#pragma region Single Operations
+
+	static void Quaternion_Multiplication(benchmark::State& state)
+	{
+		auto a = Quaternion::Rotation(Vector<3>{ 0, 1, 0 }, 0.5f);
+		auto b = Quaternion::Rotation(Vector<3>{ 1, 0, 0 }, 0.3f);
+		OperationCounters counters(state);
+
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(a);
+			benchmark::DoNotOptimize(b);
+			benchmark::DoNotOptimize(a * b);
+		}
+	}
+	BENCHMARK(Quaternion_Multiplication);
+
+	static void Quaternion_Rotation(benchmark::State& state)
+	{
+		Vector<3> axis{ 0.267f, 0.535f, 0.802f };
+		float theta = 0.7f;
+		OperationCounters counters(state);
+
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(theta);
+			benchmark::DoNotOptimize(Quaternion::Rotation(axis, theta));
+		}
+	}
+	BENCHMARK(Quaternion_Rotation);
+
+	static void Quaternion_Rotate_Vector(benchmark::State& state)
+	{
+		auto q = Quaternion::Rotation(Vector<3>{ 0, 1, 0 }, 0.5f);
+		Vector<3> v{ 1, 2, 3 };
+		OperationCounters counters(state);
+
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(q);
+			benchmark::DoNotOptimize(v);
+			benchmark::DoNotOptimize(q.rotate(v));
+		}
+	}
+	BENCHMARK(Quaternion_Rotate_Vector);
+
+	static void Quaternion_Normalize(benchmark::State& state)
+	{
+		Quaternion q{ 1, 2, 3, 4 };
+		OperationCounters counters(state);
+
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(q);
+			benchmark::DoNotOptimize(q.normal());
+		}
+	}
+	BENCHMARK(Quaternion_Normalize);
+
+	static void Quaternion_Nlerp(benchmark::State& state)
+	{
+		auto a = Quaternion::Rotation(Vector<3>{ 0, 1, 0 }, 0.5f);
+		auto b = Quaternion::Rotation(Vector<3>{ 1, 0, 0 }, 1.3f);
+		float t = 0.3f;
+		OperationCounters counters(state);
+
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(t);
+			benchmark::DoNotOptimize(Quaternion::Nlerp(a, b, t));
+		}
+	}
+	BENCHMARK(Quaternion_Nlerp);
+
+	static void Quaternion_Slerp(benchmark::State& state)
+	{
+		auto a = Quaternion::Rotation(Vector<3>{ 0, 1, 0 }, 0.5f);
+		auto b = Quaternion::Rotation(Vector<3>{ 1, 0, 0 }, 1.3f);
+		float t = 0.3f;
+		OperationCounters counters(state);
+
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(t);
+			benchmark::DoNotOptimize(Quaternion::Slerp(a, b, t));
+		}
+	}
+	BENCHMARK(Quaternion_Slerp);
+
+	static void Quaternion_To_Matrix(benchmark::State& state)
+	{
+		auto q = Quaternion::Rotation(Vector<3>{ 0, 1, 0 }, 0.5f);
+		OperationCounters counters(state);
+
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(q);
+			benchmark::DoNotOptimize(q.toMatrix());
+		}
+	}
+	BENCHMARK(Quaternion_To_Matrix);
+
+	static void Quaternion_From_Matrix(benchmark::State& state)
+	{
+		auto m = Matrix<4, 4>::Rotation(Vector<3>{ 0, 1, 0 }, 0.5f);
+		OperationCounters counters(state);
+
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(m);
+			benchmark::DoNotOptimize(Quaternion::FromMatrix(m));
+		}
+	}
+	BENCHMARK(Quaternion_From_Matrix);
+
+#pragma endregion
+
+#pragma region Joint Composition
+
+	// Composes each joint's local rotation with its parent's, the per frame work of an animated skeleton
+	template<typename Rotation>
+	static void composeJoints(benchmark::State& state, const Rotation& local)
+	{
+		const int count = static_cast<int>(state.range(0));
+		std::vector<Rotation> locals(count, local);
+		std::vector<Rotation> globals(count);
+
+		for (auto _ : state)
+		{
+			globals[0] = locals[0];
+			for (int i = 1; i < count; ++i)
+				globals[i] = globals[(i - 1) / 2] * locals[i];
+
+			benchmark::ClobberMemory();
+		}
+
+		state.SetItemsProcessed(state.iterations() * count);
+		state.SetBytesProcessed(state.iterations() * count * 2 * sizeof(Rotation));
+	}
+
+	static void Compose_Joints_Matrix(benchmark::State& state)
+	{
+		composeJoints(state, Matrix<4, 4>::Rotation(Vector<3>{ 0, 1, 0 }, 0.05f));
+	}
+	BENCHMARK(Compose_Joints_Matrix)->Arg(1 << 12);
+
+	static void Compose_Joints_Quaternion(benchmark::State& state)
+	{
+		composeJoints(state, Quaternion::Rotation(Vector<3>{ 0, 1, 0 }, 0.05f));
+	}
+	BENCHMARK(Compose_Joints_Quaternion)->Arg(1 << 12);
+
+#pragma endregion
+
+}
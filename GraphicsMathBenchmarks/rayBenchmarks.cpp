@@ -0,0 +1,171 @@
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "../GraphicsMathLib/Ray.h"
+
+using namespace GraphicsMath;
+
+namespace GraphicsMathBenchmarks
+{
+
+#pragma region Ray Workload
+
+	static const int IntersectionRayCount = 1 << 12;
+	static const int PrimitiveCount = 64;
+
+	// A 64 x 64 grid of camera rays looking down +z
+	static std::vector<Ray> makeCameraRays()
+	{
+		std::vector<Ray> result(IntersectionRayCount);
+		const Vector<3> camera{ 0, 0, -5 };
+
+		for (int i = 0; i < IntersectionRayCount; ++i)
+			result[i] = Ray(camera, Vector<3>{ (float)(i % 64) / 32.0f - 1.0f, (float)(i / 64) / 32.0f - 1.0f, 1.0f });
+
+		return result;
+	}
+
+	// A strip of triangles, each a little further away than the last, and a box around each
+	struct Primitives
+	{
+		std::vector<Vector<3>> vertices;
+		std::vector<AABB> boxes;
+
+		Primitives()
+		{
+			for (int i = 0; i < PrimitiveCount; ++i)
+			{
+				float x = (float)(i % 8) * 0.5f - 2.0f, y = (float)(i / 8) * 0.5f - 2.0f, z = (float)i * 0.05f;
+				vertices.push_back(Vector<3>{ x, y, z });
+				vertices.push_back(Vector<3>{ x + 0.9f, y, z });
+				vertices.push_back(Vector<3>{ x, y + 0.9f, z + 0.2f });
+
+				AABB box;
+				for (int v = 0; v < 3; ++v)
+					box.expand(vertices[3 * i + v]);
+				boxes.push_back(box);
+			}
+		}
+	};
+
+	static void countIntersections(benchmark::State& state)
+	{
+		state.counters["intersections"] = benchmark::Counter(static_cast<double>(state.iterations()) * IntersectionRayCount * PrimitiveCount, benchmark::Counter::kIsRate);
+	}
+
+#pragma endregion
+
+#pragma region Ray Benchmarks
+
+	// Closest hit of every ray against every triangle, one ray at a time
+	static void Ray_Triangle_Scalar(benchmark::State& state)
+	{
+		std::vector<Ray> rays = makeCameraRays();
+		Primitives primitives;
+		std::vector<float> closest(IntersectionRayCount);
+
+		for (auto _ : state)
+		{
+			for (int i = 0; i < IntersectionRayCount; ++i)
+			{
+				float distance = INFINITY;
+				for (int p = 0; p < PrimitiveCount; ++p)
+				{
+					const Vector<3>* v = &primitives.vertices[3 * p];
+					TriangleHit hit = intersectTriangle(rays[i], v[0], v[1], v[2], 0.0f, distance);
+					if (hit.hit)
+						distance = hit.distance;
+				}
+
+				closest[i] = distance;
+			}
+
+			benchmark::ClobberMemory();
+		}
+
+		countIntersections(state);
+	}
+	BENCHMARK(Ray_Triangle_Scalar)->Unit(benchmark::kMillisecond);
+
+	static void Ray_Triangle_Packet(benchmark::State& state)
+	{
+		std::vector<Ray> rays = makeCameraRays();
+		Primitives primitives;
+		std::vector<float> closest(IntersectionRayCount);
+
+		for (auto _ : state)
+		{
+			for (int i = 0; i < IntersectionRayCount; i += 8)
+			{
+				RayPacket packet = RayPacket::Load(&rays[i]);
+				Float8 distance(INFINITY);
+				for (int p = 0; p < PrimitiveCount; ++p)
+				{
+					const Vector<3>* v = &primitives.vertices[3 * p];
+					TriangleHit8 hit = intersectTriangle(packet, v[0], v[1], v[2], Float8(0.0f), distance);
+					distance = select(hit.hit, hit.distance, distance);
+				}
+
+				distance.store(&closest[i]);
+			}
+
+			benchmark::ClobberMemory();
+		}
+
+		countIntersections(state);
+	}
+	BENCHMARK(Ray_Triangle_Packet)->Unit(benchmark::kMillisecond);
+
+	static void Ray_Box_Scalar(benchmark::State& state)
+	{
+		std::vector<Ray> rays = makeCameraRays();
+		Primitives primitives;
+		std::vector<int> hits(IntersectionRayCount);
+
+		for (auto _ : state)
+		{
+			for (int i = 0; i < IntersectionRayCount; ++i)
+			{
+				int count = 0;
+				for (int p = 0; p < PrimitiveCount; ++p)
+					count += intersectBox(rays[i], primitives.boxes[p]).hit;
+
+				hits[i] = count;
+			}
+
+			benchmark::ClobberMemory();
+		}
+
+		countIntersections(state);
+	}
+	BENCHMARK(Ray_Box_Scalar)->Unit(benchmark::kMillisecond);
+
+	static void Ray_Box_Packet(benchmark::State& state)
+	{
+		std::vector<Ray> rays = makeCameraRays();
+		Primitives primitives;
+		std::vector<float> hits(IntersectionRayCount);
+
+		for (auto _ : state)
+		{
+			for (int i = 0; i < IntersectionRayCount; i += 8)
+			{
+				RayPacket packet = RayPacket::Load(&rays[i]);
+				Float8 count(0.0f);
+				for (int p = 0; p < PrimitiveCount; ++p)
+					count += select(intersectBox(packet, primitives.boxes[p]).hit, Float8(1.0f), Float8(0.0f));
+
+				count.store(&hits[i]);
+			}
+
+			benchmark::ClobberMemory();
+		}
+
+		countIntersections(state);
+	}
+	BENCHMARK(Ray_Box_Packet)->Unit(benchmark::kMillisecond);
+
+#pragma endregion
+
+}
@@ -0,0 +1,154 @@
+#include <cmath>
+#include <map>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "../GraphicsMathLib/SparseMatrix.h"
+#include "OperationCounters.h"
+
+using namespace GraphicsMath;
+
+namespace GraphicsMathBenchmarks
+{
+
+#pragma region Sparse Workload
+
+	// An implicit cloth step on a square grid of about vertexCount vertices: a spring between each
+	// vertex and its right and lower neighbours, plus mass on the diagonal
+	static BlockSparseMatrix makeCloth(int vertexCount)
+	{
+		const int side = static_cast<int>(std::sqrt(static_cast<double>(vertexCount)));
+		const Matrix<3, 3> zero = Matrix<3, 3>() * 0.0f;
+		std::vector<BlockTriplet> triplets;
+		triplets.reserve(static_cast<size_t>(side) * side * 9);
+
+		for (int y = 0; y < side; ++y)
+		{
+			for (int x = 0; x < side; ++x)
+			{
+				int v = y * side + x;
+				triplets.push_back({ v, v, Matrix<3, 3>() * 0.5f });
+
+				for (int neighbour : { x + 1 < side ? v + 1 : -1, y + 1 < side ? v + side : -1 })
+				{
+					if (neighbour < 0)
+						continue;
+
+					Matrix<3, 3> k = Matrix<3, 3>() * (1.0f + (float)(v % 5) * 0.1f);
+					triplets.push_back({ v, v, k });
+					triplets.push_back({ neighbour, neighbour, k });
+					triplets.push_back({ v, neighbour, zero - k });
+					triplets.push_back({ neighbour, v, zero - k });
+				}
+			}
+		}
+
+		return BlockSparseMatrix::FromTriplets(side * side, side * side, triplets);
+	}
+
+	static std::vector<Vector<3>> makeForces(int count)
+	{
+		std::vector<Vector<3>> result(count);
+
+		for (int i = 0; i < count; ++i)
+			result[i] = Vector<3>{ (float)(i % 7) - 3.0f, -9.8f, (float)(i % 3) };
+
+		return result;
+	}
+
+	// The matrices take a while to assemble, so each size is built once
+	static const BlockSparseMatrix& cloth(int vertexCount)
+	{
+		static std::map<int, BlockSparseMatrix> matrices;
+
+		auto found = matrices.find(vertexCount);
+		if (found == matrices.end())
+			found = matrices.emplace(vertexCount, makeCloth(vertexCount)).first;
+
+		return found->second;
+	}
+
+#pragma endregion
+
+#pragma region Sparse Benchmarks
+
+	static void Sparse_Block_SpMV(benchmark::State& state)
+	{
+		const BlockSparseMatrix& a = cloth(static_cast<int>(state.range(0)));
+		std::vector<Vector<3>> x = makeForces(a.rows()), out(a.rows());
+		OperationCounters counters(state);
+
+		for (auto _ : state)
+		{
+			multiply(a, x.data(), out.data());
+			benchmark::ClobberMemory();
+		}
+
+		// 9 multiplies and 9 adds per block
+		state.counters["FLOPS"] = benchmark::Counter(18.0 * a.nonZeroBlocks() * static_cast<double>(state.iterations()), benchmark::Counter::kIsRate);
+	}
+	BENCHMARK(Sparse_Block_SpMV)->Arg(100000)->Arg(1000000)->UseRealTime();
+
+	// The same matrix expanded to scalar CSR, for the bandwidth saved by the 3x3 blocks
+	static void Sparse_Scalar_SpMV(benchmark::State& state)
+	{
+		SparseMatrix a = cloth(static_cast<int>(state.range(0))).toScalar();
+		DenseVector x(a.cols()), out(a.rows());
+		OperationCounters counters(state);
+
+		for (auto _ : state)
+		{
+			multiply(a, x, out);
+			benchmark::ClobberMemory();
+		}
+
+		state.counters["FLOPS"] = benchmark::Counter(2.0 * a.nonZeros() * static_cast<double>(state.iterations()), benchmark::Counter::kIsRate);
+	}
+	BENCHMARK(Sparse_Scalar_SpMV)->Arg(100000)->Arg(1000000)->UseRealTime();
+
+	static void Sparse_Conjugate_Gradient(benchmark::State& state)
+	{
+		const BlockSparseMatrix& a = cloth(static_cast<int>(state.range(0)));
+		std::vector<Vector<3>> b = makeForces(a.rows()), x(a.rows());
+		SolverSettings settings;
+		settings.maxIterations = 50;
+		int64_t iterations = 0;
+
+		for (auto _ : state)
+		{
+			std::fill(x.begin(), x.end(), Vector<3>());
+			iterations += conjugateGradient(a, b.data(), x.data(), settings).iterations;
+		}
+
+		state.counters["solver_iterations/s"] = benchmark::Counter(static_cast<double>(iterations), benchmark::Counter::kIsRate);
+	}
+	BENCHMARK(Sparse_Conjugate_Gradient)->Arg(100000)->Arg(1000000)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+	static void Sparse_Gauss_Seidel(benchmark::State& state)
+	{
+		const BlockSparseMatrix& a = cloth(static_cast<int>(state.range(0)));
+		std::vector<Vector<3>> b = makeForces(a.rows()), x(a.rows());
+
+		for (auto _ : state)
+			gaussSeidel(a, b.data(), x.data(), 1);
+
+		state.counters["solver_iterations/s"] = benchmark::Counter(static_cast<double>(state.iterations()), benchmark::Counter::kIsRate);
+	}
+	BENCHMARK(Sparse_Gauss_Seidel)->Arg(100000)->Arg(1000000)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+	static void Sparse_Jacobi(benchmark::State& state)
+	{
+		const BlockSparseMatrix& a = cloth(static_cast<int>(state.range(0)));
+		std::vector<Vector<3>> b = makeForces(a.rows()), x(a.rows());
+
+		for (auto _ : state)
+			jacobi(a, b.data(), x.data(), 1);
+
+		state.counters["solver_iterations/s"] = benchmark::Counter(static_cast<double>(state.iterations()), benchmark::Counter::kIsRate);
+	}
+	BENCHMARK(Sparse_Jacobi)->Arg(100000)->Arg(1000000)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+#pragma endregion
+
+}
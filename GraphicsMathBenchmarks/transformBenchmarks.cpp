@@ -0,0 +1,118 @@
+#include <benchmark/benchmark.h>
+
+#include "../GraphicsMathLib/Transform.h"
+#include "OperationCounters.h"
+
+using namespace GraphicsMath;
+
+namespace GraphicsMathBenchmarks
+{
+
+#pragma region Transform Benchmarks
+
+	static Transform benchmarkTransform()
+	{
+		return Transform(Vector<3>{ 1, 2, 3 }, Quaternion::Rotation(Vector<3>{ 0.267f, 0.535f, 0.802f }, 0.7f), Vector<3>{ 2, 2, 2 });
+	}
+
+	// Each Transform benchmark is followed by the Matrix<4, 4> operation it replaces
+	static void Transform_Composition(benchmark::State& state)
+	{
+		Transform a = benchmarkTransform();
+		Transform b(Vector<3>{ -1, 0, 4 }, Quaternion::Rotation(Vector<3>{ 0, 1, 0 }, 0.3f), Vector<3>{ 1, 0.5f, 1 });
+		OperationCounters counters(state);
+
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(a);
+			benchmark::DoNotOptimize(b);
+			benchmark::DoNotOptimize(a * b);
+		}
+	}
+	BENCHMARK(Transform_Composition);
+
+	static void Transform_Composition_Matrix(benchmark::State& state)
+	{
+		Matrix<4, 4> a = benchmarkTransform().toMatrix();
+		Matrix<4, 4> b = Transform(Vector<3>{ -1, 0, 4 }, Quaternion::Rotation(Vector<3>{ 0, 1, 0 }, 0.3f), Vector<3>{ 1, 0.5f, 1 }).toMatrix();
+		OperationCounters counters(state);
+
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(a);
+			benchmark::DoNotOptimize(b);
+			benchmark::DoNotOptimize(a * b);
+		}
+	}
+	BENCHMARK(Transform_Composition_Matrix);
+
+	static void Transform_Inverse(benchmark::State& state)
+	{
+		Transform a = benchmarkTransform();
+		OperationCounters counters(state);
+
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(a);
+			benchmark::DoNotOptimize(a.inverse());
+		}
+	}
+	BENCHMARK(Transform_Inverse);
+
+	static void Transform_Inverse_Matrix(benchmark::State& state)
+	{
+		Matrix<4, 4> m = benchmarkTransform().toMatrix();
+		OperationCounters counters(state);
+
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(m);
+			benchmark::DoNotOptimize(m.inverse());
+		}
+	}
+	BENCHMARK(Transform_Inverse_Matrix);
+
+	static void Transform_Point(benchmark::State& state)
+	{
+		Transform a = benchmarkTransform();
+		Vector<3> p{ 0.5f, -1.5f, 2.25f };
+		OperationCounters counters(state);
+
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(a);
+			benchmark::DoNotOptimize(p);
+			benchmark::DoNotOptimize(a.transformPoint(p));
+		}
+	}
+	BENCHMARK(Transform_Point);
+
+	static void Transform_To_Matrix(benchmark::State& state)
+	{
+		Transform a = benchmarkTransform();
+		OperationCounters counters(state);
+
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(a);
+			benchmark::DoNotOptimize(a.toMatrix());
+		}
+	}
+	BENCHMARK(Transform_To_Matrix);
+
+	static void Transform_Decompose(benchmark::State& state)
+	{
+		Matrix<4, 4> m = benchmarkTransform().toMatrix();
+		OperationCounters counters(state);
+
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(m);
+			benchmark::DoNotOptimize(Transform::Decompose(m));
+		}
+	}
+	BENCHMARK(Transform_Decompose);
+
+#pragma endregion
+
+}
@@ -0,0 +1,116 @@
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "../GraphicsMathLib/TransformHierarchy.h"
+
+using namespace GraphicsMath;
+
+namespace GraphicsMathBenchmarks
+{
+
+#pragma region Transform Hierarchy Workload
+
+	static const std::uint32_t SceneNodeCount = 100000;
+
+	// A tree of 100000 nodes, four children each, nine levels deep
+	static std::vector<std::uint32_t> makeSceneParents()
+	{
+		std::vector<std::uint32_t> parents(SceneNodeCount);
+		parents[0] = TransformHierarchy::NoParent;
+		for (std::uint32_t i = 1; i < SceneNodeCount; ++i)
+			parents[i] = (i - 1) / 4;
+
+		return parents;
+	}
+
+	static Matrix<4, 4> sceneLocal(std::uint32_t node, int frame)
+	{
+		return Matrix<4, 4>::Translation(Vector<3>{ 0.01f * (float)(node % 13), 0.02f * (float)frame, 1.0f }) *
+			   Matrix<4, 4>::Rotation(Vector<3>{ 0, 1, 0 }, 0.001f * (float)(node % 31 + frame));
+	}
+
+#pragma endregion
+
+#pragma region Transform Hierarchy Benchmarks
+
+	// Every world matrix recomputed with operator* each frame, the baseline for the incremental update
+	static void TransformHierarchy_Naive_Full(benchmark::State& state)
+	{
+		std::vector<std::uint32_t> parents = makeSceneParents();
+		std::vector<Matrix<4, 4>> locals(SceneNodeCount), worlds(SceneNodeCount);
+		for (std::uint32_t i = 0; i < SceneNodeCount; ++i)
+			locals[i] = sceneLocal(i, 0);
+
+		for (auto _ : state)
+		{
+			worlds[0] = locals[0];
+			for (std::uint32_t i = 1; i < SceneNodeCount; ++i)
+				worlds[i] = worlds[parents[i]] * locals[i];
+
+			benchmark::ClobberMemory();
+		}
+
+		state.counters["nodes"] = benchmark::Counter(static_cast<double>(SceneNodeCount) * static_cast<double>(state.iterations()), benchmark::Counter::kIsRate);
+	}
+	BENCHMARK(TransformHierarchy_Naive_Full)->Unit(benchmark::kMicrosecond);
+
+	// state.range(0) nodes out of every 10000 change per frame, spread evenly over the scene
+	static void TransformHierarchy_Update(benchmark::State& state)
+	{
+		TransformHierarchy scene = TransformHierarchy::FromParents(makeSceneParents());
+		for (std::uint32_t i = 0; i < SceneNodeCount; ++i)
+			scene.setLocal(i, sceneLocal(i, 0), TransformKind::Rigid);
+		scene.update();
+
+		// Two frames of local matrices made up front, so only the update is timed
+		std::vector<Matrix<4, 4>> frames[2] = { std::vector<Matrix<4, 4>>(SceneNodeCount), std::vector<Matrix<4, 4>>(SceneNodeCount) };
+		for (std::uint32_t i = 0; i < SceneNodeCount; ++i)
+		{
+			frames[0][i] = sceneLocal(i, 1);
+			frames[1][i] = sceneLocal(i, 2);
+		}
+
+		const std::uint32_t stride = 10000 / static_cast<std::uint32_t>(state.range(0));
+		std::size_t recomputed = 0;
+		std::uint32_t frame = 0;
+
+		for (auto _ : state)
+		{
+			++frame;
+			const std::vector<Matrix<4, 4>>& locals = frames[frame % 2];
+			for (std::uint32_t i = frame % stride; i < SceneNodeCount; i += stride)
+				scene.setLocal(i, locals[i], TransformKind::Rigid);
+
+			recomputed += scene.update();
+		}
+
+		state.counters["recomputed"] = static_cast<double>(recomputed) / static_cast<double>(state.iterations());
+	}
+	BENCHMARK(TransformHierarchy_Update)->Arg(10000)->Arg(100)->Arg(10)->Unit(benchmark::kMicrosecond);
+
+	// The inverse of every world matrix after a full update, through the cheap rigid path
+	static void TransformHierarchy_Inverse_World(benchmark::State& state)
+	{
+		TransformHierarchy scene = TransformHierarchy::FromParents(makeSceneParents());
+		for (std::uint32_t i = 0; i < SceneNodeCount; ++i)
+			scene.setLocal(i, sceneLocal(i, 0), static_cast<TransformKind>(state.range(0)));
+
+		for (auto _ : state)
+		{
+			state.PauseTiming();
+			scene.setLocal(0, sceneLocal(0, 1), static_cast<TransformKind>(state.range(0)));
+			scene.update();
+			state.ResumeTiming();
+
+			for (std::uint32_t i = 0; i < SceneNodeCount; ++i)
+				benchmark::DoNotOptimize(scene.inverseWorld(i));
+		}
+
+		state.counters["nodes"] = benchmark::Counter(static_cast<double>(SceneNodeCount) * static_cast<double>(state.iterations()), benchmark::Counter::kIsRate);
+	}
+	BENCHMARK(TransformHierarchy_Inverse_World)->Arg(static_cast<int>(TransformKind::Rigid))->Arg(static_cast<int>(TransformKind::Affine))->Unit(benchmark::kMicrosecond);
+
+#pragma endregion
+
+}
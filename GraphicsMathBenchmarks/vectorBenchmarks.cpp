@@ -0,0 +1,418 @@
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "../GraphicsMathLib/Vector.h"
+#include "OperationCounters.h"
+
+using namespace GraphicsMath;
+
+// Registers a Vector<size> benchmark for every supported dimension
+#define VECTOR_BENCHMARK(name) \
+	BENCHMARK_TEMPLATE(name, 2); \
+	BENCHMARK_TEMPLATE(name, 3); \
+	BENCHMARK_TEMPLATE(name, 4)
+
+namespace GraphicsMathBenchmarks
+{
+
+#pragma region Helpers
+
+	// A vector with distinct, non-zero components so no operation hits a special case
+	template<int size>
+	static Vector<size> sampleVector(float seed)
+	{
+		Vector<size> v;
+		for (int i = 0; i < size; ++i)
+			v[i] = seed + static_cast<float>(i) + 1.0f;
+
+		return v;
+	}
+
+	// Times a binary operation on two sample vectors
+	template<int size, typename Operation>
+	static void measureBinary(benchmark::State& state, Operation operation)
+	{
+		auto a = sampleVector<size>(1.0f);
+		auto b = sampleVector<size>(2.0f);
+		OperationCounters counters(state);
+
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(a);
+			benchmark::DoNotOptimize(b);
+			benchmark::DoNotOptimize(operation(a, b));
+		}
+	}
+
+	// Times a mutating operation applied to a sample vector
+	template<int size, typename Operation>
+	static void measureMutating(benchmark::State& state, Operation operation)
+	{
+		auto a = sampleVector<size>(1.0f);
+		auto b = sampleVector<size>(2.0f);
+		OperationCounters counters(state);
+
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(b);
+			operation(a, b);
+			benchmark::DoNotOptimize(a);
+		}
+	}
+
+#pragma endregion
+
+#pragma region Construction & Copy
+
+	template<int size>
+	static void Vector_Default_Construction(benchmark::State& state)
+	{
+		OperationCounters counters(state);
+
+		for (auto _ : state)
+		{
+			Vector<size> v;
+			benchmark::DoNotOptimize(v);
+		}
+	}
+	VECTOR_BENCHMARK(Vector_Default_Construction);
+
+	template<int size>
+	static void Vector_List_Construction(benchmark::State& state)
+	{
+		OperationCounters counters(state);
+
+		for (auto _ : state)
+		{
+			Vector<size> v{ 1.0f, 2.0f };
+			benchmark::DoNotOptimize(v);
+		}
+	}
+	VECTOR_BENCHMARK(Vector_List_Construction);
+
+	template<int size>
+	static void Vector_Copy(benchmark::State& state)
+	{
+		measureBinary<size>(state, [](const Vector<size>& a, const Vector<size>&) { return Vector<size>{ a }; });
+	}
+	VECTOR_BENCHMARK(Vector_Copy);
+
+	template<int size>
+	static void Vector_Assignment(benchmark::State& state)
+	{
+		measureMutating<size>(state, [](Vector<size>& a, const Vector<size>& b) { a = b; });
+	}
+	VECTOR_BENCHMARK(Vector_Assignment);
+
+	template<int size>
+	static void Vector_Move_Assignment(benchmark::State& state)
+	{
+		measureMutating<size>(state, [](Vector<size>& a, const Vector<size>& b) { a = Vector<size>{ b }; });
+	}
+	VECTOR_BENCHMARK(Vector_Move_Assignment);
+
+	template<int size>
+	static void Vector_Subscript(benchmark::State& state)
+	{
+		measureBinary<size>(state, [](const Vector<size>& a, const Vector<size>&) { return a[size - 1]; });
+	}
+	VECTOR_BENCHMARK(Vector_Subscript);
+
+	template<int size>
+	static void Vector_Iteration(benchmark::State& state)
+	{
+		measureBinary<size>(state, [](const Vector<size>& a, const Vector<size>&)
+		{
+			float sum = 0;
+			for (float f : a)
+				sum += f;
+
+			return sum;
+		});
+	}
+	VECTOR_BENCHMARK(Vector_Iteration);
+
+#pragma endregion
+
+#pragma region Arithmetic
+
+	template<int size>
+	static void Vector_Addition(benchmark::State& state)
+	{
+		measureBinary<size>(state, [](const Vector<size>& a, const Vector<size>& b) { return a + b; });
+	}
+	VECTOR_BENCHMARK(Vector_Addition);
+
+	template<int size>
+	static void Vector_Scalar_Addition(benchmark::State& state)
+	{
+		measureBinary<size>(state, [](const Vector<size>& a, const Vector<size>&) { return a + 2.0f; });
+	}
+	VECTOR_BENCHMARK(Vector_Scalar_Addition);
+
+	template<int size>
+	static void Vector_Subtraction(benchmark::State& state)
+	{
+		measureBinary<size>(state, [](const Vector<size>& a, const Vector<size>& b) { return a - b; });
+	}
+	VECTOR_BENCHMARK(Vector_Subtraction);
+
+	template<int size>
+	static void Vector_Scalar_Subtraction(benchmark::State& state)
+	{
+		measureBinary<size>(state, [](const Vector<size>& a, const Vector<size>&) { return a - 2.0f; });
+	}
+	VECTOR_BENCHMARK(Vector_Scalar_Subtraction);
+
+	template<int size>
+	static void Vector_Multiplication(benchmark::State& state)
+	{
+		measureBinary<size>(state, [](const Vector<size>& a, const Vector<size>& b) { return a * b; });
+	}
+	VECTOR_BENCHMARK(Vector_Multiplication);
+
+	template<int size>
+	static void Vector_Scalar_Multiplication(benchmark::State& state)
+	{
+		measureBinary<size>(state, [](const Vector<size>& a, const Vector<size>&) { return a * 2.0f; });
+	}
+	VECTOR_BENCHMARK(Vector_Scalar_Multiplication);
+
+	template<int size>
+	static void Vector_Scalar_Division(benchmark::State& state)
+	{
+		measureBinary<size>(state, [](const Vector<size>& a, const Vector<size>&) { return a / 2.0f; });
+	}
+	VECTOR_BENCHMARK(Vector_Scalar_Division);
+
+	template<int size>
+	static void Vector_Mutating_Addition(benchmark::State& state)
+	{
+		measureMutating<size>(state, [](Vector<size>& a, const Vector<size>& b) { a += b; });
+	}
+	VECTOR_BENCHMARK(Vector_Mutating_Addition);
+
+	template<int size>
+	static void Vector_Mutating_Scalar_Addition(benchmark::State& state)
+	{
+		measureMutating<size>(state, [](Vector<size>& a, const Vector<size>&) { a += 1.0f; });
+	}
+	VECTOR_BENCHMARK(Vector_Mutating_Scalar_Addition);
+
+	template<int size>
+	static void Vector_Mutating_Subtraction(benchmark::State& state)
+	{
+		measureMutating<size>(state, [](Vector<size>& a, const Vector<size>& b) { a -= b; });
+	}
+	VECTOR_BENCHMARK(Vector_Mutating_Subtraction);
+
+	template<int size>
+	static void Vector_Mutating_Scalar_Subtraction(benchmark::State& state)
+	{
+		measureMutating<size>(state, [](Vector<size>& a, const Vector<size>&) { a -= 1.0f; });
+	}
+	VECTOR_BENCHMARK(Vector_Mutating_Scalar_Subtraction);
+
+	template<int size>
+	static void Vector_Mutating_Multiplication(benchmark::State& state)
+	{
+		measureMutating<size>(state, [](Vector<size>& a, const Vector<size>& b) { a *= b; });
+	}
+	VECTOR_BENCHMARK(Vector_Mutating_Multiplication);
+
+	template<int size>
+	static void Vector_Mutating_Scalar_Multiplication(benchmark::State& state)
+	{
+		measureMutating<size>(state, [](Vector<size>& a, const Vector<size>&) { a *= 1.0f; });
+	}
+	VECTOR_BENCHMARK(Vector_Mutating_Scalar_Multiplication);
+
+	template<int size>
+	static void Vector_Mutating_Scalar_Division(benchmark::State& state)
+	{
+		measureMutating<size>(state, [](Vector<size>& a, const Vector<size>&) { a /= 1.0f; });
+	}
+	VECTOR_BENCHMARK(Vector_Mutating_Scalar_Division);
+
+	static void Vector_Chained_Expression(benchmark::State& state)
+	{
+		Vector<3> a{ 1.0f, 2.0f, 3.0f };
+		Vector<3> b{ 4.0f, 5.0f, 6.0f };
+		Vector<3> c{ 7.0f, 8.0f, 9.0f };
+		OperationCounters counters(state);
+
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(a);
+			benchmark::DoNotOptimize(a + b * 2.0f - c);
+		}
+	}
+	BENCHMARK(Vector_Chained_Expression);
+
+#pragma endregion
+
+#pragma region Comparison Operators
+
+	template<int size>
+	static void Vector_Equality(benchmark::State& state)
+	{
+		measureBinary<size>(state, [](const Vector<size>& a, const Vector<size>& b) { return a == b; });
+	}
+	VECTOR_BENCHMARK(Vector_Equality);
+
+	template<int size>
+	static void Vector_Inequality(benchmark::State& state)
+	{
+		measureBinary<size>(state, [](const Vector<size>& a, const Vector<size>& b) { return a != b; });
+	}
+	VECTOR_BENCHMARK(Vector_Inequality);
+
+	template<int size>
+	static void Vector_Less_Than(benchmark::State& state)
+	{
+		measureBinary<size>(state, [](const Vector<size>& a, const Vector<size>& b) { return a < b; });
+	}
+	VECTOR_BENCHMARK(Vector_Less_Than);
+
+	template<int size>
+	static void Vector_Greater_Equal(benchmark::State& state)
+	{
+		measureBinary<size>(state, [](const Vector<size>& a, const Vector<size>& b) { return a >= b; });
+	}
+	VECTOR_BENCHMARK(Vector_Greater_Equal);
+
+#pragma endregion
+
+#pragma region Vector Specific Operations
+
+	template<int size>
+	static void Vector_Square_Magnitude(benchmark::State& state)
+	{
+		measureBinary<size>(state, [](const Vector<size>& a, const Vector<size>&) { return a.squareMagnitude(); });
+	}
+	VECTOR_BENCHMARK(Vector_Square_Magnitude);
+
+	template<int size>
+	static void Vector_Magnitude(benchmark::State& state)
+	{
+		measureBinary<size>(state, [](const Vector<size>& a, const Vector<size>&) { return a.magnitude(); });
+	}
+	VECTOR_BENCHMARK(Vector_Magnitude);
+
+	template<int size>
+	static void Vector_Dot_Product(benchmark::State& state)
+	{
+		measureBinary<size>(state, [](const Vector<size>& a, const Vector<size>& b) { return a.dotProduct(b); });
+	}
+	VECTOR_BENCHMARK(Vector_Dot_Product);
+
+	static void Vector_Cross_Product(benchmark::State& state)
+	{
+		measureBinary<3>(state, [](const Vector<3>& a, const Vector<3>& b) { return a.crossProduct(b); });
+	}
+	BENCHMARK(Vector_Cross_Product);
+
+	template<int size>
+	static void Vector_Normal(benchmark::State& state)
+	{
+		measureBinary<size>(state, [](const Vector<size>& a, const Vector<size>&) { return a.normal(); });
+	}
+	VECTOR_BENCHMARK(Vector_Normal);
+
+	template<int size>
+	static void Vector_Normalize(benchmark::State& state)
+	{
+		measureMutating<size>(state, [](Vector<size>& a, const Vector<size>& b) { a = b; a.normalize(); });
+	}
+	VECTOR_BENCHMARK(Vector_Normalize);
+
+	template<int size>
+	static void Vector_Homogenous(benchmark::State& state)
+	{
+		measureBinary<size>(state, [](const Vector<size>& a, const Vector<size>&) { return a.homogenous(); });
+	}
+	VECTOR_BENCHMARK(Vector_Homogenous);
+
+	template<int size>
+	static void Vector_Homogenize(benchmark::State& state)
+	{
+		measureMutating<size>(state, [](Vector<size>& a, const Vector<size>& b) { a = b; a.homogenize(); });
+	}
+	VECTOR_BENCHMARK(Vector_Homogenize);
+
+	template<int size>
+	static void Vector_To_String(benchmark::State& state)
+	{
+		measureBinary<size>(state, [](const Vector<size>& a, const Vector<size>&) { return a.to_string(); });
+	}
+	VECTOR_BENCHMARK(Vector_To_String);
+
+#pragma endregion
+
+#pragma region Vector Conversion Methods
+
+	static void Vector_Lower_Dimension(benchmark::State& state)
+	{
+		measureBinary<4>(state, [](const Vector<4>& a, const Vector<4>&) { return lowerDimension(lowerDimension(a)); });
+	}
+	BENCHMARK(Vector_Lower_Dimension);
+
+	static void Vector_Higher_Dimension(benchmark::State& state)
+	{
+		measureBinary<2>(state, [](const Vector<2>& a, const Vector<2>&) { return higherDimension(higherDimension(a, 3.0f), 1.0f); });
+	}
+	BENCHMARK(Vector_Higher_Dimension);
+
+#pragma endregion
+
+#pragma region Vector Streams
+
+	// a + b * s over arrays of vectors, the inner loop of particle and skinning updates. Run with
+	// GRAPHICSMATH_BOUNDS_CHECK on and off to see the cost of checking operator[] in hot loops.
+	template<int size>
+	static void Vector_Stream_Subscript(benchmark::State& state)
+	{
+		const size_t count = static_cast<size_t>(state.range(0));
+		std::vector<Vector<size>> a(count, sampleVector<size>(1.0f)), b(count, sampleVector<size>(2.0f)), out(count);
+		OperationCounters counters(state, count);
+
+		for (auto _ : state)
+		{
+			for (size_t i = 0; i < count; ++i)
+			{
+				for (int j = 0; j < size; ++j)
+					out[i][j] = a[i][j] + b[i][j] * 0.5f;
+			}
+
+			benchmark::ClobberMemory();
+		}
+
+		state.SetItemsProcessed(state.iterations() * count);
+	}
+	BENCHMARK_TEMPLATE(Vector_Stream_Subscript, 3)->Arg(1 << 12);
+	BENCHMARK_TEMPLATE(Vector_Stream_Subscript, 4)->Arg(1 << 12);
+
+	template<int size>
+	static void Vector_Stream_Operators(benchmark::State& state)
+	{
+		const size_t count = static_cast<size_t>(state.range(0));
+		std::vector<Vector<size>> a(count, sampleVector<size>(1.0f)), b(count, sampleVector<size>(2.0f)), out(count);
+		OperationCounters counters(state, count);
+
+		for (auto _ : state)
+		{
+			for (size_t i = 0; i < count; ++i)
+				out[i] = a[i] + b[i] * 0.5f;
+
+			benchmark::ClobberMemory();
+		}
+
+		state.SetItemsProcessed(state.iterations() * count);
+	}
+	BENCHMARK_TEMPLATE(Vector_Stream_Operators, 3)->Arg(1 << 12);
+	BENCHMARK_TEMPLATE(Vector_Stream_Operators, 4)->Arg(1 << 12);
+
+#pragma endregion
+
+}
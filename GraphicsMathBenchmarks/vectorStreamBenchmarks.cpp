@@ -0,0 +1,166 @@
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "../GraphicsMathLib/VectorStream.h"
+
+using namespace GraphicsMath;
+
+namespace GraphicsMathBenchmarks
+{
+
+#pragma region Stream Workload
+
+	static std::vector<Vector<3>> makeDirections(size_t count)
+	{
+		std::vector<Vector<3>> result(count);
+
+		for (size_t i = 0; i < count; ++i)
+			result[i] = Vector<3>{ (float)(i % 7) + 1.0f, (float)(i % 5) - 2.5f, 0.5f };
+
+		return result;
+	}
+
+#pragma endregion
+
+#pragma region Stream Benchmarks
+
+	// An array of Vector<3>, one call per vector
+	static void Stream_Normalize_AoS(benchmark::State& state)
+	{
+		const size_t count = static_cast<size_t>(state.range(0));
+		std::vector<Vector<3>> v = makeDirections(count);
+
+		for (auto _ : state)
+		{
+			for (size_t i = 0; i < count; ++i)
+				v[i].normalize();
+
+			benchmark::ClobberMemory();
+		}
+
+		state.SetItemsProcessed(state.iterations() * count);
+	}
+	BENCHMARK(Stream_Normalize_AoS)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 20);
+
+	static void Stream_Normalize_SoA(benchmark::State& state)
+	{
+		const size_t count = static_cast<size_t>(state.range(0));
+		std::vector<Vector<3>> v = makeDirections(count);
+		VectorStream<3> stream(v.data(), count);
+
+		for (auto _ : state)
+		{
+			stream.normalize();
+			benchmark::ClobberMemory();
+		}
+
+		state.SetItemsProcessed(state.iterations() * count);
+	}
+	BENCHMARK(Stream_Normalize_SoA)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 20);
+
+	static void Stream_Dot_AoS(benchmark::State& state)
+	{
+		const size_t count = static_cast<size_t>(state.range(0));
+		std::vector<Vector<3>> a = makeDirections(count), b = makeDirections(count);
+		std::vector<float> out(count);
+
+		for (auto _ : state)
+		{
+			for (size_t i = 0; i < count; ++i)
+				out[i] = a[i].dotProduct(b[i]);
+
+			benchmark::ClobberMemory();
+		}
+
+		state.SetItemsProcessed(state.iterations() * count);
+	}
+	BENCHMARK(Stream_Dot_AoS)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 20);
+
+	static void Stream_Dot_SoA(benchmark::State& state)
+	{
+		const size_t count = static_cast<size_t>(state.range(0));
+		std::vector<Vector<3>> v = makeDirections(count);
+		VectorStream<3> a(v.data(), count), b(v.data(), count);
+		std::vector<float> out(count);
+
+		for (auto _ : state)
+		{
+			a.dotProduct(b, out.data());
+			benchmark::ClobberMemory();
+		}
+
+		state.SetItemsProcessed(state.iterations() * count);
+	}
+	BENCHMARK(Stream_Dot_SoA)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 20);
+
+	static void Stream_Cross_AoS(benchmark::State& state)
+	{
+		const size_t count = static_cast<size_t>(state.range(0));
+		std::vector<Vector<3>> a = makeDirections(count), b = makeDirections(count), out(count);
+
+		for (auto _ : state)
+		{
+			for (size_t i = 0; i < count; ++i)
+				out[i] = a[i].crossProduct(b[i]);
+
+			benchmark::ClobberMemory();
+		}
+
+		state.SetItemsProcessed(state.iterations() * count);
+	}
+	BENCHMARK(Stream_Cross_AoS)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 20);
+
+	static void Stream_Cross_SoA(benchmark::State& state)
+	{
+		const size_t count = static_cast<size_t>(state.range(0));
+		std::vector<Vector<3>> v = makeDirections(count);
+		VectorStream<3> a(v.data(), count), b(v.data(), count), out(count);
+
+		for (auto _ : state)
+		{
+			a.crossProduct(b, out);
+			benchmark::ClobberMemory();
+		}
+
+		state.SetItemsProcessed(state.iterations() * count);
+	}
+	BENCHMARK(Stream_Cross_SoA)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 20);
+
+	// position += velocity * dt over a particle system
+	static void Stream_Integrate_AoS(benchmark::State& state)
+	{
+		const size_t count = static_cast<size_t>(state.range(0));
+		std::vector<Vector<3>> position = makeDirections(count), velocity = makeDirections(count);
+
+		for (auto _ : state)
+		{
+			for (size_t i = 0; i < count; ++i)
+				position[i] += velocity[i] * 0.016f;
+
+			benchmark::ClobberMemory();
+		}
+
+		state.SetItemsProcessed(state.iterations() * count);
+	}
+	BENCHMARK(Stream_Integrate_AoS)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 20);
+
+	static void Stream_Integrate_SoA(benchmark::State& state)
+	{
+		const size_t count = static_cast<size_t>(state.range(0));
+		std::vector<Vector<3>> v = makeDirections(count);
+		VectorStream<3> position(v.data(), count), velocity(v.data(), count);
+
+		for (auto _ : state)
+		{
+			position.multiplyAdd(velocity, 0.016f);
+			benchmark::ClobberMemory();
+		}
+
+		state.SetItemsProcessed(state.iterations() * count);
+	}
+	BENCHMARK(Stream_Integrate_SoA)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 20);
+
+#pragma endregion
+
+}
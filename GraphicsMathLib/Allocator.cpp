@@ -0,0 +1,169 @@
+#include <algorithm>
+#include <cstdint>
+
+#include "Allocator.h"
+
+namespace GraphicsMath
+{
+
+	// Blocks start on a cache line so aligned allocations rarely need padding
+	static const std::size_t BlockAlignment = 64;
+
+#pragma region Frame Arena
+
+	FrameArena& FrameArena::threadLocal()
+	{
+		thread_local FrameArena arena;
+		return arena;
+	}
+
+	FrameArena::FrameArena(std::size_t blockSize)
+		: m_blockSize(std::max<std::size_t>(blockSize, BlockAlignment)), m_offset(0), m_used(0)
+	{
+	}
+
+	FrameArena::~FrameArena()
+	{
+		releaseBlocks();
+	}
+
+	void FrameArena::addBlock(std::size_t minimumSize)
+	{
+		std::size_t size = std::max(m_blockSize, minimumSize);
+		char* data = static_cast<char*>(::operator new(size, std::align_val_t(BlockAlignment)));
+
+		m_blocks.push_back(Block{ data, size });
+		m_offset = 0;
+	}
+
+	void FrameArena::releaseBlocks()
+	{
+		for (auto& block : m_blocks)
+			::operator delete(block.data, std::align_val_t(BlockAlignment));
+
+		m_blocks.clear();
+	}
+
+	void* FrameArena::allocate(std::size_t bytes, std::size_t alignment)
+	{
+		if (!m_blocks.empty())
+		{
+			const Block& block = m_blocks.back();
+			std::uintptr_t current = reinterpret_cast<std::uintptr_t>(block.data) + m_offset;
+			std::size_t padding = (alignment - current % alignment) % alignment;
+
+			if (m_offset + padding + bytes <= block.size)
+			{
+				m_offset += padding + bytes;
+				m_used += bytes;
+				return reinterpret_cast<void*>(current + padding);
+			}
+		}
+
+		// Blocks are cache line aligned, so only alignments beyond that need room for padding
+		addBlock(bytes + (alignment > BlockAlignment ? alignment : 0));
+
+		return allocate(bytes, alignment);
+	}
+
+	void FrameArena::reset()
+	{
+		// Fold a frame that spilled into several blocks into one block big enough for all of it
+		if (m_blocks.size() > 1)
+		{
+			std::size_t total = capacity();
+			releaseBlocks();
+			addBlock(total);
+		}
+
+		m_offset = 0;
+		m_used = 0;
+	}
+
+	std::size_t FrameArena::bytesUsed() const
+	{
+		return m_used;
+	}
+
+	std::size_t FrameArena::capacity() const
+	{
+		std::size_t total = 0;
+		for (const auto& block : m_blocks)
+			total += block.size;
+
+		return total;
+	}
+
+#pragma endregion
+
+#pragma region Pool Allocator
+
+	PoolAllocator& PoolAllocator::threadLocal()
+	{
+		thread_local PoolAllocator pool;
+		return pool;
+	}
+
+	PoolAllocator::PoolAllocator(std::size_t blockSize)
+		: m_freeLists{}, m_arena(blockSize)
+	{
+	}
+
+	int PoolAllocator::sizeClass(std::size_t bytes)
+	{
+		int c = 0;
+		for (std::size_t size = MinimumBlock; size < bytes; size <<= 1)
+			++c;
+
+		return c;
+	}
+
+	void* PoolAllocator::allocate(std::size_t bytes, std::size_t alignment)
+	{
+		if (bytes > MaximumBlock || alignment > MinimumBlock)
+			return ::operator new(bytes, std::align_val_t(std::max(alignment, MinimumBlock)));
+
+		int c = sizeClass(bytes);
+
+		if (FreeBlock* block = m_freeLists[c])
+		{
+			m_freeLists[c] = block->next;
+			return block;
+		}
+
+		return m_arena.allocate(MinimumBlock << c, MinimumBlock);
+	}
+
+	void PoolAllocator::deallocate(void* p, std::size_t bytes, std::size_t alignment)
+	{
+		if (p == nullptr)
+			return;
+
+		if (bytes > MaximumBlock || alignment > MinimumBlock)
+		{
+			::operator delete(p, std::align_val_t(std::max(alignment, MinimumBlock)));
+			return;
+		}
+
+		int c = sizeClass(bytes);
+		FreeBlock* block = static_cast<FreeBlock*>(p);
+		block->next = m_freeLists[c];
+		m_freeLists[c] = block;
+	}
+
+	void PoolAllocator::reset()
+	{
+		for (auto& list : m_freeLists)
+			list = nullptr;
+
+		m_arena.reset();
+	}
+
+	std::size_t PoolAllocator::capacity() const
+	{
+		return m_arena.capacity();
+	}
+
+#pragma endregion
+
+}
@@ -0,0 +1,199 @@
+#ifndef ALLOCATOR_H
+#define ALLOCATOR_H
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+namespace GraphicsMath
+{
+
+#pragma region Allocator Definitions
+
+	/* -------------------------------------------------------------------------------------------------
+		Copyright 2017 Shealyn Tate Hindenlang
+
+		Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+		and associated documentation files (the "Software"), to deal in the Software without restriction,
+		including without limitation the rights to use, copy, modify, merge, publish, distribute,
+		sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+		furnished to do so, subject to the following conditions:
+
+		The above copyright notice and this permission notice shall be included in all copies or
+		substantial portions of the Software.
+
+		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+		BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+		NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+		DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+		-------------------------------------------------------------------------------------------------
+
+		Allocators for the short lived arrays of vectors and matrices built during a frame: hit
+		lists, visible sets, per object scratch buffers. Vector and Matrix themselves never allocate;
+		these replace the calls to operator new behind the containers that hold them.
+
+		Constructors:
+			FrameArena(blockSize)
+			PoolAllocator(blockSize)
+			static FrameArena::threadLocal()
+			static PoolAllocator::threadLocal()
+			ResourceAllocator<T, Resource>(Resource&)
+
+		Usage:
+			auto& arena = FrameArena::threadLocal();
+			std::vector<Vector<4>, ResourceAllocator<Vector<4>, FrameArena>> hits(arena);
+			...
+			arena.reset();		// once per frame, after every container using it is gone
+
+		Notes:
+			- FrameArena hands out memory by bumping a pointer and frees nothing until reset(). It
+			  suits data that all dies at the end of the frame.
+			- PoolAllocator rounds each request up to one of its size classes (16 to 512 bytes) and
+			  keeps a free list per class, so freed blocks are reused by later requests of a similar
+			  size. Larger requests go straight to operator new.
+			- Both allocators keep their memory across reset(). If a frame needed more than one block,
+			  reset() replaces the blocks with a single block of the combined size, so a steady
+			  workload settles on one block and stops calling operator new altogether.
+			- Neither allocator is thread safe. Use one per thread; threadLocal() returns the calling
+			  thread's instance.
+			- reset() invalidates every pointer the allocator has handed out.
+			- ResourceAllocator adapts either allocator to the standard Allocator requirements for
+			  use with std::vector and the other standard containers. Two ResourceAllocators compare
+			  equal when they share the same resource.
+	*/
+
+	class FrameArena
+	{
+	private:
+		struct Block
+		{
+			char* data;
+			std::size_t size;
+		};
+
+		std::vector<Block> m_blocks;
+		std::size_t m_blockSize;
+		std::size_t m_offset;
+		std::size_t m_used;
+
+		void addBlock(std::size_t minimumSize);
+		void releaseBlocks();
+
+	public:
+		static constexpr std::size_t DefaultBlockSize = 64 * 1024;
+
+		static FrameArena& threadLocal();
+
+		explicit FrameArena(std::size_t blockSize = DefaultBlockSize);
+		~FrameArena();
+
+		FrameArena(const FrameArena&) = delete;
+		FrameArena& operator=(const FrameArena&) = delete;
+
+		void* allocate(std::size_t bytes, std::size_t alignment = alignof(std::max_align_t));
+		void deallocate(void*, std::size_t, std::size_t = alignof(std::max_align_t)) {}
+
+		void reset();
+
+		std::size_t bytesUsed() const;
+		std::size_t capacity() const;
+	};
+
+	class PoolAllocator
+	{
+	private:
+		static constexpr int ClassCount = 6;
+
+		struct FreeBlock
+		{
+			FreeBlock* next;
+		};
+
+		FreeBlock* m_freeLists[ClassCount];
+		FrameArena m_arena;
+
+		static int sizeClass(std::size_t bytes);
+
+	public:
+		static constexpr std::size_t MinimumBlock = 16;
+		static constexpr std::size_t MaximumBlock = MinimumBlock << (ClassCount - 1);
+
+		static PoolAllocator& threadLocal();
+
+		explicit PoolAllocator(std::size_t blockSize = FrameArena::DefaultBlockSize);
+
+		PoolAllocator(const PoolAllocator&) = delete;
+		PoolAllocator& operator=(const PoolAllocator&) = delete;
+
+		void* allocate(std::size_t bytes, std::size_t alignment = alignof(std::max_align_t));
+		void deallocate(void* p, std::size_t bytes, std::size_t alignment = alignof(std::max_align_t));
+
+		void reset();
+
+		std::size_t capacity() const;
+	};
+
+	template<typename T, typename Resource>
+	class ResourceAllocator
+	{
+	private:
+		Resource* m_resource;
+
+		template<typename, typename>
+		friend class ResourceAllocator;
+
+	public:
+		typedef T value_type;
+
+		template<typename U>
+		struct rebind
+		{
+			typedef ResourceAllocator<U, Resource> other;
+		};
+
+		ResourceAllocator(Resource& resource) noexcept
+			: m_resource(&resource)
+		{
+		}
+
+		template<typename U>
+		ResourceAllocator(const ResourceAllocator<U, Resource>& other) noexcept
+			: m_resource(other.m_resource)
+		{
+		}
+
+		T* allocate(std::size_t n)
+		{
+			return static_cast<T*>(m_resource->allocate(n * sizeof(T), alignof(T)));
+		}
+
+		void deallocate(T* p, std::size_t n)
+		{
+			m_resource->deallocate(p, n * sizeof(T), alignof(T));
+		}
+
+		Resource& resource() const
+		{
+			return *m_resource;
+		}
+
+		template<typename U>
+		bool operator ==(const ResourceAllocator<U, Resource>& other) const
+		{
+			return m_resource == other.m_resource;
+		}
+
+		template<typename U>
+		bool operator !=(const ResourceAllocator<U, Resource>& other) const
+		{
+			return m_resource != other.m_resource;
+		}
+	};
+
+#pragma endregion
+
+}
+
+#endif
@@ -0,0 +1,760 @@
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include "BVH.h"
+
+namespace GraphicsMath
+{
+
+	static_assert(sizeof(BVHNode) == 32, "Two nodes per cache line");
+
+	// Nodes with more primitives than this are split with the whole pool binning them; the ones
+	// below it are built as independent subtrees
+	static const std::size_t SubtreeSize = 16384;
+	static const std::size_t BinningGrain = 16384;
+
+	// Below this depth every split is at the median, which bounds the depth by 64 for 2^32 primitives
+	static const int BalancedDepth = 32;
+	static const int MaxDepth = 64;
+
+	static const int MaxBinCount = 256;
+	static const int MaxLeafSize = 255;
+
+#pragma region Builder
+
+	struct BuildPrimitive
+	{
+		AABB bounds;
+		std::uint32_t index;
+	};
+
+	struct BuildNode
+	{
+		AABB bounds;
+		std::uint32_t first;
+		std::uint32_t count;
+		// Children in the same tree, -1 for a leaf
+		std::int32_t left;
+		std::int32_t right;
+		// The subtree job that builds the rest of this node, or -1
+		std::int32_t subtree;
+		std::uint16_t axis;
+	};
+
+	// A node still to be built: its primitives and the bounds of them and of their centroids
+	struct BuildRange
+	{
+		std::int32_t node;
+		std::uint32_t first;
+		std::uint32_t count;
+		int depth;
+		AABB bounds;
+		AABB centroids;
+	};
+
+	struct BuildContext
+	{
+		std::vector<BuildPrimitive> primitives;
+		const BVHSettings& settings;
+	};
+
+	struct RangeBounds
+	{
+		AABB bounds;
+		AABB centroids;
+	};
+
+	struct Bin
+	{
+		AABB bounds;
+		std::uint32_t count = 0;
+	};
+
+	static void checkSettings(const BVHSettings& settings)
+	{
+		if (settings.binCount < 2 || settings.binCount > MaxBinCount || settings.leafSize < 1 ||
+			settings.maxLeafSize < settings.leafSize || settings.maxLeafSize > MaxLeafSize || !(settings.traversalCost >= 0))
+			throw std::invalid_argument("ERROR: Invalid BVH settings.");
+	}
+
+	// Bounds and centroid bounds of primitives[first, first + count), in fixed size chunks across
+	// the pool when one is given
+	static RangeBounds rangeBounds(const BuildContext& c, std::uint32_t first, std::uint32_t count, ThreadPool* pool)
+	{
+		auto accumulate = [&c](std::size_t begin, std::size_t end, RangeBounds& result)
+		{
+			for (std::size_t i = begin; i < end; ++i)
+			{
+				result.bounds.expand(c.primitives[i].bounds);
+				result.centroids.expand(c.primitives[i].bounds.center());
+			}
+		};
+
+		RangeBounds result;
+		if (!pool)
+		{
+			accumulate(first, first + count, result);
+			return result;
+		}
+
+		std::vector<RangeBounds> chunks((count + BinningGrain - 1) / BinningGrain);
+		pool->parallelFor(count, BinningGrain, [&](std::size_t begin, std::size_t end)
+		{
+			accumulate(first + begin, first + end, chunks[begin / BinningGrain]);
+		});
+
+		for (const RangeBounds& chunk : chunks)
+		{
+			result.bounds.expand(chunk.bounds);
+			result.centroids.expand(chunk.centroids);
+		}
+
+		return result;
+	}
+
+	// Bins per unit of centroid extent along an axis, or 0 when the centroids are too close together
+	// along it to tell apart
+	static float binScale(float extent, int binCount)
+	{
+		const float scale = binCount / extent;
+		return extent > 0 && std::isfinite(scale) ? scale : 0.0f;
+	}
+
+	static int binIndex(const AABB& bounds, int axis, float minimum, float scale, int binCount)
+	{
+		const float centroid = (bounds.minimum()[axis] + bounds.maximum()[axis]) * 0.5f;
+		return std::min(std::max(static_cast<int>((centroid - minimum) * scale), 0), binCount - 1);
+	}
+
+	// Fills binCount bins per axis, laid out axis by axis, in one pass over the primitives. Axes
+	// with a scale of 0 stay empty.
+	static void binRange(const BuildContext& c, const BuildRange& range, int binCount, const float scale[3], ThreadPool* pool, std::vector<Bin>& bins)
+	{
+		const Vector<3> minimum = range.centroids.minimum();
+
+		auto accumulate = [&](std::size_t begin, std::size_t end, Bin* out)
+		{
+			for (std::size_t i = begin; i < end; ++i)
+			{
+				const AABB& bounds = c.primitives[i].bounds;
+
+				for (int axis = 0; axis < 3; ++axis)
+				{
+					if (scale[axis] == 0.0f)
+						continue;
+
+					Bin& bin = out[axis * binCount + binIndex(bounds, axis, minimum[axis], scale[axis], binCount)];
+					bin.bounds.expand(bounds);
+					++bin.count;
+				}
+			}
+		};
+
+		bins.assign(3 * binCount, Bin());
+		if (!pool)
+		{
+			accumulate(range.first, range.first + range.count, bins.data());
+			return;
+		}
+
+		const std::size_t chunks = (range.count + BinningGrain - 1) / BinningGrain;
+		std::vector<Bin> chunkBins(chunks * bins.size());
+		pool->parallelFor(range.count, BinningGrain, [&](std::size_t begin, std::size_t end)
+		{
+			accumulate(range.first + begin, range.first + end, &chunkBins[(begin / BinningGrain) * bins.size()]);
+		});
+
+		// Bounds merge exactly in any order and counts are integers, so this matches a serial pass
+		for (std::size_t chunk = 0; chunk < chunks; ++chunk)
+		{
+			for (std::size_t i = 0; i < bins.size(); ++i)
+			{
+				bins[i].bounds.expand(chunkBins[chunk * bins.size() + i].bounds);
+				bins[i].count += chunkBins[chunk * bins.size() + i].count;
+			}
+		}
+	}
+
+	// Makes nodes[range.node] a leaf or splits its range in two, adding the children to nodes and
+	// returning true. bins is scratch space.
+	static bool splitNode(BuildContext& c, std::vector<BuildNode>& nodes, const BuildRange& range, ThreadPool* pool,
+						  std::vector<Bin>& bins, BuildRange children[2])
+	{
+		const BVHSettings& settings = c.settings;
+		const std::uint32_t first = range.first, count = range.count;
+		const auto begin = c.primitives.begin() + first, end = begin + count;
+
+		BuildNode& node = nodes[range.node];
+		node.bounds = range.bounds;
+		node.first = first;
+		node.count = count;
+		node.left = node.right = node.subtree = -1;
+		node.axis = 0;
+
+		const bool fitsLeaf = count <= static_cast<std::uint32_t>(settings.maxLeafSize);
+		if (count <= static_cast<std::uint32_t>(settings.leafSize))
+			return false;
+
+		// Small nodes get one bin per primitive at most
+		const int binCount = static_cast<int>(std::min<std::uint32_t>(settings.binCount, count));
+		const Vector<3> extent = range.centroids.extent();
+		int axis = extent[1] > extent[0] ? 1 : 0;
+		axis = extent[2] > extent[axis] ? 2 : axis;
+		float scale[3];
+		for (int a = 0; a < 3; ++a)
+			scale[a] = binScale(extent[a], binCount);
+		RangeBounds left, right;
+		std::uint32_t leftCount = 0;
+
+		if (range.depth < BalancedDepth && (scale[0] > 0 || scale[1] > 0 || scale[2] > 0))
+		{
+			// Sweep the bins of each axis from both ends for the cheapest boundary
+			binRange(c, range, binCount, scale, pool, bins);
+			float rightCost[MaxBinCount];
+			float bestCost = INFINITY;
+			int bestAxis = -1, bestBin = 0;
+
+			for (int a = 0; a < 3; ++a)
+			{
+				if (scale[a] == 0.0f)
+					continue;
+
+				// Only the bounds and counts matter here; empty bins change neither
+				const Bin* axisBins = &bins[a * binCount];
+				AABB sweep;
+				std::uint32_t sweepCount = 0;
+				for (int b = binCount - 1; b > 0; --b)
+				{
+					if (axisBins[b].count > 0)
+					{
+						sweep.expand(axisBins[b].bounds);
+						sweepCount += axisBins[b].count;
+					}
+
+					rightCost[b] = sweepCount * sweep.surfaceArea();
+				}
+
+				sweep = AABB();
+				sweepCount = 0;
+				for (int b = 1; b < binCount; ++b)
+				{
+					if (axisBins[b - 1].count > 0)
+					{
+						sweep.expand(axisBins[b - 1].bounds);
+						sweepCount += axisBins[b - 1].count;
+					}
+
+					if (sweepCount == 0 || sweepCount == count)
+						continue;
+
+					float cost = sweepCount * sweep.surfaceArea() + rightCost[b];
+					if (cost < bestCost)
+					{
+						bestCost = cost;
+						bestAxis = a;
+						bestBin = b;
+					}
+				}
+			}
+
+			// Both ends of an axis with any extent land in different bins, so there is a split
+			const float area = range.bounds.surfaceArea();
+			const float splitCost = settings.traversalCost + (area > 0 ? bestCost / area : 0.0f);
+			if (fitsLeaf && splitCost >= static_cast<float>(count))
+				return false;
+
+			axis = bestAxis;
+			const Bin* axisBins = &bins[axis * binCount];
+			for (int b = 0; b < binCount; ++b)
+			{
+				(b < bestBin ? left : right).bounds.expand(axisBins[b].bounds);
+				leftCount += b < bestBin ? axisBins[b].count : 0;
+			}
+
+			// Partition by hand to pick up the centroid bounds of both sides on the way
+			const float minimum = range.centroids.minimum()[axis];
+			auto middle = begin, last = end;
+			while (middle != last)
+			{
+				const Vector<3> centroid = middle->bounds.center();
+				if (binIndex(middle->bounds, axis, minimum, scale[axis], binCount) < bestBin)
+				{
+					left.centroids.expand(centroid);
+					++middle;
+				}
+				else
+				{
+					right.centroids.expand(centroid);
+					std::iter_swap(middle, --last);
+				}
+			}
+		}
+		else if (fitsLeaf)
+		{
+			return false;
+		}
+		else
+		{
+			// Coincident centroids or past BalancedDepth: split in half by count
+			leftCount = count / 2;
+			std::nth_element(begin, begin + leftCount, end, [axis](const BuildPrimitive& a, const BuildPrimitive& b)
+			{
+				return a.bounds.center()[axis] < b.bounds.center()[axis];
+			});
+
+			left = rangeBounds(c, first, leftCount, pool);
+			right = rangeBounds(c, first + leftCount, count - leftCount, pool);
+		}
+
+		node.axis = static_cast<std::uint16_t>(axis);
+		node.left = static_cast<std::int32_t>(nodes.size());
+		node.right = node.left + 1;
+		children[0] = { node.left, first, leftCount, range.depth + 1, left.bounds, left.centroids };
+		children[1] = { node.right, first + leftCount, count - leftCount, range.depth + 1, right.bounds, right.centroids };
+		nodes.resize(nodes.size() + 2);
+
+		return true;
+	}
+
+	// Builds the subtree over a range serially into its own node array, with the root at 0
+	static void buildSubtree(BuildContext& c, BuildRange root, std::vector<BuildNode>& nodes, int& depth)
+	{
+		root.node = 0;
+		nodes.resize(1);
+		std::vector<BuildRange> stack = { root };
+		std::vector<Bin> bins;
+		BuildRange children[2];
+
+		while (!stack.empty())
+		{
+			BuildRange range = stack.back();
+			stack.pop_back();
+			depth = std::max(depth, range.depth);
+
+			if (splitNode(c, nodes, range, nullptr, bins, children))
+			{
+				stack.push_back(children[1]);
+				stack.push_back(children[0]);
+			}
+		}
+	}
+
+	// Builds a hierarchy over the given primitive bounds. order receives the primitive of each
+	// leaf slot, in the order the leaves reference them.
+	static void buildHierarchy(const std::vector<AABB>& bounds, const BVHSettings& settings, ThreadPool& pool,
+							   std::vector<BVHNode>& flat, std::vector<std::uint32_t>& order, int& depth)
+	{
+		checkSettings(settings);
+
+		flat.clear();
+		order.clear();
+		depth = 0;
+		if (bounds.empty())
+			return;
+
+		const std::uint32_t count = static_cast<std::uint32_t>(bounds.size());
+		BuildContext c{ std::vector<BuildPrimitive>(count), settings };
+		pool.parallelFor(count, BinningGrain, [&](std::size_t begin, std::size_t end)
+		{
+			for (std::size_t i = begin; i < end; ++i)
+				c.primitives[i] = { bounds[i], static_cast<std::uint32_t>(i) };
+		});
+
+		// The large nodes at the top, one at a time with the pool binning each
+		const RangeBounds all = rangeBounds(c, 0, count, &pool);
+		std::vector<BuildNode> top(1);
+		std::vector<BuildRange> stack = { { 0, 0, count, 0, all.bounds, all.centroids } };
+		std::vector<BuildRange> subtrees;
+		std::vector<Bin> bins;
+		BuildRange children[2];
+
+		while (!stack.empty())
+		{
+			BuildRange range = stack.back();
+			stack.pop_back();
+			depth = std::max(depth, range.depth);
+
+			if (range.count <= SubtreeSize)
+			{
+				top[range.node].subtree = static_cast<std::int32_t>(subtrees.size());
+				subtrees.push_back(range);
+			}
+			else if (splitNode(c, top, range, &pool, bins, children))
+			{
+				stack.push_back(children[1]);
+				stack.push_back(children[0]);
+			}
+		}
+
+		// The subtrees below them in parallel, each on disjoint parts of the primitives
+		std::vector<std::vector<BuildNode>> subtreeNodes(subtrees.size());
+		std::vector<int> subtreeDepths(subtrees.size(), 0);
+		pool.parallelFor(subtrees.size(), 1, [&](std::size_t begin, std::size_t end)
+		{
+			for (std::size_t i = begin; i < end; ++i)
+				buildSubtree(c, subtrees[i], subtreeNodes[i], subtreeDepths[i]);
+		});
+
+		for (int d : subtreeDepths)
+			depth = std::max(depth, d);
+
+		// Flatten depth first, so every interior node is followed by its first child
+		struct Pending
+		{
+			const std::vector<BuildNode>* tree;
+			std::int32_t node;
+			std::int32_t parent;
+		};
+
+		std::size_t nodeCount = top.size();
+		for (const auto& nodes : subtreeNodes)
+			nodeCount += nodes.size();
+		flat.reserve(nodeCount);
+
+		std::vector<Pending> pending = { { &top, 0, -1 } };
+		while (!pending.empty())
+		{
+			Pending p = pending.back();
+			pending.pop_back();
+
+			const BuildNode* node = &(*p.tree)[p.node];
+			if (node->subtree >= 0)
+			{
+				p.tree = &subtreeNodes[node->subtree];
+				node = &(*p.tree)[0];
+			}
+
+			const std::uint32_t index = static_cast<std::uint32_t>(flat.size());
+			if (p.parent >= 0)
+				flat[p.parent].index = index;
+
+			if (node->left < 0)
+			{
+				flat.push_back({ node->bounds, node->first, static_cast<std::uint16_t>(node->count), 0 });
+			}
+			else
+			{
+				flat.push_back({ node->bounds, 0, 0, node->axis });
+				pending.push_back({ p.tree, node->right, static_cast<std::int32_t>(index) });
+				pending.push_back({ p.tree, node->left, -1 });
+			}
+		}
+
+		order.resize(count);
+		for (std::uint32_t i = 0; i < count; ++i)
+			order[i] = c.primitives[i].index;
+	}
+#pragma endregion
+
+#pragma region Traversal
+
+	// Walks the hierarchy nearer child first. testLeaf(node, closest) tests the primitives of a leaf
+	// against the range [minDistance, closest], lowering closest on a hit and returning whether there
+	// was one. With anyHit the walk stops at the first hit.
+	template<bool anyHit, typename LeafFunction>
+	static bool traverse(const std::vector<BVHNode>& nodes, const Ray& ray, float minDistance, float closest, LeafFunction testLeaf)
+	{
+		if (nodes.empty() || !intersectBox(ray, nodes[0].bounds, minDistance, closest).hit)
+			return false;
+
+		struct Entry
+		{
+			std::uint32_t node;
+			float distance;
+		};
+
+		Entry stack[MaxDepth];
+		int size = 0;
+		std::uint32_t current = 0;
+		bool found = false;
+
+		while (true)
+		{
+			const BVHNode& node = nodes[current];
+
+			if (node.count > 0)
+			{
+				if (testLeaf(node, closest))
+				{
+					found = true;
+					if (anyHit)
+						return true;
+				}
+			}
+			else
+			{
+				std::uint32_t nearChild = current + 1, farChild = node.index;
+				if (ray.direction()[node.axis] < 0)
+					std::swap(nearChild, farChild);
+
+				const BoxHit nearHit = intersectBox(ray, nodes[nearChild].bounds, minDistance, closest);
+				const BoxHit farHit = intersectBox(ray, nodes[farChild].bounds, minDistance, closest);
+
+				if (nearHit.hit)
+				{
+					if (farHit.hit)
+						stack[size++] = { farChild, farHit.entry };
+
+					current = nearChild;
+					continue;
+				}
+
+				if (farHit.hit)
+				{
+					current = farChild;
+					continue;
+				}
+			}
+
+			// Skip stacked nodes that start past a hit found since they were pushed
+			do
+			{
+				if (size == 0)
+					return found;
+			}
+			while (stack[--size].distance > closest);
+
+			current = stack[size].node;
+		}
+	}
+
+	static Vector<3> transformPoint(const Matrix<4, 4>& m, const Vector<3>& p)
+	{
+		Vector<4> result = m * Vector<4>{ p[0], p[1], p[2], 1.0f };
+		return Vector<3>{ result[0], result[1], result[2] };
+	}
+
+	static Vector<3> transformDirection(const Matrix<4, 4>& m, const Vector<3>& d)
+	{
+		Vector<4> result = m * Vector<4>{ d[0], d[1], d[2], 0.0f };
+		return Vector<3>{ result[0], result[1], result[2] };
+	}
+
+#pragma endregion
+
+#pragma region BVH
+
+	BVH BVH::FromTriangles(const std::vector<Vector<3>>& vertices, const std::vector<std::uint32_t>& indices,
+						   const BVHSettings& settings, ThreadPool& pool)
+	{
+		if (indices.size() % 3 != 0)
+			throw std::invalid_argument("ERROR: Triangle indices must come in threes.");
+
+		const std::size_t triangleCount = indices.size() / 3;
+		std::vector<AABB> bounds(triangleCount);
+		pool.parallelFor(triangleCount, BinningGrain, [&](std::size_t begin, std::size_t end)
+		{
+			for (std::size_t i = begin; i < end; ++i)
+			{
+				for (int v = 0; v < 3; ++v)
+				{
+					if (indices[3 * i + v] >= vertices.size())
+						throw std::out_of_range("ERROR: Triangle index past the end of the vertices.");
+
+					bounds[i].expand(vertices[indices[3 * i + v]]);
+				}
+			}
+		});
+
+		BVH result;
+		buildHierarchy(bounds, settings, pool, result.m_nodes, result.m_triangles, result.m_depth);
+
+		// The vertices of each leaf slot, next to each other in leaf order
+		result.m_vertices.resize(3 * triangleCount);
+		pool.parallelFor(triangleCount, BinningGrain, [&](std::size_t begin, std::size_t end)
+		{
+			for (std::size_t i = begin; i < end; ++i)
+			{
+				for (int v = 0; v < 3; ++v)
+					result.m_vertices[3 * i + v] = vertices[indices[3 * result.m_triangles[i] + v]];
+			}
+		});
+
+		return result;
+	}
+
+	BVH::BVH()
+		: m_depth(0)
+	{
+	}
+
+	const std::vector<BVHNode>& BVH::nodes() const
+	{
+		return m_nodes;
+	}
+
+	std::size_t BVH::triangleCount() const
+	{
+		return m_triangles.size();
+	}
+
+	int BVH::depth() const
+	{
+		return m_depth;
+	}
+
+	AABB BVH::bounds() const
+	{
+		return m_nodes.empty() ? AABB() : m_nodes[0].bounds;
+	}
+
+	BVHHit BVH::intersect(const Ray& ray, float minDistance, float maxDistance) const
+	{
+		BVHHit result = { false, 0.0f, 0.0f, 0.0f, 0, 0 };
+
+		traverse<false>(m_nodes, ray, minDistance, maxDistance, [&](const BVHNode& node, float& closest)
+		{
+			bool hit = false;
+			for (std::uint32_t i = node.index; i < node.index + node.count; ++i)
+			{
+				const Vector<3>* v = &m_vertices[3 * i];
+				TriangleHit triangle = intersectTriangle(ray, v[0], v[1], v[2], minDistance, closest);
+				if (triangle.hit)
+				{
+					closest = triangle.distance;
+					result = { true, triangle.distance, triangle.u, triangle.v, m_triangles[i], 0 };
+					hit = true;
+				}
+			}
+
+			return hit;
+		});
+
+		return result;
+	}
+
+	bool BVH::occluded(const Ray& ray, float minDistance, float maxDistance) const
+	{
+		return traverse<true>(m_nodes, ray, minDistance, maxDistance, [&](const BVHNode& node, float& closest)
+		{
+			for (std::uint32_t i = node.index; i < node.index + node.count; ++i)
+			{
+				const Vector<3>* v = &m_vertices[3 * i];
+				if (intersectTriangle(ray, v[0], v[1], v[2], minDistance, closest).hit)
+					return true;
+			}
+
+			return false;
+		});
+	}
+
+#pragma endregion
+
+#pragma region Instanced BVH
+
+	InstancedBVH InstancedBVH::FromInstances(const std::vector<BVHInstance>& instances, const BVHSettings& settings, ThreadPool& pool)
+	{
+		InstancedBVH result;
+		std::vector<AABB> bounds;
+		std::vector<std::uint32_t> placed;
+
+		for (std::size_t i = 0; i < instances.size(); ++i)
+		{
+			const BVHInstance& instance = instances[i];
+			if (!instance.bvh)
+				throw std::invalid_argument("ERROR: Instance without a BVH.");
+
+			result.m_meshes.push_back(instance.bvh);
+			result.m_inverseTransforms.push_back(instance.transform.affineInverse());
+
+			// Empty meshes can't be hit, so they stay out of the hierarchy
+			const AABB local = instance.bvh->bounds();
+			if (local.isEmpty())
+				continue;
+
+			AABB world;
+			for (int corner = 0; corner < 8; ++corner)
+			{
+				Vector<3> p{ corner & 1 ? local.maximum()[0] : local.minimum()[0],
+							 corner & 2 ? local.maximum()[1] : local.minimum()[1],
+							 corner & 4 ? local.maximum()[2] : local.minimum()[2] };
+				world.expand(transformPoint(instance.transform, p));
+			}
+
+			bounds.push_back(world);
+			placed.push_back(static_cast<std::uint32_t>(i));
+		}
+
+		buildHierarchy(bounds, settings, pool, result.m_nodes, result.m_instances, result.m_depth);
+		for (std::uint32_t& instance : result.m_instances)
+			instance = placed[instance];
+
+		return result;
+	}
+
+	InstancedBVH::InstancedBVH()
+		: m_depth(0)
+	{
+	}
+
+	const std::vector<BVHNode>& InstancedBVH::nodes() const
+	{
+		return m_nodes;
+	}
+
+	std::size_t InstancedBVH::instanceCount() const
+	{
+		return m_meshes.size();
+	}
+
+	int InstancedBVH::depth() const
+	{
+		return m_depth;
+	}
+
+	AABB InstancedBVH::bounds() const
+	{
+		return m_nodes.empty() ? AABB() : m_nodes[0].bounds;
+	}
+
+	BVHHit InstancedBVH::intersect(const Ray& ray, float minDistance, float maxDistance) const
+	{
+		BVHHit result = { false, 0.0f, 0.0f, 0.0f, 0, 0 };
+
+		traverse<false>(m_nodes, ray, minDistance, maxDistance, [&](const BVHNode& node, float& closest)
+		{
+			bool hit = false;
+			for (std::uint32_t i = node.index; i < node.index + node.count; ++i)
+			{
+				const std::uint32_t instance = m_instances[i];
+				const Matrix<4, 4>& inverse = m_inverseTransforms[instance];
+				Ray local(transformPoint(inverse, ray.origin()), transformDirection(inverse, ray.direction()));
+
+				BVHHit meshHit = m_meshes[instance]->intersect(local, minDistance, closest);
+				if (meshHit.hit)
+				{
+					closest = meshHit.distance;
+					result = meshHit;
+					result.instance = instance;
+					hit = true;
+				}
+			}
+
+			return hit;
+		});
+
+		return result;
+	}
+
+	bool InstancedBVH::occluded(const Ray& ray, float minDistance, float maxDistance) const
+	{
+		return traverse<true>(m_nodes, ray, minDistance, maxDistance, [&](const BVHNode& node, float& closest)
+		{
+			for (std::uint32_t i = node.index; i < node.index + node.count; ++i)
+			{
+				const std::uint32_t instance = m_instances[i];
+				const Matrix<4, 4>& inverse = m_inverseTransforms[instance];
+				Ray local(transformPoint(inverse, ray.origin()), transformDirection(inverse, ray.direction()));
+
+				if (m_meshes[instance]->occluded(local, minDistance, closest))
+					return true;
+			}
+
+			return false;
+		});
+	}
+
+#pragma endregion
+
+}
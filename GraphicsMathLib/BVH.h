@@ -0,0 +1,174 @@
+#ifndef BVH_H
+#define BVH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Ray.h"
+#include "ThreadPool.h"
+
+namespace GraphicsMath
+{
+
+#pragma region BVH Definitions
+
+	/* -------------------------------------------------------------------------------------------------
+		Copyright 2017 Shealyn Tate Hindenlang
+
+		Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+		and associated documentation files (the "Software"), to deal in the Software without restriction,
+		including without limitation the rights to use, copy, modify, merge, publish, distribute,
+		sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+		furnished to do so, subject to the following conditions:
+
+		The above copyright notice and this permission notice shall be included in all copies or
+		substantial portions of the Software.
+
+		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+		BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+		NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+		DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+		-------------------------------------------------------------------------------------------------
+
+		BVH is a bounding volume hierarchy over a triangle mesh for ray queries. InstancedBVH is a
+		second level over placed copies of BVHs, each with its own Matrix<4, 4>, so a mesh used many
+		times in a scene is only built and stored once.
+
+		Constructors:
+			static BVH::FromTriangles(vertices, indices, settings)
+			static InstancedBVH::FromInstances(instances, settings)
+
+		Methods:
+			intersect(ray, minDistance, maxDistance)	closest hit, or hit == false
+			occluded(ray, minDistance, maxDistance)		whether anything is hit, stopping at the first
+
+		Usage:
+			BVH mesh = BVH::FromTriangles(vertices, indices);
+			BVHHit hit = mesh.intersect(Ray(camera, direction));
+			if (hit.hit)
+				shade(hit.triangle, hit.u, hit.v);
+
+			InstancedBVH scene = InstancedBVH::FromInstances({ { &mesh, Matrix<4, 4>::Translation(offset) } });
+			bool shadowed = scene.occluded(Ray(point, toLight), 1e-4f, 1.0f);
+
+		Notes:
+			- The builder bins primitive centroids into BVHSettings::binCount buckets per axis and
+			  splits each node at the bucket boundary with the lowest surface area heuristic cost.
+			  A node becomes a leaf at leafSize triangles or fewer, or when splitting costs more than
+			  testing every triangle, up to maxLeafSize. Nodes whose centroids coincide are split in
+			  half by count.
+			- The build runs on a ThreadPool, ThreadPool::global() unless one is given. Nodes of more
+			  than 16384 triangles are split one at a time with their binning spread across the pool,
+			  and the subtrees below that are built in parallel. The work is divided by triangle
+			  count alone, so the tree is identical for any number of threads.
+			- The nodes are one array in depth first order, 32 bytes each: a node's first child is
+			  the next node and index holds the second, so descending to the first child reads memory
+			  that is usually already in cache. Leaf triangles are copied into leaf order, three
+			  vertices each, next to the node array instead of behind the index buffer.
+			- Traversal keeps its stack in a fixed array. It visits the nearer child first and skips
+			  stacked nodes that start beyond the closest hit found since. Past depth 32 the builder
+			  only makes balanced splits, which bounds the depth at 64 for any input.
+			- intersect() and occluded() use intersectTriangle() and intersectBox() from Ray.h, so both
+			  faces of a triangle count and the direction needn't be normalized. BVHHit::triangle is
+			  the index of the triangle in the index buffer given to FromTriangles().
+			- Instances point at their BVH rather than copying it, so each BVH has to outlive every
+			  InstancedBVH built on it. The transform maps the mesh into the scene and must be affine;
+			  rays are carried into each mesh through its affineInverse(), which keeps distances in
+			  multiples of the original direction. BVHHit::instance is the position in the instance
+			  list, and 0 for hits on a plain BVH.
+			- FromTriangles() throws std::out_of_range for indices past the vertex array and
+			  std::invalid_argument for an index count that isn't a multiple of 3 or bad settings.
+	*/
+
+	struct BVHSettings
+	{
+		int binCount = 16;
+		int leafSize = 2;
+		int maxLeafSize = 8;
+		// Cost of visiting a node relative to testing one primitive
+		float traversalCost = 1.0f;
+	};
+
+	struct alignas(32) BVHNode
+	{
+		AABB bounds;
+		// The first primitive of a leaf, or the second child of an interior node
+		std::uint32_t index;
+		// Primitives in a leaf, 0 for an interior node
+		std::uint16_t count;
+		std::uint16_t axis;
+	};
+
+	struct BVHHit
+	{
+		bool hit;
+		float distance;
+		float u;
+		float v;
+		std::uint32_t triangle;
+		std::uint32_t instance;
+	};
+
+	class BVH
+	{
+	private:
+		std::vector<BVHNode> m_nodes;
+		std::vector<Vector<3>> m_vertices;
+		std::vector<std::uint32_t> m_triangles;
+		int m_depth;
+
+		friend class InstancedBVH;
+
+	public:
+		static BVH FromTriangles(const std::vector<Vector<3>>& vertices, const std::vector<std::uint32_t>& indices,
+								 const BVHSettings& settings = BVHSettings(), ThreadPool& pool = ThreadPool::global());
+
+		BVH();
+
+		const std::vector<BVHNode>& nodes() const;
+		std::size_t triangleCount() const;
+		int depth() const;
+		AABB bounds() const;
+
+		BVHHit intersect(const Ray&, float minDistance = 0.0f, float maxDistance = INFINITY) const;
+		bool occluded(const Ray&, float minDistance = 0.0f, float maxDistance = INFINITY) const;
+	};
+
+	struct BVHInstance
+	{
+		const BVH* bvh;
+		Matrix<4, 4> transform;
+	};
+
+	class InstancedBVH
+	{
+	private:
+		std::vector<BVHNode> m_nodes;
+		std::vector<const BVH*> m_meshes;
+		std::vector<Matrix<4, 4>> m_inverseTransforms;
+		std::vector<std::uint32_t> m_instances;
+		int m_depth;
+
+	public:
+		static InstancedBVH FromInstances(const std::vector<BVHInstance>& instances,
+										  const BVHSettings& settings = BVHSettings(), ThreadPool& pool = ThreadPool::global());
+
+		InstancedBVH();
+
+		const std::vector<BVHNode>& nodes() const;
+		std::size_t instanceCount() const;
+		int depth() const;
+		AABB bounds() const;
+
+		BVHHit intersect(const Ray&, float minDistance = 0.0f, float maxDistance = INFINITY) const;
+		bool occluded(const Ray&, float minDistance = 0.0f, float maxDistance = INFINITY) const;
+	};
+
+#pragma endregion
+
+}
+
+#endif
@@ -0,0 +1,148 @@
+#include "BatchTransform.h"
+
+namespace GraphicsMath
+{
+
+#pragma region Kernels
+
+	// Transforms points [begin, end) one at a time. Handles the tails the SIMD kernels leave behind.
+	static void transformPointsScalar(const float* m, ConstPointStreams in, PointStreams out,
+									  std::size_t begin, std::size_t end, bool homogenize)
+	{
+		for (std::size_t i = begin; i < end; ++i)
+		{
+			float x = in.x[i];
+			float y = in.y[i];
+			float z = in.z[i];
+			float w = in.w ? in.w[i] : 1.0f;
+
+			float rx = m[0] * x + m[4] * y + m[8] * z + m[12] * w;
+			float ry = m[1] * x + m[5] * y + m[9] * z + m[13] * w;
+			float rz = m[2] * x + m[6] * y + m[10] * z + m[14] * w;
+			float rw = m[3] * x + m[7] * y + m[11] * z + m[15] * w;
+
+			if (homogenize && rw != 0)
+			{
+				rx /= rw;
+				ry /= rw;
+				rz /= rw;
+			}
+
+			out.x[i] = rx;
+			out.y[i] = ry;
+			out.z[i] = rz;
+			if (out.w)
+				out.w[i] = rw;
+		}
+	}
+
+#if defined(GRAPHICSMATH_AVX)
+
+	// Transforms 8 points per iteration and returns how many points were handled
+	static std::size_t transformPointsAVX(const float* m, ConstPointStreams in, PointStreams out,
+										  std::size_t count, bool homogenize)
+	{
+		__m256 c[16];
+		for (int k = 0; k < 16; ++k)
+			c[k] = _mm256_set1_ps(m[k]);
+
+		const __m256 one = _mm256_set1_ps(1.0f);
+		const __m256 zero = _mm256_setzero_ps();
+
+		std::size_t i = 0;
+		for (; i + 8 <= count; i += 8)
+		{
+			__m256 x = _mm256_loadu_ps(in.x + i);
+			__m256 y = _mm256_loadu_ps(in.y + i);
+			__m256 z = _mm256_loadu_ps(in.z + i);
+			__m256 w = in.w ? _mm256_loadu_ps(in.w + i) : one;
+
+			__m256 rx = SIMD::multiplyAdd(c[12], w, SIMD::multiplyAdd(c[8], z, SIMD::multiplyAdd(c[4], y, _mm256_mul_ps(c[0], x))));
+			__m256 ry = SIMD::multiplyAdd(c[13], w, SIMD::multiplyAdd(c[9], z, SIMD::multiplyAdd(c[5], y, _mm256_mul_ps(c[1], x))));
+			__m256 rz = SIMD::multiplyAdd(c[14], w, SIMD::multiplyAdd(c[10], z, SIMD::multiplyAdd(c[6], y, _mm256_mul_ps(c[2], x))));
+			__m256 rw = SIMD::multiplyAdd(c[15], w, SIMD::multiplyAdd(c[11], z, SIMD::multiplyAdd(c[7], y, _mm256_mul_ps(c[3], x))));
+
+			if (homogenize)
+			{
+				__m256 valid = _mm256_cmp_ps(rw, zero, _CMP_NEQ_OQ);
+				rx = SIMD::select(valid, _mm256_div_ps(rx, rw), rx);
+				ry = SIMD::select(valid, _mm256_div_ps(ry, rw), ry);
+				rz = SIMD::select(valid, _mm256_div_ps(rz, rw), rz);
+			}
+
+			_mm256_storeu_ps(out.x + i, rx);
+			_mm256_storeu_ps(out.y + i, ry);
+			_mm256_storeu_ps(out.z + i, rz);
+			if (out.w)
+				_mm256_storeu_ps(out.w + i, rw);
+		}
+
+		return i;
+	}
+
+#elif defined(GRAPHICSMATH_SSE)
+
+	// Transforms 4 points per iteration and returns how many points were handled
+	static std::size_t transformPointsSSE(const float* m, ConstPointStreams in, PointStreams out,
+										  std::size_t count, bool homogenize)
+	{
+		__m128 c[16];
+		for (int k = 0; k < 16; ++k)
+			c[k] = _mm_set1_ps(m[k]);
+
+		const __m128 one = _mm_set1_ps(1.0f);
+		const __m128 zero = _mm_setzero_ps();
+
+		std::size_t i = 0;
+		for (; i + 4 <= count; i += 4)
+		{
+			__m128 x = _mm_loadu_ps(in.x + i);
+			__m128 y = _mm_loadu_ps(in.y + i);
+			__m128 z = _mm_loadu_ps(in.z + i);
+			__m128 w = in.w ? _mm_loadu_ps(in.w + i) : one;
+
+			__m128 rx = SIMD::multiplyAdd(c[12], w, SIMD::multiplyAdd(c[8], z, SIMD::multiplyAdd(c[4], y, _mm_mul_ps(c[0], x))));
+			__m128 ry = SIMD::multiplyAdd(c[13], w, SIMD::multiplyAdd(c[9], z, SIMD::multiplyAdd(c[5], y, _mm_mul_ps(c[1], x))));
+			__m128 rz = SIMD::multiplyAdd(c[14], w, SIMD::multiplyAdd(c[10], z, SIMD::multiplyAdd(c[6], y, _mm_mul_ps(c[2], x))));
+			__m128 rw = SIMD::multiplyAdd(c[15], w, SIMD::multiplyAdd(c[11], z, SIMD::multiplyAdd(c[7], y, _mm_mul_ps(c[3], x))));
+
+			if (homogenize)
+			{
+				__m128 valid = _mm_cmpneq_ps(rw, zero);
+				rx = SIMD::select(valid, _mm_div_ps(rx, rw), rx);
+				ry = SIMD::select(valid, _mm_div_ps(ry, rw), ry);
+				rz = SIMD::select(valid, _mm_div_ps(rz, rw), rz);
+			}
+
+			_mm_storeu_ps(out.x + i, rx);
+			_mm_storeu_ps(out.y + i, ry);
+			_mm_storeu_ps(out.z + i, rz);
+			if (out.w)
+				_mm_storeu_ps(out.w + i, rw);
+		}
+
+		return i;
+	}
+
+#endif
+
+#pragma endregion
+
+#pragma region Batch Transform
+
+	void transformPoints(const Matrix<4, 4>& m, ConstPointStreams in, PointStreams out, std::size_t count, bool homogenize)
+	{
+		std::size_t done = 0;
+
+#if defined(GRAPHICSMATH_AVX)
+		done = transformPointsAVX(m.data(), in, out, count, homogenize);
+#elif defined(GRAPHICSMATH_SSE)
+		done = transformPointsSSE(m.data(), in, out, count, homogenize);
+#endif
+
+		transformPointsScalar(m.data(), in, out, done, count, homogenize);
+	}
+
+#pragma endregion
+
+}
@@ -0,0 +1,79 @@
+#ifndef BATCH_TRANSFORM_H
+#define BATCH_TRANSFORM_H
+
+#include <cstddef>
+
+#include "Matrix.h"
+
+namespace GraphicsMath
+{
+
+#pragma region Batch Transform Definitions
+
+	/* -------------------------------------------------------------------------------------------------
+		Copyright 2017 Shealyn Tate Hindenlang
+
+		Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+		and associated documentation files (the "Software"), to deal in the Software without restriction,
+		including without limitation the rights to use, copy, modify, merge, publish, distribute,
+		sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+		furnished to do so, subject to the following conditions:
+
+		The above copyright notice and this permission notice shall be included in all copies or
+		substantial portions of the Software.
+
+		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+		BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+		NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+		DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+		-------------------------------------------------------------------------------------------------
+
+		transformPoints applies one Matrix<4, 4> to a whole point cloud stored as a structure of arrays,
+		i.e. separate x[], y[], z[] and w[] buffers, in a single call.
+
+		Usage:
+			transformPoints(m, ConstPointStreams{ x, y, z, nullptr }, PointStreams{ ox, oy, oz, nullptr }, n);
+
+		Notes:
+			- Point i is (x[i], y[i], z[i], w[i]) and the result is m * point, exactly as
+			  Matrix<4, 4>::operator *(Vector<4>) would compute it.
+			- If the input w pointer is null every point is read with w = 1. If the output w pointer
+			  is null the transformed w is not stored.
+			- With homogenize set, x, y and z of each result are divided by its w in the same pass,
+			  following Vector::homogenize(): results whose w is zero are left undivided, and w itself
+			  is stored unchanged.
+			- Buffers need no particular alignment and count need not be a multiple of the SIMD width;
+			  the tail is handled separately. Output buffers may be the input buffers (in place), but
+			  must not otherwise overlap them.
+	*/
+
+	struct ConstPointStreams
+	{
+		const float* x;
+		const float* y;
+		const float* z;
+		const float* w;
+	};
+
+	struct PointStreams
+	{
+		float* x;
+		float* y;
+		float* z;
+		float* w;
+
+		operator ConstPointStreams() const
+		{
+			return ConstPointStreams{ x, y, z, w };
+		}
+	};
+
+	void transformPoints(const Matrix<4, 4>& m, ConstPointStreams in, PointStreams out, std::size_t count, bool homogenize = false);
+
+#pragma endregion
+
+}
+
+#endif
@@ -0,0 +1,667 @@
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+#include "DenseMatrix.h"
+
+namespace GraphicsMath
+{
+
+	// Columns of the result per parallel chunk, and the smallest product worth splitting at all
+	static const int ColumnGrain = 64;
+	static const double ParallelFlops = 64.0 * 64.0 * 64.0;
+
+	// Rows of the result per chunk of a matrix vector product, a whole number of cache lines
+	static const int RowGrain = 1024;
+
+	// Side of the square tiles transposition() copies at a time
+	static const int TransposeTile = 32;
+
+	static void checkDimensions(bool match)
+	{
+		if (!match)
+			throw std::invalid_argument("ERROR: Dimension mismatch.");
+	}
+
+	// out (+)= alpha * a * b, split across the pool by columns of out
+	static void parallelMultiplyBlocked(const float* a, int lda, const float* b, int ldb, float* out, int ldo,
+										int rows, int inner, int cols, float alpha, bool accumulate, ThreadPool& pool)
+	{
+		const bool split = static_cast<double>(rows) * inner * cols >= ParallelFlops;
+
+		pool.parallelFor(cols, split ? ColumnGrain : cols, [=](std::size_t begin, std::size_t end)
+		{
+			SIMD::multiplyBlocked(a, lda, b + begin * ldb, ldb, out + begin * ldo, ldo, rows, inner,
+								  static_cast<int>(end - begin), alpha, accumulate);
+		});
+	}
+
+	static void swapRows(float* a, int n, int r0, int r1)
+	{
+		for (int c = 0; c < n; ++c)
+			std::swap(a[static_cast<std::size_t>(c) * n + r0], a[static_cast<std::size_t>(c) * n + r1]);
+	}
+
+#pragma region Dense Vector
+
+	std::string DenseVector::toString() const
+	{
+		std::string output = "DenseVector<" + std::to_string(size()) + "> (";
+
+		for (int i = 0; i < size(); i++)
+		{
+			output += std::to_string(m_data[i]);
+			if (i != size() - 1)
+				output += ", ";
+		}
+
+		output += ")";
+
+		return output;
+	}
+
+	std::string DenseVector::to_string() const
+	{
+		return this->toString();
+	}
+
+	bool DenseVector::operator==(const DenseVector& v) const
+	{
+		return m_data == v.m_data;
+	}
+
+	bool DenseVector::operator!=(const DenseVector& v) const
+	{
+		return m_data != v.m_data;
+	}
+
+	DenseVector DenseVector::operator+(const DenseVector& v) const
+	{
+		DenseVector result(*this);
+		result += v;
+
+		return result;
+	}
+
+	DenseVector DenseVector::operator-(const DenseVector& v) const
+	{
+		DenseVector result(*this);
+		result -= v;
+
+		return result;
+	}
+
+	DenseVector DenseVector::operator*(float s) const
+	{
+		DenseVector result(*this);
+		result *= s;
+
+		return result;
+	}
+
+	void DenseVector::operator+=(const DenseVector& v)
+	{
+		checkDimensions(size() == v.size());
+
+		for (int i = 0; i < size(); ++i)
+			m_data[i] += v.m_data[i];
+	}
+
+	void DenseVector::operator-=(const DenseVector& v)
+	{
+		checkDimensions(size() == v.size());
+
+		for (int i = 0; i < size(); ++i)
+			m_data[i] -= v.m_data[i];
+	}
+
+	void DenseVector::operator*=(float s)
+	{
+		for (float& f : m_data)
+			f *= s;
+	}
+
+	float DenseVector::dotProduct(const DenseVector& v) const
+	{
+		checkDimensions(size() == v.size());
+
+		float result = 0;
+		for (int i = 0; i < size(); ++i)
+			result += m_data[i] * v.m_data[i];
+
+		return result;
+	}
+
+	float DenseVector::magnitude() const
+	{
+		return sqrtf(dotProduct(*this));
+	}
+
+#pragma endregion
+
+#pragma region Dense Matrix
+
+	DenseMatrix DenseMatrix::Identity(int size)
+	{
+		DenseMatrix result(size, size);
+
+		for (int i = 0; i < size; ++i)
+			result.m_data[static_cast<std::size_t>(i) * size + i] = 1;
+
+		return result;
+	}
+
+	DenseMatrix::DenseMatrix()
+		: m_rows(0), m_cols(0)
+	{
+	}
+
+	DenseMatrix::DenseMatrix(int rows, int cols)
+		: m_rows(rows), m_cols(cols)
+	{
+		if (rows < 0 || cols < 0)
+			throw std::invalid_argument("ERROR: DenseMatrix dimensions must not be negative.");
+
+		m_data.resize(static_cast<std::size_t>(rows) * cols);
+	}
+
+	DenseMatrix::DenseMatrix(std::initializer_list<DenseVector> args)
+		: m_rows(args.size() ? args.begin()->size() : 0), m_cols(static_cast<int>(args.size()))
+	{
+		m_data.reserve(static_cast<std::size_t>(m_rows) * m_cols);
+
+		for (const DenseVector& column : args)
+		{
+			if (column.size() != m_rows)
+				throw std::invalid_argument("DenseMatrix initializer list columns must all be the same size");
+
+			m_data.insert(m_data.end(), column.begin(), column.end());
+		}
+	}
+
+	std::string DenseMatrix::toString() const
+	{
+		std::string result;
+
+		for (int i = 0; i < m_rows; ++i)
+		{
+			result += "[ ";
+			for (int j = 0; j < m_cols; ++j)
+			{
+				result += std::to_string(m_data[static_cast<std::size_t>(j) * m_rows + i]);
+				result += (j < m_cols - 1) ? ", " : " ";
+			}
+			result += "]\n";
+		}
+
+		return result;
+	}
+
+	std::string DenseMatrix::to_string() const
+	{
+		return this->toString();
+	}
+
+	bool DenseMatrix::operator==(const DenseMatrix& m) const
+	{
+		return m_rows == m.m_rows && m_cols == m.m_cols && m_data == m.m_data;
+	}
+
+	bool DenseMatrix::operator!=(const DenseMatrix& m) const
+	{
+		return !(*this == m);
+	}
+
+	DenseMatrix DenseMatrix::operator+(const DenseMatrix& m) const
+	{
+		DenseMatrix result(*this);
+		result += m;
+
+		return result;
+	}
+
+	DenseMatrix DenseMatrix::operator-(const DenseMatrix& m) const
+	{
+		DenseMatrix result(*this);
+		result -= m;
+
+		return result;
+	}
+
+	DenseMatrix DenseMatrix::operator*(const DenseMatrix& m) const
+	{
+		DenseMatrix result;
+		multiply(*this, m, result);
+
+		return result;
+	}
+
+	DenseMatrix DenseMatrix::operator*(float s) const
+	{
+		DenseMatrix result(*this);
+		result *= s;
+
+		return result;
+	}
+
+	DenseVector DenseMatrix::operator*(const DenseVector& v) const
+	{
+		DenseVector result;
+		multiply(*this, v, result);
+
+		return result;
+	}
+
+	void DenseMatrix::operator+=(const DenseMatrix& m)
+	{
+		checkDimensions(m_rows == m.m_rows && m_cols == m.m_cols);
+
+		for (std::size_t i = 0; i < m_data.size(); ++i)
+			m_data[i] += m.m_data[i];
+	}
+
+	void DenseMatrix::operator-=(const DenseMatrix& m)
+	{
+		checkDimensions(m_rows == m.m_rows && m_cols == m.m_cols);
+
+		for (std::size_t i = 0; i < m_data.size(); ++i)
+			m_data[i] -= m.m_data[i];
+	}
+
+	void DenseMatrix::operator*=(float s)
+	{
+		for (float& f : m_data)
+			f *= s;
+	}
+
+	DenseMatrix DenseMatrix::transposition(ThreadPool& pool) const
+	{
+		DenseMatrix result(m_cols, m_rows);
+		const float* in = m_data.data();
+		float* out = result.m_data.data();
+		const int rows = m_rows;
+		const int cols = m_cols;
+
+		// Tile by tile so both the columns read and the columns written stay in cache. Chunks are
+		// bands of whole tile columns of the source, which are disjoint tile rows of the result.
+		const std::size_t tileCols = (cols + TransposeTile - 1) / TransposeTile;
+		const bool split = static_cast<double>(rows) * cols >= ParallelFlops;
+
+		pool.parallelFor(tileCols, split ? 4 : tileCols, [=](std::size_t begin, std::size_t end)
+		{
+			for (int c0 = static_cast<int>(begin) * TransposeTile; c0 < std::min<int>(cols, static_cast<int>(end) * TransposeTile); c0 += TransposeTile)
+			{
+				for (int r0 = 0; r0 < rows; r0 += TransposeTile)
+				{
+					const int c1 = std::min(cols, c0 + TransposeTile);
+					const int r1 = std::min(rows, r0 + TransposeTile);
+
+					for (int c = c0; c < c1; ++c)
+					{
+						for (int r = r0; r < r1; ++r)
+							out[static_cast<std::size_t>(r) * cols + c] = in[static_cast<std::size_t>(c) * rows + r];
+					}
+				}
+			}
+		});
+
+		return result;
+	}
+
+#pragma endregion
+
+#pragma region Dense Products
+
+	void multiply(const DenseMatrix& a, const DenseMatrix& b, DenseMatrix& out, ThreadPool& pool)
+	{
+		checkDimensions(a.cols() == b.rows());
+
+		if (&out == &a || &out == &b)
+		{
+			DenseMatrix result;
+			multiply(a, b, result, pool);
+			out = std::move(result);
+			return;
+		}
+
+		if (out.rows() != a.rows() || out.cols() != b.cols() || a.cols() == 0)
+			out = DenseMatrix(a.rows(), b.cols());
+
+		if (a.rows() == 0 || b.cols() == 0 || a.cols() == 0)
+			return;
+
+		parallelMultiplyBlocked(a.data(), a.rows(), b.data(), b.rows(), out.data(), out.rows(),
+								a.rows(), a.cols(), b.cols(), 1.0f, false, pool);
+	}
+
+	void multiply(const DenseMatrix& a, const DenseVector& x, DenseVector& out, ThreadPool& pool)
+	{
+		checkDimensions(a.cols() == x.size());
+
+		if (&out == &x)
+		{
+			DenseVector result;
+			multiply(a, x, result, pool);
+			out = std::move(result);
+			return;
+		}
+
+		if (out.size() != a.rows())
+			out = DenseVector(a.rows());
+
+		const float* m = a.data();
+		const float* v = x.data();
+		float* result = out.data();
+		const int rows = a.rows();
+		const int cols = a.cols();
+		const bool split = static_cast<double>(rows) * cols >= ParallelFlops;
+
+		pool.parallelFor(rows, split ? RowGrain : rows, [=](std::size_t begin, std::size_t end)
+		{
+			SIMD::multiplyVector(m + begin, rows, v, result + begin, static_cast<int>(end - begin), cols, false);
+		});
+	}
+
+#pragma endregion
+
+#pragma region LU Decomposition
+
+	LUDecomposition::LUDecomposition(const DenseMatrix& m, ThreadPool& pool)
+		: m_lu(m), m_pivots(m.rows()), m_singular(false)
+	{
+		checkDimensions(m.rows() == m.cols());
+
+		const int n = m.rows();
+		float* a = m_lu.data();
+
+		// Pivots this small relative to the input are rounding error left from cancelling rows
+		float largest = 0;
+		for (std::size_t i = 0; i < static_cast<std::size_t>(n) * n; ++i)
+			largest = std::max(largest, fabsf(a[i]));
+
+		const float zeroPivot = n * FLT_EPSILON * largest;
+
+		for (int k = 0; k < n; k += FactorBlock)
+		{
+			const int width = std::min(FactorBlock, n - k);
+			const int end = k + width;
+
+			// Factor the panel a[k:n, k:end] a column at a time, swapping whole rows as we go
+			for (int j = k; j < end; ++j)
+			{
+				float* column = a + static_cast<std::size_t>(j) * n;
+
+				int pivot = j;
+				for (int i = j + 1; i < n; ++i)
+				{
+					if (fabsf(column[i]) > fabsf(column[pivot]))
+						pivot = i;
+				}
+
+				m_pivots[j] = pivot;
+				if (pivot != j)
+					swapRows(a, n, j, pivot);
+
+				if (fabsf(column[j]) <= zeroPivot)
+				{
+					m_singular = true;
+					continue;
+				}
+
+				const float inverse = 1.0f / column[j];
+				for (int i = j + 1; i < n; ++i)
+					column[i] *= inverse;
+
+				for (int c = j + 1; c < end; ++c)
+				{
+					float* target = a + static_cast<std::size_t>(c) * n;
+					const float s = target[j];
+
+					for (int i = j + 1; i < n; ++i)
+						target[i] -= column[i] * s;
+				}
+			}
+
+			const int rest = n - end;
+			if (rest == 0)
+				break;
+
+			// U12 = inverse(L11) * A12, each column on its own
+			pool.parallelFor(rest, static_cast<double>(width) * width * rest >= ParallelFlops ? ColumnGrain : rest,
+							 [=](std::size_t begin, std::size_t last)
+			{
+				for (std::size_t c = begin; c < last; ++c)
+				{
+					float* target = a + (end + c) * n;
+
+					for (int j = k; j < end; ++j)
+					{
+						const float* l = a + static_cast<std::size_t>(j) * n;
+						const float s = target[j];
+
+						for (int i = j + 1; i < end; ++i)
+							target[i] -= l[i] * s;
+					}
+				}
+			});
+
+			// A22 -= L21 * U12
+			parallelMultiplyBlocked(a + static_cast<std::size_t>(k) * n + end, n,
+									a + static_cast<std::size_t>(end) * n + k, n,
+									a + static_cast<std::size_t>(end) * n + end, n,
+									rest, width, rest, -1.0f, true, pool);
+		}
+	}
+
+	const DenseMatrix& LUDecomposition::factors() const
+	{
+		return m_lu;
+	}
+
+	const std::vector<int>& LUDecomposition::pivots() const
+	{
+		return m_pivots;
+	}
+
+	DenseMatrix LUDecomposition::lower() const
+	{
+		const int n = m_lu.rows();
+		DenseMatrix result = DenseMatrix::Identity(n);
+
+		for (int c = 0; c < n; ++c)
+		{
+			for (int r = c + 1; r < n; ++r)
+				result(r, c) = m_lu(r, c);
+		}
+
+		return result;
+	}
+
+	DenseMatrix LUDecomposition::upper() const
+	{
+		const int n = m_lu.rows();
+		DenseMatrix result(n, n);
+
+		for (int c = 0; c < n; ++c)
+		{
+			for (int r = 0; r <= c; ++r)
+				result(r, c) = m_lu(r, c);
+		}
+
+		return result;
+	}
+
+	bool LUDecomposition::isSingular() const
+	{
+		return m_singular;
+	}
+
+	float LUDecomposition::determinant() const
+	{
+		if (m_singular)
+			return 0;
+
+		float result = 1;
+		for (int i = 0; i < m_lu.rows(); ++i)
+		{
+			result *= m_lu(i, i);
+			if (m_pivots[i] != i)
+				result = -result;
+		}
+
+		return result;
+	}
+
+	DenseVector LUDecomposition::solve(const DenseVector& b) const
+	{
+		checkDimensions(b.size() == m_lu.rows());
+
+		if (m_singular)
+			throw std::runtime_error("ERROR: Matrix cannot be inverted.");
+
+		const int n = m_lu.rows();
+		const float* a = m_lu.data();
+		DenseVector x(b);
+		float* y = x.data();
+
+		for (int i = 0; i < n; ++i)
+			std::swap(y[i], y[m_pivots[i]]);
+
+		// Forward substitution with the unit L, then back substitution with U, both by columns
+		for (int c = 0; c < n; ++c)
+		{
+			const float* column = a + static_cast<std::size_t>(c) * n;
+			for (int i = c + 1; i < n; ++i)
+				y[i] -= column[i] * y[c];
+		}
+
+		for (int c = n - 1; c >= 0; --c)
+		{
+			const float* column = a + static_cast<std::size_t>(c) * n;
+			y[c] /= column[c];
+			for (int i = 0; i < c; ++i)
+				y[i] -= column[i] * y[c];
+		}
+
+		return x;
+	}
+
+#pragma endregion
+
+#pragma region Cholesky Decomposition
+
+	CholeskyDecomposition::CholeskyDecomposition(const DenseMatrix& m, ThreadPool& pool)
+		: m_lower(m)
+	{
+		checkDimensions(m.rows() == m.cols());
+
+		const int n = m.rows();
+		float* a = m_lower.data();
+		std::vector<float> panel;
+
+		for (int k = 0; k < n; k += FactorBlock)
+		{
+			const int width = std::min(FactorBlock, n - k);
+			const int end = k + width;
+
+			// Factor the panel a[k:n, k:end], only ever reading the lower triangle
+			for (int j = k; j < end; ++j)
+			{
+				float* column = a + static_cast<std::size_t>(j) * n;
+
+				if (!(column[j] > 0))
+					throw std::runtime_error("ERROR: Matrix is not positive definite.");
+
+				column[j] = sqrtf(column[j]);
+				const float inverse = 1.0f / column[j];
+				for (int i = j + 1; i < n; ++i)
+					column[i] *= inverse;
+
+				for (int c = j + 1; c < end; ++c)
+				{
+					float* target = a + static_cast<std::size_t>(c) * n;
+					const float s = column[c];
+
+					for (int i = c; i < n; ++i)
+						target[i] -= column[i] * s;
+				}
+			}
+
+			const int rest = n - end;
+			if (rest == 0)
+				break;
+
+			// The kernel reads b by columns, so L21^T is copied out once per panel
+			panel.resize(static_cast<std::size_t>(width) * rest);
+			for (int c = 0; c < rest; ++c)
+			{
+				for (int p = 0; p < width; ++p)
+					panel[static_cast<std::size_t>(c) * width + p] = a[static_cast<std::size_t>(k + p) * n + end + c];
+			}
+
+			// A22 -= L21 * L21^T, from the diagonal down in each band of columns
+			const float* l21 = a + static_cast<std::size_t>(k) * n + end;
+			const float* l21t = panel.data();
+			const bool split = static_cast<double>(rest) * width * rest >= 2 * ParallelFlops;
+
+			pool.parallelFor(rest, split ? ColumnGrain : rest, [=](std::size_t begin, std::size_t last)
+			{
+				const int c0 = static_cast<int>(begin);
+				SIMD::multiplyBlocked(l21 + c0, n, l21t + static_cast<std::size_t>(c0) * width, width,
+									  a + static_cast<std::size_t>(end + c0) * n + end + c0, n,
+									  rest - c0, width, static_cast<int>(last - begin), -1.0f, true);
+			});
+		}
+
+		// The upper triangle still holds the input and partial updates
+		for (int c = 1; c < n; ++c)
+			std::fill(a + static_cast<std::size_t>(c) * n, a + static_cast<std::size_t>(c) * n + c, 0.0f);
+	}
+
+	const DenseMatrix& CholeskyDecomposition::lower() const
+	{
+		return m_lower;
+	}
+
+	float CholeskyDecomposition::determinant() const
+	{
+		float result = 1;
+		for (int i = 0; i < m_lower.rows(); ++i)
+			result *= m_lower(i, i) * m_lower(i, i);
+
+		return result;
+	}
+
+	DenseVector CholeskyDecomposition::solve(const DenseVector& b) const
+	{
+		checkDimensions(b.size() == m_lower.rows());
+
+		const int n = m_lower.rows();
+		const float* a = m_lower.data();
+		DenseVector x(b);
+		float* y = x.data();
+
+		// L y = b by columns, then L^T x = y by rows of L^T, which are columns of L
+		for (int c = 0; c < n; ++c)
+		{
+			const float* column = a + static_cast<std::size_t>(c) * n;
+			y[c] /= column[c];
+			for (int i = c + 1; i < n; ++i)
+				y[i] -= column[i] * y[c];
+		}
+
+		for (int c = n - 1; c >= 0; --c)
+		{
+			const float* column = a + static_cast<std::size_t>(c) * n;
+			float sum = y[c];
+			for (int i = c + 1; i < n; ++i)
+				sum -= column[i] * y[i];
+			y[c] = sum / column[c];
+		}
+
+		return x;
+	}
+
+#pragma endregion
+
+}
@@ -0,0 +1,439 @@
+#ifndef DENSE_MATRIX_H
+#define DENSE_MATRIX_H
+
+#include <initializer_list>
+#include <string>
+#include <vector>
+
+#include "Matrix.h"
+#include "ThreadPool.h"
+
+namespace GraphicsMath
+{
+
+#pragma region Dense Class Definitions
+
+	/* -------------------------------------------------------------------------------------------------
+		Copyright 2017 Shealyn Tate Hindenlang
+
+		Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+		and associated documentation files (the "Software"), to deal in the Software without restriction,
+		including without limitation the rights to use, copy, modify, merge, publish, distribute,
+		sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+		furnished to do so, subject to the following conditions:
+
+		The above copyright notice and this permission notice shall be included in all copies or
+		substantial portions of the Software.
+
+		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+		BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+		NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+		DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+		-------------------------------------------------------------------------------------------------
+
+		DenseVector and DenseMatrix are the run time sized counterparts of Vector and Matrix, for
+		systems whose size is only known once the data is loaded: bundle adjustment, mesh Laplacians
+		and the like. LUDecomposition and CholeskyDecomposition factor a square DenseMatrix and solve
+		linear systems with it.
+
+		Constructors:
+			DenseVector(size)
+			DenseVector(initializer_list<float>)
+			DenseVector(Vector<n>)
+			DenseMatrix(rows, cols)
+			DenseMatrix(initializer_list<DenseVector>)
+			DenseMatrix(Matrix<row, col>)
+			static DenseMatrix::Identity(size)
+			LUDecomposition(DenseMatrix)
+			CholeskyDecomposition(DenseMatrix)
+
+		Methods:
+			multiply(a, b, out)		out = a * b for matrices
+			multiply(a, x, out)		out = a * x
+
+		Usage:
+			DenseMatrix a(n, n);
+			...
+			a.setBlock(4, 4, Matrix<4, 4>::Translation(Vector<3>{ 1, 2, 3 }));
+			DenseVector x = LUDecomposition(a).solve(b);
+
+		Notes:
+			- Elements are stored in column-major order in one heap block, like Matrix. A new vector
+			  or matrix is all zeros, except Identity().
+			- operator[] and operator() are bounds checked only while GRAPHICSMATH_BOUNDS_CHECK is 1,
+			  like Vector::operator[], and so are block() and segment(). Mismatched dimensions in
+			  arithmetic, products and solves always throw std::invalid_argument.
+			- block<r, c>(row, col) copies the r x c block starting at (row, col) into a Matrix<r, c>
+			  and setBlock() writes one back, so a Matrix<4, 4> transform can be placed inside a
+			  larger system. segment<n>() and setSegment() do the same between DenseVector and
+			  Vector<n>.
+			- Matrix products run on the packed multiplyBlocked kernel in SIMD.h, and matrix vector
+			  products on multiplyVector. The free multiply() functions, the factorizations and
+			  transposition() take an optional ThreadPool and use ThreadPool::global() otherwise;
+			  the operators always use the global pool.
+			- Work is split by columns of the result (rows for matrix vector products) in chunks
+			  whose size depends only on the dimensions, so results are bit for bit the same for any
+			  number of threads. Small products run as a single chunk on the calling thread.
+			- LUDecomposition uses partial pivoting, so PA = LU with L unit lower triangular. A
+			  singular matrix still factors; determinant() is then 0 and solve() throws
+			  std::runtime_error. A pivot counts as zero when it is within n * FLT_EPSILON of the
+			  largest input element, since exact zeros rarely survive the rounding of elimination.
+			- CholeskyDecomposition reads only the lower triangle and gives A = LL^T. It throws
+			  std::runtime_error from the constructor when the matrix isn't positive definite.
+			- Both factorizations work on panels of FactorBlock columns: the panel is factored
+			  directly, then the rest of the matrix is updated with one large multiplyBlocked call,
+			  which is where nearly all of the arithmetic happens.
+	*/
+
+	class DenseVector
+	{
+	private:
+		std::vector<float> m_data;
+
+		std::string toString() const;
+
+	public:
+		DenseVector();
+		explicit DenseVector(int size);
+		DenseVector(std::initializer_list<float>);
+		template<int n>
+		explicit DenseVector(const Vector<n>&);
+
+		int size() const;
+
+		float& operator [](const int);
+		const float& operator [](const int) const;
+
+		float* data();
+		const float* data() const;
+		float* begin();
+		const float* begin() const;
+		float* end();
+		const float* end() const;
+
+		template<int n>
+		Vector<n> segment(int start) const;
+		template<int n>
+		void setSegment(int start, const Vector<n>&);
+
+		bool operator ==(const DenseVector&) const;
+		bool operator !=(const DenseVector&) const;
+
+		DenseVector operator +(const DenseVector&) const;
+		DenseVector operator -(const DenseVector&) const;
+		DenseVector operator *(float) const;
+
+		void operator +=(const DenseVector&);
+		void operator -=(const DenseVector&);
+		void operator *=(float);
+
+		float dotProduct(const DenseVector&) const;
+		float magnitude() const;
+
+		std::string to_string() const;
+
+		friend std::ostream& operator <<(std::ostream& os, const DenseVector& v)
+		{
+			os << v.toString() << std::endl;
+			return os;
+		}
+	};
+
+	class DenseMatrix
+	{
+	private:
+		int m_rows;
+		int m_cols;
+		std::vector<float> m_data;
+
+		std::string toString() const;
+		bool blockInRange(int row, int col, int rows, int cols) const;
+
+	public:
+		static DenseMatrix Identity(int size);
+
+		DenseMatrix();
+		DenseMatrix(int rows, int cols);
+		DenseMatrix(std::initializer_list<DenseVector>);
+		template<int row, int col>
+		explicit DenseMatrix(const Matrix<row, col>&);
+
+		int rows() const;
+		int cols() const;
+
+		float& operator ()(const int row, const int col);
+		const float& operator ()(const int row, const int col) const;
+
+		float* data();
+		const float* data() const;
+		float* column(const int);
+		const float* column(const int) const;
+
+		template<int r, int c>
+		Matrix<r, c> block(int row, int col) const;
+		template<int r, int c>
+		void setBlock(int row, int col, const Matrix<r, c>&);
+
+		bool operator ==(const DenseMatrix&) const;
+		bool operator !=(const DenseMatrix&) const;
+
+		DenseMatrix operator +(const DenseMatrix&) const;
+		DenseMatrix operator -(const DenseMatrix&) const;
+		DenseMatrix operator *(const DenseMatrix&) const;
+		DenseMatrix operator *(float) const;
+		DenseVector operator *(const DenseVector&) const;
+
+		void operator +=(const DenseMatrix&);
+		void operator -=(const DenseMatrix&);
+		void operator *=(float);
+
+		DenseMatrix transposition(ThreadPool& pool = ThreadPool::global()) const;
+
+		std::string to_string() const;
+
+		friend std::ostream& operator <<(std::ostream& os, const DenseMatrix& m)
+		{
+			os << m.toString() << std::endl;
+			return os;
+		}
+	};
+
+	class LUDecomposition
+	{
+	private:
+		DenseMatrix m_lu;
+		std::vector<int> m_pivots;
+		bool m_singular;
+
+	public:
+		explicit LUDecomposition(const DenseMatrix&, ThreadPool& pool = ThreadPool::global());
+
+		const DenseMatrix& factors() const;
+		const std::vector<int>& pivots() const;
+		DenseMatrix lower() const;
+		DenseMatrix upper() const;
+
+		bool isSingular() const;
+		float determinant() const;
+		DenseVector solve(const DenseVector&) const;
+	};
+
+	class CholeskyDecomposition
+	{
+	private:
+		DenseMatrix m_lower;
+
+	public:
+		explicit CholeskyDecomposition(const DenseMatrix&, ThreadPool& pool = ThreadPool::global());
+
+		const DenseMatrix& lower() const;
+
+		float determinant() const;
+		DenseVector solve(const DenseVector&) const;
+	};
+
+	// Panel width of the blocked factorizations
+	static const int FactorBlock = 64;
+
+	void multiply(const DenseMatrix& a, const DenseMatrix& b, DenseMatrix& out, ThreadPool& pool = ThreadPool::global());
+	void multiply(const DenseMatrix& a, const DenseVector& x, DenseVector& out, ThreadPool& pool = ThreadPool::global());
+
+#pragma endregion
+
+#pragma region Dense Vector Methods
+
+	inline DenseVector::DenseVector()
+	{
+	}
+
+	inline DenseVector::DenseVector(int size)
+	{
+		if (size < 0)
+			throw std::invalid_argument("ERROR: DenseVector size must not be negative.");
+
+		m_data.resize(size);
+	}
+
+	inline DenseVector::DenseVector(std::initializer_list<float> args)
+		: m_data(args)
+	{
+	}
+
+	template<int n>
+	DenseVector::DenseVector(const Vector<n>& v)
+		: m_data(v.begin(), v.end())
+	{
+	}
+
+	inline int DenseVector::size() const
+	{
+		return static_cast<int>(m_data.size());
+	}
+
+	inline float& DenseVector::operator[](const int index)
+	{
+		if (GRAPHICSMATH_BOUNDS_CHECK && (index < 0 || index >= size()))
+			throw std::out_of_range("ERROR: Attempted to access value out of DenseVector range.");
+
+		return m_data[index];
+	}
+
+	inline const float& DenseVector::operator[](const int index) const
+	{
+		if (GRAPHICSMATH_BOUNDS_CHECK && (index < 0 || index >= size()))
+			throw std::out_of_range("ERROR: Attempted to access value out of DenseVector range.");
+
+		return m_data[index];
+	}
+
+	inline float* DenseVector::data()
+	{
+		return m_data.data();
+	}
+
+	inline const float* DenseVector::data() const
+	{
+		return m_data.data();
+	}
+
+	inline float* DenseVector::begin()
+	{
+		return m_data.data();
+	}
+
+	inline const float* DenseVector::begin() const
+	{
+		return m_data.data();
+	}
+
+	inline float* DenseVector::end()
+	{
+		return m_data.data() + m_data.size();
+	}
+
+	inline const float* DenseVector::end() const
+	{
+		return m_data.data() + m_data.size();
+	}
+
+	template<int n>
+	Vector<n> DenseVector::segment(int start) const
+	{
+		if (GRAPHICSMATH_BOUNDS_CHECK && (start < 0 || start + n > size()))
+			throw std::out_of_range("ERROR: Attempted to access value out of DenseVector range.");
+
+		Vector<n> result;
+		std::copy(m_data.begin() + start, m_data.begin() + start + n, result.begin());
+
+		return result;
+	}
+
+	template<int n>
+	void DenseVector::setSegment(int start, const Vector<n>& v)
+	{
+		if (GRAPHICSMATH_BOUNDS_CHECK && (start < 0 || start + n > size()))
+			throw std::out_of_range("ERROR: Attempted to access value out of DenseVector range.");
+
+		std::copy(v.begin(), v.end(), m_data.begin() + start);
+	}
+
+#pragma endregion
+
+#pragma region Dense Matrix Methods
+
+	template<int row, int col>
+	DenseMatrix::DenseMatrix(const Matrix<row, col>& m)
+		: m_rows(row), m_cols(col), m_data(m.data(), m.data() + row * col)
+	{
+	}
+
+	inline int DenseMatrix::rows() const
+	{
+		return m_rows;
+	}
+
+	inline int DenseMatrix::cols() const
+	{
+		return m_cols;
+	}
+
+	inline float& DenseMatrix::operator()(const int row, const int col)
+	{
+		if (GRAPHICSMATH_BOUNDS_CHECK && !blockInRange(row, col, 1, 1))
+			throw std::out_of_range("ERROR: Attempted to access value out of DenseMatrix range.");
+
+		return m_data[static_cast<std::size_t>(col) * m_rows + row];
+	}
+
+	inline const float& DenseMatrix::operator()(const int row, const int col) const
+	{
+		if (GRAPHICSMATH_BOUNDS_CHECK && !blockInRange(row, col, 1, 1))
+			throw std::out_of_range("ERROR: Attempted to access value out of DenseMatrix range.");
+
+		return m_data[static_cast<std::size_t>(col) * m_rows + row];
+	}
+
+	inline float* DenseMatrix::data()
+	{
+		return m_data.data();
+	}
+
+	inline const float* DenseMatrix::data() const
+	{
+		return m_data.data();
+	}
+
+	inline float* DenseMatrix::column(const int col)
+	{
+		if (GRAPHICSMATH_BOUNDS_CHECK && (col < 0 || col >= m_cols))
+			throw std::out_of_range("ERROR: Attempted to access value out of DenseMatrix range.");
+
+		return m_data.data() + static_cast<std::size_t>(col) * m_rows;
+	}
+
+	inline const float* DenseMatrix::column(const int col) const
+	{
+		if (GRAPHICSMATH_BOUNDS_CHECK && (col < 0 || col >= m_cols))
+			throw std::out_of_range("ERROR: Attempted to access value out of DenseMatrix range.");
+
+		return m_data.data() + static_cast<std::size_t>(col) * m_rows;
+	}
+
+	inline bool DenseMatrix::blockInRange(int row, int col, int rows, int cols) const
+	{
+		return row >= 0 && col >= 0 && row + rows <= m_rows && col + cols <= m_cols;
+	}
+
+	template<int r, int c>
+	Matrix<r, c> DenseMatrix::block(int row, int col) const
+	{
+		if (GRAPHICSMATH_BOUNDS_CHECK && !blockInRange(row, col, r, c))
+			throw std::out_of_range("ERROR: Attempted to access value out of DenseMatrix range.");
+
+		Matrix<r, c> result;
+		for (int j = 0; j < c; ++j)
+		{
+			const float* source = m_data.data() + static_cast<std::size_t>(col + j) * m_rows + row;
+			std::copy(source, source + r, result.data() + j * r);
+		}
+
+		return result;
+	}
+
+	template<int r, int c>
+	void DenseMatrix::setBlock(int row, int col, const Matrix<r, c>& m)
+	{
+		if (GRAPHICSMATH_BOUNDS_CHECK && !blockInRange(row, col, r, c))
+			throw std::out_of_range("ERROR: Attempted to access value out of DenseMatrix range.");
+
+		for (int j = 0; j < c; ++j)
+			std::copy(m.data() + j * r, m.data() + (j + 1) * r, m_data.data() + static_cast<std::size_t>(col + j) * m_rows + row);
+	}
+
+#pragma endregion
+
+}
+
+#endif
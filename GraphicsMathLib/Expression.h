@@ -0,0 +1,317 @@
+#ifndef EXPRESSION_H
+#define EXPRESSION_H
+
+#include <type_traits>
+
+#include "Matrix.h"
+
+namespace GraphicsMath
+{
+
+#pragma region Expression Definitions
+
+	/* -------------------------------------------------------------------------------------------------
+		Copyright 2017 Shealyn Tate Hindenlang
+
+		Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+		and associated documentation files (the "Software"), to deal in the Software without restriction,
+		including without limitation the rights to use, copy, modify, merge, publish, distribute,
+		sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+		furnished to do so, subject to the following conditions:
+
+		The above copyright notice and this permission notice shall be included in all copies or
+		substantial portions of the Software.
+
+		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+		BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+		NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+		DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+		-------------------------------------------------------------------------------------------------
+
+		Expression.h is an opt-in layer of expression templates for element-wise Vector and Matrix
+		arithmetic. Wrapping an operand in lazy() makes the operators around it build an expression
+		instead of a result, and the whole chain is evaluated in one loop when it is converted back
+		to a Vector or Matrix, with no intermediate Vector or Matrix in between.
+
+		Usage:
+			Vector<4> color = lazy(albedo) * light + lazy(specular) * 0.5f - fog;
+			Matrix<4, 4> blend = lazy(m1) * 0.25f + lazy(m2) * 0.75f;
+			auto v = (lazy(a) + b).evaluate();
+
+		Supported operators, matching the eager ones in Vector.h and Matrix.h:
+			Vector:		+, -, * with a Vector or a float, and / with a float
+			Matrix:		+, - with a Matrix, and * with a float
+
+		Notes:
+			- Only the operators that touch an expression are lazy. In lazy(a) + b * 2.0f the product
+			  b * 2.0f is still an eager Vector, so wrap the first operand of every product to fuse
+			  the whole chain: lazy(a) + lazy(b) * 2.0f.
+			- Expressions hold references to their Vector and Matrix operands. Evaluate an expression
+			  in the statement that builds it; don't keep one in an auto variable past the lifetime
+			  of its operands.
+			- Dividing by a zero scalar throws when the expression is built, like Vector::operator /.
+			- Matrix * Matrix and Matrix * Vector aren't element-wise and have no lazy form; the
+			  operators don't accept matrix expressions for them.
+	*/
+
+	namespace Expressions
+	{
+		// Element access shared by the operands and the results of expressions; both Vector and
+		// Matrix store their elements in one contiguous block
+		template<int size>
+		inline float* elements(Vector<size>& v) { return v.begin(); }
+
+		template<int size>
+		inline const float* elements(const Vector<size>& v) { return v.begin(); }
+
+		template<int row, int col>
+		inline float* elements(Matrix<row, col>& m) { return m.data(); }
+
+		template<int row, int col>
+		inline const float* elements(const Matrix<row, col>& m) { return m.data(); }
+
+		template<typename T>
+		struct Shape
+		{
+			static constexpr bool isVector = false;
+			static constexpr bool isMatrix = false;
+		};
+
+		template<int size>
+		struct Shape<Vector<size>>
+		{
+			static constexpr bool isVector = true;
+			static constexpr bool isMatrix = false;
+			static constexpr int count = size;
+		};
+
+		template<int row, int col>
+		struct Shape<Matrix<row, col>>
+		{
+			static constexpr bool isVector = false;
+			static constexpr bool isMatrix = true;
+			static constexpr int count = row * col;
+		};
+
+		// A Vector or Matrix leaf of an expression
+		template<typename T>
+		class Operand
+		{
+		private:
+			const float* m_data;
+
+		public:
+			typedef T Result;
+
+			explicit Operand(const T& value)
+				: m_data(elements(value))
+			{
+			}
+
+			float operator [](const int i) const
+			{
+				return m_data[i];
+			}
+		};
+
+		// A scalar leaf, the same value for every element
+		class Constant
+		{
+		private:
+			float m_value;
+
+		public:
+			explicit Constant(float value)
+				: m_value(value)
+			{
+			}
+
+			float operator [](const int) const
+			{
+				return m_value;
+			}
+		};
+
+		struct Add { static float apply(float a, float b) { return a + b; } };
+		struct Subtract { static float apply(float a, float b) { return a - b; } };
+		struct Multiply { static float apply(float a, float b) { return a * b; } };
+		struct Divide { static float apply(float a, float b) { return a / b; } };
+
+		template<typename Left, typename Right>
+		struct ResultOf
+		{
+			static_assert(std::is_same<typename Left::Result, typename Right::Result>::value,
+						  "Both sides of an expression must have the same Vector or Matrix type");
+
+			typedef typename Left::Result type;
+		};
+
+		template<typename Left>
+		struct ResultOf<Left, Constant>
+		{
+			typedef typename Left::Result type;
+		};
+
+		template<typename Right>
+		struct ResultOf<Constant, Right>
+		{
+			typedef typename Right::Result type;
+		};
+
+		template<typename Operation, typename Left, typename Right>
+		class BinaryExpression
+		{
+		private:
+			Left m_left;
+			Right m_right;
+
+		public:
+			typedef typename ResultOf<Left, Right>::type Result;
+
+			BinaryExpression(const Left& left, const Right& right)
+				: m_left(left), m_right(right)
+			{
+			}
+
+			float operator [](const int i) const
+			{
+				return Operation::apply(m_left[i], m_right[i]);
+			}
+
+			Result evaluate() const
+			{
+				Result result;
+				float* out = elements(result);
+
+				for (int i = 0; i < Shape<Result>::count; ++i)
+					out[i] = (*this)[i];
+
+				return result;
+			}
+
+			operator Result() const
+			{
+				return evaluate();
+			}
+		};
+
+		template<typename T>
+		struct IsExpression : std::false_type {};
+
+		template<typename T>
+		struct IsExpression<Operand<T>> : std::true_type {};
+
+		template<typename Operation, typename Left, typename Right>
+		struct IsExpression<BinaryExpression<Operation, Left, Right>> : std::true_type {};
+
+		// Turns each side of an operator into an expression node
+		template<typename T>
+		inline const T& node(const T& expression, typename std::enable_if<IsExpression<T>::value>::type* = nullptr)
+		{
+			return expression;
+		}
+
+		template<int size>
+		inline Operand<Vector<size>> node(const Vector<size>& v)
+		{
+			return Operand<Vector<size>>(v);
+		}
+
+		template<int row, int col>
+		inline Operand<Matrix<row, col>> node(const Matrix<row, col>& m)
+		{
+			return Operand<Matrix<row, col>>(m);
+		}
+
+		inline Constant node(float s)
+		{
+			return Constant(s);
+		}
+
+		template<typename T>
+		using Node = typename std::decay<decltype(node(std::declval<const T&>()))>::type;
+
+		template<typename T>
+		struct IsOperandType : std::integral_constant<bool, IsExpression<T>::value || Shape<T>::isVector || Shape<T>::isMatrix || std::is_arithmetic<T>::value> {};
+
+		// The lazy operators only take part in overload resolution when one side is already an
+		// expression, so plain Vector and Matrix arithmetic keeps using the eager operators
+		template<typename Left, typename Right>
+		using EnableLazy = typename std::enable_if<
+			(IsExpression<Left>::value || IsExpression<Right>::value) && IsOperandType<Left>::value && IsOperandType<Right>::value>::type;
+
+		template<typename Left, typename Right>
+		struct Operands
+		{
+			typedef Node<Left> LeftNode;
+			typedef Node<Right> RightNode;
+			typedef typename ResultOf<LeftNode, RightNode>::type Result;
+
+			static constexpr bool leftIsScalar = std::is_same<LeftNode, Constant>::value;
+			static constexpr bool rightIsScalar = std::is_same<RightNode, Constant>::value;
+			static constexpr bool isVector = Shape<Result>::isVector;
+		};
+
+		template<typename Left, typename Right, typename = EnableLazy<Left, Right>>
+		inline BinaryExpression<Add, Node<Left>, Node<Right>> operator +(const Left& left, const Right& right)
+		{
+			typedef Operands<Left, Right> Types;
+			static_assert(Types::isVector || !(Types::leftIsScalar || Types::rightIsScalar), "Matrices can't be added to a scalar");
+
+			return BinaryExpression<Add, Node<Left>, Node<Right>>(node(left), node(right));
+		}
+
+		template<typename Left, typename Right, typename = EnableLazy<Left, Right>>
+		inline BinaryExpression<Subtract, Node<Left>, Node<Right>> operator -(const Left& left, const Right& right)
+		{
+			typedef Operands<Left, Right> Types;
+			static_assert(Types::isVector || !(Types::leftIsScalar || Types::rightIsScalar), "Scalars can't be subtracted from a matrix");
+
+			return BinaryExpression<Subtract, Node<Left>, Node<Right>>(node(left), node(right));
+		}
+
+		template<typename Left, typename Right, typename = EnableLazy<Left, Right>>
+		inline BinaryExpression<Multiply, Node<Left>, Node<Right>> operator *(const Left& left, const Right& right)
+		{
+			typedef Operands<Left, Right> Types;
+			static_assert(Types::isVector || Types::leftIsScalar || Types::rightIsScalar, "Only scalar multiplication of matrices is element-wise");
+
+			return BinaryExpression<Multiply, Node<Left>, Node<Right>>(node(left), node(right));
+		}
+
+		template<typename Left, typename Right, typename = EnableLazy<Left, Right>>
+		inline BinaryExpression<Divide, Node<Left>, Node<Right>> operator /(const Left& left, const Right& right)
+		{
+			typedef Operands<Left, Right> Types;
+			static_assert(Types::isVector && Types::rightIsScalar, "Only vectors can be divided, and only by a scalar");
+
+			if (right == 0)
+				throw std::runtime_error("Cannot divide vector by zero scalar.");
+
+			return BinaryExpression<Divide, Node<Left>, Node<Right>>(node(left), node(right));
+		}
+	}
+
+#pragma endregion
+
+#pragma region Lazy Evaluation
+
+	template<int size>
+	inline Expressions::Operand<Vector<size>> lazy(const Vector<size>& v)
+	{
+		return Expressions::Operand<Vector<size>>(v);
+	}
+
+	template<int row, int col>
+	inline Expressions::Operand<Matrix<row, col>> lazy(const Matrix<row, col>& m)
+	{
+		return Expressions::Operand<Matrix<row, col>>(m);
+	}
+
+#pragma endregion
+
+}
+
+#endif
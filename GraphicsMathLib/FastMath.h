@@ -0,0 +1,204 @@
+#ifndef FAST_MATH_H
+#define FAST_MATH_H
+
+#include <cmath>
+
+#include "SIMD.h"
+
+// The math policy of normal() and normalize() on vectors, packets and streams, and of
+// Matrix<4, 4>::Rotation() and Matrix<4, 4>::PerspectiveProjection(), when a call doesn't name one.
+// Define GRAPHICSMATH_FAST_MATH to 1 before including the library to make MathPolicy::Fast the
+// default in a translation unit.
+#if !defined(GRAPHICSMATH_FAST_MATH)
+	#define GRAPHICSMATH_FAST_MATH 0
+#endif
+
+namespace GraphicsMath
+{
+
+#pragma region Fast Math Definitions
+
+	/* -------------------------------------------------------------------------------------------------
+		Copyright 2017 Shealyn Tate Hindenlang
+
+		Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+		and associated documentation files (the "Software"), to deal in the Software without restriction,
+		including without limitation the rights to use, copy, modify, merge, publish, distribute,
+		sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+		furnished to do so, subject to the following conditions:
+
+		The above copyright notice and this permission notice shall be included in all copies or
+		substantial portions of the Software.
+
+		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+		BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+		NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+		DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+		-------------------------------------------------------------------------------------------------
+
+		MathPolicy picks between the standard library functions (Precise) and cheaper approximations
+		(Fast) for the square roots and trigonometry inside the library. The approximations are in
+		FastMath, and reciprocalSquareRoot<policy>(), sinCos<policy>() and tangent<policy>() call
+		whichever one the policy names.
+
+		Methods:
+			FastMath::reciprocalSquareRoot(x)		1 / sqrt(x)
+			FastMath::sinCos(x, s, c)				s = sin(x), c = cos(x)
+			FastMath::tangent(x)					tan(x)
+
+		Usage:
+			Vector<3> n = normal.normal<MathPolicy::Fast>();
+			auto r = Matrix<4, 4>::Rotation<MathPolicy::Fast>(axis, theta);
+
+			#define GRAPHICSMATH_FAST_MATH 1		// every call in this file
+			#include "Matrix.h"
+
+		Notes:
+			- reciprocalSquareRoot starts from the 12 bit hardware estimate (rsqrtss) and refines
+			  it with one Newton-Raphson step. The result is within 3.5 ULP of 1 / sqrt(x) for every
+			  positive normal float, about the limit of a single step. Without SSE it is 1 / sqrt(x).
+			- sinCos reduces x to [-pi/4, pi/4] by the nearest multiple of pi/2, split into three
+			  parts so the reduction stays exact, then evaluates minimax polynomials of degree 7
+			  (sine) and 8 (cosine). For |x| <= 8192 the absolute error is below 1e-7, and the error
+			  is within 1.6 ULP except near the zeros of each function, where the absolute error is
+			  already below 6e-8. Larger arguments, infinities and NaNs go to std::sin and
+			  std::cos instead.
+			- tangent is sine over cosine, so it is within 4 ULP where both are at least 0.1 in
+			  magnitude. Closer to its zeros and poles the absolute error of the sine or cosine
+			  dominates, and like tanf it grows without bound near odd multiples of pi/2.
+			- Vector::normal<MathPolicy::Fast>() multiplies by reciprocalSquareRoot of the square
+			  magnitude instead of dividing by the magnitude, so a zero vector still becomes NaNs.
+			  VectorPacket and VectorStreamView do the same with SIMD::Wide::reciprocalSquareRoot,
+			  which has the same bound. That is where the policy pays most: a packed square root
+			  and divide cost several times a packed multiply, while the scalar ones are cheap
+			  next to the loads and shuffles around a single Vector<3>.
+			- Translation units may choose different defaults with GRAPHICSMATH_FAST_MATH. Every
+			  function whose behaviour depends on the default takes the policy as a template
+			  argument, down to library templates such as parallelNormalize(), so the two defaults
+			  are different instantiations and code compiled either way links together. Inline
+			  library code that isn't templated on the policy, such as Transform::Decompose(),
+			  names MathPolicy::Precise itself so it is the same in every file.
+	*/
+
+	enum class MathPolicy
+	{
+		Precise,
+		Fast
+	};
+
+	constexpr MathPolicy DefaultMathPolicy = GRAPHICSMATH_FAST_MATH ? MathPolicy::Fast : MathPolicy::Precise;
+
+	namespace FastMath
+	{
+		float reciprocalSquareRoot(float);
+		void sinCos(float, float& s, float& c);
+		float tangent(float);
+	}
+
+	template<MathPolicy policy>
+	float reciprocalSquareRoot(float);
+	template<MathPolicy policy>
+	void sinCos(float, float& s, float& c);
+	template<MathPolicy policy>
+	float tangent(float);
+
+#pragma endregion
+
+#pragma region Approximations
+
+	inline float FastMath::reciprocalSquareRoot(float x)
+	{
+#if defined(GRAPHICSMATH_SSE)
+		float estimate = _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(x)));
+
+		// One Newton-Raphson step squares the estimate's 2^-12 relative error. Applying it as a
+		// correction to the estimate keeps the rounding of the step itself out of most of the result.
+		float error = 1.0f - (x * estimate) * estimate;
+		return estimate + (0.5f * estimate) * error;
+#else
+		return 1.0f / std::sqrt(x);
+#endif
+	}
+
+	inline void FastMath::sinCos(float x, float& s, float& c)
+	{
+		// pi/2 in three parts; the first two have few enough bits that quadrant * part is exact
+		const float halfPi1 = 1.5703125f;
+		const float halfPi2 = 4.837512969970703125e-4f;
+		const float halfPi3 = 7.54978995489188216e-8f;
+
+		// Past this the reduction loses accuracy, and far past it the quadrant overflows an int
+		if (!(std::fabs(x) <= 8192.0f))
+		{
+			s = std::sin(x);
+			c = std::cos(x);
+			return;
+		}
+
+		const float quadrant = std::nearbyint(x * 0.636619772f);
+		const float r = ((x - quadrant * halfPi1) - quadrant * halfPi2) - quadrant * halfPi3;
+		const float r2 = r * r;
+
+		const float sine = r + r * r2 * (-1.6666654611e-1f + r2 * (8.3321608736e-3f + r2 * -1.9515295891e-4f));
+		const float cosine = 1.0f - 0.5f * r2 + r2 * r2 * (4.166664568298827e-2f + r2 * (-1.388731625493765e-3f + r2 * 2.443315711809948e-5f));
+
+		switch (static_cast<int>(quadrant) & 3)
+		{
+		case 0: s = sine; c = cosine; break;
+		case 1: s = cosine; c = -sine; break;
+		case 2: s = -sine; c = -cosine; break;
+		default: s = -cosine; c = sine; break;
+		}
+	}
+
+	inline float FastMath::tangent(float x)
+	{
+		float s, c;
+		sinCos(x, s, c);
+
+		return s / c;
+	}
+
+#pragma endregion
+
+#pragma region Policy Dispatch
+
+	template<MathPolicy policy>
+	inline float reciprocalSquareRoot(float x)
+	{
+		if constexpr (policy == MathPolicy::Fast)
+			return FastMath::reciprocalSquareRoot(x);
+		else
+			return 1.0f / std::sqrt(x);
+	}
+
+	template<MathPolicy policy>
+	inline void sinCos(float x, float& s, float& c)
+	{
+		if constexpr (policy == MathPolicy::Fast)
+		{
+			FastMath::sinCos(x, s, c);
+		}
+		else
+		{
+			s = std::sin(x);
+			c = std::cos(x);
+		}
+	}
+
+	template<MathPolicy policy>
+	inline float tangent(float x)
+	{
+		if constexpr (policy == MathPolicy::Fast)
+			return FastMath::tangent(x);
+		else
+			return std::tan(x);
+	}
+
+#pragma endregion
+
+}
+
+#endif
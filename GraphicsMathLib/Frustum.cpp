@@ -0,0 +1,147 @@
+#include <algorithm>
+#include <limits>
+
+#include "Frustum.h"
+#include "Parallel.h"
+#include "SIMD.h"
+
+namespace GraphicsMath
+{
+
+	namespace Wide = SIMD::Wide;
+
+	// Objects per parallel chunk. Testing one is a few dozen flops, so chunks are larger than
+	// ParallelGrain to keep the task overhead small.
+	static const std::size_t CullGrain = cacheAlignedGrain<std::uint32_t>(4 * ParallelGrain);
+
+	// Each plane's normal and distance broadcast to a register apiece
+	struct WidePlane
+	{
+		Wide::Lanes x;
+		Wide::Lanes y;
+		Wide::Lanes z;
+		Wide::Lanes distance;
+	};
+
+	static void broadcastPlanes(const Frustum& frustum, WidePlane (&planes)[6])
+	{
+		for (int p = 0; p < 6; ++p)
+		{
+			const Plane& plane = frustum.plane(p);
+			planes[p] = { Wide::broadcast(plane.normal()[0]), Wide::broadcast(plane.normal()[1]),
+						  Wide::broadcast(plane.normal()[2]), Wide::broadcast(plane.distance()) };
+		}
+	}
+
+	static Wide::Lanes signedDistance(const WidePlane& plane, Wide::Lanes x, Wide::Lanes y, Wide::Lanes z)
+	{
+		return Wide::multiplyAdd(plane.z, z, Wide::multiplyAdd(plane.y, y, Wide::multiplyAdd(plane.x, x, plane.distance)));
+	}
+
+	// Runs culledBits(i, n), a mask with bit k set when object i + k is outside, over [0, count)
+	// and packs the indices of the rest into out. Each chunk packs its indices into its own
+	// stretch of out, then the stretches are moved down in chunk order, so the result doesn't
+	// depend on the number of threads.
+	template<typename CulledBits>
+	static std::size_t cull(std::size_t count, std::uint32_t* out, ThreadPool& pool, CulledBits culledBits)
+	{
+		if (count > std::numeric_limits<std::uint32_t>::max())
+			throw std::length_error("ERROR: Too many objects for 32 bit indices.");
+
+		std::vector<std::size_t> found((count + CullGrain - 1) / CullGrain);
+
+		pool.parallelFor(count, CullGrain, [&](std::size_t begin, std::size_t end)
+		{
+			std::uint32_t* chunk = out + begin;
+			std::size_t kept = 0;
+
+			for (std::size_t i = begin; i < end; i += Wide::LaneCount)
+			{
+				const int n = end - i < (std::size_t)Wide::LaneCount ? static_cast<int>(end - i) : Wide::LaneCount;
+				const int culled = culledBits(i, n);
+
+				// Most objects are usually outside, so whole registers of them skip the packing
+				const int all = (1 << n) - 1;
+				if ((culled & all) == all)
+					continue;
+
+				// Every lane writes its index, and only the visible ones move the cursor past it
+				for (int lane = 0; lane < n; ++lane)
+				{
+					chunk[kept] = static_cast<std::uint32_t>(i + lane);
+					kept += ((culled >> lane) & 1) ^ 1;
+				}
+			}
+
+			found[begin / CullGrain] = kept;
+		});
+
+		std::size_t total = 0;
+		for (std::size_t c = 0; c < found.size(); ++c)
+		{
+			const std::uint32_t* chunk = out + c * CullGrain;
+			if (chunk != out + total)
+				std::copy(chunk, chunk + found[c], out + total);
+
+			total += found[c];
+		}
+
+		return total;
+	}
+
+#pragma region Batch Culling
+
+	std::size_t Frustum::cullSpheres(SphereStreams spheres, std::size_t count, std::uint32_t* visible, ThreadPool& pool) const
+	{
+		WidePlane planes[6];
+		broadcastPlanes(*this, planes);
+
+		return cull(count, visible, pool, [&spheres, &planes](std::size_t i, int n)
+		{
+			Wide::Lanes x = Wide::load(spheres.x + i, n);
+			Wide::Lanes y = Wide::load(spheres.y + i, n);
+			Wide::Lanes z = Wide::load(spheres.z + i, n);
+			Wide::Lanes negativeRadius = Wide::subtract(Wide::zero(), Wide::load(spheres.radius + i, n));
+
+			Wide::Mask outside = Wide::less(signedDistance(planes[0], x, y, z), negativeRadius);
+			for (int p = 1; p < 6; ++p)
+				outside = Wide::maskOr(outside, Wide::less(signedDistance(planes[p], x, y, z), negativeRadius));
+
+			return Wide::maskBits(outside);
+		});
+	}
+
+	std::size_t Frustum::cullBoxes(BoxStreams boxes, std::size_t count, std::uint32_t* visible, ThreadPool& pool) const
+	{
+		WidePlane planes[6];
+		broadcastPlanes(*this, planes);
+
+		// The corner furthest along each normal, as in intersects(const AABB&)
+		bool positive[6][3];
+		for (int p = 0; p < 6; ++p)
+		{
+			for (int axis = 0; axis < 3; ++axis)
+				positive[p][axis] = m_planes[p].normal()[axis] >= 0;
+		}
+
+		return cull(count, visible, pool, [&boxes, &planes, &positive](std::size_t i, int n)
+		{
+			const Wide::Lanes minimum[3] = { Wide::load(boxes.minimumX + i, n), Wide::load(boxes.minimumY + i, n), Wide::load(boxes.minimumZ + i, n) };
+			const Wide::Lanes maximum[3] = { Wide::load(boxes.maximumX + i, n), Wide::load(boxes.maximumY + i, n), Wide::load(boxes.maximumZ + i, n) };
+
+			Wide::Mask outside = Wide::maskBroadcast(false);
+			for (int p = 0; p < 6; ++p)
+			{
+				Wide::Lanes distance = signedDistance(planes[p], positive[p][0] ? maximum[0] : minimum[0],
+													  positive[p][1] ? maximum[1] : minimum[1],
+													  positive[p][2] ? maximum[2] : minimum[2]);
+				outside = Wide::maskOr(outside, Wide::less(distance, Wide::zero()));
+			}
+
+			return Wide::maskBits(outside);
+		});
+	}
+
+#pragma endregion
+
+}
@@ -0,0 +1,258 @@
+#ifndef FRUSTUM_H
+#define FRUSTUM_H
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+#include "Matrix.h"
+#include "Ray.h"
+#include "ThreadPool.h"
+
+namespace GraphicsMath
+{
+
+#pragma region Frustum Definitions
+
+	/* -------------------------------------------------------------------------------------------------
+		Copyright 2017 Shealyn Tate Hindenlang
+
+		Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+		and associated documentation files (the "Software"), to deal in the Software without restriction,
+		including without limitation the rights to use, copy, modify, merge, publish, distribute,
+		sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+		furnished to do so, subject to the following conditions:
+
+		The above copyright notice and this permission notice shall be included in all copies or
+		substantial portions of the Software.
+
+		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+		BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+		NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+		DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+		-------------------------------------------------------------------------------------------------
+
+		Plane is the set of points p with normal.dotProduct(p) + distance == 0. Frustum is the six
+		planes bounding the volume a view-projection Matrix<4, 4> maps into clip space, facing
+		inwards, with single object tests and batch culling of bounding spheres and boxes.
+
+		Constructors:
+			Plane(normal, distance)
+			static Frustum::FromMatrix(viewProjection)
+
+		Methods:
+			plane.signedDistance(point)						positive on the side the normal faces
+			frustum.contains(point)
+			frustum.intersects(center, radius)				bounding sphere
+			frustum.intersects(box)							AABB
+			frustum.cullSpheres(spheres, count, visible)	indices of the visible spheres, and their number
+			frustum.cullBoxes(boxes, count, visible)		indices of the visible boxes, and their number
+
+		Usage:
+			Frustum frustum = Frustum::FromMatrix(projection * view);
+
+			std::vector<std::uint32_t> visible(objectCount);
+			std::size_t visibleCount = frustum.cullSpheres({ x, y, z, radius }, objectCount, visible.data());
+			for (std::size_t i = 0; i < visibleCount; ++i)
+				draw(objects[visible[i]]);
+
+		Notes:
+			- FromMatrix() takes the planes from the rows of the matrix (Gribb and Hartmann), so it
+			  works for PerspectiveProjection(), OrthographicProjection() and any product of them with
+			  a view or model matrix. Clip space is the [-w, w] cube on every axis, as those
+			  projections produce. A projection alone gives planes in view space, projection * view
+			  in world space, and projection * view * model in the model's own space.
+			- Planes are normalized, so signedDistance() is a true distance and sphere radii compare
+			  against it directly.
+			- The sphere and box tests are the usual conservative ones: an object is culled only
+			  when it lies entirely behind one plane, so objects near the frustum's edges and corners
+			  may be kept although they are outside. Touching a plane counts as visible.
+			- cullSpheres() and cullBoxes() read structure of arrays input, SphereStreams and
+			  BoxStreams, and test a full SIMD register of objects per plane. The work is split
+			  across a ThreadPool, ThreadPool::global() unless one is given, in chunks that depend
+			  only on count. visible needs room for count indices, as every one may be written
+			  while the list is packed. The first n of them, where n is the returned count, are the
+			  indices of the visible objects in increasing order, the same for any number of threads.
+			  Nothing is allocated beyond a few bytes per chunk.
+			- Boxes must not be empty. Spheres with negative radii are culled unless their center
+			  is at least that far inside.
+			- plane() throws std::out_of_range for indices outside [0, 6).
+	*/
+
+	class Plane
+	{
+	private:
+		Vector<3> m_normal;
+		float m_distance;
+
+	public:
+		Plane();
+		Plane(const Vector<3>& normal, float distance);
+
+		const Vector<3>& normal() const;
+		float distance() const;
+
+		float signedDistance(const Vector<3>&) const;
+		Plane normalized() const;
+	};
+
+	// Structure of arrays bounding volumes for batch culling, one float per object in each array
+	struct SphereStreams
+	{
+		const float* x;
+		const float* y;
+		const float* z;
+		const float* radius;
+	};
+
+	struct BoxStreams
+	{
+		const float* minimumX;
+		const float* minimumY;
+		const float* minimumZ;
+		const float* maximumX;
+		const float* maximumY;
+		const float* maximumZ;
+	};
+
+	class Frustum
+	{
+	private:
+		Plane m_planes[6];
+
+	public:
+		enum PlaneIndex { Left, Right, Bottom, Top, Near, Far };
+
+		static Frustum FromMatrix(const Matrix<4, 4>& viewProjection);
+
+		Frustum();
+
+		const Plane& plane(const int) const;
+
+		bool contains(const Vector<3>&) const;
+		bool intersects(const Vector<3>& center, float radius) const;
+		bool intersects(const AABB&) const;
+
+		std::size_t cullSpheres(SphereStreams, std::size_t count, std::uint32_t* visible,
+								ThreadPool& pool = ThreadPool::global()) const;
+		std::size_t cullBoxes(BoxStreams, std::size_t count, std::uint32_t* visible,
+							  ThreadPool& pool = ThreadPool::global()) const;
+	};
+
+#pragma endregion
+
+#pragma region Plane
+
+	inline Plane::Plane()
+		: m_normal(), m_distance(0.0f)
+	{
+	}
+
+	inline Plane::Plane(const Vector<3>& normal, float distance)
+		: m_normal(normal), m_distance(distance)
+	{
+	}
+
+	inline const Vector<3>& Plane::normal() const
+	{
+		return m_normal;
+	}
+
+	inline float Plane::distance() const
+	{
+		return m_distance;
+	}
+
+	inline float Plane::signedDistance(const Vector<3>& point) const
+	{
+		return m_normal.dotProduct(point) + m_distance;
+	}
+
+	// A zero normal has no direction to scale, so it is left as it is
+	inline Plane Plane::normalized() const
+	{
+		float length = m_normal.magnitude();
+		if (length == 0.0f)
+			return *this;
+
+		return Plane(m_normal / length, m_distance / length);
+	}
+
+#pragma endregion
+
+#pragma region Frustum
+
+	inline Frustum Frustum::FromMatrix(const Matrix<4, 4>& m)
+	{
+		// Row r of a column-major matrix is m[0][r], m[1][r], m[2][r], m[3][r]
+		auto combine = [&m](int row, float sign)
+		{
+			return Plane(Vector<3>{ m[0][3] + sign * m[0][row], m[1][3] + sign * m[1][row], m[2][3] + sign * m[2][row] },
+						 m[3][3] + sign * m[3][row]).normalized();
+		};
+
+		Frustum frustum;
+		frustum.m_planes[Left] = combine(0, 1.0f);
+		frustum.m_planes[Right] = combine(0, -1.0f);
+		frustum.m_planes[Bottom] = combine(1, 1.0f);
+		frustum.m_planes[Top] = combine(1, -1.0f);
+		frustum.m_planes[Near] = combine(2, 1.0f);
+		frustum.m_planes[Far] = combine(2, -1.0f);
+
+		return frustum;
+	}
+
+	inline Frustum::Frustum()
+	{
+	}
+
+	inline const Plane& Frustum::plane(const int index) const
+	{
+		if (index < 0 || index >= 6)
+			throw std::out_of_range("ERROR: Frustum plane index out of range.");
+
+		return m_planes[index];
+	}
+
+	inline bool Frustum::contains(const Vector<3>& point) const
+	{
+		return intersects(point, 0.0f);
+	}
+
+	inline bool Frustum::intersects(const Vector<3>& center, float radius) const
+	{
+		for (const Plane& plane : m_planes)
+		{
+			if (plane.signedDistance(center) < -radius)
+				return false;
+		}
+
+		return true;
+	}
+
+	// Tests the corner furthest along each plane's normal, which is behind the plane only if the
+	// whole box is
+	inline bool Frustum::intersects(const AABB& box) const
+	{
+		for (const Plane& plane : m_planes)
+		{
+			const Vector<3>& n = plane.normal();
+			Vector<3> corner{ n[0] >= 0 ? box.maximum()[0] : box.minimum()[0],
+							  n[1] >= 0 ? box.maximum()[1] : box.minimum()[1],
+							  n[2] >= 0 ? box.maximum()[2] : box.minimum()[2] };
+
+			if (plane.signedDistance(corner) < 0)
+				return false;
+		}
+
+		return true;
+	}
+
+#pragma endregion
+
+}
+
+#endif
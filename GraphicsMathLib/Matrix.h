@@ -1,10 +1,11 @@
 #ifndef MATRIX_H
-#define MAXRIX_H
+#define MATRIX_H
 
 #include <algorithm>
 #include <iterator>
 
 #include "Vector.h"
+#include "SIMD.h"
 
 namespace GraphicsMath
 {
@@ -43,11 +44,24 @@ namespace GraphicsMath
 			static Matrix::Rotation(Vector)
 
 		Notes:
-			- Matrices are stored in column-major order
-			- The default constructor initializes an identity matrix
-			- Currently, matrices are restricted to square dimensions in the range [2, 4]. This is
-			  sufficient for graphics operations, but more generalized functionality may be added
-			  at a future date.
+			- Matrices are stored in column-major order as one contiguous block of floats inside the
+			  object, 16 byte aligned when the element count allows it. Matrices never allocate, are
+			  trivially copyable, and data() can be handed straight to graphics APIs that expect a
+			  const float*. Moving a matrix is the same as copying it, and neither can throw.
+			- invert() leaves the matrix unchanged when it throws.
+			- operator[] returns a reference to a column, which is a Vector<row> living inside that
+			  block, so m[i][j] reads and writes the matrix in place. Like Vector::operator[], it is
+			  bounds checked only while GRAPHICSMATH_BOUNDS_CHECK is 1. get<c>() and get<c, r>() are
+			  the unchecked column and element accessors, with their indices checked at compile time.
+			- The default constructor initializes an identity matrix, ones on the main diagonal for
+			  matrices that aren't square
+			- Any dimensions of 2 or more are allowed. Matrix<row, n> * Matrix<n, col> gives a
+			  Matrix<row, col>, and transposition() of a Matrix<row, col> is a Matrix<col, row>.
+			  Square only operations (determinant, inverse, *=, transpose) fail to compile for other
+			  shapes. Matrices are stored inline, so keep the large ones off the stack.
+			- Products where every dimension is 16 or more use the cache blocked multiplyBlocked
+			  kernel in SIMD.h. Determinants and inverses past 4x4 use elimination with partial
+			  pivoting.
 			- The static Scale, Translation, Rotation, and Projection methods provide a streamlined way
 			  to construct those matrices. 
 			- The corresponding static inverse() methods can be used on the matrices for greater 
@@ -56,62 +70,94 @@ namespace GraphicsMath
 			  ::ScaleInverse() will return an incorrectly inverted matrix.
 			- Currently this library just handles 3d transformations using 4x4 matrices with the
 			  homogeneous coordinate in the w spot.
+			- Matrix<4, 4> * Matrix<4, 4>, Matrix<4, 4> * Vector<4> and the Matrix<4, 4> inverses run
+			  on the SSE/AVX kernels in SIMD.h when the target supports them.
+			- Everything except Rotation(), PerspectiveProjection() and to_string(), which need the
+			  runtime trigonometric functions, is constexpr. In constant expressions the 4x4 products
+			  and inverses switch to the scalar kernels, so fixed transforms can be computed entirely
+			  at compile time.
+			- affineInverse() inverts a Matrix<4, 4> of the form [R|t; 0 1] (any combination of scale,
+			  rotation, shear and translation) through its 3x3 block. Like the static inverse methods
+			  it trusts the caller: the bottom row is assumed to be [0 0 0 1] and isn't checked.
+			- Quaternion.h holds the quaternion alternative to Rotation(), with conversions to and
+			  from Matrix<4, 4>.
+			- Rotation<MathPolicy::Fast>() and PerspectiveProjection<MathPolicy::Fast>() use the
+			  polynomial sine, cosine and tangent from FastMath.h.
 		TODO:
 			- Provide support for 2 dimensional affine transformations using 3x3 matrices
-			- Add quaternion implementation for rotations
 			- Implement iterator interface
 	*/
 
 	template<int row, int col>
 	class Matrix
 	{
-		static_assert(1 < row && row < 5, "Row dimension must be in range [2, 4]");
-		static_assert(1 < col && col < 5, "Column dimension must be in range [2, 4]");
+		static_assert(1 < row, "Row dimension must be at least 2");
+		static_assert(1 < col, "Column dimension must be at least 2");
 
 	private:
-		std::vector<Vector<row>> m_cols;
+		alignas((row * col) % 4 == 0 ? 16 : alignof(Vector<row>)) Vector<row> m_cols[col];
 		
 		std::string toString() const;
-		void checkValidMatrix() const;
+		constexpr void copyTo(float*) const;
+		constexpr void copyFrom(const float*);
+
+		template<int, int>
+		friend class Matrix;
 
 	public:
-		static Matrix Scale(Vector<row - 1>);
-		static Matrix Translation(Vector<row - 1>);
+		static constexpr Matrix Scale(Vector<row - 1>);
+		static constexpr Matrix Translation(Vector<row - 1>);
+		template<MathPolicy policy = DefaultMathPolicy>
 		static Matrix Rotation(Vector<row-1>, float);
-		static Matrix OrthographicProjection(float, float, float, float, float, float);
+		static constexpr Matrix OrthographicProjection(float, float, float, float, float, float);
+		template<MathPolicy policy = DefaultMathPolicy>
 		static Matrix PerspectiveProjection(float, float, float, float);
 
-		static Matrix ScaleInverse(Matrix);
-		static Matrix TranslationInverse(Matrix);
-		static Matrix RotationInverse(Matrix);
+		static constexpr Matrix ScaleInverse(Matrix);
+		static constexpr Matrix TranslationInverse(Matrix);
+		static constexpr Matrix RotationInverse(Matrix);
+
+		constexpr Matrix();
+		constexpr Matrix(std::initializer_list<Vector<row>>);
+
+		constexpr Vector<row>& operator [](const int);
+		constexpr const Vector<row>& operator [](const int) const;
 
-		Matrix();
-		Matrix(std::initializer_list<Vector<row>>);
+		template<int c>
+		constexpr Vector<row>& get();
+		template<int c>
+		constexpr const Vector<row>& get() const;
+		template<int c, int r>
+		constexpr float& get();
+		template<int c, int r>
+		constexpr const float& get() const;
 
-		Vector<col>& operator [](const int);
-		const Vector<col>& operator [](const int) const;
+		constexpr float* data();
+		constexpr const float* data() const;
 
-		bool operator ==(const Matrix&) const;
+		constexpr bool operator ==(const Matrix&) const;
 
-		Matrix operator +(const Matrix&) const;
-		Matrix operator -(const Matrix&) const;
-		Matrix operator *(const Matrix&) const;
+		constexpr Matrix operator +(const Matrix&) const;
+		constexpr Matrix operator -(const Matrix&) const;
+		template<int count>
+		constexpr Matrix<row, count> operator *(const Matrix<col, count>&) const;
 
-		void operator +=(const Matrix&);
-		void operator -=(const Matrix&);
-		void operator *=(const Matrix&);
+		constexpr void operator +=(const Matrix&);
+		constexpr void operator -=(const Matrix&);
+		constexpr void operator *=(const Matrix&);
 
-		Matrix operator *(float) const;
-		void operator *=(float);
+		constexpr Matrix operator *(float) const;
+		constexpr void operator *=(float);
 
-		Vector<row> operator *(const Vector<col>&) const;
+		constexpr Vector<row> operator *(const Vector<col>&) const;
 
-		float determinant() const;
-		Matrix inverse() const;
-		void invert();
+		constexpr float determinant() const;
+		constexpr Matrix inverse() const;
+		constexpr Matrix affineInverse() const;
+		constexpr void invert();
 
-		Matrix transposition() const;
-		void transpose();
+		constexpr Matrix<col, row> transposition() const;
+		constexpr void transpose();
 
 		std::string to_string() const;
 
@@ -126,7 +172,8 @@ namespace GraphicsMath
 
 #pragma region Transformation Matrix Constructors
 
-	inline Matrix<4, 4> Matrix<4, 4>::Scale(Vector<3> v)
+	template<>
+	constexpr Matrix<4, 4> Matrix<4, 4>::Scale(Vector<3> v)
 	{
 		Matrix<4, 4> result;
 
@@ -136,7 +183,8 @@ namespace GraphicsMath
 		return result;
 	}
 
-	inline Matrix<4, 4> Matrix<4, 4>::Translation(Vector<3> v)
+	template<>
+	constexpr Matrix<4, 4> Matrix<4, 4>::Translation(Vector<3> v)
 	{
 		Matrix<4, 4> result;
 
@@ -146,12 +194,14 @@ namespace GraphicsMath
 		return result;
 	}
 
+	template<>
+	template<MathPolicy policy>
 	inline Matrix<4, 4> Matrix<4, 4>::Rotation(Vector<3> axis, float theta)
 	{
 		Matrix<4, 4> result;
 		
-		float c = cosf(theta);
-		float s = sinf(theta);
+		float c, s;
+		sinCos<policy>(theta, s, c);
 		float oMc = 1.0f - c;
 		float x = axis[0];
 		float y = axis[1];
@@ -168,7 +218,8 @@ namespace GraphicsMath
 
 #pragma region Transformation Matrix Inversion
 
-	inline Matrix<4, 4> Matrix<4, 4>::ScaleInverse(Matrix<4, 4> m)
+	template<>
+	constexpr Matrix<4, 4> Matrix<4, 4>::ScaleInverse(Matrix<4, 4> m)
 	{
 		auto result{ m };
 
@@ -178,7 +229,8 @@ namespace GraphicsMath
 		return result;
 	}
 
-	inline Matrix<4, 4> Matrix<4, 4>::TranslationInverse(Matrix<4, 4> m)
+	template<>
+	constexpr Matrix<4, 4> Matrix<4, 4>::TranslationInverse(Matrix<4, 4> m)
 	{
 		auto result{ m };
 
@@ -188,12 +240,14 @@ namespace GraphicsMath
 		return result;
 	}
 
-	inline Matrix<4, 4> Matrix<4, 4>::RotationInverse(Matrix<4, 4> m)
+	template<>
+	constexpr Matrix<4, 4> Matrix<4, 4>::RotationInverse(Matrix<4, 4> m)
 	{
 		return m.transposition();
 	}
 
-	inline Matrix<4, 4> Matrix<4, 4>::OrthographicProjection(float l, float r, float t, float b, float zN, float zF)
+	template<>
+	constexpr Matrix<4, 4> Matrix<4, 4>::OrthographicProjection(float l, float r, float t, float b, float zN, float zF)
 	{
 		Matrix<4, 4> result;
 
@@ -212,11 +266,13 @@ namespace GraphicsMath
 		return result;
 	}
 
+	template<>
+	template<MathPolicy policy>
 	inline Matrix<4, 4> Matrix<4, 4>::PerspectiveProjection(float fovy, float aspect, float zNear, float zFar)
 	{
 		Matrix<4, 4> result;
 
-		float top = zNear * tanf(fovy * PI / 360.0f);
+		float top = zNear * tangent<policy>(fovy * PI / 360.0f);
 		float bottom = -top;
 		float right = top * aspect;
 		float left = -right;
@@ -242,11 +298,26 @@ namespace GraphicsMath
 
 #pragma region Private Methods
 
+	// Element by element copies to and from a flat column-major array. Unlike data(), these can be
+	// used in constant expressions, where pointer arithmetic can't cross from one column to the next.
 	template<int row, int col>
-	void Matrix<row, col>::checkValidMatrix() const
+	constexpr void Matrix<row, col>::copyTo(float* out) const
 	{
-		if (row != col)
-			throw std::runtime_error("Matrices must be square dimensions");
+		for (int i = 0; i < col; ++i)
+		{
+			for (int j = 0; j < row; ++j)
+				out[i * row + j] = m_cols[i].m_data[j];
+		}
+	}
+
+	template<int row, int col>
+	constexpr void Matrix<row, col>::copyFrom(const float* in)
+	{
+		for (int i = 0; i < col; ++i)
+		{
+			for (int j = 0; j < row; ++j)
+				m_cols[i].m_data[j] = in[i * row + j];
+		}
 	}
 
 	template<int row, int col>
@@ -259,7 +330,7 @@ namespace GraphicsMath
 			result += "[ ";
 			for (int j = 0; j < col; ++j)
 			{
-				result += std::to_string(m_cols[j][i]);
+				result += std::to_string(m_cols[j].m_data[i]);
 				result += (j < col - 1) ? ", " : " ";
 			}
 			result += "]\n";
@@ -273,23 +344,23 @@ namespace GraphicsMath
 #pragma region Constructors
 
 	template<int row, int col>
-	Matrix<row, col>::Matrix()
-		: m_cols{ col, std::initializer_list<float>{} }
+	constexpr Matrix<row, col>::Matrix()
+		: m_cols{}
 	{
-		checkValidMatrix();
-
-		for (int i = 0; i < row; ++i)
-			m_cols[i][i] = 1;
+		for (int i = 0; i < row && i < col; ++i)
+			m_cols[i].m_data[i] = 1;
 	}
 
 	template<int row, int col>
-	Matrix<row, col>::Matrix(std::initializer_list<Vector<row>> args)
+	constexpr Matrix<row, col>::Matrix(std::initializer_list<Vector<row>> args)
+		: m_cols{}
 	{
 		if (args.size() != col)
-			throw std::runtime_error("Matrices must be square dimensions");
+			throw std::runtime_error("Matrix initializer list must have one Vector per column");
 
-		for (auto r : args)
-			m_cols.push_back(Vector<row>{r});
+		int i = 0;
+		for (const auto& arg : args)
+			m_cols[i++] = arg;
 	}
 
 #pragma endregion
@@ -297,18 +368,18 @@ namespace GraphicsMath
 #pragma region Subscript Operators
 
 	template<int row, int col>
-	Vector<col>& Matrix<row, col>::operator [](const int index)
+	constexpr Vector<row>& Matrix<row, col>::operator [](const int index)
 	{
-		if (index < 0 || index >= col)
+		if (GRAPHICSMATH_BOUNDS_CHECK && (index < 0 || index >= col))
 			throw std::out_of_range("ERROR: Attempted to access value out of Matrix range.");
 
 		return m_cols[index];
 	}
 
 	template<int row, int col>
-	const Vector<col>& Matrix<row, col>::operator [](const int index) const
+	constexpr const Vector<row>& Matrix<row, col>::operator [](const int index) const
 	{
-		if (index < 0 || index >= col)
+		if (GRAPHICSMATH_BOUNDS_CHECK && (index < 0 || index >= col))
 			throw std::out_of_range("ERROR: Attempted to access value out of Matrix range.");
 
 		return m_cols[index];
@@ -316,14 +387,76 @@ namespace GraphicsMath
 
 #pragma endregion
 
+#pragma region Unchecked Accessors
+
+	template<int row, int col>
+	template<int c>
+	constexpr Vector<row>& Matrix<row, col>::get()
+	{
+		static_assert(0 <= c && c < col, "Matrix column out of range");
+
+		return m_cols[c];
+	}
+
+	template<int row, int col>
+	template<int c>
+	constexpr const Vector<row>& Matrix<row, col>::get() const
+	{
+		static_assert(0 <= c && c < col, "Matrix column out of range");
+
+		return m_cols[c];
+	}
+
+	template<int row, int col>
+	template<int c, int r>
+	constexpr float& Matrix<row, col>::get()
+	{
+		static_assert(0 <= c && c < col, "Matrix column out of range");
+		static_assert(0 <= r && r < row, "Matrix row out of range");
+
+		return m_cols[c].m_data[r];
+	}
+
+	template<int row, int col>
+	template<int c, int r>
+	constexpr const float& Matrix<row, col>::get() const
+	{
+		static_assert(0 <= c && c < col, "Matrix column out of range");
+		static_assert(0 <= r && r < row, "Matrix row out of range");
+
+		return m_cols[c].m_data[r];
+	}
+
+#pragma endregion
+
+#pragma region Raw Data Access
+
+	template<int row, int col>
+	constexpr float* Matrix<row, col>::data()
+	{
+		static_assert(sizeof(m_cols) == row * col * sizeof(float), "Matrix columns must be tightly packed");
+
+		return m_cols[0].begin();
+	}
+
+	template<int row, int col>
+	constexpr const float* Matrix<row, col>::data() const
+	{
+		static_assert(sizeof(m_cols) == row * col * sizeof(float), "Matrix columns must be tightly packed");
+
+		return m_cols[0].begin();
+	}
+
+#pragma endregion
+
 #pragma region Comparison Operators
 
 	template<int row, int col>
-	bool Matrix<row, col>::operator ==(const Matrix& m) const
+	constexpr bool Matrix<row, col>::operator ==(const Matrix& m) const
 	{
-		for (int i = 0; i < row; ++i)
+		for (int i = 0; i < col; ++i)
 		{
-			if (m_cols[i] != m[i])
+			if (m_cols[i] != m.m_cols[i])
 				return false;
 		}
 
@@ -335,42 +468,55 @@ namespace GraphicsMath
 #pragma region Matrix Addtion, Subtraction, & Multiplication
 
 	template<int row, int col>
-	Matrix<row, col> Matrix<row, col>::operator +(const Matrix<row, col>& m) const
+	constexpr Matrix<row, col> Matrix<row, col>::operator +(const Matrix<row, col>& m) const
 	{
 		Matrix<row, col> result;
 	
-		for (int i = 0; i < row; i++)
-			result[i] = m_cols[i] + m[i];
+		for (int i = 0; i < col; i++)
+			result.m_cols[i] = m_cols[i] + m.m_cols[i];
 		
 		return result;
 	}
 
 	template<int row, int col>
-	Matrix<row, col> Matrix<row, col>::operator -(const Matrix<row, col>& m) const
+	constexpr Matrix<row, col> Matrix<row, col>::operator -(const Matrix<row, col>& m) const
 	{
 		Matrix<row, col> result;
 
-		for (int i = 0; i < row; i++)
-			result[i] = m_cols[i] - m[i];
+		for (int i = 0; i < col; i++)
+			result.m_cols[i] = m_cols[i] - m.m_cols[i];
 
 		return result;
 	}
 
 	template<int row, int col>
-	Matrix<row, col> Matrix<row, col>::operator *(const Matrix<row, col>& m) const
+	template<int count>
+	constexpr Matrix<row, count> Matrix<row, col>::operator *(const Matrix<col, count>& m) const
 	{
-		Matrix<row, col> result;
+		Matrix<row, count> result;
 
-		for (int i = 0; i < row; ++i)
+		// Past a few thousand multiply-adds the packing done by the blocked kernel pays for itself
+		if constexpr (row >= 16 && col >= 16 && count >= 16)
 		{
-			for (int j = 0; j < col; ++j)
+			if (!GRAPHICSMATH_CONSTANT_EVALUATED())
 			{
-				float sum = 0;
+				SIMD::multiplyBlocked(data(), m.data(), result.data(), row, col, count);
+				return result;
+			}
+		}
 
-				for (int k = 0; k < col; ++k)
-					sum += m_cols[k][j] * m[i][k];
+		// Each column of the result is a combination of the columns of this matrix
+		for (int i = 0; i < count; ++i)
+		{
+			for (int j = 0; j < row; ++j)
+				result.m_cols[i].m_data[j] = m_cols[0].m_data[j] * m.m_cols[i].m_data[0];
+
+			for (int k = 1; k < col; ++k)
+			{
+				float s = m.m_cols[i].m_data[k];
 
-				result[i][j] = sum;
+				for (int j = 0; j < row; ++j)
+					result.m_cols[i].m_data[j] += m_cols[k].m_data[j] * s;
 			}
 		}
 
@@ -378,54 +524,93 @@ namespace GraphicsMath
 	}
 
 	template<int row, int col>
-	void Matrix<row, col>::operator +=(const Matrix<row, col>& m)
+	constexpr void Matrix<row, col>::operator +=(const Matrix<row, col>& m)
 	{
-		for (int i = 0; i < row; i++)
-			m_cols[i] += m[i];
+		for (int i = 0; i < col; i++)
+			m_cols[i] += m.m_cols[i];
 	}
 
 	template<int row, int col>
-	void Matrix<row, col>::operator -=(const Matrix<row, col>& m)
+	constexpr void Matrix<row, col>::operator -=(const Matrix<row, col>& m)
 	{
-		for (int i = 0; i < row; i++)
-			m_cols[i] -= m[i];
+		for (int i = 0; i < col; i++)
+			m_cols[i] -= m.m_cols[i];
 	}
 
 	template<int row, int col>
-	void Matrix<row, col>::operator *=(const Matrix<row, col>& m)
+	constexpr void Matrix<row, col>::operator *=(const Matrix<row, col>& m)
 	{
+		static_assert(row == col, "Only square matrices can be multiplied in place");
+
 		*this = *this * m;
 	}
 
 	template<int row, int col>
-	Vector<row> Matrix<row, col>::operator *(const Vector<col>& v) const
+	constexpr Vector<row> Matrix<row, col>::operator *(const Vector<col>& v) const
+	{
+		Vector<row> result;
+
+		for (int j = 0; j < col; ++j)
+		{
+			for (int i = 0; i < row; ++i)
+				result.m_data[i] += v.m_data[j] * m_cols[j].m_data[i];
+		}
+
+		return result;
+	}
+
+	template<>
+	template<>
+	constexpr Matrix<4, 4> Matrix<4, 4>::operator *(const Matrix<4, 4>& m) const
+	{
+		Matrix<4, 4> result;
+
+		if (GRAPHICSMATH_CONSTANT_EVALUATED())
+		{
+			float a[16]{}, b[16]{}, out[16]{};
+			copyTo(a);
+			m.copyTo(b);
+			SIMD::Scalar::multiply4x4(a, b, out);
+			result.copyFrom(out);
+		}
+		else
+			SIMD::multiply4x4(data(), m.data(), result.data());
+
+		return result;
+	}
+
+	template<>
+	constexpr Vector<4> Matrix<4, 4>::operator *(const Vector<4>& v) const
 	{
-		Vector<col> result;
+		Vector<4> result;
 
-		for (int j = 0; j < row; ++j)
+		if (GRAPHICSMATH_CONSTANT_EVALUATED())
 		{
-			for (int i = 0; i < col; ++i)
-				result[i] += v[j] * m_cols[j][i];
+			float m[16]{};
+			copyTo(m);
+			SIMD::Scalar::transform4x4(m, v.begin(), result.begin());
 		}
+		else
+			SIMD::transform4x4(data(), v.begin(), result.begin());
 
 		return result;
 	}
 
 	template<int row, int col>
-	Matrix<row, col> Matrix<row, col>::operator *(float s) const
+	constexpr Matrix<row, col> Matrix<row, col>::operator *(float s) const
 	{
 		auto result{ *this };
 
-		for (int i = 0; i < row; ++i)
-			result[i] *= s;
+		for (int i = 0; i < col; ++i)
+			result.m_cols[i] *= s;
 		
 		return result;
 	}
 
 	template<int row, int col>
-	void Matrix<row, col>::operator *=(float s)
+	constexpr void Matrix<row, col>::operator *=(float s)
 	{
-		for (int i = 0; i < row; ++i)
+		for (int i = 0; i < col; ++i)
 			m_cols[i] *= s;
 	}
 
@@ -433,126 +618,243 @@ namespace GraphicsMath
 
 #pragma region Determinant
 
-	inline float Matrix<2, 2>::determinant() const
+	// Matrices past 4x4 are reduced to triangular form with partial pivoting
+	template<int row, int col>
+	constexpr float Matrix<row, col>::determinant() const
 	{
-		return m_cols[0][0] * m_cols[1][1] - m_cols[0][1] * m_cols[1][0];
+		static_assert(row == col, "Only square matrices have a determinant");
+
+		auto m{ *this };
+		float det = 1;
+
+		for (int c = 0; c < col; ++c)
+		{
+			int pivot = c;
+			for (int r = c + 1; r < row; ++r)
+			{
+				float candidate = m.m_cols[c].m_data[r];
+				float best = m.m_cols[c].m_data[pivot];
+
+				if ((candidate < 0 ? -candidate : candidate) > (best < 0 ? -best : best))
+					pivot = r;
+			}
+
+			if (m.m_cols[c].m_data[pivot] == 0)
+				return 0;
+
+			if (pivot != c)
+			{
+				for (int k = c; k < col; ++k)
+				{
+					float t = m.m_cols[k].m_data[c];
+					m.m_cols[k].m_data[c] = m.m_cols[k].m_data[pivot];
+					m.m_cols[k].m_data[pivot] = t;
+				}
+
+				det = -det;
+			}
+
+			det *= m.m_cols[c].m_data[c];
+
+			for (int k = c + 1; k < col; ++k)
+			{
+				float f = m.m_cols[k].m_data[c] / m.m_cols[c].m_data[c];
+
+				for (int r = c + 1; r < row; ++r)
+					m.m_cols[k].m_data[r] -= f * m.m_cols[c].m_data[r];
+			}
+		}
+
+		return det;
+	}
+
+	template<>
+	constexpr float Matrix<2, 2>::determinant() const
+	{
+		return m_cols[0].m_data[0] * m_cols[1].m_data[1] - m_cols[0].m_data[1] * m_cols[1].m_data[0];
 	}
 
-	inline float Matrix<3, 3>::determinant() const
+	template<>
+	constexpr float Matrix<3, 3>::determinant() const
 	{
-		return m_cols[0][0] * m_cols[1][1] * m_cols[2][2] + m_cols[0][1] * m_cols[1][2] * m_cols[2][0] +
-			   m_cols[0][2] * m_cols[1][0] * m_cols[2][1] - m_cols[0][0] * m_cols[1][2] * m_cols[2][1] -
-			   m_cols[0][2] * m_cols[1][1] * m_cols[2][0] - m_cols[0][1] * m_cols[1][0] * m_cols[2][2];
+		return m_cols[0].m_data[0] * m_cols[1].m_data[1] * m_cols[2].m_data[2] + m_cols[0].m_data[1] * m_cols[1].m_data[2] * m_cols[2].m_data[0] +
+			   m_cols[0].m_data[2] * m_cols[1].m_data[0] * m_cols[2].m_data[1] - m_cols[0].m_data[0] * m_cols[1].m_data[2] * m_cols[2].m_data[1] -
+			   m_cols[0].m_data[2] * m_cols[1].m_data[1] * m_cols[2].m_data[0] - m_cols[0].m_data[1] * m_cols[1].m_data[0] * m_cols[2].m_data[2];
 	}
 
-	inline float Matrix<4, 4>::determinant() const
+	template<>
+	constexpr float Matrix<4, 4>::determinant() const
 	{
 		return
-			m_cols[0][0] * m_cols[1][1] * m_cols[2][2] * m_cols[3][3] + m_cols[0][0] * m_cols[2][1] * m_cols[3][2] * m_cols[1][3] +
-			m_cols[0][0] * m_cols[3][1] * m_cols[1][2] * m_cols[2][3] + m_cols[1][0] * m_cols[0][1] * m_cols[3][2] * m_cols[2][3] +
-			m_cols[1][0] * m_cols[2][1] * m_cols[0][2] * m_cols[3][3] + m_cols[1][0] * m_cols[3][1] * m_cols[2][2] * m_cols[0][3] +
-			m_cols[2][0] * m_cols[0][1] * m_cols[1][2] * m_cols[3][3] + m_cols[2][0] * m_cols[1][1] * m_cols[3][2] * m_cols[0][3] +
-			m_cols[2][0] * m_cols[3][1] * m_cols[0][2] * m_cols[1][3] + m_cols[3][0] * m_cols[0][1] * m_cols[2][2] * m_cols[1][3] +
-			m_cols[3][0] * m_cols[1][1] * m_cols[0][2] * m_cols[2][3] + m_cols[3][0] * m_cols[2][1] * m_cols[1][2] * m_cols[0][3] -
-			m_cols[0][0] * m_cols[1][1] * m_cols[3][2] * m_cols[2][3] - m_cols[0][0] * m_cols[2][1] * m_cols[1][2] * m_cols[3][3] -
-			m_cols[0][0] * m_cols[3][1] * m_cols[2][2] * m_cols[1][3] - m_cols[1][0] * m_cols[0][1] * m_cols[2][2] * m_cols[3][3] -
-			m_cols[1][0] * m_cols[2][1] * m_cols[3][2] * m_cols[0][3] - m_cols[1][0] * m_cols[3][1] * m_cols[0][2] * m_cols[2][3] -
-			m_cols[2][0] * m_cols[0][1] * m_cols[3][2] * m_cols[1][3] - m_cols[2][0] * m_cols[1][1] * m_cols[0][2] * m_cols[3][3] -
-			m_cols[2][0] * m_cols[3][1] * m_cols[1][2] * m_cols[0][3] - m_cols[3][0] * m_cols[0][1] * m_cols[1][2] * m_cols[2][3] -
-			m_cols[3][0] * m_cols[1][1] * m_cols[2][2] * m_cols[0][3] - m_cols[3][0] * m_cols[2][1] * m_cols[0][2] * m_cols[1][3];
+			m_cols[0].m_data[0] * m_cols[1].m_data[1] * m_cols[2].m_data[2] * m_cols[3].m_data[3] + m_cols[0].m_data[0] * m_cols[2].m_data[1] * m_cols[3].m_data[2] * m_cols[1].m_data[3] +
+			m_cols[0].m_data[0] * m_cols[3].m_data[1] * m_cols[1].m_data[2] * m_cols[2].m_data[3] + m_cols[1].m_data[0] * m_cols[0].m_data[1] * m_cols[3].m_data[2] * m_cols[2].m_data[3] +
+			m_cols[1].m_data[0] * m_cols[2].m_data[1] * m_cols[0].m_data[2] * m_cols[3].m_data[3] + m_cols[1].m_data[0] * m_cols[3].m_data[1] * m_cols[2].m_data[2] * m_cols[0].m_data[3] +
+			m_cols[2].m_data[0] * m_cols[0].m_data[1] * m_cols[1].m_data[2] * m_cols[3].m_data[3] + m_cols[2].m_data[0] * m_cols[1].m_data[1] * m_cols[3].m_data[2] * m_cols[0].m_data[3] +
+			m_cols[2].m_data[0] * m_cols[3].m_data[1] * m_cols[0].m_data[2] * m_cols[1].m_data[3] + m_cols[3].m_data[0] * m_cols[0].m_data[1] * m_cols[2].m_data[2] * m_cols[1].m_data[3] +
+			m_cols[3].m_data[0] * m_cols[1].m_data[1] * m_cols[0].m_data[2] * m_cols[2].m_data[3] + m_cols[3].m_data[0] * m_cols[2].m_data[1] * m_cols[1].m_data[2] * m_cols[0].m_data[3] -
+			m_cols[0].m_data[0] * m_cols[1].m_data[1] * m_cols[3].m_data[2] * m_cols[2].m_data[3] - m_cols[0].m_data[0] * m_cols[2].m_data[1] * m_cols[1].m_data[2] * m_cols[3].m_data[3] -
+			m_cols[0].m_data[0] * m_cols[3].m_data[1] * m_cols[2].m_data[2] * m_cols[1].m_data[3] - m_cols[1].m_data[0] * m_cols[0].m_data[1] * m_cols[2].m_data[2] * m_cols[3].m_data[3] -
+			m_cols[1].m_data[0] * m_cols[2].m_data[1] * m_cols[3].m_data[2] * m_cols[0].m_data[3] - m_cols[1].m_data[0] * m_cols[3].m_data[1] * m_cols[0].m_data[2] * m_cols[2].m_data[3] -
+			m_cols[2].m_data[0] * m_cols[0].m_data[1] * m_cols[3].m_data[2] * m_cols[1].m_data[3] - m_cols[2].m_data[0] * m_cols[1].m_data[1] * m_cols[0].m_data[2] * m_cols[3].m_data[3] -
+			m_cols[2].m_data[0] * m_cols[3].m_data[1] * m_cols[1].m_data[2] * m_cols[0].m_data[3] - m_cols[3].m_data[0] * m_cols[0].m_data[1] * m_cols[1].m_data[2] * m_cols[2].m_data[3] -
+			m_cols[3].m_data[0] * m_cols[1].m_data[1] * m_cols[2].m_data[2] * m_cols[0].m_data[3] - m_cols[3].m_data[0] * m_cols[2].m_data[1] * m_cols[0].m_data[2] * m_cols[1].m_data[3];
 	}
 
 #pragma endregion
 
 #pragma region Inversion
 
-	inline Matrix<2, 2> Matrix<2, 2>::inverse() const
+	// Gauss-Jordan elimination with partial pivoting for matrices past 4x4
+	template<int row, int col>
+	constexpr Matrix<row, col> Matrix<row, col>::inverse() const
+	{
+		static_assert(row == col, "Only square matrices can be inverted");
+
+		auto m{ *this };
+		Matrix<row, col> result;
+
+		for (int c = 0; c < col; ++c)
+		{
+			int pivot = c;
+			for (int r = c + 1; r < row; ++r)
+			{
+				float candidate = m.m_cols[c].m_data[r];
+				float best = m.m_cols[c].m_data[pivot];
+
+				if ((candidate < 0 ? -candidate : candidate) > (best < 0 ? -best : best))
+					pivot = r;
+			}
+
+			if (m.m_cols[c].m_data[pivot] == 0)
+				throw std::runtime_error("ERROR: Matrix cannot be inverted.");
+
+			for (int k = 0; k < col; ++k)
+			{
+				float t = m.m_cols[k].m_data[c];
+				m.m_cols[k].m_data[c] = m.m_cols[k].m_data[pivot];
+				m.m_cols[k].m_data[pivot] = t;
+
+				t = result.m_cols[k].m_data[c];
+				result.m_cols[k].m_data[c] = result.m_cols[k].m_data[pivot];
+				result.m_cols[k].m_data[pivot] = t;
+			}
+
+			float scale = 1.0f / m.m_cols[c].m_data[c];
+			for (int k = 0; k < col; ++k)
+			{
+				m.m_cols[k].m_data[c] *= scale;
+				result.m_cols[k].m_data[c] *= scale;
+			}
+
+			for (int r = 0; r < row; ++r)
+			{
+				float f = m.m_cols[c].m_data[r];
+				if (r == c || f == 0)
+					continue;
+
+				for (int k = 0; k < col; ++k)
+				{
+					m.m_cols[k].m_data[r] -= f * m.m_cols[k].m_data[c];
+					result.m_cols[k].m_data[r] -= f * result.m_cols[k].m_data[c];
+				}
+			}
+		}
+
+		return result;
+	}
+
+	template<>
+	constexpr Matrix<2, 2> Matrix<2, 2>::inverse() const
 	{
 		float det = determinant();
 
 		if (det == 0)
-			throw std::exception("ERROR: Matrix cannot be inverted.");
+			throw std::runtime_error("ERROR: Matrix cannot be inverted.");
 
-		auto m = Matrix<2, 2>{ Vector<2>{m_cols[1][1], -m_cols[0][1]}, 
-							   Vector<2>{-m_cols[1][0], m_cols[0][0]} };
+		auto m = Matrix<2, 2>{ Vector<2>{m_cols[1].m_data[1], -m_cols[0].m_data[1]}, 
+							   Vector<2>{-m_cols[1].m_data[0], m_cols[0].m_data[0]} };
 		m *= 1.0f / det;
 
 		return m;
 	}
 
-	inline Matrix<3, 3> Matrix<3, 3>::inverse() const
+	template<>
+	constexpr Matrix<3, 3> Matrix<3, 3>::inverse() const
 	{
 		float det = determinant();
 
 		if (det == 0)
-			throw std::exception("ERROR: Matrix cannot be inverted.");
-
-		auto m = Matrix<3, 3>{ Vector<3>{m_cols[1][1] * m_cols[2][2] - m_cols[2][1] * m_cols[1][2],
-										 m_cols[2][1] * m_cols[0][2] - m_cols[0][1] * m_cols[2][2],
-										 m_cols[0][1] * m_cols[1][2] - m_cols[1][1] * m_cols[0][2]},
-							   Vector<3>{m_cols[2][0] * m_cols[1][2] - m_cols[1][0] * m_cols[2][2],
-										 m_cols[0][0] * m_cols[2][2] - m_cols[2][0] * m_cols[0][2],
-										 m_cols[1][0] * m_cols[0][2] - m_cols[0][0] * m_cols[1][2]},
-							   Vector<3>{m_cols[1][0] * m_cols[2][1] - m_cols[2][0] * m_cols[1][1],
-										 m_cols[2][0] * m_cols[0][1] - m_cols[0][0] * m_cols[2][1],
-										 m_cols[0][0] * m_cols[1][1] - m_cols[1][0] * m_cols[0][1]} };
+			throw std::runtime_error("ERROR: Matrix cannot be inverted.");
+
+		auto m = Matrix<3, 3>{ Vector<3>{m_cols[1].m_data[1] * m_cols[2].m_data[2] - m_cols[2].m_data[1] * m_cols[1].m_data[2],
+										 m_cols[2].m_data[1] * m_cols[0].m_data[2] - m_cols[0].m_data[1] * m_cols[2].m_data[2],
+										 m_cols[0].m_data[1] * m_cols[1].m_data[2] - m_cols[1].m_data[1] * m_cols[0].m_data[2]},
+							   Vector<3>{m_cols[2].m_data[0] * m_cols[1].m_data[2] - m_cols[1].m_data[0] * m_cols[2].m_data[2],
+										 m_cols[0].m_data[0] * m_cols[2].m_data[2] - m_cols[2].m_data[0] * m_cols[0].m_data[2],
+										 m_cols[1].m_data[0] * m_cols[0].m_data[2] - m_cols[0].m_data[0] * m_cols[1].m_data[2]},
+							   Vector<3>{m_cols[1].m_data[0] * m_cols[2].m_data[1] - m_cols[2].m_data[0] * m_cols[1].m_data[1],
+										 m_cols[2].m_data[0] * m_cols[0].m_data[1] - m_cols[0].m_data[0] * m_cols[2].m_data[1],
+										 m_cols[0].m_data[0] * m_cols[1].m_data[1] - m_cols[1].m_data[0] * m_cols[0].m_data[1]} };
 		
 		m *= 1.0f / det;
 
 		return m;
 	}
 
-	inline Matrix<4, 4> Matrix<4, 4>::inverse() const
+	template<>
+	constexpr Matrix<4, 4> Matrix<4, 4>::inverse() const
 	{
-		float det = determinant();
+		Matrix<4, 4> result;
+		float det = 0;
+
+		if (GRAPHICSMATH_CONSTANT_EVALUATED())
+		{
+			float m[16]{}, out[16]{};
+			copyTo(m);
+			det = SIMD::Scalar::inverse4x4(m, out);
+			result.copyFrom(out);
+		}
+		else
+			det = SIMD::inverse4x4(data(), result.data());
 
 		if (det == 0)
-			throw std::exception("ERROR: Matrix cannot be inverted.");
-
-		auto m = Matrix<4, 4>{
-					Vector<4>{m_cols[1][1] * m_cols[2][2] * m_cols[3][3] + m_cols[2][1] * m_cols[3][2] * m_cols[1][3] + m_cols[3][1] * m_cols[1][2] * m_cols[2][3] -
-							  m_cols[1][1] * m_cols[3][2] * m_cols[2][3] - m_cols[2][1] * m_cols[1][2] * m_cols[3][3] - m_cols[3][1] * m_cols[2][2] * m_cols[1][3],
-							  m_cols[0][1] * m_cols[3][2] * m_cols[2][3] + m_cols[2][1] * m_cols[0][2] * m_cols[3][3] + m_cols[3][1] * m_cols[2][2] * m_cols[0][3] -
-							  m_cols[0][1] * m_cols[2][2] * m_cols[3][3] - m_cols[2][1] * m_cols[3][2] * m_cols[0][3] - m_cols[3][1] * m_cols[0][2] * m_cols[2][3],
-							  m_cols[0][1] * m_cols[1][2] * m_cols[3][3] + m_cols[1][1] * m_cols[3][2] * m_cols[0][3] + m_cols[3][1] * m_cols[0][2] * m_cols[1][3] -
-							  m_cols[0][1] * m_cols[3][2] * m_cols[1][3] - m_cols[1][1] * m_cols[0][2] * m_cols[3][3] - m_cols[3][1] * m_cols[1][2] * m_cols[0][3],
-							  m_cols[0][1] * m_cols[2][2] * m_cols[1][3] + m_cols[1][1] * m_cols[0][2] * m_cols[2][3] + m_cols[2][1] * m_cols[1][2] * m_cols[0][3] -
-							  m_cols[0][1] * m_cols[1][2] * m_cols[2][3] - m_cols[1][1] * m_cols[2][2] * m_cols[0][3] - m_cols[2][1] * m_cols[0][2] * m_cols[1][3]},
-
-					Vector<4>{m_cols[1][0] * m_cols[3][2] * m_cols[2][3] + m_cols[2][0] * m_cols[1][2] * m_cols[3][3] + m_cols[3][0] * m_cols[2][2] * m_cols[1][3] -
-							  m_cols[1][0] * m_cols[2][2] * m_cols[3][3] - m_cols[2][0] * m_cols[3][2] * m_cols[1][3] - m_cols[3][0] * m_cols[1][2] * m_cols[2][3],
-							  m_cols[0][0] * m_cols[2][2] * m_cols[3][3] + m_cols[2][0] * m_cols[3][2] * m_cols[0][3] + m_cols[3][0] * m_cols[0][2] * m_cols[2][3] -
-							  m_cols[0][0] * m_cols[3][2] * m_cols[2][3] - m_cols[2][0] * m_cols[0][2] * m_cols[3][3] - m_cols[3][0] * m_cols[2][2] * m_cols[0][3],
-							  m_cols[0][0] * m_cols[3][2] * m_cols[1][3] + m_cols[1][0] * m_cols[0][2] * m_cols[3][3] + m_cols[3][0] * m_cols[1][2] * m_cols[0][3] -
-							  m_cols[0][0] * m_cols[1][2] * m_cols[3][3] - m_cols[1][0] * m_cols[3][2] * m_cols[0][3] - m_cols[3][0] * m_cols[0][2] * m_cols[1][3],
-							  m_cols[0][0] * m_cols[1][2] * m_cols[2][3] + m_cols[1][0] * m_cols[2][2] * m_cols[0][3] + m_cols[2][0] * m_cols[0][2] * m_cols[1][3] -
-							  m_cols[0][0] * m_cols[2][2] * m_cols[1][3] - m_cols[1][0] * m_cols[0][2] * m_cols[2][3] - m_cols[2][0] * m_cols[1][2] * m_cols[0][3]},
-
-					Vector<4>{m_cols[1][0] * m_cols[2][1] * m_cols[3][3] + m_cols[2][0] * m_cols[3][1] * m_cols[1][3] + m_cols[3][0] * m_cols[1][1] * m_cols[2][3] -
-							  m_cols[1][0] * m_cols[3][1] * m_cols[2][3] - m_cols[2][0] * m_cols[1][1] * m_cols[3][3] - m_cols[3][0] * m_cols[2][1] * m_cols[1][3],
-							  m_cols[0][0] * m_cols[3][1] * m_cols[2][3] + m_cols[2][0] * m_cols[0][1] * m_cols[3][3] + m_cols[3][0] * m_cols[2][1] * m_cols[0][3] -
-							  m_cols[0][0] * m_cols[2][1] * m_cols[3][3] - m_cols[2][0] * m_cols[3][1] * m_cols[0][3] - m_cols[3][0] * m_cols[0][1] * m_cols[2][3],
-							  m_cols[0][0] * m_cols[1][1] * m_cols[3][3] + m_cols[1][0] * m_cols[3][1] * m_cols[0][3] + m_cols[3][0] * m_cols[0][1] * m_cols[1][3] -
-							  m_cols[0][0] * m_cols[3][1] * m_cols[1][3] - m_cols[1][0] * m_cols[0][1] * m_cols[3][3] - m_cols[3][0] * m_cols[1][1] * m_cols[0][3],
-							  m_cols[0][0] * m_cols[2][1] * m_cols[1][3] + m_cols[1][0] * m_cols[0][1] * m_cols[2][3] + m_cols[2][0] * m_cols[1][1] * m_cols[0][3] -
-							  m_cols[0][0] * m_cols[1][1] * m_cols[2][3] - m_cols[1][0] * m_cols[2][1] * m_cols[0][3] - m_cols[2][0] * m_cols[0][1] * m_cols[1][3]},
-
-					Vector<4>{m_cols[1][0] * m_cols[3][1] * m_cols[2][2] + m_cols[2][0] * m_cols[1][1] * m_cols[3][2] + m_cols[3][0] * m_cols[2][1] * m_cols[1][2] -
-							  m_cols[1][0] * m_cols[2][1] * m_cols[3][2] - m_cols[2][0] * m_cols[3][1] * m_cols[1][2] - m_cols[3][0] * m_cols[1][1] * m_cols[2][2],
-							  m_cols[0][0] * m_cols[2][1] * m_cols[3][2] + m_cols[2][0] * m_cols[3][1] * m_cols[0][2] + m_cols[3][0] * m_cols[0][1] * m_cols[2][2] -
-							  m_cols[0][0] * m_cols[3][1] * m_cols[2][2] - m_cols[2][0] * m_cols[0][1] * m_cols[3][2] - m_cols[3][0] * m_cols[2][1] * m_cols[0][2],
-							  m_cols[0][0] * m_cols[3][1] * m_cols[1][2] + m_cols[1][0] * m_cols[0][1] * m_cols[3][2] + m_cols[3][0] * m_cols[1][1] * m_cols[0][2] -
-							  m_cols[0][0] * m_cols[1][1] * m_cols[3][2] - m_cols[1][0] * m_cols[3][1] * m_cols[0][2] - m_cols[3][0] * m_cols[0][1] * m_cols[1][2],
-							  m_cols[0][0] * m_cols[1][1] * m_cols[2][2] + m_cols[1][0] * m_cols[2][1] * m_cols[0][2] + m_cols[2][0] * m_cols[0][1] * m_cols[1][2] -
-							  m_cols[0][0] * m_cols[2][1] * m_cols[1][2] - m_cols[1][0] * m_cols[0][1] * m_cols[2][2] - m_cols[2][0] * m_cols[1][1] * m_cols[0][2]} };
+			throw std::runtime_error("ERROR: Matrix cannot be inverted.");
 
-		m *= 1.0f / det;
+		return result;
+	}
 
-		return m;
+	template<int row, int col>
+	constexpr Matrix<row, col> Matrix<row, col>::affineInverse() const
+	{
+		static_assert(row == 4 && col == 4, "affineInverse() is only defined for Matrix<4, 4>");
+
+		return *this;
+	}
+
+	template<>
+	constexpr Matrix<4, 4> Matrix<4, 4>::affineInverse() const
+	{
+		Matrix<4, 4> result;
+		float det = 0;
+
+		if (GRAPHICSMATH_CONSTANT_EVALUATED())
+		{
+			float m[16]{}, out[16]{};
+			copyTo(m);
+			det = SIMD::Scalar::affineInverse4x4(m, out);
+			result.copyFrom(out);
+		}
+		else
+			det = SIMD::affineInverse4x4(data(), result.data());
+
+		if (det == 0)
+			throw std::runtime_error("ERROR: Matrix cannot be inverted.");
+
+		return result;
 	}
 
 	template<int row, int col>
-	void  Matrix<row, col>::invert()
+	constexpr void  Matrix<row, col>::invert()
 	{
 		*this = inverse();
 	}
@@ -562,22 +864,24 @@ namespace GraphicsMath
 #pragma region Transpose
 
 	template<int row, int col>
-	Matrix<row, col> Matrix<row, col>::transposition() const
+	constexpr Matrix<col, row> Matrix<row, col>::transposition() const
 	{
-		Matrix<row, col> result;
+		Matrix<col, row> result;
 
-		for (int i = 0; i < col; ++i)
+		for (int i = 0; i < row; ++i)
 		{
-			for (int j = 0; j < row; ++j)
-				result[i][j] = m_cols[j][i];
+			for (int j = 0; j < col; ++j)
+				result.m_cols[i].m_data[j] = m_cols[j].m_data[i];
 		}
 
 		return result;
 	}
 
 	template<int row, int col>
-	void Matrix<row, col>::transpose()
+	constexpr void Matrix<row, col>::transpose()
 	{
+		static_assert(row == col, "Only square matrices can be transposed in place");
+
 		*this = transposition();
 	}
 
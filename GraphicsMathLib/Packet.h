@@ -0,0 +1,1072 @@
+#ifndef PACKET_H
+#define PACKET_H
+
+#include <initializer_list>
+
+#include "Matrix.h"
+#include "SIMD.h"
+
+namespace GraphicsMath
+{
+
+#pragma region Packet Class Definitions
+
+	/* -------------------------------------------------------------------------------------------------
+		Copyright 2017 Shealyn Tate Hindenlang
+
+		Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+		and associated documentation files (the "Software"), to deal in the Software without restriction,
+		including without limitation the rights to use, copy, modify, merge, publish, distribute,
+		sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+		furnished to do so, subject to the following conditions:
+
+		The above copyright notice and this permission notice shall be included in all copies or
+		substantial portions of the Software.
+
+		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+		BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+		NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+		DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+		-------------------------------------------------------------------------------------------------
+
+		Packets hold eight vectors or matrices at once, one lane each, so that eight rays or shading
+		samples go through the same math in the same instructions. Float8 is eight floats and Mask8
+		the result of comparing two of them. VectorPacket<size> is a Vector<size> whose components
+		are Float8 (Vector2x8, Vector3x8 and Vector4x8), and Matrix4x4Batch is a Matrix<4, 4> whose
+		columns are Vector4x8.
+
+		Constructors:
+			Float8(f)							every lane f
+			VectorPacket<size>(v)				every lane the Vector<size> v
+			VectorPacket<size>{ x, y, z }		components from Float8s
+			static VectorPacket::Load(vectors)			eight consecutive vectors
+			static VectorPacket::Gather(vectors, indices)	vectors[indices[0]] ... vectors[indices[7]]
+			Matrix4x4Batch(m)					every lane the Matrix<4, 4> m
+			static Matrix4x4Batch::Load(matrices)
+
+		Methods:
+			select(mask, a, b)				a in the lanes where mask is set, b elsewhere
+			mask.any(), all(), none()		for leaving a loop once every lane is done
+			packet.store(vectors)			writes the eight lanes back
+			packet.scatter(vectors, indices, mask)	writes only the lanes where mask is set
+
+		Usage:
+			Vector3x8 origin(camera), direction = Vector3x8::Gather(directions, rayIds);
+			direction.normalize();
+			Float8 t = (center - origin).dotProduct(direction);
+			Mask8 hit = t > Float8(0) & ...;
+			select(hit, t, closest).store(distances);
+
+		Notes:
+			- The methods mirror Vector<size> and Matrix<4, 4> lane for lane, so a scalar routine
+			  ports to packets by changing its types. Comparisons return a Mask8 instead of bool;
+			  packet == packet is set in the lanes where every component is equal.
+			- The lanes are one AVX register with AVX, two SSE registers with SSE, and eight floats
+			  otherwise. The backend is picked at compile time like the rest of SIMD.h, through
+			  SIMD::Wide, so these types add no code of their own per instruction set.
+			- Gather() and scatter() take 32 bit indices into an array of Vector<size>. They are
+			  plain loads and stores lane by lane, which is what the hardware gather instructions
+			  cost on most processors anyway.
+			- Lane access through lane(), setLane() and Float8::operator[] is for tests and setup;
+			  the arithmetic never leaves the registers.
+			- normal(), normalize() and reciprocalSquareRoot() take a MathPolicy like their scalar
+			  counterparts; the Fast one is the rsqrtps estimate and one Newton-Raphson step.
+	*/
+
+	class Mask8;
+
+	class Float8;
+
+	template<MathPolicy policy = DefaultMathPolicy>
+	Float8 reciprocalSquareRoot(const Float8&);
+
+	class Float8
+	{
+	private:
+		static const int Parts = 8 / SIMD::Wide::LaneCount;
+
+		SIMD::Wide::Lanes m_parts[Parts];
+
+		friend class Mask8;
+		friend Float8 select(const Mask8&, const Float8&, const Float8&);
+		friend Float8 squareRoot(const Float8&);
+		template<MathPolicy policy>
+		friend Float8 reciprocalSquareRoot(const Float8&);
+		friend Float8 minimum(const Float8&, const Float8&);
+		friend Float8 maximum(const Float8&, const Float8&);
+		friend Float8 multiplyAdd(const Float8&, const Float8&, const Float8&);
+
+	public:
+		static Float8 Load(const float*);
+
+		Float8();
+		Float8(float);
+
+		void store(float*) const;
+
+		float operator [](const int) const;
+		void setLane(const int, float);
+
+		Float8 operator +(const Float8&) const;
+		Float8 operator -(const Float8&) const;
+		Float8 operator *(const Float8&) const;
+		Float8 operator /(const Float8&) const;
+		Float8 operator -() const;
+		void operator +=(const Float8&);
+		void operator -=(const Float8&);
+		void operator *=(const Float8&);
+		void operator /=(const Float8&);
+
+		Mask8 operator <(const Float8&) const;
+		Mask8 operator <=(const Float8&) const;
+		Mask8 operator >(const Float8&) const;
+		Mask8 operator >=(const Float8&) const;
+		Mask8 operator ==(const Float8&) const;
+		Mask8 operator !=(const Float8&) const;
+	};
+
+	class Mask8
+	{
+	private:
+		static const int Parts = 8 / SIMD::Wide::LaneCount;
+
+		SIMD::Wide::Mask m_parts[Parts];
+
+		friend class Float8;
+		friend Float8 select(const Mask8&, const Float8&, const Float8&);
+
+	public:
+		Mask8();
+		Mask8(bool);
+
+		bool operator [](const int) const;
+		int bits() const;
+		bool any() const;
+		bool all() const;
+		bool none() const;
+
+		Mask8 operator &(const Mask8&) const;
+		Mask8 operator |(const Mask8&) const;
+		Mask8 operator ~() const;
+	};
+
+	Float8 select(const Mask8&, const Float8&, const Float8&);
+	Float8 squareRoot(const Float8&);
+	Float8 minimum(const Float8&, const Float8&);
+	Float8 maximum(const Float8&, const Float8&);
+	Float8 multiplyAdd(const Float8&, const Float8&, const Float8&);
+
+	template<int size>
+	class VectorPacket
+	{
+		static_assert(size > 1, "Vector dimension must be at least 2");
+
+	private:
+		Float8 m_data[size];
+
+	public:
+		static VectorPacket Load(const Vector<size>*);
+		static VectorPacket Gather(const Vector<size>*, const int* indices);
+
+		VectorPacket();
+		explicit VectorPacket(const Vector<size>&);
+		VectorPacket(std::initializer_list<Float8>);
+
+		Float8& operator [](const int);
+		const Float8& operator [](const int) const;
+
+		Float8& x();
+		const Float8& x() const;
+		Float8& y();
+		const Float8& y() const;
+		Float8& z();
+		const Float8& z() const;
+		Float8& w();
+		const Float8& w() const;
+
+		Vector<size> lane(const int) const;
+		void setLane(const int, const Vector<size>&);
+		void store(Vector<size>*) const;
+		void scatter(Vector<size>*, const int* indices, const Mask8& active = Mask8(true)) const;
+
+		VectorPacket operator +(const VectorPacket&) const;
+		VectorPacket operator -(const VectorPacket&) const;
+		VectorPacket operator *(const VectorPacket&) const;
+		VectorPacket operator *(const Float8&) const;
+		VectorPacket operator /(const Float8&) const;
+		VectorPacket operator -() const;
+		void operator +=(const VectorPacket&);
+		void operator -=(const VectorPacket&);
+		void operator *=(const VectorPacket&);
+		void operator *=(const Float8&);
+		void operator /=(const Float8&);
+
+		Mask8 operator ==(const VectorPacket&) const;
+		Mask8 operator !=(const VectorPacket&) const;
+
+		Float8 dotProduct(const VectorPacket&) const;
+		VectorPacket crossProduct(const VectorPacket&) const;
+		Float8 magnitude() const;
+		template<MathPolicy policy = DefaultMathPolicy>
+		VectorPacket normal() const;
+		template<MathPolicy policy = DefaultMathPolicy>
+		void normalize();
+		VectorPacket homogenous() const;
+		void homogenize();
+	};
+
+	typedef VectorPacket<2> Vector2x8;
+	typedef VectorPacket<3> Vector3x8;
+	typedef VectorPacket<4> Vector4x8;
+
+	template<int size>
+	VectorPacket<size> select(const Mask8&, const VectorPacket<size>&, const VectorPacket<size>&);
+
+	class Matrix4x4Batch
+	{
+	private:
+		Vector4x8 m_cols[4];
+
+	public:
+		static Matrix4x4Batch Load(const Matrix<4, 4>*);
+		static Matrix4x4Batch Gather(const Matrix<4, 4>*, const int* indices);
+
+		Matrix4x4Batch();
+		explicit Matrix4x4Batch(const Matrix<4, 4>&);
+
+		Vector4x8& operator [](const int);
+		const Vector4x8& operator [](const int) const;
+
+		Matrix<4, 4> lane(const int) const;
+		void setLane(const int, const Matrix<4, 4>&);
+		void store(Matrix<4, 4>*) const;
+
+		Matrix4x4Batch operator *(const Matrix4x4Batch&) const;
+		Vector4x8 operator *(const Vector4x8&) const;
+		Vector3x8 transformPoint(const Vector3x8&) const;
+		Vector3x8 transformDirection(const Vector3x8&) const;
+
+		Matrix4x4Batch transposition() const;
+	};
+
+#pragma endregion
+
+#pragma region Float8 Methods
+
+	inline Float8 Float8::Load(const float* p)
+	{
+		Float8 result;
+		for (int i = 0; i < Parts; ++i)
+			result.m_parts[i] = SIMD::Wide::load(p + i * SIMD::Wide::LaneCount);
+
+		return result;
+	}
+
+	inline Float8::Float8()
+		: Float8(0.0f)
+	{
+	}
+
+	inline Float8::Float8(float f)
+	{
+		for (int i = 0; i < Parts; ++i)
+			m_parts[i] = SIMD::Wide::broadcast(f);
+	}
+
+	inline void Float8::store(float* p) const
+	{
+		for (int i = 0; i < Parts; ++i)
+			SIMD::Wide::store(p + i * SIMD::Wide::LaneCount, m_parts[i]);
+	}
+
+	inline float Float8::operator[](const int index) const
+	{
+		if (GRAPHICSMATH_BOUNDS_CHECK && (index < 0 || index >= 8))
+			throw std::out_of_range("ERROR: Attempted to access lane out of packet range.");
+
+		alignas(32) float lanes[8];
+		store(lanes);
+
+		return lanes[index];
+	}
+
+	inline void Float8::setLane(const int index, float f)
+	{
+		if (GRAPHICSMATH_BOUNDS_CHECK && (index < 0 || index >= 8))
+			throw std::out_of_range("ERROR: Attempted to access lane out of packet range.");
+
+		alignas(32) float lanes[8];
+		store(lanes);
+		lanes[index] = f;
+		*this = Load(lanes);
+	}
+
+	inline Float8 Float8::operator+(const Float8& f) const
+	{
+		Float8 result;
+		for (int i = 0; i < Parts; ++i)
+			result.m_parts[i] = SIMD::Wide::add(m_parts[i], f.m_parts[i]);
+
+		return result;
+	}
+
+	inline Float8 Float8::operator-(const Float8& f) const
+	{
+		Float8 result;
+		for (int i = 0; i < Parts; ++i)
+			result.m_parts[i] = SIMD::Wide::subtract(m_parts[i], f.m_parts[i]);
+
+		return result;
+	}
+
+	inline Float8 Float8::operator*(const Float8& f) const
+	{
+		Float8 result;
+		for (int i = 0; i < Parts; ++i)
+			result.m_parts[i] = SIMD::Wide::multiply(m_parts[i], f.m_parts[i]);
+
+		return result;
+	}
+
+	inline Float8 Float8::operator/(const Float8& f) const
+	{
+		Float8 result;
+		for (int i = 0; i < Parts; ++i)
+			result.m_parts[i] = SIMD::Wide::divide(m_parts[i], f.m_parts[i]);
+
+		return result;
+	}
+
+	inline Float8 Float8::operator-() const
+	{
+		return Float8() - *this;
+	}
+
+	inline void Float8::operator+=(const Float8& f)
+	{
+		*this = *this + f;
+	}
+
+	inline void Float8::operator-=(const Float8& f)
+	{
+		*this = *this - f;
+	}
+
+	inline void Float8::operator*=(const Float8& f)
+	{
+		*this = *this * f;
+	}
+
+	inline void Float8::operator/=(const Float8& f)
+	{
+		*this = *this / f;
+	}
+
+	inline Mask8 Float8::operator<(const Float8& f) const
+	{
+		Mask8 result;
+		for (int i = 0; i < Parts; ++i)
+			result.m_parts[i] = SIMD::Wide::less(m_parts[i], f.m_parts[i]);
+
+		return result;
+	}
+
+	inline Mask8 Float8::operator<=(const Float8& f) const
+	{
+		Mask8 result;
+		for (int i = 0; i < Parts; ++i)
+			result.m_parts[i] = SIMD::Wide::lessEqual(m_parts[i], f.m_parts[i]);
+
+		return result;
+	}
+
+	inline Mask8 Float8::operator>(const Float8& f) const
+	{
+		return f < *this;
+	}
+
+	inline Mask8 Float8::operator>=(const Float8& f) const
+	{
+		return f <= *this;
+	}
+
+	inline Mask8 Float8::operator==(const Float8& f) const
+	{
+		Mask8 result;
+		for (int i = 0; i < Parts; ++i)
+			result.m_parts[i] = SIMD::Wide::equal(m_parts[i], f.m_parts[i]);
+
+		return result;
+	}
+
+	inline Mask8 Float8::operator!=(const Float8& f) const
+	{
+		Mask8 result;
+		for (int i = 0; i < Parts; ++i)
+			result.m_parts[i] = SIMD::Wide::notEqual(m_parts[i], f.m_parts[i]);
+
+		return result;
+	}
+
+	inline Float8 select(const Mask8& mask, const Float8& a, const Float8& b)
+	{
+		Float8 result;
+		for (int i = 0; i < Float8::Parts; ++i)
+			result.m_parts[i] = SIMD::Wide::select(mask.m_parts[i], a.m_parts[i], b.m_parts[i]);
+
+		return result;
+	}
+
+	inline Float8 squareRoot(const Float8& f)
+	{
+		Float8 result;
+		for (int i = 0; i < Float8::Parts; ++i)
+			result.m_parts[i] = SIMD::Wide::squareRoot(f.m_parts[i]);
+
+		return result;
+	}
+
+	template<MathPolicy policy>
+	inline Float8 reciprocalSquareRoot(const Float8& f)
+	{
+		if constexpr (policy == MathPolicy::Fast)
+		{
+			Float8 result;
+			for (int i = 0; i < Float8::Parts; ++i)
+				result.m_parts[i] = SIMD::Wide::reciprocalSquareRoot(f.m_parts[i]);
+
+			return result;
+		}
+		else
+		{
+			return Float8(1.0f) / squareRoot(f);
+		}
+	}
+
+	inline Float8 minimum(const Float8& a, const Float8& b)
+	{
+		Float8 result;
+		for (int i = 0; i < Float8::Parts; ++i)
+			result.m_parts[i] = SIMD::Wide::minimum(a.m_parts[i], b.m_parts[i]);
+
+		return result;
+	}
+
+	inline Float8 maximum(const Float8& a, const Float8& b)
+	{
+		Float8 result;
+		for (int i = 0; i < Float8::Parts; ++i)
+			result.m_parts[i] = SIMD::Wide::maximum(a.m_parts[i], b.m_parts[i]);
+
+		return result;
+	}
+
+	// a * b + c, fused where the target has FMA
+	inline Float8 multiplyAdd(const Float8& a, const Float8& b, const Float8& c)
+	{
+		Float8 result;
+		for (int i = 0; i < Float8::Parts; ++i)
+			result.m_parts[i] = SIMD::Wide::multiplyAdd(a.m_parts[i], b.m_parts[i], c.m_parts[i]);
+
+		return result;
+	}
+
+#pragma endregion
+
+#pragma region Mask8 Methods
+
+	inline Mask8::Mask8()
+		: Mask8(false)
+	{
+	}
+
+	inline Mask8::Mask8(bool b)
+	{
+		for (int i = 0; i < Parts; ++i)
+			m_parts[i] = SIMD::Wide::maskBroadcast(b);
+	}
+
+	inline bool Mask8::operator[](const int index) const
+	{
+		if (GRAPHICSMATH_BOUNDS_CHECK && (index < 0 || index >= 8))
+			throw std::out_of_range("ERROR: Attempted to access lane out of packet range.");
+
+		return (bits() >> index) & 1;
+	}
+
+	// One bit per lane, lane 0 in the lowest bit
+	inline int Mask8::bits() const
+	{
+		int result = 0;
+		for (int i = 0; i < Parts; ++i)
+			result |= SIMD::Wide::maskBits(m_parts[i]) << (i * SIMD::Wide::LaneCount);
+
+		return result;
+	}
+
+	inline bool Mask8::any() const
+	{
+		return bits() != 0;
+	}
+
+	inline bool Mask8::all() const
+	{
+		return bits() == 0xFF;
+	}
+
+	inline bool Mask8::none() const
+	{
+		return bits() == 0;
+	}
+
+	inline Mask8 Mask8::operator&(const Mask8& m) const
+	{
+		Mask8 result;
+		for (int i = 0; i < Parts; ++i)
+			result.m_parts[i] = SIMD::Wide::maskAnd(m_parts[i], m.m_parts[i]);
+
+		return result;
+	}
+
+	inline Mask8 Mask8::operator|(const Mask8& m) const
+	{
+		Mask8 result;
+		for (int i = 0; i < Parts; ++i)
+			result.m_parts[i] = SIMD::Wide::maskOr(m_parts[i], m.m_parts[i]);
+
+		return result;
+	}
+
+	inline Mask8 Mask8::operator~() const
+	{
+		Mask8 result;
+		for (int i = 0; i < Parts; ++i)
+			result.m_parts[i] = SIMD::Wide::maskNot(m_parts[i]);
+
+		return result;
+	}
+
+#pragma endregion
+
+#pragma region VectorPacket Methods
+
+	template<int size>
+	VectorPacket<size> VectorPacket<size>::Load(const Vector<size>* vectors)
+	{
+		static const int consecutive[8] = { 0, 1, 2, 3, 4, 5, 6, 7 };
+
+		return Gather(vectors, consecutive);
+	}
+
+	// Transposes the eight vectors through the stack, one aligned load per component
+	template<int size>
+	VectorPacket<size> VectorPacket<size>::Gather(const Vector<size>* vectors, const int* indices)
+	{
+		alignas(32) float components[size][8];
+		for (int lane = 0; lane < 8; ++lane)
+		{
+			const float* v = vectors[indices[lane]].begin();
+			for (int c = 0; c < size; ++c)
+				components[c][lane] = v[c];
+		}
+
+		VectorPacket result;
+		for (int c = 0; c < size; ++c)
+			result.m_data[c] = Float8::Load(components[c]);
+
+		return result;
+	}
+
+	template<int size>
+	VectorPacket<size>::VectorPacket()
+	{
+	}
+
+	template<int size>
+	VectorPacket<size>::VectorPacket(const Vector<size>& v)
+	{
+		for (int c = 0; c < size; ++c)
+			m_data[c] = Float8(v.begin()[c]);
+	}
+
+	template<int size>
+	VectorPacket<size>::VectorPacket(std::initializer_list<Float8> args)
+	{
+		if (args.size() > size)
+			throw std::out_of_range("ERROR: Cannot add more elements to a vector than it can hold.");
+
+		int i = 0;
+		for (const Float8& arg : args)
+			m_data[i++] = arg;
+	}
+
+	template<int size>
+	Float8& VectorPacket<size>::operator[](const int index)
+	{
+		if (GRAPHICSMATH_BOUNDS_CHECK && (index < 0 || index >= size))
+			throw std::out_of_range("ERROR: Attempted to access value out of Vector range.");
+
+		return m_data[index];
+	}
+
+	template<int size>
+	const Float8& VectorPacket<size>::operator[](const int index) const
+	{
+		if (GRAPHICSMATH_BOUNDS_CHECK && (index < 0 || index >= size))
+			throw std::out_of_range("ERROR: Attempted to access value out of Vector range.");
+
+		return m_data[index];
+	}
+
+	template<int size>
+	Float8& VectorPacket<size>::x()
+	{
+		return m_data[0];
+	}
+
+	template<int size>
+	const Float8& VectorPacket<size>::x() const
+	{
+		return m_data[0];
+	}
+
+	template<int size>
+	Float8& VectorPacket<size>::y()
+	{
+		return m_data[1];
+	}
+
+	template<int size>
+	const Float8& VectorPacket<size>::y() const
+	{
+		return m_data[1];
+	}
+
+	template<int size>
+	Float8& VectorPacket<size>::z()
+	{
+		static_assert(size > 2, "z() requires a vector of at least 3 dimensions");
+		return m_data[2];
+	}
+
+	template<int size>
+	const Float8& VectorPacket<size>::z() const
+	{
+		static_assert(size > 2, "z() requires a vector of at least 3 dimensions");
+		return m_data[2];
+	}
+
+	template<int size>
+	Float8& VectorPacket<size>::w()
+	{
+		static_assert(size > 3, "w() requires a vector of at least 4 dimensions");
+		return m_data[3];
+	}
+
+	template<int size>
+	const Float8& VectorPacket<size>::w() const
+	{
+		static_assert(size > 3, "w() requires a vector of at least 4 dimensions");
+		return m_data[3];
+	}
+
+	template<int size>
+	Vector<size> VectorPacket<size>::lane(const int index) const
+	{
+		Vector<size> result;
+		for (int c = 0; c < size; ++c)
+			result.begin()[c] = m_data[c][index];
+
+		return result;
+	}
+
+	template<int size>
+	void VectorPacket<size>::setLane(const int index, const Vector<size>& v)
+	{
+		for (int c = 0; c < size; ++c)
+			m_data[c].setLane(index, v.begin()[c]);
+	}
+
+	template<int size>
+	void VectorPacket<size>::store(Vector<size>* vectors) const
+	{
+		alignas(32) float components[size][8];
+		for (int c = 0; c < size; ++c)
+			m_data[c].store(components[c]);
+
+		for (int lane = 0; lane < 8; ++lane)
+		{
+			float* v = vectors[lane].begin();
+			for (int c = 0; c < size; ++c)
+				v[c] = components[c][lane];
+		}
+	}
+
+	template<int size>
+	void VectorPacket<size>::scatter(Vector<size>* vectors, const int* indices, const Mask8& active) const
+	{
+		alignas(32) float components[size][8];
+		for (int c = 0; c < size; ++c)
+			m_data[c].store(components[c]);
+
+		const int bits = active.bits();
+		for (int lane = 0; lane < 8; ++lane)
+		{
+			if (!((bits >> lane) & 1))
+				continue;
+
+			float* v = vectors[indices[lane]].begin();
+			for (int c = 0; c < size; ++c)
+				v[c] = components[c][lane];
+		}
+	}
+
+	template<int size>
+	VectorPacket<size> VectorPacket<size>::operator+(const VectorPacket& v) const
+	{
+		VectorPacket result;
+		for (int c = 0; c < size; ++c)
+			result.m_data[c] = m_data[c] + v.m_data[c];
+
+		return result;
+	}
+
+	template<int size>
+	VectorPacket<size> VectorPacket<size>::operator-(const VectorPacket& v) const
+	{
+		VectorPacket result;
+		for (int c = 0; c < size; ++c)
+			result.m_data[c] = m_data[c] - v.m_data[c];
+
+		return result;
+	}
+
+	template<int size>
+	VectorPacket<size> VectorPacket<size>::operator*(const VectorPacket& v) const
+	{
+		VectorPacket result;
+		for (int c = 0; c < size; ++c)
+			result.m_data[c] = m_data[c] * v.m_data[c];
+
+		return result;
+	}
+
+	template<int size>
+	VectorPacket<size> VectorPacket<size>::operator*(const Float8& f) const
+	{
+		VectorPacket result;
+		for (int c = 0; c < size; ++c)
+			result.m_data[c] = m_data[c] * f;
+
+		return result;
+	}
+
+	template<int size>
+	VectorPacket<size> VectorPacket<size>::operator/(const Float8& f) const
+	{
+		VectorPacket result;
+		for (int c = 0; c < size; ++c)
+			result.m_data[c] = m_data[c] / f;
+
+		return result;
+	}
+
+	template<int size>
+	VectorPacket<size> VectorPacket<size>::operator-() const
+	{
+		VectorPacket result;
+		for (int c = 0; c < size; ++c)
+			result.m_data[c] = -m_data[c];
+
+		return result;
+	}
+
+	template<int size>
+	void VectorPacket<size>::operator+=(const VectorPacket& v)
+	{
+		*this = *this + v;
+	}
+
+	template<int size>
+	void VectorPacket<size>::operator-=(const VectorPacket& v)
+	{
+		*this = *this - v;
+	}
+
+	template<int size>
+	void VectorPacket<size>::operator*=(const VectorPacket& v)
+	{
+		*this = *this * v;
+	}
+
+	template<int size>
+	void VectorPacket<size>::operator*=(const Float8& f)
+	{
+		*this = *this * f;
+	}
+
+	template<int size>
+	void VectorPacket<size>::operator/=(const Float8& f)
+	{
+		*this = *this / f;
+	}
+
+	template<int size>
+	Mask8 VectorPacket<size>::operator==(const VectorPacket& v) const
+	{
+		Mask8 result = m_data[0] == v.m_data[0];
+		for (int c = 1; c < size; ++c)
+			result = result & (m_data[c] == v.m_data[c]);
+
+		return result;
+	}
+
+	template<int size>
+	Mask8 VectorPacket<size>::operator!=(const VectorPacket& v) const
+	{
+		return ~(*this == v);
+	}
+
+	template<int size>
+	Float8 VectorPacket<size>::dotProduct(const VectorPacket& v) const
+	{
+		Float8 result = m_data[0] * v.m_data[0];
+		for (int c = 1; c < size; ++c)
+			result = multiplyAdd(m_data[c], v.m_data[c], result);
+
+		return result;
+	}
+
+	template<int size>
+	VectorPacket<size> VectorPacket<size>::crossProduct(const VectorPacket& v) const
+	{
+		static_assert(size == 3, "Cross product only valid in 3 dimensional space.");
+
+		VectorPacket result;
+		result.m_data[0] = m_data[1] * v.m_data[2] - m_data[2] * v.m_data[1];
+		result.m_data[1] = m_data[2] * v.m_data[0] - m_data[0] * v.m_data[2];
+		result.m_data[2] = m_data[0] * v.m_data[1] - m_data[1] * v.m_data[0];
+
+		return result;
+	}
+
+	template<int size>
+	Float8 VectorPacket<size>::magnitude() const
+	{
+		return squareRoot(dotProduct(*this));
+	}
+
+	template<int size>
+	template<MathPolicy policy>
+	VectorPacket<size> VectorPacket<size>::normal() const
+	{
+		if constexpr (policy == MathPolicy::Fast)
+			return *this * reciprocalSquareRoot<policy>(dotProduct(*this));
+		else
+			return *this / magnitude();
+	}
+
+	template<int size>
+	template<MathPolicy policy>
+	void VectorPacket<size>::normalize()
+	{
+		*this = normal<policy>();
+	}
+
+	template<int size>
+	VectorPacket<size> VectorPacket<size>::homogenous() const
+	{
+		VectorPacket result(*this);
+		result.homogenize();
+
+		return result;
+	}
+
+	// Lanes whose last component is zero are left unchanged, as in Vector::homogenize()
+	template<int size>
+	void VectorPacket<size>::homogenize()
+	{
+		const Float8 last = m_data[size - 1];
+		const Mask8 finite = last != Float8(0.0f);
+
+		for (int c = 0; c < size - 1; ++c)
+			m_data[c] = select(finite, m_data[c] / last, m_data[c]);
+	}
+
+	template<int size>
+	VectorPacket<size> select(const Mask8& mask, const VectorPacket<size>& a, const VectorPacket<size>& b)
+	{
+		VectorPacket<size> result;
+		for (int c = 0; c < size; ++c)
+			result[c] = select(mask, a[c], b[c]);
+
+		return result;
+	}
+
+#pragma endregion
+
+#pragma region Matrix4x4Batch Methods
+
+	inline Matrix4x4Batch Matrix4x4Batch::Load(const Matrix<4, 4>* matrices)
+	{
+		static const int consecutive[8] = { 0, 1, 2, 3, 4, 5, 6, 7 };
+
+		return Gather(matrices, consecutive);
+	}
+
+	inline Matrix4x4Batch Matrix4x4Batch::Gather(const Matrix<4, 4>* matrices, const int* indices)
+	{
+		alignas(32) float elements[16][8];
+		for (int lane = 0; lane < 8; ++lane)
+		{
+			const float* m = matrices[indices[lane]].data();
+			for (int i = 0; i < 16; ++i)
+				elements[i][lane] = m[i];
+		}
+
+		Matrix4x4Batch result;
+		for (int c = 0; c < 4; ++c)
+		{
+			for (int r = 0; r < 4; ++r)
+				result.m_cols[c][r] = Float8::Load(elements[4 * c + r]);
+		}
+
+		return result;
+	}
+
+	// Identity in every lane, like Matrix<4, 4>()
+	inline Matrix4x4Batch::Matrix4x4Batch()
+		: Matrix4x4Batch(Matrix<4, 4>())
+	{
+	}
+
+	inline Matrix4x4Batch::Matrix4x4Batch(const Matrix<4, 4>& m)
+	{
+		for (int c = 0; c < 4; ++c)
+			m_cols[c] = Vector4x8(m[c]);
+	}
+
+	inline Vector4x8& Matrix4x4Batch::operator[](const int index)
+	{
+		if (GRAPHICSMATH_BOUNDS_CHECK && (index < 0 || index >= 4))
+			throw std::out_of_range("ERROR: Attempted to access value out of Matrix range.");
+
+		return m_cols[index];
+	}
+
+	inline const Vector4x8& Matrix4x4Batch::operator[](const int index) const
+	{
+		if (GRAPHICSMATH_BOUNDS_CHECK && (index < 0 || index >= 4))
+			throw std::out_of_range("ERROR: Attempted to access value out of Matrix range.");
+
+		return m_cols[index];
+	}
+
+	inline Matrix<4, 4> Matrix4x4Batch::lane(const int index) const
+	{
+		Matrix<4, 4> result;
+		for (int c = 0; c < 4; ++c)
+			result[c] = m_cols[c].lane(index);
+
+		return result;
+	}
+
+	inline void Matrix4x4Batch::setLane(const int index, const Matrix<4, 4>& m)
+	{
+		for (int c = 0; c < 4; ++c)
+			m_cols[c].setLane(index, m[c]);
+	}
+
+	inline void Matrix4x4Batch::store(Matrix<4, 4>* matrices) const
+	{
+		alignas(32) float elements[16][8];
+		for (int c = 0; c < 4; ++c)
+		{
+			for (int r = 0; r < 4; ++r)
+				m_cols[c][r].store(elements[4 * c + r]);
+		}
+
+		for (int lane = 0; lane < 8; ++lane)
+		{
+			float* m = matrices[lane].data();
+			for (int i = 0; i < 16; ++i)
+				m[i] = elements[i][lane];
+		}
+	}
+
+	inline Matrix4x4Batch Matrix4x4Batch::operator*(const Matrix4x4Batch& m) const
+	{
+		Matrix4x4Batch result;
+		for (int c = 0; c < 4; ++c)
+			result.m_cols[c] = *this * m.m_cols[c];
+
+		return result;
+	}
+
+	// Each lane's columns weighted by the components of that lane's vector
+	inline Vector4x8 Matrix4x4Batch::operator*(const Vector4x8& v) const
+	{
+		Vector4x8 result;
+		for (int r = 0; r < 4; ++r)
+		{
+			Float8 sum = m_cols[0][r] * v[0];
+			for (int c = 1; c < 4; ++c)
+				sum = multiplyAdd(m_cols[c][r], v[c], sum);
+
+			result[r] = sum;
+		}
+
+		return result;
+	}
+
+	// The point as w = 1, without the projective divide, so for affine transforms only
+	inline Vector3x8 Matrix4x4Batch::transformPoint(const Vector3x8& p) const
+	{
+		Vector3x8 result;
+		for (int r = 0; r < 3; ++r)
+		{
+			Float8 sum = m_cols[3][r];
+			for (int c = 0; c < 3; ++c)
+				sum = multiplyAdd(m_cols[c][r], p[c], sum);
+
+			result[r] = sum;
+		}
+
+		return result;
+	}
+
+	// The direction as w = 0, so the translation doesn't apply
+	inline Vector3x8 Matrix4x4Batch::transformDirection(const Vector3x8& d) const
+	{
+		Vector3x8 result;
+		for (int r = 0; r < 3; ++r)
+		{
+			Float8 sum = m_cols[0][r] * d[0];
+			for (int c = 1; c < 3; ++c)
+				sum = multiplyAdd(m_cols[c][r], d[c], sum);
+
+			result[r] = sum;
+		}
+
+		return result;
+	}
+
+	inline Matrix4x4Batch Matrix4x4Batch::transposition() const
+	{
+		Matrix4x4Batch result;
+		for (int c = 0; c < 4; ++c)
+		{
+			for (int r = 0; r < 4; ++r)
+				result.m_cols[r][c] = m_cols[c][r];
+		}
+
+		return result;
+	}
+
+#pragma endregion
+
+}
+
+#endif
@@ -0,0 +1,40 @@
+#include "Parallel.h"
+
+namespace GraphicsMath
+{
+
+#pragma region Parallel Transforms
+
+	void parallelTransformPoints(const Matrix<4, 4>& m, ConstPointStreams in, PointStreams out, std::size_t count,
+								 bool homogenize, ThreadPool& pool)
+	{
+		pool.parallelFor(count, cacheAlignedGrain<float>(ParallelGrain), [&](std::size_t begin, std::size_t end)
+		{
+			ConstPointStreams chunkIn{ in.x + begin, in.y + begin, in.z + begin, in.w ? in.w + begin : nullptr };
+			PointStreams chunkOut{ out.x + begin, out.y + begin, out.z + begin, out.w ? out.w + begin : nullptr };
+
+			transformPoints(m, chunkIn, chunkOut, end - begin, homogenize);
+		});
+	}
+
+	void parallelTransform(const Matrix<4, 4>& m, const Vector<4>* in, Vector<4>* out, std::size_t count, ThreadPool& pool)
+	{
+		pool.parallelFor(count, cacheAlignedGrain<Vector<4>>(ParallelGrain), [&](std::size_t begin, std::size_t end)
+		{
+			for (std::size_t i = begin; i < end; ++i)
+				SIMD::transform4x4(m.data(), in[i].begin(), out[i].begin());
+		});
+	}
+
+	void parallelMultiply(const Matrix<4, 4>& m, const Matrix<4, 4>* in, Matrix<4, 4>* out, std::size_t count, ThreadPool& pool)
+	{
+		pool.parallelFor(count, cacheAlignedGrain<Matrix<4, 4>>(ParallelGrain / 4), [&](std::size_t begin, std::size_t end)
+		{
+			for (std::size_t i = begin; i < end; ++i)
+				SIMD::multiply4x4(m.data(), in[i].data(), out[i].data());
+		});
+	}
+
+#pragma endregion
+
+}
@@ -0,0 +1,131 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <cstddef>
+#include <numeric>
+#include <vector>
+
+#include "BatchTransform.h"
+#include "ThreadPool.h"
+
+namespace GraphicsMath
+{
+
+#pragma region Parallel Operation Definitions
+
+	/* -------------------------------------------------------------------------------------------------
+		Copyright 2017 Shealyn Tate Hindenlang
+
+		Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+		and associated documentation files (the "Software"), to deal in the Software without restriction,
+		including without limitation the rights to use, copy, modify, merge, publish, distribute,
+		sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+		furnished to do so, subject to the following conditions:
+
+		The above copyright notice and this permission notice shall be included in all copies or
+		substantial portions of the Software.
+
+		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+		BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+		NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+		DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+		-------------------------------------------------------------------------------------------------
+
+		Parallel versions of the bulk Vector and Matrix operations, run on a ThreadPool.
+
+		Methods:
+			parallelTransformPoints(m, in, out, count, homogenize)	transformPoints() over SoA streams
+			parallelTransform(m, in, out, count)					out[i] = m * in[i]
+			parallelMultiply(m, in, out, count)						out[i] = m * in[i] for matrices
+			parallelNormalize<policy>(v, count)						v[i].normalize<policy>()
+			parallelDotProduct(a, b, count)							sum of a[i].dotProduct(b[i])
+
+		Notes:
+			- Every method takes an optional ThreadPool and uses ThreadPool::global() otherwise.
+			- Work is split into chunks of about ParallelGrain items, rounded so each chunk of the
+			  array starts and ends on a cache line boundary relative to the start of the array.
+			  Neighbouring threads therefore never write to the same cache line.
+			- Chunk boundaries only depend on the element count, so results are bit for bit the same
+			  for any number of threads. parallelDotProduct sums each chunk in order, then adds the
+			  chunk sums in chunk order.
+			- Output arrays must not overlap the input arrays, except for parallelTransformPoints which
+			  may run in place like transformPoints().
+	*/
+
+	static const std::size_t CacheLineSize = 64;
+	static const std::size_t ParallelGrain = 4096;
+
+	// Rounds grain up to a whole number of cache lines worth of T
+	template<typename T>
+	std::size_t cacheAlignedGrain(std::size_t grain)
+	{
+		const std::size_t perLine = CacheLineSize / std::gcd(sizeof(T), CacheLineSize);
+
+		return (grain + perLine - 1) / perLine * perLine;
+	}
+
+	void parallelTransformPoints(const Matrix<4, 4>& m, ConstPointStreams in, PointStreams out, std::size_t count,
+								 bool homogenize = false, ThreadPool& pool = ThreadPool::global());
+
+	void parallelTransform(const Matrix<4, 4>& m, const Vector<4>* in, Vector<4>* out, std::size_t count,
+						   ThreadPool& pool = ThreadPool::global());
+
+	void parallelMultiply(const Matrix<4, 4>& m, const Matrix<4, 4>* in, Matrix<4, 4>* out, std::size_t count,
+						  ThreadPool& pool = ThreadPool::global());
+
+	template<MathPolicy policy = DefaultMathPolicy, int size>
+	void parallelNormalize(Vector<size>* v, std::size_t count, ThreadPool& pool = ThreadPool::global());
+
+	template<int size>
+	float parallelDotProduct(const Vector<size>* a, const Vector<size>* b, std::size_t count,
+							 ThreadPool& pool = ThreadPool::global());
+
+#pragma endregion
+
+#pragma region Template Methods
+
+	template<MathPolicy policy, int size>
+	void parallelNormalize(Vector<size>* v, std::size_t count, ThreadPool& pool)
+	{
+		pool.parallelFor(count, cacheAlignedGrain<Vector<size>>(ParallelGrain), [v](std::size_t begin, std::size_t end)
+		{
+			for (std::size_t i = begin; i < end; ++i)
+				v[i].template normalize<policy>();
+		});
+	}
+
+	template<int size>
+	float parallelDotProduct(const Vector<size>* a, const Vector<size>* b, std::size_t count, ThreadPool& pool)
+	{
+		// Each chunk writes its own cache line so the partial sums don't false share
+		struct alignas(CacheLineSize) Partial
+		{
+			float sum;
+		};
+
+		const std::size_t grain = cacheAlignedGrain<Vector<size>>(ParallelGrain);
+		std::vector<Partial> partials((count + grain - 1) / grain);
+
+		pool.parallelFor(count, grain, [a, b, grain, &partials](std::size_t begin, std::size_t end)
+		{
+			float sum = 0;
+			for (std::size_t i = begin; i < end; ++i)
+				sum += a[i].dotProduct(b[i]);
+
+			partials[begin / grain].sum = sum;
+		});
+
+		float result = 0;
+		for (const auto& partial : partials)
+			result += partial.sum;
+
+		return result;
+	}
+
+#pragma endregion
+
+}
+
+#endif
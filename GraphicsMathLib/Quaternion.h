@@ -0,0 +1,383 @@
+#ifndef QUATERNION_H
+#define QUATERNION_H
+
+#include "Matrix.h"
+
+namespace GraphicsMath
+{
+
+#pragma region Quaternion Class Definition
+
+	/* -------------------------------------------------------------------------------------------------
+		Copyright 2017 Shealyn Tate Hindenlang
+
+		Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+		and associated documentation files (the "Software"), to deal in the Software without restriction,
+		including without limitation the rights to use, copy, modify, merge, publish, distribute,
+		sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+		furnished to do so, subject to the following conditions:
+
+		The above copyright notice and this permission notice shall be included in all copies or
+		substantial portions of the Software.
+
+		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+		BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+		NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+		DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+		-------------------------------------------------------------------------------------------------
+
+		Quaternion is a rotation in 3 dimensions stored as four floats, a quarter of the memory of the
+		equivalent Matrix<4, 4>. Composing two rotations costs 16 multiplies instead of 64.
+
+		Constructors:
+			Quaternion()
+			Quaternion(float x, float y, float z, float w)
+			static Quaternion::Rotation(Vector<3>, float)
+			static Quaternion::FromMatrix(Matrix<4, 4>)
+
+		Notes:
+			- The components are stored in (x, y, z, w) order, where (x, y, z) is the vector part and
+			  w the scalar part. operator[] indexes them in that order and follows the same
+			  GRAPHICSMATH_BOUNDS_CHECK policy as Vector::operator[].
+			- The default constructor initializes the identity rotation (0, 0, 0, 1).
+			- Rotation(axis, theta) matches Matrix<4, 4>::Rotation(axis, theta): the axis is expected
+			  to be normalized and theta is in radians.
+			- a * b is the rotation that applies b first and then a, the same order as
+			  Matrix<4, 4>::Rotation(a) * Matrix<4, 4>::Rotation(b).
+			- conjugate() is the inverse of a unit quaternion. inverse() also handles quaternions that
+			  are not unit length.
+			- FromMatrix() reads only the upper 3x3 block, which must be a pure rotation.
+			- Quaternion * Quaternion runs on the SSE kernel in SIMD.h when the target supports it.
+			- Slerp takes the shorter arc between the two rotations and falls back to Nlerp when
+			  they are nearly identical. Nlerp is cheaper and is fine for small angles.
+	*/
+
+	class Quaternion
+	{
+	private:
+		alignas(16) float m_data[4];
+
+		std::string toString() const;
+
+	public:
+		static Quaternion Rotation(Vector<3>, float);
+		static Quaternion FromMatrix(const Matrix<4, 4>&);
+		static Quaternion Nlerp(const Quaternion&, const Quaternion&, float);
+		static Quaternion Slerp(const Quaternion&, const Quaternion&, float);
+
+		Quaternion();
+		Quaternion(float, float, float, float);
+
+		float& operator[](const int);
+		const float& operator[](const int) const;
+
+		bool operator ==(const Quaternion&) const;
+		bool operator !=(const Quaternion&) const;
+
+		Quaternion operator *(const Quaternion&) const;
+		void operator *=(const Quaternion&);
+
+		float dotProduct(const Quaternion&) const;
+		float squareMagnitude() const;
+		float magnitude() const;
+		Quaternion normal() const;
+		void normalize();
+
+		Quaternion conjugate() const;
+		Quaternion inverse() const;
+
+		Vector<3> rotate(const Vector<3>&) const;
+		Matrix<4, 4> toMatrix() const;
+
+		std::string to_string() const;
+
+		friend std::ostream& operator <<(std::ostream& os, const Quaternion& q)
+		{
+			os << q.toString() << std::endl;
+			return os;
+		}
+	};
+
+#pragma endregion
+
+#pragma region Static Constructors
+
+	inline Quaternion Quaternion::Rotation(Vector<3> axis, float theta)
+	{
+		float s = sinf(theta * 0.5f);
+
+		return Quaternion(axis[0] * s, axis[1] * s, axis[2] * s, cosf(theta * 0.5f));
+	}
+
+	inline Quaternion Quaternion::FromMatrix(const Matrix<4, 4>& m)
+	{
+		// Take the square root of whichever of w, x, y or z is largest so the division below is
+		// always by a value of at least 0.5
+		float trace = m[0][0] + m[1][1] + m[2][2];
+
+		if (trace > 0)
+		{
+			float s = 0.5f / sqrtf(trace + 1.0f);
+			return Quaternion((m[1][2] - m[2][1]) * s, (m[2][0] - m[0][2]) * s, (m[0][1] - m[1][0]) * s, 0.25f / s);
+		}
+
+		if (m[0][0] > m[1][1] && m[0][0] > m[2][2])
+		{
+			float s = 0.5f / sqrtf(1.0f + m[0][0] - m[1][1] - m[2][2]);
+			return Quaternion(0.25f / s, (m[1][0] + m[0][1]) * s, (m[2][0] + m[0][2]) * s, (m[1][2] - m[2][1]) * s);
+		}
+
+		if (m[1][1] > m[2][2])
+		{
+			float s = 0.5f / sqrtf(1.0f + m[1][1] - m[0][0] - m[2][2]);
+			return Quaternion((m[1][0] + m[0][1]) * s, 0.25f / s, (m[2][1] + m[1][2]) * s, (m[2][0] - m[0][2]) * s);
+		}
+
+		float s = 0.5f / sqrtf(1.0f + m[2][2] - m[0][0] - m[1][1]);
+		return Quaternion((m[2][0] + m[0][2]) * s, (m[2][1] + m[1][2]) * s, 0.25f / s, (m[0][1] - m[1][0]) * s);
+	}
+
+	inline Quaternion Quaternion::Nlerp(const Quaternion& a, const Quaternion& b, float t)
+	{
+		// q and -q are the same rotation, flip b onto a's hemisphere to take the shorter arc
+		float wb = a.dotProduct(b) < 0 ? -t : t;
+		float wa = 1.0f - t;
+
+		Quaternion result;
+		for (int i = 0; i < 4; ++i)
+			result.m_data[i] = a.m_data[i] * wa + b.m_data[i] * wb;
+
+		result.normalize();
+
+		return result;
+	}
+
+	inline Quaternion Quaternion::Slerp(const Quaternion& a, const Quaternion& b, float t)
+	{
+		float cosTheta = a.dotProduct(b);
+		float sign = 1.0f;
+
+		if (cosTheta < 0)
+		{
+			cosTheta = -cosTheta;
+			sign = -1.0f;
+		}
+
+		// sin(theta) approaches zero for nearly identical rotations, where nlerp is just as accurate
+		if (cosTheta > 0.9995f)
+			return Nlerp(a, b, t);
+
+		float theta = acosf(cosTheta);
+		float invSinTheta = 1.0f / sinf(theta);
+		float wa = sinf((1.0f - t) * theta) * invSinTheta;
+		float wb = sinf(t * theta) * invSinTheta * sign;
+
+		Quaternion result;
+		for (int i = 0; i < 4; ++i)
+			result.m_data[i] = a.m_data[i] * wa + b.m_data[i] * wb;
+
+		return result;
+	}
+
+#pragma endregion
+
+#pragma region Private Methods
+
+	inline std::string Quaternion::toString() const
+	{
+		std::string output = "Quaternion (";
+
+		for (int i = 0; i < 4; i++)
+		{
+			output += std::to_string(m_data[i]);
+			if (i != 3)
+				output += ", ";
+		}
+
+		output += ")";
+
+		return output;
+	}
+
+#pragma endregion
+
+#pragma region Constructors
+
+	inline Quaternion::Quaternion()
+		: m_data{ 0, 0, 0, 1 }
+	{
+	}
+
+	inline Quaternion::Quaternion(float x, float y, float z, float w)
+		: m_data{ x, y, z, w }
+	{
+	}
+
+#pragma endregion
+
+#pragma region Subscript Operators
+
+	inline float& Quaternion::operator[](const int index)
+	{
+		if (GRAPHICSMATH_BOUNDS_CHECK && (index < 0 || index >= 4))
+			throw std::out_of_range("ERROR: Attempted to access value out of Quaternion range.");
+
+		return m_data[index];
+	}
+
+	inline const float& Quaternion::operator[](const int index) const
+	{
+		if (GRAPHICSMATH_BOUNDS_CHECK && (index < 0 || index >= 4))
+			throw std::out_of_range("ERROR: Attempted to access value out of Quaternion range.");
+
+		return m_data[index];
+	}
+
+#pragma endregion
+
+#pragma region Comparison Operators
+
+	inline bool Quaternion::operator ==(const Quaternion& q) const
+	{
+		for (int i = 0; i < 4; ++i)
+		{
+			if (m_data[i] != q.m_data[i])
+				return false;
+		}
+
+		return true;
+	}
+
+	inline bool Quaternion::operator !=(const Quaternion& q) const
+	{
+		return !(*this == q);
+	}
+
+#pragma endregion
+
+#pragma region Multiplication
+
+	inline Quaternion Quaternion::operator *(const Quaternion& q) const
+	{
+		Quaternion result;
+		SIMD::multiplyQuaternion(m_data, q.m_data, result.m_data);
+
+		return result;
+	}
+
+	inline void Quaternion::operator *=(const Quaternion& q)
+	{
+		*this = *this * q;
+	}
+
+#pragma endregion
+
+#pragma region Magnitude & Normalization
+
+	inline float Quaternion::dotProduct(const Quaternion& q) const
+	{
+		return m_data[0] * q.m_data[0] + m_data[1] * q.m_data[1] + m_data[2] * q.m_data[2] + m_data[3] * q.m_data[3];
+	}
+
+	inline float Quaternion::squareMagnitude() const
+	{
+		return dotProduct(*this);
+	}
+
+	inline float Quaternion::magnitude() const
+	{
+		return sqrtf(squareMagnitude());
+	}
+
+	inline Quaternion Quaternion::normal() const
+	{
+		auto result{ *this };
+		result.normalize();
+
+		return result;
+	}
+
+	inline void Quaternion::normalize()
+	{
+		float m = magnitude();
+
+		if (m == 0)
+			throw std::runtime_error("Cannot normalize a zero quaternion.");
+
+		float invM = 1.0f / m;
+		for (int i = 0; i < 4; ++i)
+			m_data[i] *= invM;
+	}
+
+#pragma endregion
+
+#pragma region Inversion
+
+	inline Quaternion Quaternion::conjugate() const
+	{
+		return Quaternion(-m_data[0], -m_data[1], -m_data[2], m_data[3]);
+	}
+
+	inline Quaternion Quaternion::inverse() const
+	{
+		float sq = squareMagnitude();
+
+		if (sq == 0)
+			throw std::runtime_error("ERROR: Quaternion cannot be inverted.");
+
+		float invSq = 1.0f / sq;
+
+		return Quaternion(-m_data[0] * invSq, -m_data[1] * invSq, -m_data[2] * invSq, m_data[3] * invSq);
+	}
+
+#pragma endregion
+
+#pragma region Rotation
+
+	inline Vector<3> Quaternion::rotate(const Vector<3>& v) const
+	{
+		// v' = v + 2w(u x v) + 2u x (u x v), with u the vector part. 15 multiplies, no full q * v * q'
+		float x = m_data[0], y = m_data[1], z = m_data[2], w = m_data[3];
+
+		float tx = 2.0f * (y * v[2] - z * v[1]);
+		float ty = 2.0f * (z * v[0] - x * v[2]);
+		float tz = 2.0f * (x * v[1] - y * v[0]);
+
+		return Vector<3>{ v[0] + w * tx + (y * tz - z * ty),
+						  v[1] + w * ty + (z * tx - x * tz),
+						  v[2] + w * tz + (x * ty - y * tx) };
+	}
+
+	inline Matrix<4, 4> Quaternion::toMatrix() const
+	{
+		float x = m_data[0], y = m_data[1], z = m_data[2], w = m_data[3];
+		float x2 = x + x, y2 = y + y, z2 = z + z;
+		float xx = x * x2, yy = y * y2, zz = z * z2;
+		float xy = x * y2, xz = x * z2, yz = y * z2;
+		float wx = w * x2, wy = w * y2, wz = w * z2;
+
+		Matrix<4, 4> result;
+
+		result[0][0] = 1.0f - yy - zz; result[1][0] = xy - wz;        result[2][0] = xz + wy;
+		result[0][1] = xy + wz;        result[1][1] = 1.0f - xx - zz; result[2][1] = yz - wx;
+		result[0][2] = xz - wy;        result[1][2] = yz + wx;        result[2][2] = 1.0f - xx - yy;
+
+		return result;
+	}
+
+#pragma endregion
+
+#pragma region Standard Methods
+
+	inline std::string Quaternion::to_string() const
+	{
+		return this->toString();
+	}
+
+#pragma endregion
+
+}
+
+#endif
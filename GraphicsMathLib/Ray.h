@@ -0,0 +1,450 @@
+#ifndef RAY_H
+#define RAY_H
+
+#include <algorithm>
+#include <cmath>
+
+#include "Packet.h"
+
+namespace GraphicsMath
+{
+
+#pragma region Ray Definitions
+
+	/* -------------------------------------------------------------------------------------------------
+		Copyright 2017 Shealyn Tate Hindenlang
+
+		Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+		and associated documentation files (the "Software"), to deal in the Software without restriction,
+		including without limitation the rights to use, copy, modify, merge, publish, distribute,
+		sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+		furnished to do so, subject to the following conditions:
+
+		The above copyright notice and this permission notice shall be included in all copies or
+		substantial portions of the Software.
+
+		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+		BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+		NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+		DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+		-------------------------------------------------------------------------------------------------
+
+		Ray is an origin and a direction, with the reciprocal of the direction kept alongside for the
+		box test. RayPacket is eight of them in Vector3x8s. AABB is an axis aligned bounding box.
+
+		intersectTriangle() is the Moller-Trumbore test and intersectBox() the slab test. Each takes
+		a Ray or a RayPacket and the range of distances to accept, and returns a plain struct: for
+		a triangle whether it was hit, the distance and the barycentric coordinates of the hit, for
+		a box whether it was hit and the distances where the ray enters and leaves it.
+
+		Constructors:
+			Ray(origin, direction)
+			RayPacket(origins, directions)			from two Vector3x8s
+			static RayPacket::Load(rays)			eight consecutive Rays
+			AABB()									empty, ready to expand()
+			AABB(minimum, maximum)
+
+		Methods:
+			ray.pointAt(t)							origin + direction * t
+			box.expand(point or box), contains(point), center(), extent(), surfaceArea()
+
+		Usage:
+			Ray ray(camera, direction);
+			TriangleHit hit = intersectTriangle(ray, a, b, c, 0.0f, closest);
+			if (hit.hit)
+				closest = hit.distance;
+
+			RayPacket rays = RayPacket::Load(&cameraRays[i]);
+			TriangleHit8 hits = intersectTriangle(rays, a, b, c, Float8(0.0f), closest);
+			closest = select(hits.hit, hits.distance, closest);
+
+		Notes:
+			- The direction doesn't have to be normalized. Distances are in multiples of it, so
+			  pointAt(hit.distance) is the hit point either way.
+			- A triangle hit at distance t is a + (b - a) * u + (c - a) * v, where u and v are the
+			  barycentric coordinates of b and c. Both faces count as hits; the sign of
+			  (b - a).crossProduct(c - a).dotProduct(direction) says which face was struck.
+			- The triangle test only rejects rays whose determinant is exactly zero, so it doesn't
+			  depend on the scale of the scene. Nearly parallel rays give large or NaN barycentrics,
+			  which fail the range checks.
+			- The box test accepts rays parallel to a slab through the infinite reciprocal of a
+			  zero direction component. A parallel ray lying exactly in a face plane may go either
+			  way. A ray that starts inside the box enters it at minDistance.
+			- The distance, u, v, entry and exit members are only meaningful where hit is set.
+			- The packet versions run the same arithmetic on eight rays against one triangle or
+			  box, without branches, and agree with the single ray versions lane for lane up to
+			  FMA contraction.
+			- Nothing here allocates; crossProduct() and dotProduct() on Vector<3> don't either.
+	*/
+
+	class Ray
+	{
+	private:
+		Vector<3> m_origin;
+		Vector<3> m_direction;
+		Vector<3> m_inverseDirection;
+
+	public:
+		Ray();
+		Ray(const Vector<3>& origin, const Vector<3>& direction);
+
+		const Vector<3>& origin() const;
+		const Vector<3>& direction() const;
+		const Vector<3>& inverseDirection() const;
+
+		Vector<3> pointAt(float) const;
+	};
+
+	class RayPacket
+	{
+	private:
+		Vector3x8 m_origin;
+		Vector3x8 m_direction;
+		Vector3x8 m_inverseDirection;
+
+	public:
+		static RayPacket Load(const Ray*);
+
+		RayPacket();
+		RayPacket(const Vector3x8& origin, const Vector3x8& direction);
+
+		const Vector3x8& origin() const;
+		const Vector3x8& direction() const;
+		const Vector3x8& inverseDirection() const;
+
+		Ray lane(const int) const;
+		Vector3x8 pointAt(const Float8&) const;
+	};
+
+	class AABB
+	{
+	private:
+		Vector<3> m_minimum;
+		Vector<3> m_maximum;
+
+	public:
+		AABB();
+		AABB(const Vector<3>& minimum, const Vector<3>& maximum);
+
+		const Vector<3>& minimum() const;
+		const Vector<3>& maximum() const;
+
+		bool operator ==(const AABB&) const;
+		bool operator !=(const AABB&) const;
+
+		bool isEmpty() const;
+		bool contains(const Vector<3>&) const;
+		Vector<3> center() const;
+		Vector<3> extent() const;
+		float surfaceArea() const;
+
+		void expand(const Vector<3>&);
+		void expand(const AABB&);
+	};
+
+	struct TriangleHit
+	{
+		bool hit;
+		float distance;
+		float u;
+		float v;
+	};
+
+	struct BoxHit
+	{
+		bool hit;
+		float entry;
+		float exit;
+	};
+
+	struct TriangleHit8
+	{
+		Mask8 hit;
+		Float8 distance;
+		Float8 u;
+		Float8 v;
+	};
+
+	struct BoxHit8
+	{
+		Mask8 hit;
+		Float8 entry;
+		Float8 exit;
+	};
+
+	TriangleHit intersectTriangle(const Ray&, const Vector<3>& a, const Vector<3>& b, const Vector<3>& c, float minDistance = 0.0f, float maxDistance = INFINITY);
+	BoxHit intersectBox(const Ray&, const AABB&, float minDistance = 0.0f, float maxDistance = INFINITY);
+	TriangleHit8 intersectTriangle(const RayPacket&, const Vector<3>& a, const Vector<3>& b, const Vector<3>& c, const Float8& minDistance = Float8(0.0f), const Float8& maxDistance = Float8(INFINITY));
+	BoxHit8 intersectBox(const RayPacket&, const AABB&, const Float8& minDistance = Float8(0.0f), const Float8& maxDistance = Float8(INFINITY));
+
+#pragma endregion
+
+#pragma region Ray
+
+	inline Ray::Ray()
+		: m_direction{ 0, 0, 1 }, m_inverseDirection{ INFINITY, INFINITY, 1 }
+	{
+	}
+
+	inline Ray::Ray(const Vector<3>& origin, const Vector<3>& direction)
+		: m_origin(origin), m_direction(direction)
+	{
+		for (int i = 0; i < 3; ++i)
+			m_inverseDirection[i] = 1.0f / direction[i];
+	}
+
+	inline const Vector<3>& Ray::origin() const
+	{
+		return m_origin;
+	}
+
+	inline const Vector<3>& Ray::direction() const
+	{
+		return m_direction;
+	}
+
+	inline const Vector<3>& Ray::inverseDirection() const
+	{
+		return m_inverseDirection;
+	}
+
+	inline Vector<3> Ray::pointAt(float t) const
+	{
+		return m_origin + m_direction * t;
+	}
+
+#pragma endregion
+
+#pragma region Ray Packet
+
+	inline RayPacket RayPacket::Load(const Ray* rays)
+	{
+		Vector<3> origins[8], directions[8];
+		for (int i = 0; i < 8; ++i)
+		{
+			origins[i] = rays[i].origin();
+			directions[i] = rays[i].direction();
+		}
+
+		return RayPacket(Vector3x8::Load(origins), Vector3x8::Load(directions));
+	}
+
+	inline RayPacket::RayPacket()
+		: RayPacket(Vector3x8(Vector<3>()), Vector3x8(Vector<3>{ 0, 0, 1 }))
+	{
+	}
+
+	inline RayPacket::RayPacket(const Vector3x8& origin, const Vector3x8& direction)
+		: m_origin(origin), m_direction(direction)
+	{
+		for (int i = 0; i < 3; ++i)
+			m_inverseDirection[i] = Float8(1.0f) / direction[i];
+	}
+
+	inline const Vector3x8& RayPacket::origin() const
+	{
+		return m_origin;
+	}
+
+	inline const Vector3x8& RayPacket::direction() const
+	{
+		return m_direction;
+	}
+
+	inline const Vector3x8& RayPacket::inverseDirection() const
+	{
+		return m_inverseDirection;
+	}
+
+	inline Ray RayPacket::lane(const int index) const
+	{
+		return Ray(m_origin.lane(index), m_direction.lane(index));
+	}
+
+	inline Vector3x8 RayPacket::pointAt(const Float8& t) const
+	{
+		return m_origin + m_direction * t;
+	}
+
+#pragma endregion
+
+#pragma region Axis Aligned Box
+
+	inline AABB::AABB()
+		: m_minimum{ INFINITY, INFINITY, INFINITY }, m_maximum{ -INFINITY, -INFINITY, -INFINITY }
+	{
+	}
+
+	inline AABB::AABB(const Vector<3>& minimum, const Vector<3>& maximum)
+		: m_minimum(minimum), m_maximum(maximum)
+	{
+	}
+
+	inline const Vector<3>& AABB::minimum() const
+	{
+		return m_minimum;
+	}
+
+	inline const Vector<3>& AABB::maximum() const
+	{
+		return m_maximum;
+	}
+
+	inline bool AABB::operator==(const AABB& box) const
+	{
+		return m_minimum == box.m_minimum && m_maximum == box.m_maximum;
+	}
+
+	inline bool AABB::operator!=(const AABB& box) const
+	{
+		return !(*this == box);
+	}
+
+	inline bool AABB::isEmpty() const
+	{
+		return !(m_minimum[0] <= m_maximum[0] && m_minimum[1] <= m_maximum[1] && m_minimum[2] <= m_maximum[2]);
+	}
+
+	inline bool AABB::contains(const Vector<3>& point) const
+	{
+		for (int i = 0; i < 3; ++i)
+		{
+			if (!(point[i] >= m_minimum[i] && point[i] <= m_maximum[i]))
+				return false;
+		}
+
+		return true;
+	}
+
+	inline Vector<3> AABB::center() const
+	{
+		return (m_minimum + m_maximum) * 0.5f;
+	}
+
+	inline Vector<3> AABB::extent() const
+	{
+		return m_maximum - m_minimum;
+	}
+
+	inline float AABB::surfaceArea() const
+	{
+		if (isEmpty())
+			return 0.0f;
+
+		Vector<3> e = extent();
+		return 2.0f * (e[0] * e[1] + e[1] * e[2] + e[2] * e[0]);
+	}
+
+	inline void AABB::expand(const Vector<3>& point)
+	{
+		for (int i = 0; i < 3; ++i)
+		{
+			m_minimum[i] = std::min(m_minimum[i], point[i]);
+			m_maximum[i] = std::max(m_maximum[i], point[i]);
+		}
+	}
+
+	inline void AABB::expand(const AABB& box)
+	{
+		for (int i = 0; i < 3; ++i)
+		{
+			m_minimum[i] = std::min(m_minimum[i], box.m_minimum[i]);
+			m_maximum[i] = std::max(m_maximum[i], box.m_maximum[i]);
+		}
+	}
+
+#pragma endregion
+
+#pragma region Intersection Kernels
+
+	inline TriangleHit intersectTriangle(const Ray& ray, const Vector<3>& a, const Vector<3>& b, const Vector<3>& c, float minDistance, float maxDistance)
+	{
+		const TriangleHit miss = { false, 0.0f, 0.0f, 0.0f };
+
+		const Vector<3> edge1 = b - a;
+		const Vector<3> edge2 = c - a;
+		const Vector<3> p = ray.direction().crossProduct(edge2);
+		const float determinant = edge1.dotProduct(p);
+		if (determinant == 0.0f)
+			return miss;
+
+		// The comparisons are written to fail on NaN
+		const float inverse = 1.0f / determinant;
+		const Vector<3> s = ray.origin() - a;
+		const float u = s.dotProduct(p) * inverse;
+		if (!(u >= 0.0f && u <= 1.0f))
+			return miss;
+
+		const Vector<3> q = s.crossProduct(edge1);
+		const float v = ray.direction().dotProduct(q) * inverse;
+		if (!(v >= 0.0f && u + v <= 1.0f))
+			return miss;
+
+		const float t = edge2.dotProduct(q) * inverse;
+		if (!(t >= minDistance && t <= maxDistance))
+			return miss;
+
+		return { true, t, u, v };
+	}
+
+	inline BoxHit intersectBox(const Ray& ray, const AABB& box, float minDistance, float maxDistance)
+	{
+		float entry = minDistance, exit = maxDistance;
+
+		for (int i = 0; i < 3; ++i)
+		{
+			const float slabNear = (box.minimum()[i] - ray.origin()[i]) * ray.inverseDirection()[i];
+			const float slabFar = (box.maximum()[i] - ray.origin()[i]) * ray.inverseDirection()[i];
+
+			// Without branches, which mispredict on rays in every direction
+			entry = std::max(entry, std::min(slabNear, slabFar));
+			exit = std::min(exit, std::max(slabNear, slabFar));
+		}
+
+		return { entry <= exit, entry, exit };
+	}
+
+	inline TriangleHit8 intersectTriangle(const RayPacket& rays, const Vector<3>& a, const Vector<3>& b, const Vector<3>& c, const Float8& minDistance, const Float8& maxDistance)
+	{
+		const Vector3x8 edge1(b - a);
+		const Vector3x8 edge2(c - a);
+		const Vector3x8 p = rays.direction().crossProduct(edge2);
+		const Float8 determinant = edge1.dotProduct(p);
+
+		const Float8 inverse = Float8(1.0f) / determinant;
+		const Vector3x8 s = rays.origin() - Vector3x8(a);
+		const Float8 u = s.dotProduct(p) * inverse;
+		const Vector3x8 q = s.crossProduct(edge1);
+		const Float8 v = rays.direction().dotProduct(q) * inverse;
+		const Float8 t = edge2.dotProduct(q) * inverse;
+
+		// A zero determinant makes u, v and t infinite or NaN, and those fail these comparisons
+		const Float8 zero(0.0f), one(1.0f);
+		Mask8 hit = (u >= zero) & (v >= zero) & (u + v <= one) & (t >= minDistance) & (t <= maxDistance);
+
+		return { hit, t, u, v };
+	}
+
+	inline BoxHit8 intersectBox(const RayPacket& rays, const AABB& box, const Float8& minDistance, const Float8& maxDistance)
+	{
+		Float8 entry = minDistance, exit = maxDistance;
+
+		for (int i = 0; i < 3; ++i)
+		{
+			const Float8 slabNear = (Float8(box.minimum()[i]) - rays.origin()[i]) * rays.inverseDirection()[i];
+			const Float8 slabFar = (Float8(box.maximum()[i]) - rays.origin()[i]) * rays.inverseDirection()[i];
+
+			entry = maximum(entry, minimum(slabNear, slabFar));
+			exit = minimum(exit, maximum(slabNear, slabFar));
+		}
+
+		return { entry <= exit, entry, exit };
+	}
+
+#pragma endregion
+
+}
+
+#endif
@@ -0,0 +1,843 @@
+#ifndef SIMD_H
+#define SIMD_H
+
+/* -------------------------------------------------------------------------------------------------
+	Copyright 2017 Shealyn Tate Hindenlang
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+	and associated documentation files (the "Software"), to deal in the Software without restriction,
+	including without limitation the rights to use, copy, modify, merge, publish, distribute,
+	sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all copies or
+	substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+	BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+	NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+	DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+	-------------------------------------------------------------------------------------------------
+
+	SIMD.h holds the low level kernels behind the Matrix<4, 4> and Quaternion products. All matrix
+	kernels work on raw column-major float blocks, the same layout Matrix::data() exposes, and
+	quaternions are four floats in (x, y, z, w) order.
+
+	Kernels:
+		multiply4x4(a, b, out)		out = a * b
+		transform4x4(m, v, out)		out = m * v
+		inverse4x4(m, out)			out = inverse(m), returns det(m)
+		affineInverse4x4(m, out)	out = inverse(m) for m = [R|t; 0 1], returns det(R)
+		multiplyQuaternion(a, b, out)	out = a * b
+		multiplyBlocked(a, b, out, rows, inner, cols)
+									out = a * b for a rows x inner and b inner x cols
+		multiplyBlocked(a, lda, b, ldb, out, ldo, rows, inner, cols, alpha, accumulate)
+									out (+)= alpha * a * b on blocks of larger matrices
+		multiplyVector(a, lda, x, out, rows, cols, accumulate)
+									out (+)= a * x for a rows x cols
+
+	Notes:
+		- The instruction set is picked at compile time from the compiler's target flags. AVX is
+		  used when __AVX__ is defined, SSE on any x86/x64 target, and FMA instructions when
+		  __FMA__ is defined. Everything else uses the scalar versions.
+		- Define GRAPHICSMATH_NO_SIMD to force the scalar versions on every target.
+		- The scalar versions are always available in SIMD::Scalar so results can be compared
+		  against them. They are constexpr, and callers use GRAPHICSMATH_CONSTANT_EVALUATED() to
+		  switch to them inside constant expressions, where intrinsics can't run.
+		- out must not alias either input.
+		- The inverse kernels don't check the determinant; out is only meaningful when the returned
+		  value is nonzero.
+		- affineInverse4x4 reads only R and t and always writes a bottom row of [0 0 0 1], so it
+		  must only be used on matrices whose bottom row already is [0 0 0 1].
+		- multiplyBlocked is a cache blocked GEMM for the larger matrices. It copies a block of a
+		  that fits in L2 into tiles laid out in the order the inner kernel reads them, then
+		  multiplies each tile by narrow panels of b, which stay in L1, into a block of out held
+		  in registers. Scalar::multiply is the plain triple loop it is checked against.
+		- The leading dimension versions take the distance between columns separately from the
+		  block size, which is what the DenseMatrix factorizations use to update the trailing part
+		  of a matrix in place. alpha is folded into the copy of a, so it costs nothing per flop.
+		- SIMD::Wide wraps one register of consecutive floats (8 with AVX, 4 with SSE, 1 without)
+		  for loops over long arrays, with load and store versions that take a count for the
+		  last, partial register. The GEMM kernels and VectorStream are written against it.
+		  Comparisons return a Wide::Mask of all set or all clear lanes (a bool without SIMD);
+		  maskBits packs one bit per lane, lane 0 lowest, and minimum/maximum return b when
+		  either input is NaN, as the SSE instructions do.
+*/
+
+#if !defined(GRAPHICSMATH_NO_SIMD)
+	#if defined(__AVX__)
+		#define GRAPHICSMATH_AVX
+	#endif
+	#if defined(__FMA__)
+		#define GRAPHICSMATH_FMA
+	#endif
+	#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+		#define GRAPHICSMATH_SSE
+	#endif
+#endif
+
+// True while the compiler evaluates a constant expression. Compilers without the builtin always
+// take the runtime path, so the SIMD backed Matrix operations aren't usable in constant expressions
+#if defined(__has_builtin)
+	#if __has_builtin(__builtin_is_constant_evaluated)
+		#define GRAPHICSMATH_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+	#endif
+#endif
+#if !defined(GRAPHICSMATH_CONSTANT_EVALUATED) && ((defined(__GNUC__) && __GNUC__ >= 9) || (defined(_MSC_VER) && _MSC_VER >= 1925))
+	#define GRAPHICSMATH_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#endif
+#if !defined(GRAPHICSMATH_CONSTANT_EVALUATED)
+	#define GRAPHICSMATH_CONSTANT_EVALUATED() false
+#endif
+
+#include <cmath>
+
+#if defined(GRAPHICSMATH_AVX) || defined(GRAPHICSMATH_FMA)
+	#include <immintrin.h>
+#elif defined(GRAPHICSMATH_SSE)
+	#include <xmmintrin.h>
+#endif
+
+namespace GraphicsMath
+{
+namespace SIMD
+{
+
+#pragma region Scalar Kernels
+
+	namespace Scalar
+	{
+		constexpr void multiply4x4(const float* a, const float* b, float* out)
+		{
+			for (int i = 0; i < 4; ++i)
+			{
+				for (int j = 0; j < 4; ++j)
+				{
+					float sum = 0;
+
+					for (int k = 0; k < 4; ++k)
+						sum += a[k * 4 + j] * b[i * 4 + k];
+
+					out[i * 4 + j] = sum;
+				}
+			}
+		}
+
+		constexpr void transform4x4(const float* m, const float* v, float* out)
+		{
+			for (int j = 0; j < 4; ++j)
+				out[j] = m[j] * v[0] + m[4 + j] * v[1] + m[8 + j] * v[2] + m[12 + j] * v[3];
+		}
+
+		// Cofactor expansion that shares the twelve 2x2 sub-determinants of the top and bottom
+		// halves between all sixteen cofactors. The inverse of the transpose is the transpose of the
+		// inverse, so the same formula works whether the block is read by rows or by columns.
+		constexpr float inverse4x4(const float* m, float* out)
+		{
+			float s0 = m[0] * m[5] - m[4] * m[1];
+			float s1 = m[0] * m[6] - m[4] * m[2];
+			float s2 = m[0] * m[7] - m[4] * m[3];
+			float s3 = m[1] * m[6] - m[5] * m[2];
+			float s4 = m[1] * m[7] - m[5] * m[3];
+			float s5 = m[2] * m[7] - m[6] * m[3];
+
+			float c5 = m[10] * m[15] - m[14] * m[11];
+			float c4 = m[9] * m[15] - m[13] * m[11];
+			float c3 = m[9] * m[14] - m[13] * m[10];
+			float c2 = m[8] * m[15] - m[12] * m[11];
+			float c1 = m[8] * m[14] - m[12] * m[10];
+			float c0 = m[8] * m[13] - m[12] * m[9];
+
+			float det = s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+			float invDet = 1.0f / det;
+
+			out[0] = (m[5] * c5 - m[6] * c4 + m[7] * c3) * invDet;
+			out[1] = (-m[1] * c5 + m[2] * c4 - m[3] * c3) * invDet;
+			out[2] = (m[13] * s5 - m[14] * s4 + m[15] * s3) * invDet;
+			out[3] = (-m[9] * s5 + m[10] * s4 - m[11] * s3) * invDet;
+
+			out[4] = (-m[4] * c5 + m[6] * c2 - m[7] * c1) * invDet;
+			out[5] = (m[0] * c5 - m[2] * c2 + m[3] * c1) * invDet;
+			out[6] = (-m[12] * s5 + m[14] * s2 - m[15] * s1) * invDet;
+			out[7] = (m[8] * s5 - m[10] * s2 + m[11] * s1) * invDet;
+
+			out[8] = (m[4] * c4 - m[5] * c2 + m[7] * c0) * invDet;
+			out[9] = (-m[0] * c4 + m[1] * c2 - m[3] * c0) * invDet;
+			out[10] = (m[12] * s4 - m[13] * s2 + m[15] * s0) * invDet;
+			out[11] = (-m[8] * s4 + m[9] * s2 - m[11] * s0) * invDet;
+
+			out[12] = (-m[4] * c3 + m[5] * c1 - m[6] * c0) * invDet;
+			out[13] = (m[0] * c3 - m[1] * c1 + m[2] * c0) * invDet;
+			out[14] = (-m[12] * s3 + m[13] * s1 - m[14] * s0) * invDet;
+			out[15] = (m[8] * s3 - m[9] * s1 + m[10] * s0) * invDet;
+
+			return det;
+		}
+
+		// The rows of inverse(R) are the cross products of its columns over det(R), and the new
+		// translation is -inverse(R) * t
+		constexpr float affineInverse4x4(const float* m, float* out)
+		{
+			float r0[3] = { m[5] * m[10] - m[6] * m[9], m[6] * m[8] - m[4] * m[10], m[4] * m[9] - m[5] * m[8] };
+			float r1[3] = { m[9] * m[2] - m[10] * m[1], m[10] * m[0] - m[8] * m[2], m[8] * m[1] - m[9] * m[0] };
+			float r2[3] = { m[1] * m[6] - m[2] * m[5], m[2] * m[4] - m[0] * m[6], m[0] * m[5] - m[1] * m[4] };
+
+			float det = m[0] * r0[0] + m[1] * r0[1] + m[2] * r0[2];
+			float invDet = 1.0f / det;
+
+			for (int j = 0; j < 3; ++j)
+			{
+				out[j * 4] = r0[j] * invDet;
+				out[j * 4 + 1] = r1[j] * invDet;
+				out[j * 4 + 2] = r2[j] * invDet;
+				out[j * 4 + 3] = 0.0f;
+			}
+
+			for (int i = 0; i < 3; ++i)
+				out[12 + i] = -(out[i] * m[12] + out[4 + i] * m[13] + out[8 + i] * m[14]);
+
+			out[15] = 1.0f;
+
+			return det;
+		}
+
+		constexpr void multiply(const float* a, const float* b, float* out, int rows, int inner, int cols)
+		{
+			for (int j = 0; j < cols; ++j)
+			{
+				for (int i = 0; i < rows; ++i)
+					out[j * rows + i] = 0;
+
+				for (int k = 0; k < inner; ++k)
+				{
+					float s = b[j * inner + k];
+
+					for (int i = 0; i < rows; ++i)
+						out[j * rows + i] += a[k * rows + i] * s;
+				}
+			}
+		}
+
+		constexpr void multiplyQuaternion(const float* a, const float* b, float* out)
+		{
+			out[0] = a[3] * b[0] + a[0] * b[3] + a[1] * b[2] - a[2] * b[1];
+			out[1] = a[3] * b[1] - a[0] * b[2] + a[1] * b[3] + a[2] * b[0];
+			out[2] = a[3] * b[2] + a[0] * b[1] - a[1] * b[0] + a[2] * b[3];
+			out[3] = a[3] * b[3] - a[0] * b[0] - a[1] * b[1] - a[2] * b[2];
+		}
+	}
+
+#pragma endregion
+
+#pragma region SSE Helpers
+
+#if defined(GRAPHICSMATH_SSE)
+
+	// Returns acc + a * b, fused when FMA is available
+	inline __m128 multiplyAdd(__m128 a, __m128 b, __m128 acc)
+	{
+#if defined(GRAPHICSMATH_FMA)
+		return _mm_fmadd_ps(a, b, acc);
+#else
+		return _mm_add_ps(_mm_mul_ps(a, b), acc);
+#endif
+	}
+
+	// Returns a where mask is set and b elsewhere
+	inline __m128 select(__m128 mask, __m128 a, __m128 b)
+	{
+		return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+	}
+
+	// Combines the four columns of m weighted by the four components of v
+	inline __m128 linearCombination(const __m128 m[4], __m128 v)
+	{
+		__m128 r = _mm_mul_ps(m[0], _mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 0)));
+		r = multiplyAdd(m[1], _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1)), r);
+		r = multiplyAdd(m[2], _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2)), r);
+		r = multiplyAdd(m[3], _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3)), r);
+
+		return r;
+	}
+
+	// Adds the four lanes of v and broadcasts the sum to every lane
+	inline __m128 horizontalSum(__m128 v)
+	{
+		v = _mm_add_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1)));
+		return _mm_add_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 0, 3, 2)));
+	}
+
+	// Returns a x b in the xyz lanes and 0 in w
+	inline __m128 cross(__m128 a, __m128 b)
+	{
+		__m128 aYZX = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 2, 1));
+		__m128 bYZX = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 2, 1));
+		__m128 r = _mm_sub_ps(_mm_mul_ps(a, bYZX), _mm_mul_ps(aYZX, b));
+
+		return _mm_shuffle_ps(r, r, _MM_SHUFFLE(3, 0, 2, 1));
+	}
+
+	// The 2x2 helpers below work on 2x2 matrices packed into one register as (m00, m01, m10, m11)
+
+	// Returns a * b
+	inline __m128 multiply2x2(__m128 a, __m128 b)
+	{
+		return _mm_add_ps(_mm_mul_ps(a, _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 3, 0))),
+						  _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 2, 1, 2))));
+	}
+
+	// Returns adjugate(a) * b
+	inline __m128 adjugateMultiply2x2(__m128 a, __m128 b)
+	{
+		return _mm_sub_ps(_mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(0, 0, 3, 3)), b),
+						  _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 2, 1, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 0, 3, 2))));
+	}
+
+	// Returns a * adjugate(b)
+	inline __m128 multiplyAdjugate2x2(__m128 a, __m128 b)
+	{
+		return _mm_sub_ps(_mm_mul_ps(a, _mm_shuffle_ps(b, b, _MM_SHUFFLE(0, 3, 0, 3))),
+						  _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 2, 1, 2))));
+	}
+
+#endif
+
+#pragma endregion
+
+#pragma region AVX Helpers
+
+#if defined(GRAPHICSMATH_AVX)
+
+	// Returns acc + a * b, fused when FMA is available
+	inline __m256 multiplyAdd(__m256 a, __m256 b, __m256 acc)
+	{
+#if defined(GRAPHICSMATH_FMA)
+		return _mm256_fmadd_ps(a, b, acc);
+#else
+		return _mm256_add_ps(_mm256_mul_ps(a, b), acc);
+#endif
+	}
+
+	// Returns a where mask is set and b elsewhere
+	inline __m256 select(__m256 mask, __m256 a, __m256 b)
+	{
+		return _mm256_blendv_ps(b, a, mask);
+	}
+
+#endif
+
+#pragma endregion
+
+#pragma region Kernels
+
+	inline void multiply4x4(const float* a, const float* b, float* out)
+	{
+#if defined(GRAPHICSMATH_AVX)
+		// Each 256 bit register holds two columns of b, and each column of a is duplicated into
+		// both 128 bit lanes so two output columns are built at once.
+		__m256 a0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(a));
+		__m256 a1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(a + 4));
+		__m256 a2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(a + 8));
+		__m256 a3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(a + 12));
+
+		for (int i = 0; i < 16; i += 8)
+		{
+			__m256 b01 = _mm256_loadu_ps(b + i);
+			__m256 r = _mm256_mul_ps(a0, _mm256_permute_ps(b01, _MM_SHUFFLE(0, 0, 0, 0)));
+#if defined(GRAPHICSMATH_FMA)
+			r = _mm256_fmadd_ps(a1, _mm256_permute_ps(b01, _MM_SHUFFLE(1, 1, 1, 1)), r);
+			r = _mm256_fmadd_ps(a2, _mm256_permute_ps(b01, _MM_SHUFFLE(2, 2, 2, 2)), r);
+			r = _mm256_fmadd_ps(a3, _mm256_permute_ps(b01, _MM_SHUFFLE(3, 3, 3, 3)), r);
+#else
+			r = _mm256_add_ps(_mm256_mul_ps(a1, _mm256_permute_ps(b01, _MM_SHUFFLE(1, 1, 1, 1))), r);
+			r = _mm256_add_ps(_mm256_mul_ps(a2, _mm256_permute_ps(b01, _MM_SHUFFLE(2, 2, 2, 2))), r);
+			r = _mm256_add_ps(_mm256_mul_ps(a3, _mm256_permute_ps(b01, _MM_SHUFFLE(3, 3, 3, 3))), r);
+#endif
+			_mm256_storeu_ps(out + i, r);
+		}
+#elif defined(GRAPHICSMATH_SSE)
+		const __m128 cols[4] = { _mm_loadu_ps(a), _mm_loadu_ps(a + 4), _mm_loadu_ps(a + 8), _mm_loadu_ps(a + 12) };
+
+		for (int i = 0; i < 16; i += 4)
+			_mm_storeu_ps(out + i, linearCombination(cols, _mm_loadu_ps(b + i)));
+#else
+		Scalar::multiply4x4(a, b, out);
+#endif
+	}
+
+	inline void transform4x4(const float* m, const float* v, float* out)
+	{
+#if defined(GRAPHICSMATH_SSE)
+		const __m128 cols[4] = { _mm_loadu_ps(m), _mm_loadu_ps(m + 4), _mm_loadu_ps(m + 8), _mm_loadu_ps(m + 12) };
+
+		_mm_storeu_ps(out, linearCombination(cols, _mm_loadu_ps(v)));
+#else
+		Scalar::transform4x4(m, v, out);
+#endif
+	}
+
+	inline float inverse4x4(const float* m, float* out)
+	{
+#if defined(GRAPHICSMATH_SSE)
+		// Block inverse of [A B; C D] built from 2x2 adjugates, so every 2x2 sub-determinant is
+		// computed once. Like the scalar version it doesn't matter whether the registers hold rows
+		// or columns.
+		__m128 r0 = _mm_loadu_ps(m);
+		__m128 r1 = _mm_loadu_ps(m + 4);
+		__m128 r2 = _mm_loadu_ps(m + 8);
+		__m128 r3 = _mm_loadu_ps(m + 12);
+
+		__m128 a = _mm_movelh_ps(r0, r1);
+		__m128 b = _mm_movehl_ps(r1, r0);
+		__m128 c = _mm_movelh_ps(r2, r3);
+		__m128 d = _mm_movehl_ps(r3, r2);
+
+		// (det A, det B, det C, det D)
+		__m128 detSub = _mm_sub_ps(
+			_mm_mul_ps(_mm_shuffle_ps(r0, r2, _MM_SHUFFLE(2, 0, 2, 0)), _mm_shuffle_ps(r1, r3, _MM_SHUFFLE(3, 1, 3, 1))),
+			_mm_mul_ps(_mm_shuffle_ps(r0, r2, _MM_SHUFFLE(3, 1, 3, 1)), _mm_shuffle_ps(r1, r3, _MM_SHUFFLE(2, 0, 2, 0))));
+		__m128 detA = _mm_shuffle_ps(detSub, detSub, _MM_SHUFFLE(0, 0, 0, 0));
+		__m128 detB = _mm_shuffle_ps(detSub, detSub, _MM_SHUFFLE(1, 1, 1, 1));
+		__m128 detC = _mm_shuffle_ps(detSub, detSub, _MM_SHUFFLE(2, 2, 2, 2));
+		__m128 detD = _mm_shuffle_ps(detSub, detSub, _MM_SHUFFLE(3, 3, 3, 3));
+
+		__m128 dc = adjugateMultiply2x2(d, c);
+		__m128 ab = adjugateMultiply2x2(a, b);
+
+		// Adjugates of the four blocks of the inverse
+		__m128 x = _mm_sub_ps(_mm_mul_ps(detD, a), multiply2x2(b, dc));
+		__m128 w = _mm_sub_ps(_mm_mul_ps(detA, d), multiply2x2(c, ab));
+		__m128 y = _mm_sub_ps(_mm_mul_ps(detB, c), multiplyAdjugate2x2(d, ab));
+		__m128 z = _mm_sub_ps(_mm_mul_ps(detC, b), multiplyAdjugate2x2(a, dc));
+
+		// det M = det A * det D + det B * det C - trace(adj(A) B adj(D) C)
+		__m128 trace = horizontalSum(_mm_mul_ps(ab, _mm_shuffle_ps(dc, dc, _MM_SHUFFLE(3, 1, 2, 0))));
+		__m128 det = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(detA, detD), _mm_mul_ps(detB, detC)), trace);
+
+		__m128 invDet = _mm_div_ps(_mm_setr_ps(1.0f, -1.0f, -1.0f, 1.0f), det);
+		x = _mm_mul_ps(x, invDet);
+		y = _mm_mul_ps(y, invDet);
+		z = _mm_mul_ps(z, invDet);
+		w = _mm_mul_ps(w, invDet);
+
+		// The shuffles apply the final 2x2 adjugate and reassemble the blocks in one step
+		_mm_storeu_ps(out, _mm_shuffle_ps(x, y, _MM_SHUFFLE(1, 3, 1, 3)));
+		_mm_storeu_ps(out + 4, _mm_shuffle_ps(x, y, _MM_SHUFFLE(0, 2, 0, 2)));
+		_mm_storeu_ps(out + 8, _mm_shuffle_ps(z, w, _MM_SHUFFLE(1, 3, 1, 3)));
+		_mm_storeu_ps(out + 12, _mm_shuffle_ps(z, w, _MM_SHUFFLE(0, 2, 0, 2)));
+
+		return _mm_cvtss_f32(det);
+#else
+		return Scalar::inverse4x4(m, out);
+#endif
+	}
+
+	inline float affineInverse4x4(const float* m, float* out)
+	{
+#if defined(GRAPHICSMATH_SSE)
+		__m128 c0 = _mm_loadu_ps(m);
+		__m128 c1 = _mm_loadu_ps(m + 4);
+		__m128 c2 = _mm_loadu_ps(m + 8);
+		__m128 t = _mm_loadu_ps(m + 12);
+
+		// Rows of inverse(R), scaled by det(R)
+		__m128 r0 = cross(c1, c2);
+		__m128 r1 = cross(c2, c0);
+		__m128 r2 = cross(c0, c1);
+		__m128 r3 = _mm_setzero_ps();
+
+		__m128 det = horizontalSum(_mm_mul_ps(c0, r0));
+		__m128 invDet = _mm_div_ps(_mm_set1_ps(1.0f), det);
+		r0 = _mm_mul_ps(r0, invDet);
+		r1 = _mm_mul_ps(r1, invDet);
+		r2 = _mm_mul_ps(r2, invDet);
+
+		_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+
+		// [0 0 0 1] - inverse(R) * t, the w lanes of r0..r2 are zero after the transpose
+		__m128 translation = _mm_mul_ps(r0, _mm_shuffle_ps(t, t, _MM_SHUFFLE(0, 0, 0, 0)));
+		translation = multiplyAdd(r1, _mm_shuffle_ps(t, t, _MM_SHUFFLE(1, 1, 1, 1)), translation);
+		translation = multiplyAdd(r2, _mm_shuffle_ps(t, t, _MM_SHUFFLE(2, 2, 2, 2)), translation);
+
+		_mm_storeu_ps(out, r0);
+		_mm_storeu_ps(out + 4, r1);
+		_mm_storeu_ps(out + 8, r2);
+		_mm_storeu_ps(out + 12, _mm_sub_ps(_mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f), translation));
+
+		return _mm_cvtss_f32(det);
+#else
+		return Scalar::affineInverse4x4(m, out);
+#endif
+	}
+
+	inline void multiplyQuaternion(const float* a, const float* b, float* out)
+	{
+#if defined(GRAPHICSMATH_SSE)
+		// Each component of a scales a signed permutation of b:
+		// a * b = aw (bx, by, bz, bw) + ax (bw, -bz, by, -bx) + ay (bz, bw, -bx, -by) + az (-by, bx, bw, -bz)
+		__m128 va = _mm_loadu_ps(a);
+		__m128 vb = _mm_loadu_ps(b);
+
+		__m128 bx = _mm_xor_ps(_mm_shuffle_ps(vb, vb, _MM_SHUFFLE(0, 1, 2, 3)), _mm_setr_ps(0.0f, -0.0f, 0.0f, -0.0f));
+		__m128 by = _mm_xor_ps(_mm_shuffle_ps(vb, vb, _MM_SHUFFLE(1, 0, 3, 2)), _mm_setr_ps(0.0f, 0.0f, -0.0f, -0.0f));
+		__m128 bz = _mm_xor_ps(_mm_shuffle_ps(vb, vb, _MM_SHUFFLE(2, 3, 0, 1)), _mm_setr_ps(-0.0f, 0.0f, 0.0f, -0.0f));
+
+		__m128 r = _mm_mul_ps(_mm_shuffle_ps(va, va, _MM_SHUFFLE(3, 3, 3, 3)), vb);
+		r = multiplyAdd(_mm_shuffle_ps(va, va, _MM_SHUFFLE(0, 0, 0, 0)), bx, r);
+		r = multiplyAdd(_mm_shuffle_ps(va, va, _MM_SHUFFLE(1, 1, 1, 1)), by, r);
+		r = multiplyAdd(_mm_shuffle_ps(va, va, _MM_SHUFFLE(2, 2, 2, 2)), bz, r);
+
+		_mm_storeu_ps(out, r);
+#else
+		Scalar::multiplyQuaternion(a, b, out);
+#endif
+	}
+
+#pragma endregion
+
+#pragma region Lane Helpers
+
+	// One register's worth of consecutive floats, for loops over long arrays. The same operations
+	// compile to AVX, SSE or plain floats, so each loop is written once for every target.
+	namespace Wide
+	{
+#if defined(GRAPHICSMATH_AVX)
+		typedef __m256 Lanes;
+		const int LaneCount = 8;
+
+		inline Lanes zero() { return _mm256_setzero_ps(); }
+		inline Lanes load(const float* p) { return _mm256_loadu_ps(p); }
+		inline Lanes broadcast(float f) { return _mm256_set1_ps(f); }
+		inline void store(float* p, Lanes v) { _mm256_storeu_ps(p, v); }
+		inline Lanes add(Lanes a, Lanes b) { return _mm256_add_ps(a, b); }
+		inline Lanes subtract(Lanes a, Lanes b) { return _mm256_sub_ps(a, b); }
+		inline Lanes multiply(Lanes a, Lanes b) { return _mm256_mul_ps(a, b); }
+		inline Lanes divide(Lanes a, Lanes b) { return _mm256_div_ps(a, b); }
+		inline Lanes squareRoot(Lanes a) { return _mm256_sqrt_ps(a); }
+		inline Lanes reciprocalSquareRootEstimate(Lanes a) { return _mm256_rsqrt_ps(a); }
+		inline Lanes multiplyAdd(Lanes a, Lanes b, Lanes acc) { return SIMD::multiplyAdd(a, b, acc); }
+		inline Lanes divideNonZero(Lanes a, Lanes b) { return SIMD::select(_mm256_cmp_ps(b, zero(), _CMP_NEQ_UQ), divide(a, b), a); }
+		inline Lanes minimum(Lanes a, Lanes b) { return _mm256_min_ps(a, b); }
+		inline Lanes maximum(Lanes a, Lanes b) { return _mm256_max_ps(a, b); }
+
+		typedef __m256 Mask;
+
+		inline Mask less(Lanes a, Lanes b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+		inline Mask lessEqual(Lanes a, Lanes b) { return _mm256_cmp_ps(a, b, _CMP_LE_OQ); }
+		inline Mask equal(Lanes a, Lanes b) { return _mm256_cmp_ps(a, b, _CMP_EQ_OQ); }
+		inline Mask notEqual(Lanes a, Lanes b) { return _mm256_cmp_ps(a, b, _CMP_NEQ_UQ); }
+		inline Mask maskAnd(Mask a, Mask b) { return _mm256_and_ps(a, b); }
+		inline Mask maskOr(Mask a, Mask b) { return _mm256_or_ps(a, b); }
+		inline Mask maskNot(Mask a) { return _mm256_xor_ps(a, _mm256_castsi256_ps(_mm256_set1_epi32(-1))); }
+		inline Mask maskBroadcast(bool b) { return _mm256_castsi256_ps(_mm256_set1_epi32(b ? -1 : 0)); }
+		inline int maskBits(Mask m) { return _mm256_movemask_ps(m); }
+		inline Lanes select(Mask m, Lanes a, Lanes b) { return SIMD::select(m, a, b); }
+#elif defined(GRAPHICSMATH_SSE)
+		typedef __m128 Lanes;
+		const int LaneCount = 4;
+
+		inline Lanes zero() { return _mm_setzero_ps(); }
+		inline Lanes load(const float* p) { return _mm_loadu_ps(p); }
+		inline Lanes broadcast(float f) { return _mm_set1_ps(f); }
+		inline void store(float* p, Lanes v) { _mm_storeu_ps(p, v); }
+		inline Lanes add(Lanes a, Lanes b) { return _mm_add_ps(a, b); }
+		inline Lanes subtract(Lanes a, Lanes b) { return _mm_sub_ps(a, b); }
+		inline Lanes multiply(Lanes a, Lanes b) { return _mm_mul_ps(a, b); }
+		inline Lanes divide(Lanes a, Lanes b) { return _mm_div_ps(a, b); }
+		inline Lanes squareRoot(Lanes a) { return _mm_sqrt_ps(a); }
+		inline Lanes reciprocalSquareRootEstimate(Lanes a) { return _mm_rsqrt_ps(a); }
+		inline Lanes multiplyAdd(Lanes a, Lanes b, Lanes acc) { return SIMD::multiplyAdd(a, b, acc); }
+		inline Lanes divideNonZero(Lanes a, Lanes b) { return SIMD::select(_mm_cmpneq_ps(b, zero()), divide(a, b), a); }
+		inline Lanes minimum(Lanes a, Lanes b) { return _mm_min_ps(a, b); }
+		inline Lanes maximum(Lanes a, Lanes b) { return _mm_max_ps(a, b); }
+
+		typedef __m128 Mask;
+
+		inline Mask less(Lanes a, Lanes b) { return _mm_cmplt_ps(a, b); }
+		inline Mask lessEqual(Lanes a, Lanes b) { return _mm_cmple_ps(a, b); }
+		inline Mask equal(Lanes a, Lanes b) { return _mm_cmpeq_ps(a, b); }
+		inline Mask notEqual(Lanes a, Lanes b) { return _mm_cmpneq_ps(a, b); }
+		inline Mask maskAnd(Mask a, Mask b) { return _mm_and_ps(a, b); }
+		inline Mask maskOr(Mask a, Mask b) { return _mm_or_ps(a, b); }
+		inline Mask maskNot(Mask a) { return _mm_xor_ps(a, _mm_cmpeq_ps(zero(), zero())); }
+		inline Mask maskBroadcast(bool b) { return b ? _mm_cmpeq_ps(zero(), zero()) : zero(); }
+		inline int maskBits(Mask m) { return _mm_movemask_ps(m); }
+		inline Lanes select(Mask m, Lanes a, Lanes b) { return SIMD::select(m, a, b); }
+#else
+		typedef float Lanes;
+		const int LaneCount = 1;
+
+		inline Lanes zero() { return 0.0f; }
+		inline Lanes load(const float* p) { return *p; }
+		inline Lanes broadcast(float f) { return f; }
+		inline void store(float* p, Lanes v) { *p = v; }
+		inline Lanes add(Lanes a, Lanes b) { return a + b; }
+		inline Lanes subtract(Lanes a, Lanes b) { return a - b; }
+		inline Lanes multiply(Lanes a, Lanes b) { return a * b; }
+		inline Lanes divide(Lanes a, Lanes b) { return a / b; }
+		inline Lanes squareRoot(Lanes a) { return std::sqrt(a); }
+		inline Lanes reciprocalSquareRootEstimate(Lanes a) { return 1.0f / std::sqrt(a); }
+		inline Lanes multiplyAdd(Lanes a, Lanes b, Lanes acc) { return a * b + acc; }
+		inline Lanes divideNonZero(Lanes a, Lanes b) { return b != 0 ? a / b : a; }
+		inline Lanes minimum(Lanes a, Lanes b) { return a < b ? a : b; }
+		inline Lanes maximum(Lanes a, Lanes b) { return a > b ? a : b; }
+
+		typedef bool Mask;
+
+		inline Mask less(Lanes a, Lanes b) { return a < b; }
+		inline Mask lessEqual(Lanes a, Lanes b) { return a <= b; }
+		inline Mask equal(Lanes a, Lanes b) { return a == b; }
+		inline Mask notEqual(Lanes a, Lanes b) { return a != b; }
+		inline Mask maskAnd(Mask a, Mask b) { return a && b; }
+		inline Mask maskOr(Mask a, Mask b) { return a || b; }
+		inline Mask maskNot(Mask a) { return !a; }
+		inline Mask maskBroadcast(bool b) { return b; }
+		inline int maskBits(Mask m) { return m ? 1 : 0; }
+		inline Lanes select(Mask m, Lanes a, Lanes b) { return m ? a : b; }
+#endif
+
+		// 1 / sqrt(a) from the hardware estimate and one Newton-Raphson step, as in
+		// FastMath::reciprocalSquareRoot. The scalar estimate is already exact, so it skips the step.
+		inline Lanes reciprocalSquareRoot(Lanes a)
+		{
+			Lanes estimate = reciprocalSquareRootEstimate(a);
+			if (LaneCount == 1)
+				return estimate;
+
+			Lanes error = subtract(broadcast(1.0f), multiply(multiply(a, estimate), estimate));
+			return multiplyAdd(multiply(broadcast(0.5f), estimate), error, estimate);
+		}
+
+		// The first count floats at p, for the tail of an array; the lanes past count are zero
+		inline Lanes load(const float* p, int count)
+		{
+			if (count == LaneCount)
+				return load(p);
+
+			alignas(32) float lanes[LaneCount] = {};
+			for (int i = 0; i < count; ++i)
+				lanes[i] = p[i];
+
+			return load(lanes);
+		}
+
+		// Stores only the first count lanes of v
+		inline void store(float* p, Lanes v, int count)
+		{
+			if (count == LaneCount)
+			{
+				store(p, v);
+				return;
+			}
+
+			alignas(32) float lanes[LaneCount];
+			store(lanes, v);
+			for (int i = 0; i < count; ++i)
+				p[i] = lanes[i];
+		}
+	}
+
+#pragma endregion
+
+#pragma region Blocked Matrix Multiplication
+
+	namespace Gemm
+	{
+		using Wide::Lanes;
+		using Wide::LaneCount;
+		using Wide::zero;
+		using Wide::load;
+		using Wide::broadcast;
+		using Wide::store;
+		using Wide::add;
+		using Wide::multiplyAdd;
+
+		// The register tile of out computed by tileKernel, and the block of a packed at a time
+		const int TileRows = 2 * LaneCount;
+		const int TileCols = 4;
+		const int BlockRows = 64;
+		const int BlockDepth = 128;
+
+		// Copies rows x depth of a (column-major, leading dimension lda) times scale into TileRows
+		// high tiles, each stored depth-major and zero padded at the bottom
+		inline void packBlock(const float* a, int lda, int rows, int depth, float scale, float* packed)
+		{
+			for (int r = 0; r < rows; r += TileRows)
+			{
+				int height = rows - r < TileRows ? rows - r : TileRows;
+
+				for (int k = 0; k < depth; ++k)
+				{
+					const float* column = a + k * lda + r;
+
+					for (int i = 0; i < height; ++i)
+						packed[i] = column[i] * scale;
+					for (int i = height; i < TileRows; ++i)
+						packed[i] = 0;
+
+					packed += TileRows;
+				}
+			}
+		}
+
+		// out[0..height, 0..width] (+)= tile * b for one packed tile and up to TileCols columns of b
+		inline void tileKernel(const float* tile, const float* b, int ldb, int depth, float* out, int ldo,
+							   int height, int width, bool accumulate)
+		{
+			// Columns past width repeat the last one so the loop below never branches
+			const float* b0 = b;
+			const float* b1 = b + (width > 1 ? 1 : 0) * ldb;
+			const float* b2 = b + (width > 2 ? 2 : width - 1) * ldb;
+			const float* b3 = b + (width > 3 ? 3 : width - 1) * ldb;
+
+			Lanes c00 = zero(), c01 = zero(), c10 = zero(), c11 = zero();
+			Lanes c20 = zero(), c21 = zero(), c30 = zero(), c31 = zero();
+
+			for (int k = 0; k < depth; ++k)
+			{
+				Lanes a0 = load(tile);
+				Lanes a1 = load(tile + LaneCount);
+				tile += TileRows;
+
+				Lanes s = broadcast(b0[k]);
+				c00 = multiplyAdd(a0, s, c00);
+				c01 = multiplyAdd(a1, s, c01);
+				s = broadcast(b1[k]);
+				c10 = multiplyAdd(a0, s, c10);
+				c11 = multiplyAdd(a1, s, c11);
+				s = broadcast(b2[k]);
+				c20 = multiplyAdd(a0, s, c20);
+				c21 = multiplyAdd(a1, s, c21);
+				s = broadcast(b3[k]);
+				c30 = multiplyAdd(a0, s, c30);
+				c31 = multiplyAdd(a1, s, c31);
+			}
+
+			alignas(64) float result[TileCols * TileRows];
+			store(result, c00);
+			store(result + LaneCount, c01);
+			store(result + TileRows, c10);
+			store(result + TileRows + LaneCount, c11);
+			store(result + 2 * TileRows, c20);
+			store(result + 2 * TileRows + LaneCount, c21);
+			store(result + 3 * TileRows, c30);
+			store(result + 3 * TileRows + LaneCount, c31);
+
+			if (height == TileRows)
+			{
+				for (int j = 0; j < width; ++j)
+				{
+					float* column = out + j * ldo;
+
+					if (accumulate)
+					{
+						store(column, add(load(column), load(result + j * TileRows)));
+						store(column + LaneCount, add(load(column + LaneCount), load(result + j * TileRows + LaneCount)));
+					}
+					else
+					{
+						store(column, load(result + j * TileRows));
+						store(column + LaneCount, load(result + j * TileRows + LaneCount));
+					}
+				}
+			}
+			else
+			{
+				for (int j = 0; j < width; ++j)
+				{
+					for (int i = 0; i < height; ++i)
+						out[j * ldo + i] = accumulate ? out[j * ldo + i] + result[j * TileRows + i] : result[j * TileRows + i];
+				}
+			}
+		}
+	}
+
+	// out (+)= alpha * a * b for column-major operands with leading dimensions lda, ldb and ldo, so
+	// any of them can be a block inside a larger matrix
+	inline void multiplyBlocked(const float* a, int lda, const float* b, int ldb, float* out, int ldo,
+								int rows, int inner, int cols, float alpha, bool accumulate)
+	{
+		alignas(64) float packed[Gemm::BlockRows * Gemm::BlockDepth];
+
+		for (int k = 0; k < inner; k += Gemm::BlockDepth)
+		{
+			int depth = inner - k < Gemm::BlockDepth ? inner - k : Gemm::BlockDepth;
+
+			for (int r = 0; r < rows; r += Gemm::BlockRows)
+			{
+				int height = rows - r < Gemm::BlockRows ? rows - r : Gemm::BlockRows;
+				Gemm::packBlock(a + k * lda + r, lda, height, depth, alpha, packed);
+
+				// The same few columns of b are reused against every tile of the packed block
+				for (int j = 0; j < cols; j += Gemm::TileCols)
+				{
+					int width = cols - j < Gemm::TileCols ? cols - j : Gemm::TileCols;
+
+					for (int t = 0; t < height; t += Gemm::TileRows)
+					{
+						int tileHeight = height - t < Gemm::TileRows ? height - t : Gemm::TileRows;
+
+						Gemm::tileKernel(packed + t * depth, b + j * ldb + k, ldb, depth, out + j * ldo + r + t, ldo,
+										 tileHeight, width, accumulate || k > 0);
+					}
+				}
+			}
+		}
+	}
+
+	inline void multiplyBlocked(const float* a, const float* b, float* out, int rows, int inner, int cols)
+	{
+		multiplyBlocked(a, rows, b, inner, out, rows, rows, inner, cols, 1.0f, false);
+	}
+
+	// out (+)= a * x for a column-major rows x cols a with leading dimension lda, four columns at a time
+	inline void multiplyVector(const float* a, int lda, const float* x, float* out, int rows, int cols, bool accumulate)
+	{
+		if (!accumulate)
+		{
+			for (int i = 0; i < rows; ++i)
+				out[i] = 0;
+		}
+
+		const int fullRows = rows - rows % Wide::LaneCount;
+		int j = 0;
+
+		for (; j + 4 <= cols; j += 4)
+		{
+			const float* a0 = a + j * lda;
+			const float* a1 = a0 + lda;
+			const float* a2 = a1 + lda;
+			const float* a3 = a2 + lda;
+			Wide::Lanes x0 = Wide::broadcast(x[j]), x1 = Wide::broadcast(x[j + 1]);
+			Wide::Lanes x2 = Wide::broadcast(x[j + 2]), x3 = Wide::broadcast(x[j + 3]);
+
+			for (int i = 0; i < fullRows; i += Wide::LaneCount)
+			{
+				Wide::Lanes sum = Wide::multiplyAdd(Wide::load(a0 + i), x0, Wide::load(out + i));
+				sum = Wide::multiplyAdd(Wide::load(a1 + i), x1, sum);
+				sum = Wide::multiplyAdd(Wide::load(a2 + i), x2, sum);
+				sum = Wide::multiplyAdd(Wide::load(a3 + i), x3, sum);
+				Wide::store(out + i, sum);
+			}
+
+			for (int i = fullRows; i < rows; ++i)
+				out[i] += a0[i] * x[j] + a1[i] * x[j + 1] + a2[i] * x[j + 2] + a3[i] * x[j + 3];
+		}
+
+		for (; j < cols; ++j)
+		{
+			const float* column = a + j * lda;
+
+			for (int i = 0; i < rows; ++i)
+				out[i] += column[i] * x[j];
+		}
+	}
+
+#pragma endregion
+
+}
+}
+
+#endif
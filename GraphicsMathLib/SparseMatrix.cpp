@@ -0,0 +1,645 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "Parallel.h"
+#include "SparseMatrix.h"
+
+namespace GraphicsMath
+{
+
+	static_assert(sizeof(Vector<3>) == 3 * sizeof(float), "The solvers treat Vector<3> arrays as float arrays");
+	static_assert(sizeof(Matrix<3, 3>) == 9 * sizeof(float), "Blocks are read as 9 consecutive floats");
+
+	// Rows per parallel chunk. A block row does about as much work as four scalar rows.
+	static const std::size_t RowGrain = cacheAlignedGrain<float>(ParallelGrain);
+	static const std::size_t BlockRowGrain = cacheAlignedGrain<Vector<3>>(ParallelGrain / 4);
+
+	// Floats per chunk of the solvers' vector updates; a multiple of 3 so chunks hold whole Vector<3>s
+	static const std::size_t SolverGrain = 3 * RowGrain;
+
+	// Arrays of Vector<3> as the flat float arrays the kernels work on
+	static const float* floats(const Vector<3>* v)
+	{
+		return reinterpret_cast<const float*>(v);
+	}
+
+	static float* floats(Vector<3>* v)
+	{
+		return reinterpret_cast<float*>(v);
+	}
+
+	static void checkDimensions(bool match)
+	{
+		if (!match)
+			throw std::invalid_argument("ERROR: Dimension mismatch.");
+	}
+
+#pragma region Compression
+
+	// Fills the CSR arrays from triplets in any order: bucket by row, sort each row by column, then
+	// add up entries that share a column. Ties keep their input order so the sums are repeatable.
+	template<typename Entry, typename Value>
+	static void compressRows(int rows, int cols, const std::vector<Entry>& triplets, std::vector<SparseIndex>& rowStart,
+							 std::vector<SparseIndex>& columns, std::vector<Value>& values)
+	{
+		if (rows < 0 || cols < 0)
+			throw std::invalid_argument("ERROR: SparseMatrix dimensions must not be negative.");
+		if (triplets.size() > std::numeric_limits<SparseIndex>::max())
+			throw std::length_error("ERROR: Too many entries for 32 bit sparse indices.");
+
+		rowStart.assign(rows + 1, 0);
+		for (const Entry& t : triplets)
+		{
+			if (t.row < 0 || t.row >= rows || t.col < 0 || t.col >= cols)
+				throw std::out_of_range("ERROR: Attempted to add value out of SparseMatrix range.");
+
+			++rowStart[t.row + 1];
+		}
+
+		for (int r = 0; r < rows; ++r)
+			rowStart[r + 1] += rowStart[r];
+
+		std::vector<SparseIndex> order(triplets.size());
+		std::vector<SparseIndex> cursor(rowStart.begin(), rowStart.end() - 1);
+		for (std::size_t i = 0; i < triplets.size(); ++i)
+			order[cursor[triplets[i].row]++] = static_cast<SparseIndex>(i);
+
+		columns.clear();
+		values.clear();
+		columns.reserve(triplets.size());
+		values.reserve(triplets.size());
+
+		for (int r = 0; r < rows; ++r)
+		{
+			auto first = order.begin() + rowStart[r];
+			auto last = order.begin() + rowStart[r + 1];
+
+			std::sort(first, last, [&triplets](SparseIndex i, SparseIndex j)
+			{
+				return triplets[i].col < triplets[j].col || (triplets[i].col == triplets[j].col && i < j);
+			});
+
+			rowStart[r] = static_cast<SparseIndex>(columns.size());
+
+			for (auto it = first; it != last; ++it)
+			{
+				const Entry& t = triplets[*it];
+
+				if (columns.size() > rowStart[r] && columns.back() == static_cast<SparseIndex>(t.col))
+				{
+					values.back() += t.value;
+				}
+				else
+				{
+					columns.push_back(static_cast<SparseIndex>(t.col));
+					values.push_back(t.value);
+				}
+			}
+		}
+
+		rowStart[rows] = static_cast<SparseIndex>(columns.size());
+	}
+
+	// Index of (row, col) in the column and value arrays, or end of row when it isn't stored
+	static SparseIndex findEntry(const SparseIndex* rowStart, const SparseIndex* columns, int row, int col)
+	{
+		const SparseIndex* first = columns + rowStart[row];
+		const SparseIndex* last = columns + rowStart[row + 1];
+		const SparseIndex* found = std::lower_bound(first, last, static_cast<SparseIndex>(col));
+
+		return found != last && *found == static_cast<SparseIndex>(col) ? static_cast<SparseIndex>(found - columns) : rowStart[row + 1];
+	}
+
+#pragma endregion
+
+#pragma region Sparse Matrix
+
+	SparseMatrix SparseMatrix::FromTriplets(int rows, int cols, const std::vector<Triplet>& triplets)
+	{
+		SparseMatrix result;
+		result.m_rows = rows;
+		result.m_cols = cols;
+		compressRows(rows, cols, triplets, result.m_rowStart, result.m_columns, result.m_values);
+
+		return result;
+	}
+
+	SparseMatrix::SparseMatrix()
+		: m_rows(0), m_cols(0), m_rowStart(1, 0)
+	{
+	}
+
+	int SparseMatrix::rows() const
+	{
+		return m_rows;
+	}
+
+	int SparseMatrix::cols() const
+	{
+		return m_cols;
+	}
+
+	std::size_t SparseMatrix::nonZeros() const
+	{
+		return m_values.size();
+	}
+
+	const SparseIndex* SparseMatrix::rowStart() const
+	{
+		return m_rowStart.data();
+	}
+
+	const SparseIndex* SparseMatrix::columns() const
+	{
+		return m_columns.data();
+	}
+
+	const float* SparseMatrix::values() const
+	{
+		return m_values.data();
+	}
+
+	float SparseMatrix::operator()(const int row, const int col) const
+	{
+		if (row < 0 || row >= m_rows || col < 0 || col >= m_cols)
+			throw std::out_of_range("ERROR: Attempted to access value out of SparseMatrix range.");
+
+		SparseIndex i = findEntry(m_rowStart.data(), m_columns.data(), row, col);
+		return i < m_rowStart[row + 1] ? m_values[i] : 0.0f;
+	}
+
+	DenseVector SparseMatrix::operator*(const DenseVector& v) const
+	{
+		DenseVector result;
+		multiply(*this, v, result);
+
+		return result;
+	}
+
+	SparseMatrix SparseMatrix::transposition() const
+	{
+		SparseMatrix result;
+		result.m_rows = m_cols;
+		result.m_cols = m_rows;
+		result.m_rowStart.assign(m_cols + 1, 0);
+		result.m_columns.resize(m_columns.size());
+		result.m_values.resize(m_values.size());
+
+		for (SparseIndex c : m_columns)
+			++result.m_rowStart[c + 1];
+		for (int c = 0; c < m_cols; ++c)
+			result.m_rowStart[c + 1] += result.m_rowStart[c];
+
+		// Walking the rows in order leaves every row of the result sorted by column
+		std::vector<SparseIndex> cursor(result.m_rowStart.begin(), result.m_rowStart.end() - 1);
+		for (int r = 0; r < m_rows; ++r)
+		{
+			for (SparseIndex k = m_rowStart[r]; k < m_rowStart[r + 1]; ++k)
+			{
+				SparseIndex target = cursor[m_columns[k]]++;
+				result.m_columns[target] = static_cast<SparseIndex>(r);
+				result.m_values[target] = m_values[k];
+			}
+		}
+
+		return result;
+	}
+
+	DenseMatrix SparseMatrix::toDense() const
+	{
+		DenseMatrix result(m_rows, m_cols);
+
+		for (int r = 0; r < m_rows; ++r)
+		{
+			for (SparseIndex k = m_rowStart[r]; k < m_rowStart[r + 1]; ++k)
+				result(r, m_columns[k]) = m_values[k];
+		}
+
+		return result;
+	}
+
+#pragma endregion
+
+#pragma region Block Sparse Matrix
+
+	BlockSparseMatrix BlockSparseMatrix::FromTriplets(int rows, int cols, const std::vector<BlockTriplet>& triplets)
+	{
+		BlockSparseMatrix result;
+		result.m_rows = rows;
+		result.m_cols = cols;
+		compressRows(rows, cols, triplets, result.m_rowStart, result.m_columns, result.m_blocks);
+
+		return result;
+	}
+
+	BlockSparseMatrix::BlockSparseMatrix()
+		: m_rows(0), m_cols(0), m_rowStart(1, 0)
+	{
+	}
+
+	int BlockSparseMatrix::rows() const
+	{
+		return m_rows;
+	}
+
+	int BlockSparseMatrix::cols() const
+	{
+		return m_cols;
+	}
+
+	std::size_t BlockSparseMatrix::nonZeroBlocks() const
+	{
+		return m_blocks.size();
+	}
+
+	const SparseIndex* BlockSparseMatrix::rowStart() const
+	{
+		return m_rowStart.data();
+	}
+
+	const SparseIndex* BlockSparseMatrix::columns() const
+	{
+		return m_columns.data();
+	}
+
+	const Matrix<3, 3>* BlockSparseMatrix::blocks() const
+	{
+		return m_blocks.data();
+	}
+
+	Matrix<3, 3> BlockSparseMatrix::block(const int row, const int col) const
+	{
+		if (row < 0 || row >= m_rows || col < 0 || col >= m_cols)
+			throw std::out_of_range("ERROR: Attempted to access value out of SparseMatrix range.");
+
+		SparseIndex i = findEntry(m_rowStart.data(), m_columns.data(), row, col);
+		return i < m_rowStart[row + 1] ? m_blocks[i] : Matrix<3, 3>() * 0.0f;
+	}
+
+	SparseMatrix BlockSparseMatrix::toScalar() const
+	{
+		std::vector<Triplet> triplets;
+		triplets.reserve(m_blocks.size() * 9);
+
+		for (int r = 0; r < m_rows; ++r)
+		{
+			for (SparseIndex k = m_rowStart[r]; k < m_rowStart[r + 1]; ++k)
+			{
+				const float* block = m_blocks[k].data();
+
+				for (int j = 0; j < 3; ++j)
+				{
+					for (int i = 0; i < 3; ++i)
+						triplets.push_back(Triplet{ 3 * r + i, 3 * static_cast<int>(m_columns[k]) + j, block[j * 3 + i] });
+				}
+			}
+		}
+
+		return SparseMatrix::FromTriplets(3 * m_rows, 3 * m_cols, triplets);
+	}
+
+#pragma endregion
+
+#pragma region Products
+
+	// out = row r of a times x, for x and out as floats three to a vertex
+	static inline void multiplyBlockRow(const BlockSparseMatrix& a, const float* x, std::size_t r, float* out)
+	{
+		const SparseIndex* rowStart = a.rowStart();
+		const SparseIndex* columns = a.columns();
+		const Matrix<3, 3>* blocks = a.blocks();
+		float s0 = 0, s1 = 0, s2 = 0;
+
+		for (SparseIndex k = rowStart[r]; k < rowStart[r + 1]; ++k)
+		{
+			const float* m = blocks[k].data();
+			const float* v = x + 3 * static_cast<std::size_t>(columns[k]);
+
+			s0 += m[0] * v[0] + m[3] * v[1] + m[6] * v[2];
+			s1 += m[1] * v[0] + m[4] * v[1] + m[7] * v[2];
+			s2 += m[2] * v[0] + m[5] * v[1] + m[8] * v[2];
+		}
+
+		out[0] = s0;
+		out[1] = s1;
+		out[2] = s2;
+	}
+
+	static void multiplyBlocks(const BlockSparseMatrix& a, const float* x, float* out, ThreadPool& pool)
+	{
+		pool.parallelFor(a.rows(), BlockRowGrain, [&a, x, out](std::size_t begin, std::size_t end)
+		{
+			for (std::size_t r = begin; r < end; ++r)
+				multiplyBlockRow(a, x, r, out + 3 * r);
+		});
+	}
+
+	static void multiplyScalars(const SparseMatrix& a, const float* x, float* out, ThreadPool& pool)
+	{
+		pool.parallelFor(a.rows(), RowGrain, [&a, x, out](std::size_t begin, std::size_t end)
+		{
+			const SparseIndex* rowStart = a.rowStart();
+			const SparseIndex* columns = a.columns();
+			const float* values = a.values();
+
+			for (std::size_t r = begin; r < end; ++r)
+			{
+				float sum = 0;
+				for (SparseIndex k = rowStart[r]; k < rowStart[r + 1]; ++k)
+					sum += values[k] * x[columns[k]];
+
+				out[r] = sum;
+			}
+		});
+	}
+
+	void multiply(const SparseMatrix& a, const DenseVector& x, DenseVector& out, ThreadPool& pool)
+	{
+		checkDimensions(x.size() == a.cols());
+
+		if (&out == &x)
+		{
+			DenseVector result;
+			multiply(a, x, result, pool);
+			out = std::move(result);
+			return;
+		}
+
+		if (out.size() != a.rows())
+			out = DenseVector(a.rows());
+
+		multiplyScalars(a, x.data(), out.data(), pool);
+	}
+
+	void multiply(const BlockSparseMatrix& a, const Vector<3>* x, Vector<3>* out, ThreadPool& pool)
+	{
+		multiplyBlocks(a, floats(x), floats(out), pool);
+	}
+
+	void multiplyTransposed(const SparseMatrix& a, const DenseVector& x, DenseVector& out)
+	{
+		checkDimensions(x.size() == a.rows());
+
+		DenseVector result(a.cols());
+		const SparseIndex* rowStart = a.rowStart();
+		const SparseIndex* columns = a.columns();
+		const float* values = a.values();
+
+		// The rows of a are the columns of its transpose, so each one scatters into the result
+		for (int r = 0; r < a.rows(); ++r)
+		{
+			for (SparseIndex k = rowStart[r]; k < rowStart[r + 1]; ++k)
+				result[columns[k]] += values[k] * x[r];
+		}
+
+		out = std::move(result);
+	}
+
+#pragma endregion
+
+#pragma region Solvers
+
+	// Each chunk writes its own cache line so the partial sums don't false share
+	struct alignas(CacheLineSize) PartialSums
+	{
+		double first;
+		double second;
+	};
+
+	static double dot(const float* a, const float* b, std::size_t count, ThreadPool& pool)
+	{
+		std::vector<PartialSums> partials((count + SolverGrain - 1) / SolverGrain);
+
+		pool.parallelFor(count, SolverGrain, [a, b, &partials](std::size_t begin, std::size_t end)
+		{
+			double sum = 0;
+			for (std::size_t i = begin; i < end; ++i)
+				sum += static_cast<double>(a[i]) * b[i];
+
+			partials[begin / SolverGrain].first = sum;
+		});
+
+		double result = 0;
+		for (const auto& partial : partials)
+			result += partial.first;
+
+		return result;
+	}
+
+	// Conjugate gradient on count floats. multiplyA(p, out) computes out = A * p, and
+	// precondition(begin, end, r, z) applies the preconditioner to r[begin, end) into z.
+	template<typename Multiply, typename Precondition>
+	static SolverResult preconditionedConjugateGradient(std::size_t count, const float* b, float* x, Multiply multiplyA,
+														Precondition precondition, const SolverSettings& settings, ThreadPool& pool)
+	{
+		const double bMagnitude = std::sqrt(dot(b, b, count, pool));
+		if (bMagnitude == 0)
+		{
+			std::fill(x, x + count, 0.0f);
+			return SolverResult{ 0, 0.0f, true };
+		}
+
+		std::vector<float> r(count), z(count), p(count), ap(count);
+		std::vector<PartialSums> partials((count + SolverGrain - 1) / SolverGrain);
+
+		// Sums of r.r and r.z over the chunks, in chunk order
+		auto sumPartials = [&partials](double& rr, double& rz)
+		{
+			rr = 0;
+			rz = 0;
+			for (const auto& partial : partials)
+			{
+				rr += partial.first;
+				rz += partial.second;
+			}
+		};
+
+		multiplyA(x, ap.data());
+		pool.parallelFor(count, SolverGrain, [&](std::size_t begin, std::size_t end)
+		{
+			for (std::size_t i = begin; i < end; ++i)
+				r[i] = b[i] - ap[i];
+
+			precondition(begin, end, r.data(), z.data());
+
+			double rr = 0, rz = 0;
+			for (std::size_t i = begin; i < end; ++i)
+			{
+				rr += static_cast<double>(r[i]) * r[i];
+				rz += static_cast<double>(r[i]) * z[i];
+				p[i] = z[i];
+			}
+			partials[begin / SolverGrain] = PartialSums{ rr, rz };
+		});
+
+		double rr, rz;
+		sumPartials(rr, rz);
+
+		int iteration = 0;
+		while (std::sqrt(rr) > settings.tolerance * bMagnitude && iteration < settings.maxIterations)
+		{
+			multiplyA(p.data(), ap.data());
+
+			const double pap = dot(p.data(), ap.data(), count, pool);
+			if (!(pap > 0))
+				throw std::runtime_error("ERROR: Matrix is not positive definite.");
+
+			const float alpha = static_cast<float>(rz / pap);
+
+			// x, r and z in one pass over memory
+			pool.parallelFor(count, SolverGrain, [&](std::size_t begin, std::size_t end)
+			{
+				for (std::size_t i = begin; i < end; ++i)
+				{
+					x[i] += alpha * p[i];
+					r[i] -= alpha * ap[i];
+				}
+
+				precondition(begin, end, r.data(), z.data());
+
+				double chunkRR = 0, chunkRZ = 0;
+				for (std::size_t i = begin; i < end; ++i)
+				{
+					chunkRR += static_cast<double>(r[i]) * r[i];
+					chunkRZ += static_cast<double>(r[i]) * z[i];
+				}
+				partials[begin / SolverGrain] = PartialSums{ chunkRR, chunkRZ };
+			});
+
+			const double previous = rz;
+			sumPartials(rr, rz);
+
+			const float beta = static_cast<float>(rz / previous);
+			pool.parallelFor(count, SolverGrain, [&](std::size_t begin, std::size_t end)
+			{
+				for (std::size_t i = begin; i < end; ++i)
+					p[i] = z[i] + beta * p[i];
+			});
+
+			++iteration;
+		}
+
+		float residual = static_cast<float>(std::sqrt(rr) / bMagnitude);
+		return SolverResult{ iteration, residual, residual <= settings.tolerance };
+	}
+
+	static std::vector<Matrix<3, 3>> diagonalInverses(const BlockSparseMatrix& a)
+	{
+		std::vector<Matrix<3, 3>> result(a.rows());
+
+		for (int r = 0; r < a.rows(); ++r)
+			result[r] = a.block(r, r).inverse();
+
+		return result;
+	}
+
+	// x[r] += weight * inverse(D[r]) * (b[r] - (A x)[r]), the update both smoothers make
+	static inline void relaxBlockRow(const BlockSparseMatrix& a, const Matrix<3, 3>& inverse, const float* b, const float* x,
+									 std::size_t r, float weight, float* out)
+	{
+		float ax[3];
+		multiplyBlockRow(a, x, r, ax);
+
+		const float* m = inverse.data();
+		const float d0 = b[3 * r] - ax[0], d1 = b[3 * r + 1] - ax[1], d2 = b[3 * r + 2] - ax[2];
+
+		out[0] = x[3 * r] + weight * (m[0] * d0 + m[3] * d1 + m[6] * d2);
+		out[1] = x[3 * r + 1] + weight * (m[1] * d0 + m[4] * d1 + m[7] * d2);
+		out[2] = x[3 * r + 2] + weight * (m[2] * d0 + m[5] * d1 + m[8] * d2);
+	}
+
+	SolverResult conjugateGradient(const SparseMatrix& a, const DenseVector& b, DenseVector& x,
+								   const SolverSettings& settings, ThreadPool& pool)
+	{
+		checkDimensions(a.rows() == a.cols() && b.size() == a.rows());
+
+		if (x.size() != a.cols())
+			x = DenseVector(a.cols());
+
+		std::vector<float> inverseDiagonal(a.rows());
+		for (int r = 0; r < a.rows(); ++r)
+		{
+			float d = a(r, r);
+			if (d == 0)
+				throw std::runtime_error("ERROR: Matrix has a zero on its diagonal.");
+
+			inverseDiagonal[r] = 1.0f / d;
+		}
+
+		return preconditionedConjugateGradient(static_cast<std::size_t>(a.rows()), b.data(), x.data(),
+			[&a, &pool](const float* p, float* out) { multiplyScalars(a, p, out, pool); },
+			[&inverseDiagonal](std::size_t begin, std::size_t end, const float* r, float* z)
+			{
+				for (std::size_t i = begin; i < end; ++i)
+					z[i] = r[i] * inverseDiagonal[i];
+			},
+			settings, pool);
+	}
+
+	SolverResult conjugateGradient(const BlockSparseMatrix& a, const Vector<3>* b, Vector<3>* x,
+								   const SolverSettings& settings, ThreadPool& pool)
+	{
+		checkDimensions(a.rows() == a.cols());
+
+		std::vector<Matrix<3, 3>> inverses = diagonalInverses(a);
+
+		return preconditionedConjugateGradient(3 * static_cast<std::size_t>(a.rows()), floats(b), floats(x),
+			[&a, &pool](const float* p, float* out) { multiplyBlocks(a, p, out, pool); },
+			[&inverses](std::size_t begin, std::size_t end, const float* r, float* z)
+			{
+				for (std::size_t i = begin; i < end; i += 3)
+				{
+					const float* m = inverses[i / 3].data();
+					z[i] = m[0] * r[i] + m[3] * r[i + 1] + m[6] * r[i + 2];
+					z[i + 1] = m[1] * r[i] + m[4] * r[i + 1] + m[7] * r[i + 2];
+					z[i + 2] = m[2] * r[i] + m[5] * r[i + 1] + m[8] * r[i + 2];
+				}
+			},
+			settings, pool);
+	}
+
+	void jacobi(const BlockSparseMatrix& a, const Vector<3>* b, Vector<3>* x, int iterations, float weight, ThreadPool& pool)
+	{
+		checkDimensions(a.rows() == a.cols());
+
+		std::vector<Matrix<3, 3>> inverses = diagonalInverses(a);
+		std::vector<float> next(3 * static_cast<std::size_t>(a.rows()));
+		const float* bf = floats(b);
+		float* xf = floats(x);
+
+		for (int iteration = 0; iteration < iterations; ++iteration)
+		{
+			pool.parallelFor(a.rows(), BlockRowGrain, [&](std::size_t begin, std::size_t end)
+			{
+				for (std::size_t r = begin; r < end; ++r)
+					relaxBlockRow(a, inverses[r], bf, xf, r, weight, next.data() + 3 * r);
+			});
+
+			std::copy(next.begin(), next.end(), xf);
+		}
+	}
+
+	void gaussSeidel(const BlockSparseMatrix& a, const Vector<3>* b, Vector<3>* x, int iterations)
+	{
+		checkDimensions(a.rows() == a.cols());
+
+		std::vector<Matrix<3, 3>> inverses = diagonalInverses(a);
+		const float* bf = floats(b);
+		float* xf = floats(x);
+
+		// Updating x in place means every row already sees the new values of the rows above it
+		for (int iteration = 0; iteration < iterations; ++iteration)
+		{
+			for (std::size_t r = 0; r < static_cast<std::size_t>(a.rows()); ++r)
+			{
+				float updated[3];
+				relaxBlockRow(a, inverses[r], bf, xf, r, 1.0f, updated);
+				std::copy(updated, updated + 3, xf + 3 * r);
+			}
+		}
+	}
+
+#pragma endregion
+
+}
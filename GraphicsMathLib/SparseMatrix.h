@@ -0,0 +1,185 @@
+#ifndef SPARSE_MATRIX_H
+#define SPARSE_MATRIX_H
+
+#include <cstdint>
+#include <vector>
+
+#include "DenseMatrix.h"
+
+namespace GraphicsMath
+{
+
+#pragma region Sparse Class Definitions
+
+	/* -------------------------------------------------------------------------------------------------
+		Copyright 2017 Shealyn Tate Hindenlang
+
+		Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+		and associated documentation files (the "Software"), to deal in the Software without restriction,
+		including without limitation the rights to use, copy, modify, merge, publish, distribute,
+		sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+		furnished to do so, subject to the following conditions:
+
+		The above copyright notice and this permission notice shall be included in all copies or
+		substantial portions of the Software.
+
+		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+		BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+		NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+		DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+		-------------------------------------------------------------------------------------------------
+
+		SparseMatrix and BlockSparseMatrix hold the large, mostly empty systems that come out of
+		meshes: Laplacians for smoothing, stiffness matrices for cloth. SparseMatrix stores single
+		floats; BlockSparseMatrix stores Matrix<3, 3> blocks coupling the Vector<3> unknowns of two
+		vertices.
+
+		Constructors:
+			static SparseMatrix::FromTriplets(rows, cols, triplets)
+			static BlockSparseMatrix::FromTriplets(rows, cols, triplets)
+
+		Methods:
+			multiply(a, x, out)						out = a * x
+			multiplyTransposed(a, x, out)			out = transpose(a) * x
+			conjugateGradient(a, b, x, settings)	solves a * x = b, starting from x
+			jacobi(a, b, x, iterations, weight)		weighted Jacobi sweeps on a * x = b
+			gaussSeidel(a, b, x, iterations)		forward Gauss-Seidel sweeps on a * x = b
+
+		Usage:
+			std::vector<BlockTriplet> triplets;
+			triplets.push_back({ i, j, stiffness });
+			...
+			auto a = BlockSparseMatrix::FromTriplets(vertexCount, vertexCount, triplets);
+			SolverResult result = conjugateGradient(a, forces.data(), velocities.data());
+
+		Notes:
+			- Both types are compressed sparse row (CSR): an array of row starts, then the column
+			  and value of every stored entry, row by row with columns ascending. Indices are 32 bit
+			  (SparseIndex) to halve the index traffic against size_t. The compressed sparse column
+			  (CSC) form of a matrix is the CSR form of its transposition(), and
+			  multiplyTransposed() uses a CSR matrix as the CSC form of its transpose without
+			  building it.
+			- BlockSparseMatrix is block CSR with 3x3 blocks: one column index per 9 values instead
+			  of one per value, and each block multiplies a whole Vector<3> at once. Vectors passed
+			  to it are arrays of rows() (or cols()) Vector<3>.
+			- FromTriplets() takes the entries in any order and adds up duplicates, so elements can
+			  be assembled edge by edge. Entries outside the matrix throw std::out_of_range.
+			- multiply() and the solvers split the rows across a ThreadPool, ThreadPool::global()
+			  unless one is given, in chunks that depend only on the row count. Dot products are
+			  summed per chunk in double and combined in chunk order, so results are the same for
+			  any number of threads. multiplyTransposed() and gaussSeidel() run on the calling thread.
+			- conjugateGradient() is preconditioned with the inverse diagonal (the inverse diagonal
+			  blocks for BlockSparseMatrix). a must be symmetric positive definite. It stops when
+			  the residual falls to settings.tolerance times the magnitude of b, or after
+			  settings.maxIterations, and reports which in SolverResult.
+			- jacobi() and gaussSeidel() are smoothers for multigrid and for a few relaxation steps
+			  between frames. They need invertible diagonal blocks, and throw std::runtime_error
+			  otherwise, as does conjugateGradient().
+	*/
+
+	typedef std::uint32_t SparseIndex;
+
+	struct Triplet
+	{
+		int row;
+		int col;
+		float value;
+	};
+
+	struct BlockTriplet
+	{
+		int row;
+		int col;
+		Matrix<3, 3> value;
+	};
+
+	struct SolverSettings
+	{
+		int maxIterations = 1000;
+		float tolerance = 1e-5f;
+	};
+
+	struct SolverResult
+	{
+		int iterations;
+		float residual;
+		bool converged;
+	};
+
+	class SparseMatrix
+	{
+	private:
+		int m_rows;
+		int m_cols;
+		std::vector<SparseIndex> m_rowStart;
+		std::vector<SparseIndex> m_columns;
+		std::vector<float> m_values;
+
+	public:
+		static SparseMatrix FromTriplets(int rows, int cols, const std::vector<Triplet>& triplets);
+
+		SparseMatrix();
+
+		int rows() const;
+		int cols() const;
+		std::size_t nonZeros() const;
+
+		const SparseIndex* rowStart() const;
+		const SparseIndex* columns() const;
+		const float* values() const;
+
+		float operator ()(const int row, const int col) const;
+
+		DenseVector operator *(const DenseVector&) const;
+
+		SparseMatrix transposition() const;
+		DenseMatrix toDense() const;
+	};
+
+	class BlockSparseMatrix
+	{
+	private:
+		int m_rows;
+		int m_cols;
+		std::vector<SparseIndex> m_rowStart;
+		std::vector<SparseIndex> m_columns;
+		std::vector<Matrix<3, 3>> m_blocks;
+
+	public:
+		static BlockSparseMatrix FromTriplets(int rows, int cols, const std::vector<BlockTriplet>& triplets);
+
+		BlockSparseMatrix();
+
+		int rows() const;
+		int cols() const;
+		std::size_t nonZeroBlocks() const;
+
+		const SparseIndex* rowStart() const;
+		const SparseIndex* columns() const;
+		const Matrix<3, 3>* blocks() const;
+
+		Matrix<3, 3> block(const int row, const int col) const;
+
+		SparseMatrix toScalar() const;
+	};
+
+	void multiply(const SparseMatrix& a, const DenseVector& x, DenseVector& out, ThreadPool& pool = ThreadPool::global());
+	void multiply(const BlockSparseMatrix& a, const Vector<3>* x, Vector<3>* out, ThreadPool& pool = ThreadPool::global());
+	void multiplyTransposed(const SparseMatrix& a, const DenseVector& x, DenseVector& out);
+
+	SolverResult conjugateGradient(const SparseMatrix& a, const DenseVector& b, DenseVector& x,
+								   const SolverSettings& settings = SolverSettings(), ThreadPool& pool = ThreadPool::global());
+	SolverResult conjugateGradient(const BlockSparseMatrix& a, const Vector<3>* b, Vector<3>* x,
+								   const SolverSettings& settings = SolverSettings(), ThreadPool& pool = ThreadPool::global());
+
+	void jacobi(const BlockSparseMatrix& a, const Vector<3>* b, Vector<3>* x, int iterations, float weight = 2.0f / 3.0f,
+				ThreadPool& pool = ThreadPool::global());
+	void gaussSeidel(const BlockSparseMatrix& a, const Vector<3>* b, Vector<3>* x, int iterations);
+
+#pragma endregion
+
+}
+
+#endif
@@ -0,0 +1,193 @@
+#include <algorithm>
+#include <exception>
+
+#include "ThreadPool.h"
+
+namespace GraphicsMath
+{
+
+#pragma region Constructors & Destructor
+
+	ThreadPool& ThreadPool::global()
+	{
+		static ThreadPool pool;
+		return pool;
+	}
+
+	ThreadPool::ThreadPool(unsigned threadCount)
+		: m_queued{ 0 }, m_stop{ false }
+	{
+		// The calling thread counts as one of the threads and uses the last queue
+		if (threadCount == 0)
+			threadCount = 1;
+
+		for (unsigned i = 0; i < threadCount; ++i)
+			m_queues.emplace_back(new TaskQueue);
+
+		for (unsigned i = 0; i + 1 < threadCount; ++i)
+			m_threads.emplace_back(&ThreadPool::workerLoop, this, i);
+	}
+
+	ThreadPool::~ThreadPool()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_sleepMutex);
+			m_stop = true;
+		}
+		m_wake.notify_all();
+
+		for (auto& thread : m_threads)
+			thread.join();
+	}
+
+#pragma endregion
+
+#pragma region Private Methods
+
+	void ThreadPool::push(std::size_t queue, std::function<void()> task)
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_queues[queue]->mutex);
+			m_queues[queue]->tasks.push_back(std::move(task));
+		}
+
+		// Bumping the count under the sleep mutex means a worker can't miss the wake up between
+		// checking the count and going to sleep
+		{
+			std::lock_guard<std::mutex> lock(m_sleepMutex);
+			++m_queued;
+		}
+		m_wake.notify_one();
+	}
+
+	bool ThreadPool::popOrSteal(std::size_t queue, std::function<void()>& task)
+	{
+		const std::size_t queueCount = m_queues.size();
+
+		for (std::size_t i = 0; i < queueCount; ++i)
+		{
+			std::size_t victim = (queue + i) % queueCount;
+			TaskQueue& q = *m_queues[victim];
+
+			std::lock_guard<std::mutex> lock(q.mutex);
+			if (q.tasks.empty())
+				continue;
+
+			// Own work comes off the front, stolen work off the back
+			if (i == 0)
+			{
+				task = std::move(q.tasks.front());
+				q.tasks.pop_front();
+			}
+			else
+			{
+				task = std::move(q.tasks.back());
+				q.tasks.pop_back();
+			}
+
+			--m_queued;
+			return true;
+		}
+
+		return false;
+	}
+
+	void ThreadPool::workerLoop(std::size_t queue)
+	{
+		std::function<void()> task;
+
+		while (true)
+		{
+			if (popOrSteal(queue, task))
+			{
+				task();
+				continue;
+			}
+
+			std::unique_lock<std::mutex> lock(m_sleepMutex);
+			m_wake.wait(lock, [this] { return m_stop || m_queued.load() > 0; });
+
+			if (m_stop && m_queued.load() == 0)
+				return;
+		}
+	}
+
+#pragma endregion
+
+#pragma region Parallel Loops
+
+	unsigned ThreadPool::threadCount() const
+	{
+		return static_cast<unsigned>(m_queues.size());
+	}
+
+	void ThreadPool::parallelFor(std::size_t count, std::size_t grain, const RangeFunction& body)
+	{
+		if (count == 0)
+			return;
+
+		if (grain == 0)
+			grain = 1;
+
+		const std::size_t chunks = (count + grain - 1) / grain;
+
+		if (chunks == 1 || m_threads.empty())
+		{
+			for (std::size_t begin = 0; begin < count; begin += grain)
+				body(begin, std::min(begin + grain, count));
+
+			return;
+		}
+
+		struct Job
+		{
+			std::atomic<std::size_t> remaining;
+			std::mutex errorMutex;
+			std::exception_ptr error;
+		};
+
+		auto job = std::make_shared<Job>();
+		job->remaining = chunks;
+
+		// Deal the chunks out round robin so every queue starts with a share of the work
+		for (std::size_t c = 0; c < chunks; ++c)
+		{
+			std::size_t begin = c * grain;
+			std::size_t end = std::min(begin + grain, count);
+
+			push(c % m_queues.size(), [job, &body, begin, end]
+			{
+				try
+				{
+					body(begin, end);
+				}
+				catch (...)
+				{
+					std::lock_guard<std::mutex> lock(job->errorMutex);
+					if (!job->error)
+						job->error = std::current_exception();
+				}
+
+				--job->remaining;
+			});
+		}
+
+		// Help out until every chunk of this job has finished
+		const std::size_t callerQueue = m_queues.size() - 1;
+		std::function<void()> task;
+
+		while (job->remaining.load() > 0)
+		{
+			if (popOrSteal(callerQueue, task))
+				task();
+			else
+				std::this_thread::yield();
+		}
+
+		if (job->error)
+			std::rethrow_exception(job->error);
+	}
+
+#pragma endregion
+
+}
@@ -0,0 +1,100 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace GraphicsMath
+{
+
+#pragma region Thread Pool Class Definition
+
+	/* -------------------------------------------------------------------------------------------------
+		Copyright 2017 Shealyn Tate Hindenlang
+
+		Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+		and associated documentation files (the "Software"), to deal in the Software without restriction,
+		including without limitation the rights to use, copy, modify, merge, publish, distribute,
+		sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+		furnished to do so, subject to the following conditions:
+
+		The above copyright notice and this permission notice shall be included in all copies or
+		substantial portions of the Software.
+
+		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+		BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+		NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+		DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+		-------------------------------------------------------------------------------------------------
+
+		ThreadPool is a work-stealing pool used to spread bulk math across cores.
+
+		Constructors:
+			ThreadPool(threadCount)
+			static ThreadPool::global()
+
+		Notes:
+			- threadCount counts the calling thread, which always helps run the work it submits, so
+			  ThreadPool(1) starts no threads at all and runs everything inline.
+			- Every worker owns a task queue. Workers take tasks from the front of their own queue and
+			  steal from the back of the others' queues when they run dry.
+			- parallelFor() splits [0, count) into chunks of exactly grain items (the last chunk may be
+			  shorter). The split depends only on count and grain, never on the number of threads, so
+			  per-chunk results can be combined in a deterministic order.
+			- If a chunk throws, the remaining chunks still run and the first exception is rethrown
+			  from parallelFor().
+			- The global() pool uses one thread per hardware thread and lives until the program exits.
+	*/
+
+	class ThreadPool
+	{
+	public:
+		typedef std::function<void(std::size_t, std::size_t)> RangeFunction;
+
+	private:
+		struct TaskQueue
+		{
+			std::mutex mutex;
+			std::deque<std::function<void()>> tasks;
+		};
+
+		std::vector<std::unique_ptr<TaskQueue>> m_queues;
+		std::vector<std::thread> m_threads;
+
+		std::mutex m_sleepMutex;
+		std::condition_variable m_wake;
+		std::atomic<std::size_t> m_queued;
+		bool m_stop;
+
+		void push(std::size_t queue, std::function<void()> task);
+		bool popOrSteal(std::size_t queue, std::function<void()>& task);
+		void workerLoop(std::size_t queue);
+
+	public:
+		static ThreadPool& global();
+
+		explicit ThreadPool(unsigned threadCount = std::thread::hardware_concurrency());
+		~ThreadPool();
+
+		ThreadPool(const ThreadPool&) = delete;
+		ThreadPool& operator=(const ThreadPool&) = delete;
+
+		unsigned threadCount() const;
+
+		void parallelFor(std::size_t count, std::size_t grain, const RangeFunction& body);
+	};
+
+#pragma endregion
+
+}
+
+#endif
@@ -0,0 +1,347 @@
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+
+#include "SIMD.h"
+#include "TransformHierarchy.h"
+
+namespace GraphicsMath
+{
+
+	// Nodes per parallel chunk of a level. One product is a few nanoseconds, so small levels run
+	// as a single chunk on the calling thread.
+	static const std::size_t UpdateGrain = 512;
+
+	// update() sweeps the whole scene once at least one node in this many was set
+	static const std::size_t SweepRatio = 8;
+
+	// The kind of parent * local: the most general of the two, except that a rotation and a
+	// translation together make a rigid transform
+	static TransformKind combine(TransformKind parent, TransformKind local)
+	{
+		if (parent == TransformKind::Identity)
+			return local;
+		if (local == TransformKind::Identity)
+			return parent;
+		if (parent == TransformKind::Affine || local == TransformKind::Affine)
+			return TransformKind::Affine;
+		if (parent == local && parent != TransformKind::Rigid)
+			return parent;
+
+		return TransformKind::Rigid;
+	}
+
+#pragma region Construction
+
+	TransformHierarchy TransformHierarchy::FromParents(const std::vector<std::uint32_t>& parents)
+	{
+		const std::size_t count = parents.size();
+		if (count >= NoParent)
+			throw std::length_error("ERROR: Too many nodes for 32 bit indices.");
+
+		// Children of each node in node order, compressed like the rows of a sparse matrix
+		std::vector<std::uint32_t> childStart(count + 1, 0);
+		for (std::uint32_t parent : parents)
+		{
+			if (parent == NoParent)
+				continue;
+			if (parent >= count)
+				throw std::out_of_range("ERROR: TransformHierarchy parent index out of range.");
+
+			++childStart[parent + 1];
+		}
+
+		for (std::size_t i = 0; i < count; ++i)
+			childStart[i + 1] += childStart[i];
+
+		std::vector<std::uint32_t> children(count);
+		std::vector<std::uint32_t> cursor(childStart.begin(), childStart.end() - 1);
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			if (parents[i] != NoParent)
+				children[cursor[parents[i]]++] = static_cast<std::uint32_t>(i);
+		}
+
+		// Breadth first from the roots, a level at a time
+		TransformHierarchy h;
+		h.m_nodes.reserve(count);
+		h.m_parents.reserve(count);
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			if (parents[i] == NoParent)
+			{
+				h.m_nodes.push_back(static_cast<std::uint32_t>(i));
+				h.m_parents.push_back(NoParent);
+			}
+		}
+
+		for (std::size_t levelBegin = 0; levelBegin < h.m_nodes.size();)
+		{
+			const std::size_t levelEnd = h.m_nodes.size();
+			for (std::size_t s = levelBegin; s < levelEnd; ++s)
+			{
+				const std::uint32_t node = h.m_nodes[s];
+				h.m_firstChild.push_back(static_cast<std::uint32_t>(h.m_nodes.size()));
+				h.m_childCount.push_back(childStart[node + 1] - childStart[node]);
+
+				for (std::uint32_t c = childStart[node]; c < childStart[node + 1]; ++c)
+				{
+					h.m_nodes.push_back(children[c]);
+					h.m_parents.push_back(static_cast<std::uint32_t>(s));
+				}
+			}
+
+			h.m_levelStart.push_back(static_cast<std::uint32_t>(levelEnd));
+			levelBegin = levelEnd;
+		}
+
+		// Nodes on a cycle are never reached from a root
+		if (h.m_nodes.size() != count)
+			throw std::invalid_argument("ERROR: TransformHierarchy parents form a cycle.");
+
+		h.m_slots.resize(count);
+		for (std::size_t s = 0; s < count; ++s)
+			h.m_slots[h.m_nodes[s]] = static_cast<std::uint32_t>(s);
+
+		h.m_locals.resize(count);
+		h.m_worlds.resize(count);
+		h.m_inverseWorlds.resize(count);
+		h.m_localKinds.assign(count, TransformKind::Identity);
+		h.m_worldKinds.assign(count, TransformKind::Identity);
+		h.m_inverseValid.assign(count, 1);
+		h.m_dirty.assign(count, 0);
+		h.m_changed.assign(count, 0);
+
+		return h;
+	}
+
+	TransformHierarchy::TransformHierarchy()
+		: m_levelStart(1, 0)
+	{
+	}
+
+#pragma endregion
+
+#pragma region Accessors
+
+	std::uint32_t TransformHierarchy::slot(std::uint32_t node) const
+	{
+		if (node >= m_slots.size())
+			throw std::out_of_range("ERROR: TransformHierarchy node index out of range.");
+
+		return m_slots[node];
+	}
+
+	std::size_t TransformHierarchy::size() const
+	{
+		return m_slots.size();
+	}
+
+	int TransformHierarchy::depth() const
+	{
+		return static_cast<int>(m_levelStart.size()) - 1;
+	}
+
+	std::uint32_t TransformHierarchy::parent(std::uint32_t node) const
+	{
+		std::uint32_t parentSlot = m_parents[slot(node)];
+		return parentSlot == NoParent ? NoParent : m_nodes[parentSlot];
+	}
+
+	void TransformHierarchy::setLocal(std::uint32_t node, const Matrix<4, 4>& m, TransformKind kind)
+	{
+		const std::uint32_t s = slot(node);
+		m_locals[s] = m;
+		m_localKinds[s] = kind;
+
+		if (!m_dirty[s])
+		{
+			m_dirty[s] = 1;
+			m_dirtySlots.push_back(s);
+		}
+	}
+
+	const Matrix<4, 4>& TransformHierarchy::local(std::uint32_t node) const
+	{
+		return m_locals[slot(node)];
+	}
+
+	const Matrix<4, 4>& TransformHierarchy::world(std::uint32_t node) const
+	{
+		return m_worlds[slot(node)];
+	}
+
+	TransformKind TransformHierarchy::worldKind(std::uint32_t node) const
+	{
+		return m_worldKinds[slot(node)];
+	}
+
+	const Matrix<4, 4>& TransformHierarchy::inverseWorld(std::uint32_t node)
+	{
+		const std::uint32_t s = slot(node);
+		if (m_inverseValid[s])
+			return m_inverseWorlds[s];
+
+		const Matrix<4, 4>& world = m_worlds[s];
+		switch (m_worldKinds[s])
+		{
+		case TransformKind::Identity:
+			m_inverseWorlds[s] = Matrix<4, 4>();
+			break;
+		case TransformKind::Translation:
+			m_inverseWorlds[s] = Matrix<4, 4>::TranslationInverse(world);
+			break;
+		case TransformKind::Rotation:
+			m_inverseWorlds[s] = Matrix<4, 4>::RotationInverse(world);
+			break;
+		case TransformKind::Rigid:
+		{
+			// RotationInverse() of the rotation, then the translation carried back through it,
+			// written in place
+			Matrix<4, 4>& inverse = m_inverseWorlds[s];
+			for (int c = 0; c < 3; ++c)
+			{
+				for (int r = 0; r < 3; ++r)
+					inverse[c][r] = world[r][c];
+
+				inverse[c][3] = 0;
+			}
+
+			for (int r = 0; r < 3; ++r)
+				inverse[3][r] = -(world[r][0] * world[3][0] + world[r][1] * world[3][1] + world[r][2] * world[3][2]);
+
+			inverse[3][3] = 1;
+			break;
+		}
+		default:
+			m_inverseWorlds[s] = world.affineInverse();
+			break;
+		}
+
+		m_inverseValid[s] = 1;
+		return m_inverseWorlds[s];
+	}
+
+#pragma endregion
+
+#pragma region Update
+
+	void TransformHierarchy::updateSlot(std::uint32_t s)
+	{
+		const std::uint32_t p = m_parents[s];
+
+		if (p == NoParent)
+		{
+			m_worlds[s] = m_locals[s];
+			m_worldKinds[s] = m_localKinds[s];
+		}
+		else
+		{
+			SIMD::multiply4x4(m_worlds[p].data(), m_locals[s].data(), m_worlds[s].data());
+			m_worldKinds[s] = combine(m_worldKinds[p], m_localKinds[s]);
+		}
+
+		m_inverseValid[s] = 0;
+	}
+
+	std::size_t TransformHierarchy::updateFrontier(ThreadPool& pool)
+	{
+		// Breadth first order puts every level's slots after the level above, and children of
+		// earlier slots before children of later ones, so sorted slot lists stay sorted below
+		std::sort(m_dirtySlots.begin(), m_dirtySlots.end());
+
+		std::vector<std::uint32_t> frontier, next;
+		std::vector<std::uint32_t>::const_iterator dirty = m_dirtySlots.begin();
+		std::size_t updated = 0;
+
+		for (std::size_t level = 0; level + 1 < m_levelStart.size(); ++level)
+		{
+			// The children of last level's updates, and nodes set on this level that aren't among them
+			auto levelEnd = std::lower_bound(dirty, m_dirtySlots.cend(), m_levelStart[level + 1]);
+			next.clear();
+			std::set_union(frontier.begin(), frontier.end(), dirty, levelEnd, std::back_inserter(next));
+			frontier.swap(next);
+			dirty = levelEnd;
+
+			if (frontier.empty())
+			{
+				if (dirty == m_dirtySlots.cend())
+					break;
+
+				continue;
+			}
+
+			pool.parallelFor(frontier.size(), UpdateGrain, [this, &frontier](std::size_t begin, std::size_t end)
+			{
+				for (std::size_t i = begin; i < end; ++i)
+					updateSlot(frontier[i]);
+			});
+
+			updated += frontier.size();
+
+			next.clear();
+			for (std::uint32_t s : frontier)
+			{
+				for (std::uint32_t c = 0; c < m_childCount[s]; ++c)
+					next.push_back(m_firstChild[s] + c);
+			}
+
+			frontier.swap(next);
+		}
+
+		return updated;
+	}
+
+	std::size_t TransformHierarchy::updateAll(ThreadPool& pool)
+	{
+		std::vector<std::size_t> counts;
+		std::size_t updated = 0;
+
+		for (std::size_t level = 0; level + 1 < m_levelStart.size(); ++level)
+		{
+			const std::uint32_t first = m_levelStart[level];
+			const std::size_t count = m_levelStart[level + 1] - first;
+			counts.assign((count + UpdateGrain - 1) / UpdateGrain, 0);
+
+			pool.parallelFor(count, UpdateGrain, [this, first, &counts](std::size_t begin, std::size_t end)
+			{
+				std::size_t changed = 0;
+				for (std::uint32_t s = first + static_cast<std::uint32_t>(begin); s < first + end; ++s)
+				{
+					const std::uint32_t p = m_parents[s];
+					m_changed[s] = m_dirty[s] || (p != NoParent && m_changed[p]);
+
+					if (m_changed[s])
+					{
+						updateSlot(s);
+						++changed;
+					}
+				}
+
+				counts[begin / UpdateGrain] = changed;
+			});
+
+			for (std::size_t changed : counts)
+				updated += changed;
+		}
+
+		return updated;
+	}
+
+	std::size_t TransformHierarchy::update(ThreadPool& pool)
+	{
+		if (m_dirtySlots.empty())
+			return 0;
+
+		const std::size_t updated = m_dirtySlots.size() * SweepRatio >= m_slots.size() ? updateAll(pool) : updateFrontier(pool);
+
+		for (std::uint32_t s : m_dirtySlots)
+			m_dirty[s] = 0;
+
+		m_dirtySlots.clear();
+		return updated;
+	}
+
+#pragma endregion
+
+}
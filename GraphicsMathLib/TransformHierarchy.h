@@ -0,0 +1,146 @@
+#ifndef TRANSFORMHIERARCHY_H
+#define TRANSFORMHIERARCHY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Matrix.h"
+#include "ThreadPool.h"
+
+namespace GraphicsMath
+{
+
+#pragma region Transform Hierarchy Definitions
+
+	/* -------------------------------------------------------------------------------------------------
+		Copyright 2017 Shealyn Tate Hindenlang
+
+		Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+		and associated documentation files (the "Software"), to deal in the Software without restriction,
+		including without limitation the rights to use, copy, modify, merge, publish, distribute,
+		sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+		furnished to do so, subject to the following conditions:
+
+		The above copyright notice and this permission notice shall be included in all copies or
+		substantial portions of the Software.
+
+		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+		BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+		NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+		DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+		-------------------------------------------------------------------------------------------------
+
+		TransformHierarchy holds the local and world Matrix<4, 4> of every node of a scene graph, with
+		world = parent's world * local, and only recomputes the world matrices below nodes whose
+		local matrix changed since the last update().
+
+		Constructors:
+			static TransformHierarchy::FromParents(parents)	parents[i] is node i's parent, or NoParent
+
+		Methods:
+			setLocal(node, m, kind)							marks node's subtree for the next update()
+			update(pool)									recomputes the marked world matrices
+			world(node), inverseWorld(node)
+
+		Usage:
+			TransformHierarchy scene = TransformHierarchy::FromParents({ TransformHierarchy::NoParent, 0, 0, 1 });
+			scene.setLocal(1, Matrix<4, 4>::Translation(offset), TransformKind::Translation);
+			scene.update();
+			draw(mesh, scene.world(3));
+
+		Notes:
+			- Nodes are stored in breadth first order in flat arrays, one depth level after another,
+			  with each node's children next to each other. Node numbers are the ones given to
+			  FromParents() and don't change; the order is internal.
+			- update() starts from the nodes set since the last update and works down one level at
+			  a time, recomputing those nodes and the children of every node recomputed on the level
+			  above. Its cost is proportional to the size of the changed subtrees, not the scene, and
+			  it returns how many world matrices it recomputed. When at least one node in eight was
+			  set, it sweeps every level in order instead, which costs a flag test per unchanged
+			  node but skips tracking the changed ones. Each level is split across a ThreadPool,
+			  ThreadPool::global() unless one is given, and every product goes through the SIMD
+			  multiply4x4 kernel.
+			- world() and inverseWorld() give the matrices as of the last update().
+			- TransformKind says what a local matrix is made of, so the inverse can take the cheap
+			  path: TranslationInverse() for translations, RotationInverse() for rotations, both for
+			  rotations and translations together, and affineInverse() for anything else. A world
+			  matrix is the most general kind along its path from the root. Like the static inverse
+			  methods, the kind is trusted: a scaled matrix passed as Rotation inverts incorrectly.
+			- inverseWorld() computes the inverse the first time it is asked for after each update
+			  that changed the node, and keeps it until the next one. It isn't const and mustn't be
+			  called from several threads at once; call it for all the nodes needed, then share the
+			  results.
+			- FromParents() throws std::out_of_range for a parent index past the end and
+			  std::invalid_argument when the parents form a cycle. The node methods throw
+			  std::out_of_range for nodes past the end.
+	*/
+
+	enum class TransformKind : std::uint8_t
+	{
+		Identity,
+		Translation,
+		Rotation,
+		// A rotation followed by a translation
+		Rigid,
+		Affine
+	};
+
+	class TransformHierarchy
+	{
+	private:
+		// Per slot, in breadth first order
+		std::vector<std::uint32_t> m_parents;
+		std::vector<std::uint32_t> m_firstChild;
+		std::vector<std::uint32_t> m_childCount;
+		std::vector<Matrix<4, 4>> m_locals;
+		std::vector<Matrix<4, 4>> m_worlds;
+		std::vector<Matrix<4, 4>> m_inverseWorlds;
+		std::vector<TransformKind> m_localKinds;
+		std::vector<TransformKind> m_worldKinds;
+		std::vector<std::uint8_t> m_inverseValid;
+		std::vector<std::uint8_t> m_dirty;
+		// Whether each slot was recomputed by the last full sweep
+		std::vector<std::uint8_t> m_changed;
+
+		// The first slot of each level, and one past the last slot
+		std::vector<std::uint32_t> m_levelStart;
+		// Slot of each node, by node number, and the node number of each slot
+		std::vector<std::uint32_t> m_slots;
+		std::vector<std::uint32_t> m_nodes;
+		// Slots set since the last update()
+		std::vector<std::uint32_t> m_dirtySlots;
+
+		std::uint32_t slot(std::uint32_t node) const;
+
+		void updateSlot(std::uint32_t);
+		std::size_t updateFrontier(ThreadPool&);
+		std::size_t updateAll(ThreadPool&);
+
+	public:
+		static constexpr std::uint32_t NoParent = 0xFFFFFFFFu;
+
+		static TransformHierarchy FromParents(const std::vector<std::uint32_t>& parents);
+
+		TransformHierarchy();
+
+		std::size_t size() const;
+		int depth() const;
+		std::uint32_t parent(std::uint32_t node) const;
+
+		void setLocal(std::uint32_t node, const Matrix<4, 4>&, TransformKind kind = TransformKind::Affine);
+		const Matrix<4, 4>& local(std::uint32_t node) const;
+		const Matrix<4, 4>& world(std::uint32_t node) const;
+		TransformKind worldKind(std::uint32_t node) const;
+		const Matrix<4, 4>& inverseWorld(std::uint32_t node);
+
+		std::size_t update(ThreadPool& pool = ThreadPool::global());
+	};
+
+#pragma endregion
+
+}
+
+#endif
@@ -1,14 +1,30 @@
 #ifndef VECTOR_H
 #define VECTOR_H
 
-#include <vector>
 #include <string>
 #include <iostream>
+#include <stdexcept>
+#include <cmath>
+
+#include "FastMath.h"
+
+// Bounds checking of Vector and Matrix operator[]. Checks are on in debug builds and off when NDEBUG
+// is defined; define GRAPHICSMATH_BOUNDS_CHECK to 1 or 0 to choose explicitly.
+#if !defined(GRAPHICSMATH_BOUNDS_CHECK)
+	#if defined(NDEBUG)
+		#define GRAPHICSMATH_BOUNDS_CHECK 0
+	#else
+		#define GRAPHICSMATH_BOUNDS_CHECK 1
+	#endif
+#endif
 
 namespace GraphicsMath
 {
 	static const float PI = 3.14159f;
 
+	template<int row, int col>
+	class Matrix;
+
 #pragma region Vector Class Definition
 
 	/* -------------------------------------------------------------------------------------------------
@@ -40,72 +56,108 @@ namespace GraphicsMath
 		Notes:
 			- If fewer arguments are given to the constructor than the dimension, the rest of the values
 				are set to zero.
-			- Currently, vectors are restricted to the range [2, 4]. This is sufficient for graphics 
-				operations, but more generalized functionality may be added at a future date.
+			- Components are stored inline in an aligned float array, so vectors never allocate and are
+				trivially copyable. Moving a vector is the same as copying it, and neither can throw.
+			- Everything except magnitude(), normal(), normalize() and to_string() is constexpr, so
+				vectors can be built and combined in constant expressions.
+			- Any dimension of 2 or more is allowed. The graphics methods (cross product, homogenize,
+				lowerDimension, higherDimension) are meant for the 2 to 4 dimensional vectors, while
+				the larger ones serve as the columns and operands of the larger Matrix sizes.
+			- operator[] throws std::out_of_range for an invalid index only while GRAPHICSMATH_BOUNDS_CHECK
+				is 1, which by default is the case in debug builds. x(), y(), z(), w() and get<I>() are
+				never checked at run time; their indices are checked at compile time instead.
 			- operator * overloaded to be the Cartesian Product of two vectors
 			- The cross product between two vectors is only meaningful in 3 dimensions, and therefore 
 				only define for Vector<3>.
+			- normal<MathPolicy::Fast>() and normalize<MathPolicy::Fast>() scale by an approximate
+				reciprocal square root instead of dividing by the magnitude; see FastMath.h for the
+				error bound and for choosing the default policy.
 		TODO:
-			- Make move assignment
 			- Define rest of comparisons in terms of == and < 
 	*/
 
 	template<int size>
 	class Vector
 	{
-		static_assert(size > 1 && size < 5, "Vector dimension must be in range [2, 4]");
+		static_assert(size > 1, "Vector dimension must be at least 2");
 		
+	public:
+		typedef float* iterator;
+		typedef const float* const_iterator;
+
 	private:
-		std::vector<float> m_data;
+		// 2 and 4 dimensional vectors fill an 8 or 16 byte load. Other sizes are only aligned when
+		// that adds no padding, so the columns of a Matrix stay contiguous.
+		alignas(size == 2 ? 8 : size % 4 == 0 ? 16 : alignof(float)) float m_data[size];
 
-		void copyElements(const std::vector<float>&);
 		std::string toString() const;
 
+		template<int, int>
+		friend class Matrix;
+
 	public:
-		Vector();
-		Vector(std::initializer_list<float>);
-
-		Vector(const Vector&);
-		Vector& operator=(const Vector&);
-
-		float& operator[](const int);
-		const float& operator[](const int) const;
-
-		std::vector<float>::iterator begin();
-		std::vector<float>::const_iterator begin() const;
-		std::vector<float>::iterator end();
-		std::vector<float>::const_iterator end() const;
-
-		Vector operator +(const Vector&) const;
-		Vector operator +(const float) const;
-		Vector operator -(const Vector&) const;
-		Vector operator -(const float) const;
-		Vector operator *(const Vector&) const;
-		Vector operator *(const float) const;
-		Vector operator /(float) const;
-		void operator +=(const Vector&);
-		void operator +=(const float);
-		void operator -=(const Vector&);
-		void operator -=(const float);
-		void operator *=(const Vector&);
-		void operator *=(const float);
-		void operator /=(const float);
+		constexpr Vector();
+		constexpr Vector(std::initializer_list<float>);
+
+		Vector(const Vector&) = default;
+		Vector(Vector&&) noexcept = default;
+		Vector& operator=(const Vector&) = default;
+		Vector& operator=(Vector&&) noexcept = default;
+
+		constexpr float& operator[](const int);
+		constexpr const float& operator[](const int) const;
+
+		constexpr float& x();
+		constexpr const float& x() const;
+		constexpr float& y();
+		constexpr const float& y() const;
+		constexpr float& z();
+		constexpr const float& z() const;
+		constexpr float& w();
+		constexpr const float& w() const;
+
+		template<int index>
+		constexpr float& get();
+		template<int index>
+		constexpr const float& get() const;
+
+		constexpr iterator begin();
+		constexpr const_iterator begin() const;
+		constexpr iterator end();
+		constexpr const_iterator end() const;
+
+		constexpr Vector operator +(const Vector&) const;
+		constexpr Vector operator +(const float) const;
+		constexpr Vector operator -(const Vector&) const;
+		constexpr Vector operator -(const float) const;
+		constexpr Vector operator *(const Vector&) const;
+		constexpr Vector operator *(const float) const;
+		constexpr Vector operator /(float) const;
+		constexpr void operator +=(const Vector&);
+		constexpr void operator +=(const float);
+		constexpr void operator -=(const Vector&);
+		constexpr void operator -=(const float);
+		constexpr void operator *=(const Vector&);
+		constexpr void operator *=(const float);
+		constexpr void operator /=(const float);
 		
-		bool operator ==(const Vector&) const;
-		bool operator !=(const Vector&) const;
-		bool operator >(const Vector&) const;
-		bool operator <(const Vector&) const;
-		bool operator >=(const Vector&) const;
-		bool operator <=(const Vector&) const;
-
-		float squareMagnitude() const;
+		constexpr bool operator ==(const Vector&) const;
+		constexpr bool operator !=(const Vector&) const;
+		constexpr bool operator >(const Vector&) const;
+		constexpr bool operator <(const Vector&) const;
+		constexpr bool operator >=(const Vector&) const;
+		constexpr bool operator <=(const Vector&) const;
+
+		constexpr float squareMagnitude() const;
 		float magnitude() const;
-		float dotProduct(const Vector&) const;
-		Vector crossProduct(const Vector&) const;
+		constexpr float dotProduct(const Vector&) const;
+		constexpr Vector crossProduct(const Vector&) const;
+		template<MathPolicy policy = DefaultMathPolicy>
 		Vector normal() const;
+		template<MathPolicy policy = DefaultMathPolicy>
 		void normalize();
-		Vector homogenous() const;
-		void homogenize();
+		constexpr Vector homogenous() const;
+		constexpr void homogenize();
 
 		std::string to_string() const;
 
@@ -120,12 +172,6 @@ namespace GraphicsMath
 
 #pragma region Private Methods
 
-	template<int size>
-	void Vector<size>::copyElements(const std::vector<float>& v)
-	{
-		std::copy(std::begin(v), std::end(v), std::begin(m_data));
-	}
-
 	template<int size>
 	std::string Vector<size>::toString() const
 	{
@@ -149,60 +195,120 @@ namespace GraphicsMath
 #pragma region Constructors
 
 	template<int size>
-	Vector<size>::Vector()
-		: m_data(size, 0)
+	constexpr Vector<size>::Vector()
+		: m_data{}
 	{
-		// TODO: Remove this and see if m_data fills with zero value on default
 	}
 
 	template<int size>
-	Vector<size>::Vector(std::initializer_list<float> args)
+	constexpr Vector<size>::Vector(std::initializer_list<float> args)
+		: m_data{}
 	{
 		if (args.size() > size)
 			throw std::out_of_range("ERROR: Cannot add more elements to a vector than it can hold.");
 
-		// Insert all given values and fill remaining space with zeros
-		m_data.insert(m_data.begin(), args);
-		m_data.insert(m_data.end(), size - args.size(), 0);
+		// Copy all given values, the remaining components are already zero
+		int i = 0;
+		for (float arg : args)
+			m_data[i++] = arg;
 	}
 
 #pragma endregion
 
-#pragma region Copy Constructor & Assignment
-	
+#pragma region Subscript Operators
+
 	template<int size>
-	Vector<size>::Vector(const Vector<size>& v)
+	constexpr float& Vector<size>::operator[](const int index)
 	{
-		m_data = v.m_data;
+		if (GRAPHICSMATH_BOUNDS_CHECK && (index < 0 || index >= size))
+			throw std::out_of_range("ERROR: Attempted to access value out of Vector range.");
+
+		return m_data[index];
 	}
 
 	template<int size>
-	Vector<size>& Vector<size>::operator=(const Vector<size>& v)
+	constexpr const float& Vector<size>::operator[](const int index) const
 	{
-		Vector<size> c(v);
-		m_data = c.m_data;
+		if (GRAPHICSMATH_BOUNDS_CHECK && (index < 0 || index >= size))
+			throw std::out_of_range("ERROR: Attempted to access value out of Vector range.");
 
-		return *this;
+		return m_data[index];
 	}
 
 #pragma endregion
 
-#pragma region Subscript Operators
+#pragma region Unchecked Accessors
 
 	template<int size>
-	float& Vector<size>::operator[](const int index)
+	constexpr float& Vector<size>::x()
 	{
-		if (index < 0 || index >= size)
-			throw std::out_of_range("ERROR: Attempted to access value out of Vector range.");
+		return m_data[0];
+	}
+
+	template<int size>
+	constexpr const float& Vector<size>::x() const
+	{
+		return m_data[0];
+	}
+
+	template<int size>
+	constexpr float& Vector<size>::y()
+	{
+		return m_data[1];
+	}
+
+	template<int size>
+	constexpr const float& Vector<size>::y() const
+	{
+		return m_data[1];
+	}
+
+	template<int size>
+	constexpr float& Vector<size>::z()
+	{
+		static_assert(size > 2, "z() requires a Vector of 3 or more dimensions");
+
+		return m_data[2];
+	}
+
+	template<int size>
+	constexpr const float& Vector<size>::z() const
+	{
+		static_assert(size > 2, "z() requires a Vector of 3 or more dimensions");
+
+		return m_data[2];
+	}
+
+	template<int size>
+	constexpr float& Vector<size>::w()
+	{
+		static_assert(size > 3, "w() requires a Vector of 4 dimensions");
+
+		return m_data[3];
+	}
+
+	template<int size>
+	constexpr const float& Vector<size>::w() const
+	{
+		static_assert(size > 3, "w() requires a Vector of 4 dimensions");
+
+		return m_data[3];
+	}
+
+	template<int size>
+	template<int index>
+	constexpr float& Vector<size>::get()
+	{
+		static_assert(0 <= index && index < size, "Vector index out of range");
 
 		return m_data[index];
 	}
 
 	template<int size>
-	const float& Vector<size>::operator[](const int index) const
+	template<int index>
+	constexpr const float& Vector<size>::get() const
 	{
-		if (index < 0 || index >= size)
-			throw std::out_of_range("ERROR: Attempted to access value out of Vector range.");
+		static_assert(0 <= index && index < size, "Vector index out of range");
 
 		return m_data[index];
 	}
@@ -212,27 +318,27 @@ namespace GraphicsMath
 #pragma region Iterators
 
 	template<int size>
-	std::vector<float>::iterator Vector<size>::begin()
+	constexpr typename Vector<size>::iterator Vector<size>::begin()
 	{ 
-		return m_data.begin(); 
+		return m_data; 
 	}
 
 	template<int size>
-	std::vector<float>::const_iterator Vector<size>::begin() const
+	constexpr typename Vector<size>::const_iterator Vector<size>::begin() const
 	{ 
-		return m_data.begin(); 
+		return m_data; 
 	}
 
 	template<int size>
-	std::vector<float>::iterator Vector<size>::end()
+	constexpr typename Vector<size>::iterator Vector<size>::end()
 	{ 
-		return m_data.end(); 
+		return m_data + size; 
 	}
 
 	template<int size>
-	std::vector<float>::const_iterator Vector<size>::end() const
+	constexpr typename Vector<size>::const_iterator Vector<size>::end() const
 	{ 
-		return m_data.end(); 
+		return m_data + size; 
 	}
 
 #pragma endregion
@@ -240,122 +346,122 @@ namespace GraphicsMath
 #pragma region Addition, Subtraction, & Multiplication
 
 	template<int size>
-	Vector<size> Vector<size>::operator +(const Vector<size>& v) const
+	constexpr Vector<size> Vector<size>::operator +(const Vector<size>& v) const
 	{
 		Vector<size> r;
 		for (int i = 0; i < size; ++i)
-			r[i] = m_data[i] + v[i];
+			r.m_data[i] = m_data[i] + v.m_data[i];
 
 		return r;
 	}
 
 	template<int size>
-	Vector<size> Vector<size>::operator +(const float s) const
+	constexpr Vector<size> Vector<size>::operator +(const float s) const
 	{
 		Vector<size> r;
 		for (int i = 0; i < size; ++i)
-			r[i] = m_data[i] + s;
+			r.m_data[i] = m_data[i] + s;
 
 		return r;
 	}
 
 	template<int size>
-	Vector<size> Vector<size>::operator -(const Vector<size>& v) const
+	constexpr Vector<size> Vector<size>::operator -(const Vector<size>& v) const
 	{
 		Vector<size> r;
 		for (int i = 0; i < size; ++i)
-			r[i] = m_data[i] - v[i];
+			r.m_data[i] = m_data[i] - v.m_data[i];
 
 		return r;
 	}
 
-	template<int size> 
-	Vector<size> Vector<size>::operator -(const float s) const
+	template<int size>
+	constexpr Vector<size> Vector<size>::operator -(const float s) const
 	{
 		Vector<size> r;
 		for (int i = 0; i < size; ++i)
-			r[i] = m_data[i] - s;
+			r.m_data[i] = m_data[i] - s;
 
 		return r;
 	}
 
 	template<int size>
-	Vector<size> Vector<size>::operator *(const Vector<size>& v) const
+	constexpr Vector<size> Vector<size>::operator *(const Vector<size>& v) const
 	{
 		Vector<size> r;
 		for (int i = 0; i < size; ++i)
-			r[i] = m_data[i] * v[i];
+			r.m_data[i] = m_data[i] * v.m_data[i];
 
 		return r;
 	}
 
 	template<int size>
-	Vector<size> Vector<size>::operator *(const float s) const
+	constexpr Vector<size> Vector<size>::operator *(const float s) const
 	{
 		Vector<size> r;
 		for (int i = 0; i < size; ++i)
-			r[i] = m_data[i] * s;
+			r.m_data[i] = m_data[i] * s;
 
 		return r;
 	}
 
 	template<int size>
-	Vector<size> Vector<size>::operator /(const float s) const
+	constexpr Vector<size> Vector<size>::operator /(const float s) const
 	{
 		if (s == 0)
 			throw std::runtime_error("Cannot divide vector by zero scalar.");
 
 		Vector<size> r;
 		for (int i = 0; i < size; ++i)
-			r[i] = m_data[i] / s;
+			r.m_data[i] = m_data[i] / s;
 
 		return r;
 	}
 
 	template<int size>
-	void Vector<size>::operator +=(const Vector<size>& v)
+	constexpr void Vector<size>::operator +=(const Vector<size>& v)
 	{
 		for (int i = 0; i < size; ++i)
-			m_data[i] += v[i];
+			m_data[i] += v.m_data[i];
 	}
 
 	template<int size>
-	void Vector<size>::operator +=(float s)
+	constexpr void Vector<size>::operator +=(float s)
 	{
 		for (int i = 0; i < size; ++i)
 			m_data[i] += s;
 	}
 
 	template<int size>
-	void Vector<size>::operator -=(const Vector<size>& v)
+	constexpr void Vector<size>::operator -=(const Vector<size>& v)
 	{
 		for (int i = 0; i < size; ++i)
-			m_data[i] -= v[i];
+			m_data[i] -= v.m_data[i];
 	}
 
 	template<int size>
-	void Vector<size>::operator -=(const float s)
+	constexpr void Vector<size>::operator -=(const float s)
 	{
 		for (int i = 0; i < size; ++i)
 			m_data[i] -= s;
 	}
 
 	template<int size>
-	void Vector<size>::operator *=(const Vector<size>& v)
+	constexpr void Vector<size>::operator *=(const Vector<size>& v)
 	{
 		for (int i = 0; i < size; ++i)
-			m_data[i] *= v[i];
+			m_data[i] *= v.m_data[i];
 	}
 
 	template<int size>
-	void Vector<size>::operator *=(const float s)
+	constexpr void Vector<size>::operator *=(const float s)
 	{
 		for (int i = 0; i < size; ++i)
 			m_data[i] *= s;
 	}
 
 	template<int size>
-	void Vector<size>::operator /=(const float s)
+	constexpr void Vector<size>::operator /=(const float s)
 	{
 		if (s == 0)
 			throw std::runtime_error("Cannot divide vector by zero scalar.");
@@ -369,11 +475,11 @@ namespace GraphicsMath
 #pragma region Comparison Operators
 
 	template<int size>
-	bool Vector<size>::operator ==(const Vector<size>& v) const
+	constexpr bool Vector<size>::operator ==(const Vector<size>& v) const
 	{
 		for (int i = 0; i < size; ++i)
 		{
-			if (m_data[i] != v[i])
+			if (m_data[i] != v.m_data[i])
 				return false;
 		}
 
@@ -381,17 +487,17 @@ namespace GraphicsMath
 	}
 
 	template<int size>
-	bool Vector<size>::operator !=(const Vector<size>& v) const
+	constexpr bool Vector<size>::operator !=(const Vector<size>& v) const
 	{
 		return !(*this == v);
 	}
 
 	template<int size>
-	bool Vector<size>::operator >(const Vector<size>& v) const
+	constexpr bool Vector<size>::operator >(const Vector<size>& v) const
 	{
 		for (int i = 0; i < size; ++i)
 		{
-			if (m_data[i] <= v[i])
+			if (m_data[i] <= v.m_data[i])
 				return false;
 		}
 
@@ -399,11 +505,11 @@ namespace GraphicsMath
 	}
 
 	template<int size>
-	bool Vector<size>::operator <(const Vector<size>& v) const
+	constexpr bool Vector<size>::operator <(const Vector<size>& v) const
 	{
 		for (int i = 0; i < size; ++i)
 		{
-			if (m_data[i] >= v[i])
+			if (m_data[i] >= v.m_data[i])
 				return false;
 		}
 
@@ -411,11 +517,11 @@ namespace GraphicsMath
 	}
 
 	template<int size>
-	bool Vector<size>::operator >=(const Vector<size>& v) const
+	constexpr bool Vector<size>::operator >=(const Vector<size>& v) const
 	{
 		for (int i = 0; i < size; ++i)
 		{
-			if (m_data[i] < v[i])
+			if (m_data[i] < v.m_data[i])
 				return false;
 		}
 
@@ -423,11 +529,11 @@ namespace GraphicsMath
 	}
 
 	template<int size>
-	bool Vector<size>::operator <=(const Vector<size>& v) const
+	constexpr bool Vector<size>::operator <=(const Vector<size>& v) const
 	{
 		for (int i = 0; i < size; ++i)
 		{
-			if (m_data[i] > v[i])
+			if (m_data[i] > v.m_data[i])
 				return false;
 		}
 
@@ -439,7 +545,7 @@ namespace GraphicsMath
 #pragma region Vector Specific Operations
 
 	template<int size>
-	float Vector<size>::squareMagnitude() const
+	constexpr float Vector<size>::squareMagnitude() const
 	{
 		float result = 0;
 
@@ -456,52 +562,61 @@ namespace GraphicsMath
 	}
 
 	template<int size>
-	float Vector<size>::dotProduct(const Vector<size>& v) const
+	constexpr float Vector<size>::dotProduct(const Vector<size>& v) const
 	{
 		float result = 0;
 
 		for (int i = 0; i < size; ++i)
-			result += m_data[i] * v[i];
+			result += m_data[i] * v.m_data[i];
 
 		return result;
 	}
 
 	template<int size>
-	Vector<size> Vector<size>::crossProduct(const Vector<size>& v) const
+	constexpr Vector<size> Vector<size>::crossProduct(const Vector<size>& v) const
 	{
 		static_assert(size == 3, "Cross product only valid in 3 dimensional space.");
 
 		Vector<size> product;
-		product[0] = m_data[1] * v[2] - m_data[2] * v[1];
-		product[1] = m_data[2] * v[0] - m_data[0] * v[2];
-		product[2] = m_data[0] * v[1] - m_data[1] * v[0];
+		product.m_data[0] = m_data[1] * v.m_data[2] - m_data[2] * v.m_data[1];
+		product.m_data[1] = m_data[2] * v.m_data[0] - m_data[0] * v.m_data[2];
+		product.m_data[2] = m_data[0] * v.m_data[1] - m_data[1] * v.m_data[0];
 
 		return product;
 	}
 
 	template<int size>
+	template<MathPolicy policy>
 	Vector<size> Vector<size>::normal() const
 	{
-		float m = this->magnitude();
-
-		Vector<size> v;
-		for (int i = 0; i < size; ++i)
-			v[i] = m_data[i] / m;
+		Vector<size> v{ *this };
+		v.normalize<policy>();
 
 		return v;
 	}
 
 	template<int size>
+	template<MathPolicy policy>
 	void Vector<size>::normalize()
 	{
-		float m = this->magnitude();
+		if constexpr (policy == MathPolicy::Fast)
+		{
+			float inverse = FastMath::reciprocalSquareRoot(this->squareMagnitude());
 
-		for (int i = 0; i < size; ++i)
-			m_data[i] /= m;
+			for (int i = 0; i < size; ++i)
+				m_data[i] *= inverse;
+		}
+		else
+		{
+			float m = this->magnitude();
+
+			for (int i = 0; i < size; ++i)
+				m_data[i] /= m;
+		}
 	}
 
 	template<int size>
-	Vector<size> Vector<size>::homogenous() const
+	constexpr Vector<size> Vector<size>::homogenous() const
 	{
 		Vector result{ *this };
 		result.homogenize();
@@ -510,7 +625,7 @@ namespace GraphicsMath
 	}
 
 	template<int size>
-	void Vector<size>::homogenize()
+	constexpr void Vector<size>::homogenize()
 	{
 		if (m_data[size - 1] != 0)
 		{
@@ -533,13 +648,25 @@ namespace GraphicsMath
 
 #pragma region Vector Conversion Methods
 
-	Vector<3> lowerDimension(const Vector<4>& v);
+	constexpr Vector<3> lowerDimension(const Vector<4>& v)
+	{
+		return Vector<3>{ v[0], v[1], v[2] };
+	}
 
-	Vector<2> lowerDimension(const Vector<3>& v);
+	constexpr Vector<2> lowerDimension(const Vector<3>& v)
+	{
+		return Vector<2>{ v[0], v[1] };
+	}
 
-	Vector<4> higherDimension(const Vector<3>& v, float w);
+	constexpr Vector<4> higherDimension(const Vector<3>& v, float w)
+	{
+		return Vector<4>{ v[0], v[1], v[2], w };
+	}
 
-	Vector<3> higherDimension(const Vector<2>& v, float z);
+	constexpr Vector<3> higherDimension(const Vector<2>& v, float z)
+	{
+		return Vector<3>{ v[0], v[1], z };
+	}
 
 #pragma endregion
 
@@ -0,0 +1,561 @@
+#ifndef VECTOR_STREAM_H
+#define VECTOR_STREAM_H
+
+#include <algorithm>
+#include <cstddef>
+#include <new>
+
+#include "BatchTransform.h"
+#include "FastMath.h"
+#include "SIMD.h"
+
+namespace GraphicsMath
+{
+
+#pragma region Vector Stream Class Definitions
+
+	/* -------------------------------------------------------------------------------------------------
+		Copyright 2017 Shealyn Tate Hindenlang
+
+		Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+		and associated documentation files (the "Software"), to deal in the Software without restriction,
+		including without limitation the rights to use, copy, modify, merge, publish, distribute,
+		sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+		furnished to do so, subject to the following conditions:
+
+		The above copyright notice and this permission notice shall be included in all copies or
+		substantial portions of the Software.
+
+		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+		BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+		NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+		DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+		-------------------------------------------------------------------------------------------------
+
+		VectorStream<size> holds a whole array of Vector<size> as a structure of arrays: every x,
+		then every y, and so on. The bulk operations then work on a full register of vectors at a
+		time instead of one vector's few components. VectorStreamView<size> runs the same
+		operations on component arrays owned by someone else.
+
+		Constructors:
+			VectorStream<size>(count)
+			VectorStream<size>(const Vector<size>*, count)
+			VectorStreamView<size>({ x, y, z }, count)
+
+		Usage:
+			VectorStream<3> positions(particles.data(), particles.size());
+			VectorStream<3> velocities(positions.count());
+			...
+			positions.multiplyAdd(velocities, dt);
+			positions.store(particles.data());
+
+		Notes:
+			- VectorStream is a VectorStreamView over storage it owns, so every operation below is
+			  available on both, and a VectorStream can be passed wherever a view is expected.
+			- Each component array of a VectorStream starts on its own cache line.
+			- Operations process SIMD::Wide::LaneCount vectors per step (8 with AVX, 4 with SSE); the
+			  last partial step goes through a zero padded register, so any count works.
+			- Results match the Vector methods of the same names: normalize() divides by the
+			  magnitude (so a zero vector becomes NaNs, like Vector::normalize()), and homogenize()
+			  leaves vectors whose last component is zero unchanged. Only FMA contraction can make
+			  the last bit differ. normalize<MathPolicy::Fast>() multiplies by the approximate
+			  reciprocal square root instead, within the bounds given in FastMath.h.
+			- dotProduct() and magnitude() write one float per vector to out. crossProduct() writes
+			  to a third stream, which may be either input.
+			- Operations between streams throw std::invalid_argument when the counts differ.
+			- load() and store() copy from and to an array of Vector<size>. Interleaved and planar
+			  layouts can't share memory, so this is the one place a copy is made; views over
+			  planar buffers, such as the PointStreams given to transformPoints(), copy nothing.
+			  points() goes the other way for 3 and 4 dimensional streams.
+	*/
+
+	template<int size>
+	class VectorStreamView
+	{
+		static_assert(1 < size, "VectorStream size must be at least 2");
+
+	protected:
+		float* m_components[size];
+		std::size_t m_count;
+
+		VectorStreamView();
+
+		template<typename Body>
+		static void forEachLane(std::size_t count, Body body);
+
+		void checkCount(const VectorStreamView&) const;
+
+	public:
+		VectorStreamView(float* const (&components)[size], std::size_t count);
+
+		std::size_t count() const;
+
+		float* component(const int);
+		const float* component(const int) const;
+
+		Vector<size> get(std::size_t) const;
+		void set(std::size_t, const Vector<size>&);
+
+		void load(const Vector<size>*);
+		void store(Vector<size>*) const;
+
+		void operator +=(const VectorStreamView&);
+		void operator -=(const VectorStreamView&);
+		void operator *=(float);
+		void multiplyAdd(const VectorStreamView&, float);
+
+		void dotProduct(const VectorStreamView&, float* out) const;
+		void magnitude(float* out) const;
+		template<MathPolicy policy = DefaultMathPolicy>
+		void normalize();
+		void homogenize();
+		void crossProduct(const VectorStreamView&, VectorStreamView& out) const;
+
+		PointStreams points();
+		ConstPointStreams points() const;
+	};
+
+	template<int size>
+	class VectorStream : public VectorStreamView<size>
+	{
+	private:
+		float* m_block;
+		std::size_t m_stride;
+
+		void allocate(std::size_t count);
+		void release();
+
+	public:
+		VectorStream();
+		explicit VectorStream(std::size_t count);
+		VectorStream(const Vector<size>*, std::size_t count);
+
+		VectorStream(const VectorStream&);
+		VectorStream(VectorStream&&) noexcept;
+		VectorStream& operator =(const VectorStream&);
+		VectorStream& operator =(VectorStream&&) noexcept;
+		~VectorStream();
+
+		void resize(std::size_t count);
+	};
+
+#pragma endregion
+
+#pragma region View Methods
+
+	template<int size>
+	VectorStreamView<size>::VectorStreamView()
+		: m_components{}, m_count(0)
+	{
+	}
+
+	template<int size>
+	VectorStreamView<size>::VectorStreamView(float* const (&components)[size], std::size_t count)
+		: m_count(count)
+	{
+		std::copy(components, components + size, m_components);
+	}
+
+	// Calls body(first, lanes) for each register's worth of vectors, the last one possibly partial.
+	// Bodies capture the component pointers by value: the intrinsic stores may alias anything, so
+	// pointers read through this would be reloaded after every store. Operations whose components
+	// don't interact make one pass per component instead, which streams fewer arrays at once.
+	template<int size>
+	template<typename Body>
+	void VectorStreamView<size>::forEachLane(std::size_t count, Body body)
+	{
+		const std::size_t full = count - count % SIMD::Wide::LaneCount;
+
+		for (std::size_t i = 0; i < full; i += SIMD::Wide::LaneCount)
+			body(i, SIMD::Wide::LaneCount);
+
+		if (full < count)
+			body(full, static_cast<int>(count - full));
+	}
+
+	template<int size>
+	void VectorStreamView<size>::checkCount(const VectorStreamView& v) const
+	{
+		if (v.m_count != m_count)
+			throw std::invalid_argument("ERROR: Dimension mismatch.");
+	}
+
+	template<int size>
+	std::size_t VectorStreamView<size>::count() const
+	{
+		return m_count;
+	}
+
+	template<int size>
+	float* VectorStreamView<size>::component(const int c)
+	{
+		if (GRAPHICSMATH_BOUNDS_CHECK && (c < 0 || c >= size))
+			throw std::out_of_range("ERROR: Attempted to access value out of VectorStream range.");
+
+		return m_components[c];
+	}
+
+	template<int size>
+	const float* VectorStreamView<size>::component(const int c) const
+	{
+		if (GRAPHICSMATH_BOUNDS_CHECK && (c < 0 || c >= size))
+			throw std::out_of_range("ERROR: Attempted to access value out of VectorStream range.");
+
+		return m_components[c];
+	}
+
+	template<int size>
+	Vector<size> VectorStreamView<size>::get(std::size_t i) const
+	{
+		if (GRAPHICSMATH_BOUNDS_CHECK && i >= m_count)
+			throw std::out_of_range("ERROR: Attempted to access value out of VectorStream range.");
+
+		Vector<size> result;
+		for (int c = 0; c < size; ++c)
+			result.begin()[c] = m_components[c][i];
+
+		return result;
+	}
+
+	template<int size>
+	void VectorStreamView<size>::set(std::size_t i, const Vector<size>& v)
+	{
+		if (GRAPHICSMATH_BOUNDS_CHECK && i >= m_count)
+			throw std::out_of_range("ERROR: Attempted to access value out of VectorStream range.");
+
+		for (int c = 0; c < size; ++c)
+			m_components[c][i] = v.begin()[c];
+	}
+
+	template<int size>
+	void VectorStreamView<size>::load(const Vector<size>* in)
+	{
+		for (std::size_t i = 0; i < m_count; ++i)
+		{
+			const float* v = in[i].begin();
+			for (int c = 0; c < size; ++c)
+				m_components[c][i] = v[c];
+		}
+	}
+
+	template<int size>
+	void VectorStreamView<size>::store(Vector<size>* out) const
+	{
+		for (std::size_t i = 0; i < m_count; ++i)
+		{
+			float* v = out[i].begin();
+			for (int c = 0; c < size; ++c)
+				v[c] = m_components[c][i];
+		}
+	}
+
+	template<int size>
+	void VectorStreamView<size>::operator+=(const VectorStreamView& v)
+	{
+		namespace Wide = SIMD::Wide;
+		checkCount(v);
+
+		for (int c = 0; c < size; ++c)
+		{
+			float* a = m_components[c];
+			const float* b = v.m_components[c];
+
+			forEachLane(m_count, [a, b](std::size_t i, int n)
+			{
+				Wide::store(a + i, Wide::add(Wide::load(a + i, n), Wide::load(b + i, n)), n);
+			});
+		}
+	}
+
+	template<int size>
+	void VectorStreamView<size>::operator-=(const VectorStreamView& v)
+	{
+		namespace Wide = SIMD::Wide;
+		checkCount(v);
+
+		for (int c = 0; c < size; ++c)
+		{
+			float* a = m_components[c];
+			const float* b = v.m_components[c];
+
+			forEachLane(m_count, [a, b](std::size_t i, int n)
+			{
+				Wide::store(a + i, Wide::subtract(Wide::load(a + i, n), Wide::load(b + i, n)), n);
+			});
+		}
+	}
+
+	template<int size>
+	void VectorStreamView<size>::operator*=(float s)
+	{
+		namespace Wide = SIMD::Wide;
+		const Wide::Lanes scale = Wide::broadcast(s);
+
+		for (int c = 0; c < size; ++c)
+		{
+			float* a = m_components[c];
+
+			forEachLane(m_count, [a, scale](std::size_t i, int n)
+			{
+				Wide::store(a + i, Wide::multiply(Wide::load(a + i, n), scale), n);
+			});
+		}
+	}
+
+	// this += v * s, the usual position += velocity * dt step
+	template<int size>
+	void VectorStreamView<size>::multiplyAdd(const VectorStreamView& v, float s)
+	{
+		namespace Wide = SIMD::Wide;
+		checkCount(v);
+		const Wide::Lanes scale = Wide::broadcast(s);
+
+		for (int c = 0; c < size; ++c)
+		{
+			float* a = m_components[c];
+			const float* b = v.m_components[c];
+
+			forEachLane(m_count, [a, b, scale](std::size_t i, int n)
+			{
+				Wide::store(a + i, Wide::multiplyAdd(Wide::load(b + i, n), scale, Wide::load(a + i, n)), n);
+			});
+		}
+	}
+
+	template<int size>
+	void VectorStreamView<size>::dotProduct(const VectorStreamView& v, float* out) const
+	{
+		namespace Wide = SIMD::Wide;
+		checkCount(v);
+
+		forEachLane(m_count, [*this, v, out](std::size_t i, int n)
+		{
+			Wide::Lanes sum = Wide::multiply(Wide::load(m_components[0] + i, n), Wide::load(v.m_components[0] + i, n));
+			for (int c = 1; c < size; ++c)
+				sum = Wide::multiplyAdd(Wide::load(m_components[c] + i, n), Wide::load(v.m_components[c] + i, n), sum);
+
+			Wide::store(out + i, sum, n);
+		});
+	}
+
+	template<int size>
+	void VectorStreamView<size>::magnitude(float* out) const
+	{
+		namespace Wide = SIMD::Wide;
+
+		forEachLane(m_count, [*this, out](std::size_t i, int n)
+		{
+			Wide::Lanes x = Wide::load(m_components[0] + i, n);
+			Wide::Lanes sum = Wide::multiply(x, x);
+			for (int c = 1; c < size; ++c)
+			{
+				x = Wide::load(m_components[c] + i, n);
+				sum = Wide::multiplyAdd(x, x, sum);
+			}
+
+			Wide::store(out + i, Wide::squareRoot(sum), n);
+		});
+	}
+
+	template<int size>
+	template<MathPolicy policy>
+	void VectorStreamView<size>::normalize()
+	{
+		namespace Wide = SIMD::Wide;
+
+		forEachLane(m_count, [*this](std::size_t i, int n)
+		{
+			Wide::Lanes v[size];
+			v[0] = Wide::load(m_components[0] + i, n);
+			Wide::Lanes sum = Wide::multiply(v[0], v[0]);
+			for (int c = 1; c < size; ++c)
+			{
+				v[c] = Wide::load(m_components[c] + i, n);
+				sum = Wide::multiplyAdd(v[c], v[c], sum);
+			}
+
+			if constexpr (policy == MathPolicy::Fast)
+			{
+				const Wide::Lanes inverse = Wide::reciprocalSquareRoot(sum);
+				for (int c = 0; c < size; ++c)
+					Wide::store(m_components[c] + i, Wide::multiply(v[c], inverse), n);
+			}
+			else
+			{
+				const Wide::Lanes length = Wide::squareRoot(sum);
+				for (int c = 0; c < size; ++c)
+					Wide::store(m_components[c] + i, Wide::divide(v[c], length), n);
+			}
+		});
+	}
+
+	template<int size>
+	void VectorStreamView<size>::homogenize()
+	{
+		namespace Wide = SIMD::Wide;
+
+		forEachLane(m_count, [*this](std::size_t i, int n)
+		{
+			const Wide::Lanes w = Wide::load(m_components[size - 1] + i, n);
+			for (int c = 0; c < size - 1; ++c)
+				Wide::store(m_components[c] + i, Wide::divideNonZero(Wide::load(m_components[c] + i, n), w), n);
+		});
+	}
+
+	template<int size>
+	void VectorStreamView<size>::crossProduct(const VectorStreamView& v, VectorStreamView& out) const
+	{
+		static_assert(size == 3, "The cross product is only defined for 3 dimensional vectors");
+		namespace Wide = SIMD::Wide;
+		checkCount(v);
+		checkCount(out);
+
+		forEachLane(m_count, [*this, v, out](std::size_t i, int n)
+		{
+			const Wide::Lanes ax = Wide::load(m_components[0] + i, n), ay = Wide::load(m_components[1] + i, n), az = Wide::load(m_components[2] + i, n);
+			const Wide::Lanes bx = Wide::load(v.m_components[0] + i, n), by = Wide::load(v.m_components[1] + i, n), bz = Wide::load(v.m_components[2] + i, n);
+
+			Wide::store(out.m_components[0] + i, Wide::subtract(Wide::multiply(ay, bz), Wide::multiply(az, by)), n);
+			Wide::store(out.m_components[1] + i, Wide::subtract(Wide::multiply(az, bx), Wide::multiply(ax, bz)), n);
+			Wide::store(out.m_components[2] + i, Wide::subtract(Wide::multiply(ax, by), Wide::multiply(ay, bx)), n);
+		});
+	}
+
+	template<int size>
+	PointStreams VectorStreamView<size>::points()
+	{
+		static_assert(size == 3 || size == 4, "Only 3 and 4 dimensional streams hold points");
+
+		return PointStreams{ m_components[0], m_components[1], m_components[2], size == 4 ? m_components[size - 1] : nullptr };
+	}
+
+	template<int size>
+	ConstPointStreams VectorStreamView<size>::points() const
+	{
+		static_assert(size == 3 || size == 4, "Only 3 and 4 dimensional streams hold points");
+
+		return ConstPointStreams{ m_components[0], m_components[1], m_components[2], size == 4 ? m_components[size - 1] : nullptr };
+	}
+
+#pragma endregion
+
+#pragma region Stream Methods
+
+	// Component arrays are padded to whole cache lines so each one starts on its own line
+	template<int size>
+	void VectorStream<size>::allocate(std::size_t count)
+	{
+		const std::size_t perLine = 64 / sizeof(float);
+		m_stride = (count + perLine - 1) / perLine * perLine;
+		m_block = m_stride ? static_cast<float*>(::operator new(size * m_stride * sizeof(float), std::align_val_t(64))) : nullptr;
+		std::fill(m_block, m_block + size * m_stride, 0.0f);
+
+		for (int c = 0; c < size; ++c)
+			this->m_components[c] = m_block + c * m_stride;
+		this->m_count = count;
+	}
+
+	template<int size>
+	void VectorStream<size>::release()
+	{
+		if (m_block)
+			::operator delete(m_block, std::align_val_t(64));
+
+		m_block = nullptr;
+	}
+
+	template<int size>
+	VectorStream<size>::VectorStream()
+		: m_block(nullptr), m_stride(0)
+	{
+	}
+
+	template<int size>
+	VectorStream<size>::VectorStream(std::size_t count)
+	{
+		allocate(count);
+	}
+
+	template<int size>
+	VectorStream<size>::VectorStream(const Vector<size>* in, std::size_t count)
+	{
+		allocate(count);
+		this->load(in);
+	}
+
+	template<int size>
+	VectorStream<size>::VectorStream(const VectorStream& v)
+		: VectorStreamView<size>()
+	{
+		allocate(v.m_count);
+		std::copy(v.m_block, v.m_block + size * m_stride, m_block);
+	}
+
+	template<int size>
+	VectorStream<size>::VectorStream(VectorStream&& v) noexcept
+		: VectorStreamView<size>(v), m_block(v.m_block), m_stride(v.m_stride)
+	{
+		v.m_block = nullptr;
+		v.m_stride = 0;
+		v.m_count = 0;
+		std::fill(v.m_components, v.m_components + size, nullptr);
+	}
+
+	template<int size>
+	VectorStream<size>& VectorStream<size>::operator=(const VectorStream& v)
+	{
+		if (this != &v)
+		{
+			VectorStream copy(v);
+			*this = std::move(copy);
+		}
+
+		return *this;
+	}
+
+	template<int size>
+	VectorStream<size>& VectorStream<size>::operator=(VectorStream&& v) noexcept
+	{
+		if (this != &v)
+		{
+			release();
+			std::copy(v.m_components, v.m_components + size, this->m_components);
+			this->m_count = v.m_count;
+			m_block = v.m_block;
+			m_stride = v.m_stride;
+
+			v.m_block = nullptr;
+			v.m_stride = 0;
+			v.m_count = 0;
+			std::fill(v.m_components, v.m_components + size, nullptr);
+		}
+
+		return *this;
+	}
+
+	template<int size>
+	VectorStream<size>::~VectorStream()
+	{
+		release();
+	}
+
+	// Keeps the first min(count, count()) vectors; new vectors are zero
+	template<int size>
+	void VectorStream<size>::resize(std::size_t count)
+	{
+		VectorStream resized(count);
+		const std::size_t kept = std::min(count, this->m_count);
+
+		for (int c = 0; c < size; ++c)
+			std::copy(this->m_components[c], this->m_components[c] + kept, resized.m_components[c]);
+
+		*this = std::move(resized);
+	}
+
+#pragma endregion
+
+}
+
+#endif
@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+#include "../GraphicsMathLib/Allocator.h"
+#include "../GraphicsMathLib/Matrix.h"
+
+using namespace GraphicsMath;
+
+namespace GraphicsMathUnitTests
+{
+	static bool isAligned(const void* p, std::size_t alignment)
+	{
+		return reinterpret_cast<std::uintptr_t>(p) % alignment == 0;
+	}
+
+	TEST(AllocatorTests1, FrameArena_Allocations_Are_Aligned_And_Distinct)
+	{
+		FrameArena arena(1024);
+
+		char* a = static_cast<char*>(arena.allocate(3, 1));
+		void* b = arena.allocate(sizeof(Vector<4>), alignof(Vector<4>));
+		void* c = arena.allocate(sizeof(Matrix<4, 4>), 128);
+
+		EXPECT_TRUE(isAligned(b, alignof(Vector<4>)));
+		EXPECT_TRUE(isAligned(c, 128));
+		EXPECT_GE(static_cast<char*>(b), a + 3);
+		EXPECT_GE(static_cast<char*>(c), static_cast<char*>(b) + sizeof(Vector<4>));
+		EXPECT_EQ(arena.bytesUsed(), 3 + sizeof(Vector<4>) + sizeof(Matrix<4, 4>));
+	}
+
+	TEST(AllocatorTests1, FrameArena_Reset_Reuses_Memory)
+	{
+		FrameArena arena(256);
+
+		void* first = arena.allocate(64);
+		arena.reset();
+		EXPECT_EQ(arena.allocate(64), first);
+		EXPECT_EQ(arena.capacity(), (size_t)256);
+
+		// Spilling into extra blocks, including one larger than the block size
+		for (int i = 0; i < 10; ++i)
+			arena.allocate(100);
+		arena.allocate(1000);
+
+		size_t spilled = arena.capacity();
+		EXPECT_GT(spilled, (size_t)1256);
+
+		// The next frame fits in one block of the combined size
+		arena.reset();
+		EXPECT_EQ(arena.capacity(), spilled);
+		EXPECT_EQ(arena.bytesUsed(), (size_t)0);
+
+		for (int i = 0; i < 10; ++i)
+			arena.allocate(100);
+		arena.allocate(1000);
+		EXPECT_EQ(arena.capacity(), spilled);
+	}
+
+	TEST(AllocatorTests1, PoolAllocator_Reuses_Freed_Blocks)
+	{
+		PoolAllocator pool(1024);
+
+		void* a = pool.allocate(48);
+		void* b = pool.allocate(64);
+		EXPECT_NE(a, b);
+		EXPECT_TRUE(isAligned(a, 16));
+
+		// 48 and 64 bytes share the 64 byte class, 16 bytes doesn't
+		pool.deallocate(a, 48);
+		EXPECT_NE(pool.allocate(16), a);
+		EXPECT_EQ(pool.allocate(64), a);
+
+		pool.deallocate(b, 64);
+		EXPECT_EQ(pool.allocate(33), b);
+
+		// Too large for any class
+		void* large = pool.allocate(PoolAllocator::MaximumBlock + 1);
+		EXPECT_NE(large, nullptr);
+		pool.deallocate(large, PoolAllocator::MaximumBlock + 1);
+
+		pool.reset();
+		EXPECT_EQ(pool.capacity(), (size_t)1024);
+	}
+
+	TEST(AllocatorTests1, ResourceAllocator_In_Standard_Containers)
+	{
+		FrameArena arena;
+		PoolAllocator pool;
+
+		std::vector<Vector<4>, ResourceAllocator<Vector<4>, FrameArena>> v1(arena);
+		std::vector<Matrix<4, 4>, ResourceAllocator<Matrix<4, 4>, PoolAllocator>> v2(pool);
+
+		for (int i = 0; i < 100; ++i)
+		{
+			v1.push_back(Vector<4>{ (float)i, 0, 0, 1 });
+			v2.push_back(Matrix<4, 4>::Translation(Vector<3>{ (float)i, 0, 0 }));
+		}
+
+		for (int i = 0; i < 100; ++i)
+		{
+			EXPECT_EQ(v1[i][0], (float)i);
+			EXPECT_EQ(v2[i][3][0], (float)i);
+			EXPECT_TRUE(isAligned(&v1[i], alignof(Vector<4>)));
+			EXPECT_TRUE(isAligned(&v2[i], alignof(Matrix<4, 4>)));
+		}
+
+		EXPECT_GT(arena.bytesUsed(), 100 * sizeof(Vector<4>));
+
+		ResourceAllocator<float, FrameArena> a1(arena);
+		ResourceAllocator<Vector<4>, FrameArena> a2(a1);
+		EXPECT_TRUE(a1 == a2);
+		EXPECT_TRUE((a1 != ResourceAllocator<float, FrameArena>(FrameArena::threadLocal())));
+	}
+
+	TEST(AllocatorTests1, Thread_Local_Instances)
+	{
+		FrameArena* main = &FrameArena::threadLocal();
+		FrameArena* other = nullptr;
+		PoolAllocator* otherPool = nullptr;
+
+		std::thread t([&] { other = &FrameArena::threadLocal(); otherPool = &PoolAllocator::threadLocal(); });
+		t.join();
+
+		EXPECT_EQ(main, &FrameArena::threadLocal());
+		EXPECT_NE(main, other);
+		EXPECT_NE(&PoolAllocator::threadLocal(), otherPool);
+	}
+}
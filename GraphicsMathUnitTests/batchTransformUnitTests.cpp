@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+#include "../GraphicsMathLib/BatchTransform.h"
+
+using namespace GraphicsMath;
+
+namespace GraphicsMathUnitTests
+{
+	class BatchTransformTests1 : public ::testing::Test
+	{
+	protected:
+		const float tolerance = 1e-4f;
+
+		struct PointCloud
+		{
+			std::vector<float> x, y, z, w;
+
+			PointCloud(size_t count)
+				: x(count), y(count), z(count), w(count)
+			{
+				for (size_t i = 0; i < count; ++i)
+				{
+					x[i] = (float)i * 0.5f - 3;
+					y[i] = (float)(i % 7) - 2;
+					z[i] = 1.0f / (float)(i + 1);
+					w[i] = (i % 5 == 0) ? 0.0f : 1.0f + (float)(i % 3);
+				}
+			}
+
+			ConstPointStreams streams() const { return ConstPointStreams{ x.data(), y.data(), z.data(), w.data() }; }
+			PointStreams streams() { return PointStreams{ x.data(), y.data(), z.data(), w.data() }; }
+		};
+
+		Matrix<4, 4> transform() const
+		{
+			return Matrix<4, 4>::PerspectiveProjection(60, 1.5f, 0.1f, 100) *
+				   Matrix<4, 4>::Rotation(Vector<3>{ 0.267f, 0.535f, 0.802f }, 0.7f) *
+				   Matrix<4, 4>::Translation(Vector<3>{ 1, -2, 3 });
+		}
+
+		void checkAgainstMatrixVector(size_t count, bool homogenize)
+		{
+			auto m = transform();
+			PointCloud in(count);
+			PointCloud out(count);
+
+			transformPoints(m, in.streams(), out.streams(), count, homogenize);
+
+			for (size_t i = 0; i < count; ++i)
+			{
+				auto expected = m * Vector<4>{ in.x[i], in.y[i], in.z[i], in.w[i] };
+				if (homogenize)
+					expected.homogenize();
+
+				EXPECT_NEAR(expected[0], out.x[i], tolerance);
+				EXPECT_NEAR(expected[1], out.y[i], tolerance);
+				EXPECT_NEAR(expected[2], out.z[i], tolerance);
+				EXPECT_NEAR(expected[3], out.w[i], tolerance);
+			}
+		}
+	};
+
+	TEST_F(BatchTransformTests1, Batch_Transform_Matches_Matrix_Vector)
+	{
+		// Sizes below, at and around the SSE and AVX widths exercise the scalar tail
+		for (size_t count : { 0, 1, 3, 4, 7, 8, 9, 15, 16, 17, 1000 })
+			checkAgainstMatrixVector(count, false);
+	}
+
+	TEST_F(BatchTransformTests1, Batch_Transform_Homogenize)
+	{
+		for (size_t count : { 1, 5, 8, 13, 1000 })
+			checkAgainstMatrixVector(count, true);
+	}
+
+	TEST_F(BatchTransformTests1, Batch_Transform_Implicit_W)
+	{
+		auto m = Matrix<4, 4>::Translation(Vector<3>{ 1, 2, 3 });
+		PointCloud in(11);
+		PointCloud out(11);
+
+		transformPoints(m, ConstPointStreams{ in.x.data(), in.y.data(), in.z.data(), nullptr },
+						PointStreams{ out.x.data(), out.y.data(), out.z.data(), nullptr }, 11);
+
+		for (size_t i = 0; i < 11; ++i)
+		{
+			EXPECT_NEAR(in.x[i] + 1, out.x[i], tolerance);
+			EXPECT_NEAR(in.y[i] + 2, out.y[i], tolerance);
+			EXPECT_NEAR(in.z[i] + 3, out.z[i], tolerance);
+
+			// The output w buffer was not given, so it keeps its old contents
+			EXPECT_EQ(in.w[i], out.w[i]);
+		}
+	}
+
+	TEST_F(BatchTransformTests1, Batch_Transform_In_Place)
+	{
+		auto m = Matrix<4, 4>::Scale(Vector<3>{ 2, 4, 8 });
+		PointCloud points(19);
+		PointCloud original(19);
+
+		transformPoints(m, points.streams(), points.streams(), 19);
+
+		for (size_t i = 0; i < 19; ++i)
+		{
+			EXPECT_NEAR(original.x[i] * 2, points.x[i], tolerance);
+			EXPECT_NEAR(original.y[i] * 4, points.y[i], tolerance);
+			EXPECT_NEAR(original.z[i] * 8, points.z[i], tolerance);
+			EXPECT_NEAR(original.w[i], points.w[i], tolerance);
+		}
+	}
+}
@@ -0,0 +1,274 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+#include "../GraphicsMathLib/BVH.h"
+
+using namespace GraphicsMath;
+
+namespace GraphicsMathUnitTests
+{
+	class BVHTests1 : public ::testing::Test
+	{
+	protected:
+		const float tolerance = 1e-4f;
+
+		std::vector<Vector<3>> vertices;
+		std::vector<std::uint32_t> indices;
+
+		// A bumpy sphere of 2 * rings * segments triangles around the origin
+		void makeSphere(int rings, int segments)
+		{
+			vertices.clear();
+			indices.clear();
+
+			for (int r = 0; r <= rings; ++r)
+			{
+				float theta = PI * r / rings;
+				for (int s = 0; s < segments; ++s)
+				{
+					float phi = 2.0f * PI * s / segments;
+					float radius = 1.0f + 0.1f * sinf(5.0f * theta) * cosf(7.0f * phi);
+					vertices.push_back(Vector<3>{ radius * sinf(theta) * cosf(phi), radius * cosf(theta), radius * sinf(theta) * sinf(phi) });
+				}
+			}
+
+			for (int r = 0; r < rings; ++r)
+			{
+				for (int s = 0; s < segments; ++s)
+				{
+					std::uint32_t a = r * segments + s, b = r * segments + (s + 1) % segments;
+					std::uint32_t c = a + segments, d = b + segments;
+					indices.insert(indices.end(), { a, c, b, b, c, d });
+				}
+			}
+		}
+
+		// Rays from a ring around the sphere aimed near its center, so some pass by
+		static std::vector<Ray> makeRays(int count, float offset)
+		{
+			std::vector<Ray> rays;
+			for (int i = 0; i < count; ++i)
+			{
+				float angle = 0.37f * i;
+				Vector<3> origin{ 3.0f * cosf(angle), 0.2f * (float)(i % 9) - 0.8f, 3.0f * sinf(angle) };
+				Vector<3> target{ offset * sinf(1.3f * i), offset * cosf(0.7f * i), 0.0f };
+				rays.push_back(Ray(origin, target - origin));
+			}
+
+			return rays;
+		}
+
+		TriangleHit testTriangle(const Ray& ray, std::uint32_t triangle) const
+		{
+			return intersectTriangle(ray, vertices[indices[3 * triangle]], vertices[indices[3 * triangle + 1]], vertices[indices[3 * triangle + 2]]);
+		}
+
+		// Rays through a shared edge or vertex may report either triangle, so the hit has to be the
+		// closest one and describe the triangle it names. FMA contraction can round differently
+		// where the triangle test is inlined, hence the tolerance
+		void checkHit(const Ray& ray, const BVHHit& hit, const TriangleHit& expected) const
+		{
+			EXPECT_NEAR(hit.distance, expected.distance, tolerance);
+
+			TriangleHit own = testTriangle(ray, hit.triangle);
+			EXPECT_TRUE(own.hit);
+			EXPECT_NEAR(own.distance, hit.distance, tolerance);
+			EXPECT_NEAR(own.u, hit.u, tolerance);
+			EXPECT_NEAR(own.v, hit.v, tolerance);
+		}
+
+		TriangleHit bruteForce(const Ray& ray, float maxDistance = INFINITY) const
+		{
+			TriangleHit closest = { false, 0, 0, 0 };
+			for (std::size_t i = 0; i < indices.size() / 3; ++i)
+			{
+				TriangleHit hit = intersectTriangle(ray, vertices[indices[3 * i]], vertices[indices[3 * i + 1]], vertices[indices[3 * i + 2]], 0.0f, maxDistance);
+				if (hit.hit)
+				{
+					closest = hit;
+					maxDistance = hit.distance;
+				}
+			}
+
+			return closest;
+		}
+
+		// Every node contains its children, and every triangle is in exactly one leaf
+		static void checkStructure(const BVH& bvh, const BVHSettings& settings)
+		{
+			const std::vector<BVHNode>& nodes = bvh.nodes();
+			std::vector<int> seen(bvh.triangleCount(), 0);
+
+			for (std::size_t i = 0; i < nodes.size(); ++i)
+			{
+				const BVHNode& node = nodes[i];
+				if (node.count > 0)
+				{
+					EXPECT_LE(node.count, settings.maxLeafSize);
+					for (std::uint32_t t = node.index; t < node.index + node.count; ++t)
+						++seen[t];
+					continue;
+				}
+
+				ASSERT_LT(node.index, nodes.size());
+				for (std::size_t child : { i + 1, (std::size_t)node.index })
+				{
+					AABB merged = node.bounds;
+					merged.expand(nodes[child].bounds);
+					EXPECT_TRUE(merged == node.bounds);
+				}
+			}
+
+			for (int count : seen)
+				EXPECT_EQ(count, 1);
+
+			EXPECT_LE(bvh.depth(), 64);
+		}
+	};
+
+	TEST_F(BVHTests1, Closest_And_Any_Hit)
+	{
+		makeSphere(24, 40);
+		BVHSettings settings;
+		BVH bvh = BVH::FromTriangles(vertices, indices, settings);
+
+		EXPECT_EQ(bvh.triangleCount(), indices.size() / 3);
+		EXPECT_GT(bvh.depth(), 5);
+		checkStructure(bvh, settings);
+
+		int hits = 0;
+		for (const Ray& ray : makeRays(300, 1.3f))
+		{
+			TriangleHit expected = bruteForce(ray);
+			BVHHit hit = bvh.intersect(ray);
+
+			ASSERT_EQ(hit.hit, expected.hit);
+			EXPECT_EQ(bvh.occluded(ray), expected.hit);
+			if (!expected.hit)
+				continue;
+
+			++hits;
+			checkHit(ray, hit, expected);
+			EXPECT_EQ(hit.instance, 0u);
+
+			// Shadow rays that stop short of the surface, and start past it
+			EXPECT_FALSE(bvh.occluded(ray, 0.0f, expected.distance * 0.99f));
+			EXPECT_FALSE(bvh.intersect(ray, 0.0f, expected.distance * 0.99f).hit);
+			BVHHit exit = bvh.intersect(ray, expected.distance * 1.0001f);
+			EXPECT_TRUE(exit.hit);
+			EXPECT_GT(exit.distance, expected.distance);
+		}
+
+		EXPECT_GT(hits, 100);
+		EXPECT_LT(hits, 300);
+	}
+
+	TEST_F(BVHTests1, Parallel_Build)
+	{
+		// Enough triangles for the top levels to be split with parallel binning
+		makeSphere(150, 200);
+		ThreadPool serial(1);
+		ThreadPool parallel(4);
+
+		BVHSettings settings;
+		settings.binCount = 12;
+		settings.maxLeafSize = 6;
+		BVH a = BVH::FromTriangles(vertices, indices, settings, serial);
+		BVH b = BVH::FromTriangles(vertices, indices, settings, parallel);
+
+		ASSERT_EQ(a.nodes().size(), b.nodes().size());
+		EXPECT_EQ(a.depth(), b.depth());
+		for (std::size_t i = 0; i < a.nodes().size(); ++i)
+		{
+			EXPECT_TRUE(a.nodes()[i].bounds == b.nodes()[i].bounds);
+			EXPECT_EQ(a.nodes()[i].index, b.nodes()[i].index);
+			EXPECT_EQ(a.nodes()[i].count, b.nodes()[i].count);
+		}
+
+		checkStructure(b, settings);
+
+		for (const Ray& ray : makeRays(50, 0.5f))
+		{
+			TriangleHit expected = bruteForce(ray);
+			BVHHit hit = b.intersect(ray);
+			ASSERT_TRUE(hit.hit);
+			checkHit(ray, hit, expected);
+		}
+	}
+
+	TEST_F(BVHTests1, Degenerate_Input)
+	{
+		// Empty, and a pile of triangles with one centroid, which can only be split by count
+		BVH empty = BVH::FromTriangles({}, {});
+		EXPECT_TRUE(empty.nodes().empty());
+		EXPECT_TRUE(empty.bounds().isEmpty());
+		EXPECT_FALSE(empty.intersect(Ray(Vector<3>(), Vector<3>{ 0, 0, 1 })).hit);
+
+		vertices = { Vector<3>{ -1, -1, 2 }, Vector<3>{ 1, -1, 2 }, Vector<3>{ 0, 1, 2 } };
+		indices.clear();
+		for (int i = 0; i < 1000; ++i)
+			indices.insert(indices.end(), { 0, 1, 2 });
+
+		BVHSettings settings;
+		BVH pile = BVH::FromTriangles(vertices, indices, settings);
+		checkStructure(pile, settings);
+		EXPECT_LE(pile.depth(), 10);
+
+		BVHHit hit = pile.intersect(Ray(Vector<3>(), Vector<3>{ 0, 0, 1 }));
+		EXPECT_TRUE(hit.hit);
+		EXPECT_EQ(hit.distance, 2.0f);
+
+		EXPECT_THROW(BVH::FromTriangles(vertices, { 0, 1 }), std::invalid_argument);
+		EXPECT_THROW(BVH::FromTriangles(vertices, { 0, 1, 3 }), std::out_of_range);
+		settings.maxLeafSize = 1;
+		EXPECT_THROW(BVH::FromTriangles(vertices, indices, settings), std::invalid_argument);
+	}
+
+	TEST_F(BVHTests1, Instances)
+	{
+		makeSphere(12, 16);
+		BVH sphere = BVH::FromTriangles(vertices, indices);
+		BVH empty;
+
+		// A row of spheres, every other one scaled up, behind an empty instance
+		std::vector<BVHInstance> instances = { { &empty, Matrix<4, 4>() } };
+		for (int i = 0; i < 9; ++i)
+		{
+			Matrix<4, 4> transform = Matrix<4, 4>::Translation(Vector<3>{ 3.0f * i, 0, 0 });
+			if (i % 2)
+				transform = transform * Matrix<4, 4>::Scale(Vector<3>{ 1.2f, 1.2f, 1.2f });
+			instances.push_back({ &sphere, transform });
+		}
+
+		InstancedBVH scene = InstancedBVH::FromInstances(instances);
+		EXPECT_EQ(scene.instanceCount(), 10u);
+		EXPECT_NEAR(scene.bounds().maximum()[0], 24 + 1.1f, 0.01f);
+
+		// Along the row from the left, so the first sphere is the closest hit
+		BVHHit hit = scene.intersect(Ray(Vector<3>{ -5, 0, 0 }, Vector<3>{ 1, 0, 0 }));
+		ASSERT_TRUE(hit.hit);
+		EXPECT_EQ(hit.instance, 1u);
+		EXPECT_NEAR(hit.distance, 5 - 1.0f, 0.11f);
+
+		// Down onto each sphere, which a scaled one meets sooner, against the same ray carried
+		// into the sphere's space by hand
+		for (int i = 0; i < 9; ++i)
+		{
+			const float scale = i % 2 ? 1.2f : 1.0f;
+			Ray down(Vector<3>{ 3.0f * i + 0.3f, 5, 0.2f }, Vector<3>{ 0, -2, 0 });
+			BVHHit top = scene.intersect(down);
+			BVHHit local = sphere.intersect(Ray(Vector<3>{ 0.3f, 5, 0.2f } / scale, Vector<3>{ 0, -2, 0 } / scale));
+
+			ASSERT_TRUE(top.hit);
+			EXPECT_EQ(top.instance, (std::uint32_t)(i + 1));
+			EXPECT_EQ(top.triangle, local.triangle);
+			EXPECT_NEAR(top.distance, local.distance, tolerance);
+			EXPECT_TRUE(scene.occluded(down));
+			EXPECT_FALSE(scene.occluded(down, 0.0f, top.distance * 0.99f));
+		}
+
+		EXPECT_FALSE(scene.intersect(Ray(Vector<3>{ 1.5f, 5, 0 }, Vector<3>{ 0, -1, 0 })).hit);
+		EXPECT_THROW(InstancedBVH::FromInstances({ { nullptr, Matrix<4, 4>() } }), std::invalid_argument);
+	}
+}
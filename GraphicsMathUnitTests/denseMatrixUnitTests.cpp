@@ -0,0 +1,273 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+#include "../GraphicsMathLib/DenseMatrix.h"
+
+using namespace GraphicsMath;
+
+namespace GraphicsMathUnitTests
+{
+	class DenseMatrixTests1 : public ::testing::Test
+	{
+	protected:
+		const float tolerance = 1e-3f;
+
+		static DenseMatrix makeMatrix(int rows, int cols, int seed)
+		{
+			DenseMatrix result(rows, cols);
+
+			for (int c = 0; c < cols; ++c)
+			{
+				for (int r = 0; r < rows; ++r)
+					result(r, c) = (float)((r * 7 + c * 3 + seed) % 11) * 0.25f - 1.25f;
+			}
+
+			return result;
+		}
+
+		// Diagonally dominant, so LU needs no more than the usual pivoting and stays well conditioned
+		static DenseMatrix makeSystem(int n)
+		{
+			DenseMatrix result = makeMatrix(n, n, 1);
+
+			for (int i = 0; i < n; ++i)
+				result(i, i) += (float)n;
+
+			return result;
+		}
+
+		static DenseVector makeVector(int size)
+		{
+			DenseVector result(size);
+
+			for (int i = 0; i < size; ++i)
+				result[i] = (float)(i % 9) - 4.0f;
+
+			return result;
+		}
+
+		void expectNear(const DenseMatrix& expected, const DenseMatrix& actual, float epsilon)
+		{
+			ASSERT_EQ(expected.rows(), actual.rows());
+			ASSERT_EQ(expected.cols(), actual.cols());
+
+			for (int c = 0; c < expected.cols(); ++c)
+			{
+				for (int r = 0; r < expected.rows(); ++r)
+					EXPECT_NEAR(expected(r, c), actual(r, c), epsilon) << "element " << r << ", " << c;
+			}
+		}
+	};
+
+	TEST_F(DenseMatrixTests1, DenseVector_Basics)
+	{
+		DenseVector v1{ 1, 2, 3 };
+		DenseVector v2(3);
+
+		EXPECT_EQ(v1.size(), 3);
+		EXPECT_EQ(v2[2], 0.0f);
+		EXPECT_TRUE(v1 + v1 == v1 * 2.0f);
+		EXPECT_TRUE(v1 - v1 == v2);
+		EXPECT_EQ(v1.dotProduct(v1), 14.0f);
+		EXPECT_NEAR(DenseVector({ 3, 4 }).magnitude(), 5.0f, tolerance);
+		EXPECT_EQ(v1.to_string(), "DenseVector<3> (1.000000, 2.000000, 3.000000)");
+
+		EXPECT_THROW(v1[3], std::out_of_range);
+		EXPECT_THROW(v1[-1], std::out_of_range);
+		EXPECT_THROW(v1 += DenseVector(4), std::invalid_argument);
+		EXPECT_THROW(DenseVector(-1), std::invalid_argument);
+	}
+
+	TEST_F(DenseMatrixTests1, DenseVector_Segments)
+	{
+		DenseVector v(DenseVector{ 0, 1, 2, 3, 4, 5 });
+
+		EXPECT_TRUE((v.segment<4>(2) == Vector<4>{ 2, 3, 4, 5 }));
+		EXPECT_THROW(v.segment<4>(3), std::out_of_range);
+
+		v.setSegment(0, Vector<3>{ 9, 8, 7 });
+		EXPECT_TRUE((v == DenseVector{ 9, 8, 7, 3, 4, 5 }));
+		EXPECT_THROW(v.setSegment(4, Vector<3>()), std::out_of_range);
+
+		EXPECT_TRUE((DenseVector(Vector<4>{ 1, 2, 3, 4 }) == DenseVector{ 1, 2, 3, 4 }));
+	}
+
+	TEST_F(DenseMatrixTests1, DenseMatrix_Basics)
+	{
+		DenseMatrix m{ { 1, 2 }, { 3, 4 }, { 5, 6 } };
+
+		EXPECT_EQ(m.rows(), 2);
+		EXPECT_EQ(m.cols(), 3);
+		EXPECT_EQ(m(1, 2), 6.0f);
+		EXPECT_EQ(m.column(1)[0], 3.0f);
+		EXPECT_EQ(m.to_string(), "[ 1.000000, 3.000000, 5.000000 ]\n[ 2.000000, 4.000000, 6.000000 ]\n");
+
+		EXPECT_TRUE(m + m == m * 2.0f);
+		EXPECT_TRUE(m - m == DenseMatrix(2, 3));
+		EXPECT_TRUE(DenseMatrix::Identity(2) * m == m);
+		EXPECT_TRUE((m.transposition() == DenseMatrix{ { 1, 3, 5 }, { 2, 4, 6 } }));
+		EXPECT_TRUE((m * DenseVector{ 1, 0, -1 } == DenseVector{ -4, -4 }));
+
+		EXPECT_THROW(m(2, 0), std::out_of_range);
+		EXPECT_THROW(m(0, 3), std::out_of_range);
+		EXPECT_THROW(m * m, std::invalid_argument);
+		EXPECT_THROW(m + DenseMatrix(3, 2), std::invalid_argument);
+		EXPECT_THROW((DenseMatrix{ { 1, 2 }, { 3 } }), std::invalid_argument);
+	}
+
+	TEST_F(DenseMatrixTests1, DenseMatrix_Blocks)
+	{
+		Matrix<4, 4> transform = Matrix<4, 4>::Translation(Vector<3>{ 1, 2, 3 }) * Matrix<4, 4>::Scale(Vector<3>{ 2, 2, 2 });
+		DenseMatrix m(8, 10);
+
+		m.setBlock(4, 5, transform);
+		EXPECT_TRUE((m.block<4, 4>(4, 5) == transform));
+		EXPECT_EQ(m(7, 8), 1.0f);
+		EXPECT_EQ(m(4, 8), 1.0f);
+		EXPECT_EQ(m(3, 5), 0.0f);
+		EXPECT_TRUE((m.block<2, 3>(4, 5) == Matrix<2, 3>{ { 2, 0 }, { 0, 2 }, { 0, 0 } }));
+
+		EXPECT_THROW((m.block<4, 4>(5, 5)), std::out_of_range);
+		EXPECT_THROW(m.setBlock(0, 7, transform), std::out_of_range);
+
+		// Products of embedded blocks match the fixed size products
+		Matrix<4, 4> rotation = Matrix<4, 4>::Rotation(Vector<3>{ 0, 0, 1 }, 0.5f);
+		DenseMatrix product = DenseMatrix(transform) * DenseMatrix(rotation);
+		EXPECT_TRUE((product.block<4, 4>(0, 0) == transform * rotation));
+
+		Vector<4> point{ 1, 2, 3, 1 };
+		DenseVector moved = DenseMatrix(transform) * DenseVector(point);
+		EXPECT_TRUE((moved.segment<4>(0) == transform * point));
+	}
+
+	TEST_F(DenseMatrixTests1, DenseMatrix_Multiplication)
+	{
+		// Around the kernel's tile and block sizes and the parallel split, with ragged edges
+		const int sizes[][3] = { { 1, 1, 1 }, { 3, 70, 5 }, { 67, 130, 91 }, { 200, 150, 129 } };
+		ThreadPool serial(1);
+		ThreadPool parallel(4);
+
+		for (const auto& size : sizes)
+		{
+			DenseMatrix a = makeMatrix(size[0], size[1], 2);
+			DenseMatrix b = makeMatrix(size[1], size[2], 5);
+			DenseMatrix expected(size[0], size[2]);
+			DenseMatrix out1, out4;
+
+			SIMD::Scalar::multiply(a.data(), b.data(), expected.data(), size[0], size[1], size[2]);
+			multiply(a, b, out1, serial);
+			multiply(a, b, out4, parallel);
+
+			expectNear(expected, out1, tolerance);
+			EXPECT_TRUE(out1 == out4) << size[0] << "x" << size[1] << "x" << size[2];
+		}
+
+		// In place
+		DenseMatrix m = makeMatrix(20, 20, 3);
+		DenseMatrix expected = m * m;
+		multiply(m, m, m);
+		EXPECT_TRUE(m == expected);
+	}
+
+	TEST_F(DenseMatrixTests1, DenseMatrix_Vector_Multiplication_And_Transposition)
+	{
+		ThreadPool serial(1);
+		ThreadPool parallel(4);
+
+		for (int rows : { 1, 7, 300, 2500 })
+		{
+			const int cols = rows == 2500 ? 37 : rows + 3;
+			DenseMatrix a = makeMatrix(rows, cols, 4);
+			DenseVector x = makeVector(cols);
+			DenseVector out1, out4;
+
+			multiply(a, x, out1, serial);
+			multiply(a, x, out4, parallel);
+			EXPECT_TRUE(out1 == out4);
+
+			for (int r = 0; r < rows; ++r)
+			{
+				float expected = 0;
+				for (int c = 0; c < cols; ++c)
+					expected += a(r, c) * x[c];
+
+				EXPECT_NEAR(expected, out1[r], tolerance);
+			}
+
+			DenseMatrix t = a.transposition(parallel);
+			ASSERT_EQ(t.rows(), cols);
+			for (int r = 0; r < rows; ++r)
+			{
+				for (int c = 0; c < cols; ++c)
+					EXPECT_EQ(t(c, r), a(r, c));
+			}
+		}
+	}
+
+	TEST_F(DenseMatrixTests1, LUDecomposition)
+	{
+		// Larger than one panel, so the blocked update is exercised
+		const int n = 150;
+		DenseMatrix a = makeSystem(n);
+		LUDecomposition lu(a);
+
+		EXPECT_FALSE(lu.isSingular());
+
+		// PA = LU
+		DenseMatrix pa(a);
+		for (int i = 0; i < n; ++i)
+		{
+			for (int c = 0; c < n; ++c)
+				std::swap(pa(i, c), pa(lu.pivots()[i], c));
+		}
+		expectNear(pa, lu.lower() * lu.upper(), tolerance * n);
+
+		DenseVector b = makeVector(n);
+		DenseVector x = lu.solve(b);
+		DenseVector residual = a * x - b;
+		EXPECT_LT(residual.magnitude(), tolerance * n);
+
+		// Pivoting and determinants against the fixed size matrices
+		Matrix<4, 4> m{ { 0, 2, 1, 0 }, { 1, 0, 0, 3 }, { 2, 1, 0, 1 }, { 0, 0, 4, 1 } };
+		EXPECT_NEAR(LUDecomposition(DenseMatrix(m)).determinant(), m.determinant(), tolerance);
+
+		DenseMatrix singular{ { 1, 2, 3 }, { 2, 4, 6 }, { 0, 1, 1 } };
+		LUDecomposition singularLU(singular);
+		EXPECT_TRUE(singularLU.isSingular());
+		EXPECT_EQ(singularLU.determinant(), 0.0f);
+		EXPECT_THROW(singularLU.solve(DenseVector(3)), std::runtime_error);
+		EXPECT_THROW(LUDecomposition(DenseMatrix(2, 3)), std::invalid_argument);
+		EXPECT_THROW(lu.solve(DenseVector(3)), std::invalid_argument);
+	}
+
+	TEST_F(DenseMatrixTests1, CholeskyDecomposition)
+	{
+		const int n = 150;
+		DenseMatrix m = makeMatrix(n, n, 6);
+		DenseMatrix a = m * m.transposition() + DenseMatrix::Identity(n) * (float)n;
+
+		// Only the lower triangle is read
+		DenseMatrix lowerOnly(a);
+		for (int c = 1; c < n; ++c)
+		{
+			for (int r = 0; r < c; ++r)
+				lowerOnly(r, c) = -1000;
+		}
+
+		CholeskyDecomposition cholesky(lowerOnly);
+		const DenseMatrix& l = cholesky.lower();
+		EXPECT_EQ(l(0, 1), 0.0f);
+		expectNear(a, l * l.transposition(), tolerance * n);
+
+		DenseVector b = makeVector(n);
+		DenseVector residual = a * cholesky.solve(b) - b;
+		EXPECT_LT(residual.magnitude(), tolerance * n);
+
+		DenseMatrix small{ { 4, 2 }, { 2, 3 } };
+		EXPECT_NEAR(CholeskyDecomposition(small).determinant(), 8.0f, tolerance);
+		EXPECT_NEAR(LUDecomposition(small).determinant(), 8.0f, tolerance);
+
+		EXPECT_THROW(CholeskyDecomposition(DenseMatrix{ { 1, 2 }, { 2, 1 } }), std::runtime_error);
+	}
+}
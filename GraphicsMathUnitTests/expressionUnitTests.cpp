@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+
+#include "../GraphicsMathLib/Expression.h"
+
+using namespace GraphicsMath;
+
+namespace GraphicsMathUnitTests
+{
+	class ExpressionTests1 : public ::testing::Test
+	{
+	protected:
+		const Vector<4> a{ 1, 2, 3, 4 };
+		const Vector<4> b{ -5, 6, 0.5f, 8 };
+		const Vector<4> c{ 9, -10, 11, 0.25f };
+
+		const Matrix<3, 3> m1{ Vector<3>{1, 2, 3}, Vector<3>{4, 5, 6}, Vector<3>{7, 8, 9} };
+		const Matrix<3, 3> m2{ Vector<3>{-1, 0.5f, 2}, Vector<3>{3, -4, 5}, Vector<3>{6, 7, -8} };
+
+		// The fused loop may contract a * b + c differently from the eager operators
+		void expectNear(const Vector<4>& expected, const Vector<4>& actual)
+		{
+			for (int i = 0; i < 4; ++i)
+				EXPECT_NEAR(expected[i], actual[i], 1e-5f);
+		}
+
+		void expectNear(const Matrix<3, 3>& expected, const Matrix<3, 3>& actual)
+		{
+			for (int i = 0; i < 3; ++i)
+			{
+				for (int j = 0; j < 3; ++j)
+					EXPECT_NEAR(expected[i][j], actual[i][j], 1e-5f);
+			}
+		}
+	};
+
+	TEST_F(ExpressionTests1, Expression_Vector_Matches_Eager)
+	{
+		Vector<4> v1 = lazy(a) + lazy(b) * 2.0f - c;
+		expectNear(a + b * 2.0f - c, v1);
+
+		Vector<4> v2 = lazy(a) * b / 4.0f + 1.0f;
+		expectNear((a * b) / 4.0f + 1.0f, v2);
+
+		Vector<4> v3 = lazy(c) - 2.0f + lazy(a) * (lazy(b) - a);
+		expectNear((c - 2.0f) + a * (b - a), v3);
+
+		// Scalars on the left
+		Vector<4> v4 = 3.0f * lazy(a) + 1.0f;
+		expectNear(a * 3.0f + 1.0f, v4);
+
+		auto v5 = (lazy(a) + b).evaluate();
+		expectNear(a + b, v5);
+	}
+
+	TEST_F(ExpressionTests1, Expression_Matrix_Matches_Eager)
+	{
+		Matrix<3, 3> m3 = lazy(m1) + m2;
+		expectNear(m1 + m2, m3);
+
+		Matrix<3, 3> m4 = lazy(m1) * 0.25f - lazy(m2) * 0.75f;
+		expectNear(m1 * 0.25f - m2 * 0.75f, m4);
+
+		Matrix<3, 3> m5 = 2.0f * (lazy(m1) - m2);
+		expectNear((m1 - m2) * 2.0f, m5);
+	}
+
+	TEST_F(ExpressionTests1, Expression_Operands_Are_Read_Lazily)
+	{
+		Vector<4> v1{ 1, 1, 1, 1 };
+		auto e = lazy(v1) * 2.0f;
+
+		v1[0] = 5;
+
+		EXPECT_EQ(e.evaluate()[0], 10.0f);
+		EXPECT_EQ(e.evaluate()[1], 2.0f);
+	}
+
+	TEST_F(ExpressionTests1, Expression_Divide_By_Zero)
+	{
+		EXPECT_THROW(lazy(a) / 0.0f, std::runtime_error);
+	}
+}
@@ -0,0 +1,142 @@
+#include <gtest/gtest.h>
+
+// This file opts in to the fast policy; the other test files keep the precise default
+#define GRAPHICSMATH_FAST_MATH 1
+
+#include <cmath>
+#include "../GraphicsMathLib/Packet.h"
+#include "../GraphicsMathLib/VectorStream.h"
+
+using namespace GraphicsMath;
+
+namespace GraphicsMathUnitTests
+{
+	class FastMathTests1 : public ::testing::Test
+	{
+	protected:
+		// Distance from the exact result in units in the last place of the float nearest to it
+		static double ulps(float value, double exact)
+		{
+			float nearest = std::fabs((float)exact);
+			double ulp = nearest == 0 ? std::ldexp(1.0, -149) : (double)(std::nextafter(nearest, INFINITY) - nearest);
+
+			return std::fabs((double)value - exact) / ulp;
+		}
+	};
+
+	TEST_F(FastMathTests1, Reciprocal_Square_Root)
+	{
+		double worst = 0;
+		for (float x = 1e-30f; x < 1e30f; x *= 1.0013f)
+			worst = std::max(worst, ulps(FastMath::reciprocalSquareRoot(x), 1.0 / std::sqrt((double)x)));
+
+		EXPECT_LE(worst, 3.5);
+		EXPECT_EQ(reciprocalSquareRoot<MathPolicy::Precise>(4.0f), 0.5f);
+
+		// The packed version, in every lane
+		for (float x = 1e-20f; x < 1e20f; x *= 1.7f)
+		{
+			float lanes[8] = { x, x * 1.1f, x * 1.2f, x * 1.3f, x * 1.4f, x * 1.5f, x * 1.6f, x * 1.7f };
+			Float8 inverse = reciprocalSquareRoot<MathPolicy::Fast>(Float8::Load(lanes));
+			for (int i = 0; i < 8; ++i)
+				EXPECT_LE(ulps(inverse[i], 1.0 / std::sqrt((double)lanes[i])), 3.5);
+		}
+	}
+
+	TEST_F(FastMathTests1, Sine_Cosine_Tangent)
+	{
+		double worstSine = 0, worstCosine = 0, worstTangent = 0;
+
+		for (float x = -8192.0f; x <= 8192.0f; x += 0.0137f)
+		{
+			float s, c;
+			FastMath::sinCos(x, s, c);
+			double exactSine = std::sin((double)x), exactCosine = std::cos((double)x);
+
+			EXPECT_LT(std::fabs(s - exactSine), 1e-7);
+			EXPECT_LT(std::fabs(c - exactCosine), 1e-7);
+
+			// Near a zero only the absolute error is bounded
+			if (std::fabs(s - exactSine) > 6e-8)
+				worstSine = std::max(worstSine, ulps(s, exactSine));
+			if (std::fabs(c - exactCosine) > 6e-8)
+				worstCosine = std::max(worstCosine, ulps(c, exactCosine));
+			if (std::fabs(exactSine) > 0.1 && std::fabs(exactCosine) > 0.1)
+				worstTangent = std::max(worstTangent, ulps(FastMath::tangent(x), std::tan((double)x)));
+		}
+
+		EXPECT_LE(worstSine, 1.6);
+		EXPECT_LE(worstCosine, 1.6);
+		EXPECT_LE(worstTangent, 4.0);
+
+		// Arguments past the reduction's range, where the quadrant no longer fits an int
+		for (float x : { 8192.5f, -1e5f, 1e10f, -3.4e38f })
+		{
+			float s, c;
+			FastMath::sinCos(x, s, c);
+			EXPECT_EQ(s, std::sin(x));
+			EXPECT_EQ(c, std::cos(x));
+		}
+
+		for (float x : { INFINITY, -INFINITY, NAN })
+		{
+			float s, c;
+			FastMath::sinCos(x, s, c);
+			EXPECT_TRUE(std::isnan(s));
+			EXPECT_TRUE(std::isnan(c));
+			EXPECT_TRUE(std::isnan(FastMath::tangent(x)));
+		}
+	}
+
+	TEST_F(FastMathTests1, Policies)
+	{
+		// GRAPHICSMATH_FAST_MATH makes the calls without a policy take the fast path
+		EXPECT_TRUE(DefaultMathPolicy == MathPolicy::Fast);
+
+		Vector<3> v{ 3, -4, 12 };
+		Vector<3> fast = v.normal(), precise = v.normal<MathPolicy::Precise>();
+		EXPECT_TRUE(fast == v.normal<MathPolicy::Fast>());
+		for (int i = 0; i < 3; ++i)
+			EXPECT_NEAR(fast[i], precise[i], 2e-7f);
+		EXPECT_NEAR(fast.magnitude(), 1.0f, 2e-7f);
+
+		Vector<3> axis{ 0, 0.6f, 0.8f };
+		Matrix<4, 4> fastRotation = Matrix<4, 4>::Rotation(axis, 2.5f);
+		Matrix<4, 4> preciseRotation = Matrix<4, 4>::Rotation<MathPolicy::Precise>(axis, 2.5f);
+		Matrix<4, 4> fastProjection = Matrix<4, 4>::PerspectiveProjection(60, 1.5f, 0.1f, 100);
+		Matrix<4, 4> preciseProjection = Matrix<4, 4>::PerspectiveProjection<MathPolicy::Precise>(60, 1.5f, 0.1f, 100);
+
+		for (int c = 0; c < 4; ++c)
+		{
+			for (int r = 0; r < 4; ++r)
+			{
+				EXPECT_NEAR(fastRotation[c][r], preciseRotation[c][r], 3e-7f);
+				EXPECT_NEAR(fastProjection[c][r], preciseProjection[c][r], 1e-5f * std::fabs(preciseProjection[c][r]));
+			}
+		}
+
+		// Packets and streams follow the same default
+		std::vector<Vector<3>> vectors(19);
+		for (int i = 0; i < 19; ++i)
+			vectors[i] = Vector<3>{ (float)i - 9.0f, 0.5f, (float)(i % 4) * 3.0f };
+
+		Vector3x8 packet = Vector3x8::Load(vectors.data()).normal();
+		VectorStream<3> stream(vectors.data(), vectors.size());
+		stream.normalize();
+		std::vector<Vector<3>> streamed(vectors.size());
+		stream.store(streamed.data());
+
+		for (int i = 0; i < 19; ++i)
+		{
+			precise = vectors[i].normal<MathPolicy::Precise>();
+			for (int j = 0; j < 3; ++j)
+			{
+				EXPECT_NEAR(streamed[i][j], precise[j], 4e-7f);
+				if (i < 8)
+				{
+					EXPECT_NEAR(packet.lane(i)[j], precise[j], 4e-7f);
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,185 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include "../GraphicsMathLib/Frustum.h"
+
+using namespace GraphicsMath;
+
+namespace GraphicsMathUnitTests
+{
+	class FrustumTests1 : public ::testing::Test
+	{
+	protected:
+		const float tolerance = 1e-5f;
+
+		// A camera at (1, 2, 3) looking down -z, so the frustum is shifted off the origin
+		Matrix<4, 4> viewProjection = Matrix<4, 4>::PerspectiveProjection(90.0f, 1.5f, 0.5f, 50.0f) *
+									  Matrix<4, 4>::Translation(Vector<3>{ -1, -2, -3 });
+
+		// Points scattered over a box around the frustum, some of them inside it
+		static Vector<3> scatter(int i)
+		{
+			return Vector<3>{ 1 + 40.0f * sinf(1.3f * i), 2 + 30.0f * cosf(0.7f * i), 3 - 30.0f + 35.0f * sinf(0.37f * i + 1.0f) };
+		}
+
+		// Spheres and boxes over the same spread as structure of arrays
+		struct Volumes
+		{
+			std::vector<float> x, y, z, radius;
+			std::vector<float> minimumX, minimumY, minimumZ, maximumX, maximumY, maximumZ;
+
+			SphereStreams spheres() const { return { x.data(), y.data(), z.data(), radius.data() }; }
+			BoxStreams boxes() const { return { minimumX.data(), minimumY.data(), minimumZ.data(), maximumX.data(), maximumY.data(), maximumZ.data() }; }
+		};
+
+		static Volumes makeVolumes(int count)
+		{
+			Volumes v;
+			for (int i = 0; i < count; ++i)
+			{
+				Vector<3> center = scatter(i);
+				Vector<3> half{ 0.5f + 2.0f * fabsf(sinf(2.1f * i)), 0.5f + fabsf(cosf(1.7f * i)), 1.0f };
+
+				v.x.push_back(center[0]);
+				v.y.push_back(center[1]);
+				v.z.push_back(center[2]);
+				v.radius.push_back(half.magnitude());
+				v.minimumX.push_back(center[0] - half[0]);
+				v.minimumY.push_back(center[1] - half[1]);
+				v.minimumZ.push_back(center[2] - half[2]);
+				v.maximumX.push_back(center[0] + half[0]);
+				v.maximumY.push_back(center[1] + half[1]);
+				v.maximumZ.push_back(center[2] + half[2]);
+			}
+
+			return v;
+		}
+	};
+
+	TEST_F(FrustumTests1, Planes_From_Projections)
+	{
+		// A 90 degree square frustum in view space, from z = -1 to z = -100
+		Frustum view = Frustum::FromMatrix(Matrix<4, 4>::PerspectiveProjection(90.0f, 1.0f, 1.0f, 100.0f));
+		const float diagonal = 1.0f / sqrtf(2.0f);
+
+		const Plane& left = view.plane(Frustum::Left);
+		EXPECT_NEAR(left.normal()[0], diagonal, tolerance);
+		EXPECT_NEAR(left.normal()[1], 0.0f, tolerance);
+		EXPECT_NEAR(left.normal()[2], -diagonal, tolerance);
+		EXPECT_NEAR(left.distance(), 0.0f, tolerance);
+
+		const Plane& nearPlane = view.plane(Frustum::Near);
+		EXPECT_NEAR(nearPlane.normal()[2], -1.0f, tolerance);
+		EXPECT_NEAR(nearPlane.distance(), -1.0f, 1e-4f);
+		EXPECT_NEAR(view.plane(Frustum::Far).signedDistance(Vector<3>{ 0, 0, -90 }), 10.0f, 1e-3f);
+
+		EXPECT_TRUE(view.contains(Vector<3>{ 0, 0, -10 }));
+		EXPECT_TRUE(view.contains(Vector<3>{ 9.9f, -9.9f, -10 }));
+		EXPECT_FALSE(view.contains(Vector<3>{ 10.1f, 0, -10 }));
+		EXPECT_FALSE(view.contains(Vector<3>{ 0, 0, -0.5f }));
+		EXPECT_FALSE(view.contains(Vector<3>{ 0, 0, -101 }));
+		EXPECT_FALSE(view.contains(Vector<3>{ 0, 0, 10 }));
+
+		// Orthographic: a box from x = -2 to 2, y = -1 to 1, z = -0.5 to -10
+		Frustum box = Frustum::FromMatrix(Matrix<4, 4>::OrthographicProjection(-2, 2, 1, -1, 0.5f, 10));
+		EXPECT_TRUE(box.contains(Vector<3>{ 1.9f, 0.9f, -9.9f }));
+		EXPECT_FALSE(box.contains(Vector<3>{ 2.1f, 0, -5 }));
+		EXPECT_FALSE(box.contains(Vector<3>{ 0, -1.1f, -5 }));
+		EXPECT_FALSE(box.contains(Vector<3>{ 0, 0, -0.4f }));
+		EXPECT_NEAR(box.plane(Frustum::Right).signedDistance(Vector<3>{ 0.5f, 0, -5 }), 1.5f, tolerance);
+
+		EXPECT_THROW(box.plane(6), std::out_of_range);
+		EXPECT_THROW(box.plane(-1), std::out_of_range);
+	}
+
+	TEST_F(FrustumTests1, Contains_Matches_Clip_Space)
+	{
+		// A point is inside when its clip coordinates are all within [-w, w]
+		Frustum frustum = Frustum::FromMatrix(viewProjection);
+		int inside = 0;
+
+		for (int i = 0; i < 2000; ++i)
+		{
+			Vector<3> p = scatter(i);
+			Vector<4> clip = viewProjection * Vector<4>{ p[0], p[1], p[2], 1.0f };
+
+			// Skip points within rounding of a plane
+			float margin = fabsf(clip[3]);
+			for (int axis = 0; axis < 3; ++axis)
+				margin = std::fmin(margin, fabsf(fabsf(clip[axis]) - clip[3]));
+			if (margin < 1e-3f)
+				continue;
+
+			bool expected = clip[3] > 0 && fabsf(clip[0]) <= clip[3] && fabsf(clip[1]) <= clip[3] && fabsf(clip[2]) <= clip[3];
+			EXPECT_EQ(frustum.contains(p), expected) << "point " << i;
+			inside += expected;
+		}
+
+		EXPECT_GT(inside, 100);
+	}
+
+	TEST_F(FrustumTests1, Spheres_And_Boxes)
+	{
+		Frustum frustum = Frustum::FromMatrix(Matrix<4, 4>::PerspectiveProjection(90.0f, 1.0f, 1.0f, 100.0f));
+
+		// Straddling the near plane, just behind it, and touching it
+		EXPECT_TRUE(frustum.intersects(Vector<3>{ 0, 0, -0.5f }, 1.0f));
+		EXPECT_FALSE(frustum.intersects(Vector<3>{ 0, 0, -0.5f }, 0.4f));
+		EXPECT_TRUE(frustum.intersects(Vector<3>{ 0, 0, 0 }, 1.0f));
+		EXPECT_FALSE(frustum.intersects(Vector<3>{ 0, 30, -10 }, 5.0f));
+
+		EXPECT_TRUE(frustum.intersects(AABB(Vector<3>{ -1, -1, -20 }, Vector<3>{ 1, 1, -10 })));
+		EXPECT_TRUE(frustum.intersects(AABB(Vector<3>{ 9, -1, -11 }, Vector<3>{ 20, 1, -10 })));
+		EXPECT_FALSE(frustum.intersects(AABB(Vector<3>{ 11, -1, -10 }, Vector<3>{ 20, 1, -9 })));
+		EXPECT_FALSE(frustum.intersects(AABB(Vector<3>{ -1, -1, -120 }, Vector<3>{ 1, 1, -101 })));
+
+		// A box around the whole frustum is kept although no corner is inside
+		EXPECT_TRUE(frustum.intersects(AABB(Vector<3>{ -500, -500, -500 }, Vector<3>{ 500, 500, 500 })));
+	}
+
+	TEST_F(FrustumTests1, Batch_Culling)
+	{
+		// Enough objects for several parallel chunks, and a count that leaves a partial register
+		const int count = 70001;
+		Frustum frustum = Frustum::FromMatrix(viewProjection);
+		Volumes volumes = makeVolumes(count);
+
+		std::vector<std::uint32_t> expectedSpheres, expectedBoxes;
+		for (int i = 0; i < count; ++i)
+		{
+			Vector<3> center{ volumes.x[i], volumes.y[i], volumes.z[i] };
+			if (frustum.intersects(center, volumes.radius[i]))
+				expectedSpheres.push_back(i);
+
+			AABB box(Vector<3>{ volumes.minimumX[i], volumes.minimumY[i], volumes.minimumZ[i] },
+					 Vector<3>{ volumes.maximumX[i], volumes.maximumY[i], volumes.maximumZ[i] });
+			if (frustum.intersects(box))
+				expectedBoxes.push_back(i);
+		}
+
+		EXPECT_GT(expectedSpheres.size(), 1000u);
+		EXPECT_LT(expectedSpheres.size(), (std::size_t)count / 2);
+
+		ThreadPool serial(1);
+		ThreadPool parallel(4);
+		std::vector<std::uint32_t> visible(count);
+
+		auto visibleList = [&visible](std::size_t visibleCount)
+		{
+			return std::vector<std::uint32_t>(visible.begin(), visible.begin() + visibleCount);
+		};
+
+		EXPECT_EQ(visibleList(frustum.cullSpheres(volumes.spheres(), count, visible.data(), serial)), expectedSpheres);
+		EXPECT_EQ(visibleList(frustum.cullSpheres(volumes.spheres(), count, visible.data(), parallel)), expectedSpheres);
+		EXPECT_EQ(visibleList(frustum.cullBoxes(volumes.boxes(), count, visible.data(), serial)), expectedBoxes);
+		EXPECT_EQ(visibleList(frustum.cullBoxes(volumes.boxes(), count, visible.data(), parallel)), expectedBoxes);
+
+		// Short inputs, all within one partial register
+		std::size_t firstThree = std::lower_bound(expectedSpheres.begin(), expectedSpheres.end(), 3u) - expectedSpheres.begin();
+		EXPECT_EQ(visibleList(frustum.cullSpheres(volumes.spheres(), 3, visible.data())),
+				  std::vector<std::uint32_t>(expectedSpheres.begin(), expectedSpheres.begin() + firstThree));
+		EXPECT_EQ(frustum.cullBoxes(volumes.boxes(), 0, visible.data()), 0u);
+	}
+}
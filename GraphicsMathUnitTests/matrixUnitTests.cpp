@@ -1,16 +1,19 @@
-#include "stdafx.h"
-#include "CppUnitTest.h"
+#include <gtest/gtest.h>
 
+#include <algorithm>
+#include <cmath>
 #include <iostream>
-#include "..\GraphicsMathLib\Matrix.h"
+#include <memory>
+#include <vector>
+#include "../GraphicsMathLib/Matrix.h"
 
-using namespace Microsoft::VisualStudio::CppUnitTestFramework;
 using namespace GraphicsMath;
 
 namespace GraphicsMathUnitTests
 {
-	TEST_CLASS(MatrixTests1)
+	class MatrixTests1 : public ::testing::Test
 	{
+	protected:
 		const float zero = 0;
 		const float one = 1;
 		const float two = 2;
@@ -21,233 +24,623 @@ namespace GraphicsMathUnitTests
 		const float seven = 7;
 		const float eight = 8;
 		const float nine = 9;
+	};
 
-	public:
+	// Reference inverse in double precision: the adjugate built from 3x3 minors over the determinant
+	static void referenceInverse4x4(const Matrix<4, 4>& m, double out[4][4])
+	{
+		auto minor = [&m](int skipCol, int skipRow)
+		{
+			double a[3][3];
+			for (int i = 0, c = 0; i < 4; ++i)
+			{
+				if (i == skipCol)
+					continue;
+
+				for (int j = 0, r = 0; j < 4; ++j)
+				{
+					if (j != skipRow)
+						a[c][r++] = m[i][j];
+				}
+				++c;
+			}
+
+			return a[0][0] * (a[1][1] * a[2][2] - a[2][1] * a[1][2]) -
+				   a[1][0] * (a[0][1] * a[2][2] - a[2][1] * a[0][2]) +
+				   a[2][0] * (a[0][1] * a[1][2] - a[1][1] * a[0][2]);
+		};
+
+		double det = 0;
+		for (int i = 0; i < 4; ++i)
+			det += ((i % 2) ? -1.0 : 1.0) * m[i][0] * minor(i, 0);
+
+		for (int i = 0; i < 4; ++i)
+		{
+			for (int j = 0; j < 4; ++j)
+				out[i][j] = (((i + j) % 2) ? -1.0 : 1.0) * minor(j, i) / det;
+		}
+	}
 
-		// TODO: Copy and move constructor and assignment tests
+	// Expects every element of m to be within tolerance of the reference inverse, relative to its largest element
+	static void expectNearInverse(const Matrix<4, 4>& m, const Matrix<4, 4>& inverse, double tolerance)
+	{
+		double expected[4][4];
+		referenceInverse4x4(m, expected);
 
-		TEST_METHOD(Matrix_Constructors_And_Accessors_1)
+		double scale = 0;
+		for (int i = 0; i < 4; ++i)
 		{
-			Matrix<2, 2> m2a;
-			Matrix<3, 3> m3a;
-			Matrix<4, 4> m4a;
-			
-			Assert::AreEqual(m2a[0][0], one);
-			Assert::AreEqual(m2a[0][1], zero);
-			Assert::AreEqual(m2a[1][0], zero);
-			Assert::AreEqual(m2a[1][1], one);
-
-			Assert::AreEqual(m3a[0][0], one);
-			Assert::AreEqual(m3a[0][1], zero);
-			Assert::AreEqual(m3a[0][2], zero);
-			Assert::AreEqual(m3a[1][0], zero);
-			Assert::AreEqual(m3a[1][1], one);
-			Assert::AreEqual(m3a[1][2], zero);
-			Assert::AreEqual(m3a[2][0], zero);
-			Assert::AreEqual(m3a[2][1], zero);
-			Assert::AreEqual(m3a[2][2], one);
-
-			Assert::AreEqual(m4a[0][0], one);
-			Assert::AreEqual(m4a[0][1], zero);
-			Assert::AreEqual(m4a[0][2], zero);
-			Assert::AreEqual(m4a[0][3], zero);
-			Assert::AreEqual(m4a[1][0], zero);
-			Assert::AreEqual(m4a[1][1], one);
-			Assert::AreEqual(m4a[1][2], zero);
-			Assert::AreEqual(m4a[1][3], zero);
-			Assert::AreEqual(m4a[2][0], zero);
-			Assert::AreEqual(m4a[2][1], zero);
-			Assert::AreEqual(m4a[2][2], one);
-			Assert::AreEqual(m4a[2][3], zero);
-			Assert::AreEqual(m4a[3][0], zero);
-			Assert::AreEqual(m4a[3][1], zero);
-			Assert::AreEqual(m4a[3][2], zero);
-			Assert::AreEqual(m4a[3][3], one);
+			for (int j = 0; j < 4; ++j)
+				scale = std::max(scale, std::abs(expected[i][j]));
 		}
 
-		TEST_METHOD(Matrix_Constructors_And_Accessors_2)
+		for (int i = 0; i < 4; ++i)
 		{
-			Matrix<2, 2> m2{ Vector<2>{1, 2}, Vector<2>{3, 4} };
-			Matrix<3, 3> m3{ Vector<3>{1, 2, 3}, Vector<3>{4, 5, 6}, Vector<3>{7, 8, 9} };
-			Matrix<4, 4> m4{ Vector<4>{1, 2, 3, 4}, Vector<4>{5, 6, 7, 8}, Vector<4>{9, 10, 11, 12}, Vector<4>{13, 14, 15, 16} };
-
-			Assert::AreEqual(m2[0][0], one);
-			Assert::AreEqual(m2[0][1], two);
-			Assert::AreEqual(m2[1][0], three);
-			Assert::AreEqual(m2[1][1], four);
-
-			Assert::AreEqual(m3[0][0], one);
-			Assert::AreEqual(m3[0][1], two);
-			Assert::AreEqual(m3[0][2], three);
-			Assert::AreEqual(m3[1][0], four);
-			Assert::AreEqual(m3[1][1], five);
-			Assert::AreEqual(m3[1][2], six);
-			Assert::AreEqual(m3[2][0], seven);
-			Assert::AreEqual(m3[2][1], eight);
-			Assert::AreEqual(m3[2][2], nine);
-
-			Assert::AreEqual(m4[0][0], one);
-			Assert::AreEqual(m4[0][1], two);
-			Assert::AreEqual(m4[0][2], three);
-			Assert::AreEqual(m4[0][3], four);
-			Assert::AreEqual(m4[1][0], five);
-			Assert::AreEqual(m4[1][1], six);
-			Assert::AreEqual(m4[1][2], seven);
-			Assert::AreEqual(m4[1][3], eight);
-			Assert::AreEqual(m4[2][0], nine);
-			Assert::AreEqual(m4[2][1], (float)10);
-			Assert::AreEqual(m4[2][2], (float)11);
-			Assert::AreEqual(m4[2][3], (float)12);
-			Assert::AreEqual(m4[3][0], (float)13);
-			Assert::AreEqual(m4[3][1], (float)14);
-			Assert::AreEqual(m4[3][2], (float)15);
-			Assert::AreEqual(m4[3][3], (float)16);
+			for (int j = 0; j < 4; ++j)
+				EXPECT_NEAR(expected[i][j], inverse[i][j], tolerance * scale);
 		}
+	}
+
+	TEST_F(MatrixTests1, Matrix_Constructors_And_Accessors_1)
+	{
+		Matrix<2, 2> m2a;
+		Matrix<3, 3> m3a;
+		Matrix<4, 4> m4a;
+		
+		EXPECT_EQ(m2a[0][0], one);
+		EXPECT_EQ(m2a[0][1], zero);
+		EXPECT_EQ(m2a[1][0], zero);
+		EXPECT_EQ(m2a[1][1], one);
+
+		EXPECT_EQ(m3a[0][0], one);
+		EXPECT_EQ(m3a[0][1], zero);
+		EXPECT_EQ(m3a[0][2], zero);
+		EXPECT_EQ(m3a[1][0], zero);
+		EXPECT_EQ(m3a[1][1], one);
+		EXPECT_EQ(m3a[1][2], zero);
+		EXPECT_EQ(m3a[2][0], zero);
+		EXPECT_EQ(m3a[2][1], zero);
+		EXPECT_EQ(m3a[2][2], one);
+
+		EXPECT_EQ(m4a[0][0], one);
+		EXPECT_EQ(m4a[0][1], zero);
+		EXPECT_EQ(m4a[0][2], zero);
+		EXPECT_EQ(m4a[0][3], zero);
+		EXPECT_EQ(m4a[1][0], zero);
+		EXPECT_EQ(m4a[1][1], one);
+		EXPECT_EQ(m4a[1][2], zero);
+		EXPECT_EQ(m4a[1][3], zero);
+		EXPECT_EQ(m4a[2][0], zero);
+		EXPECT_EQ(m4a[2][1], zero);
+		EXPECT_EQ(m4a[2][2], one);
+		EXPECT_EQ(m4a[2][3], zero);
+		EXPECT_EQ(m4a[3][0], zero);
+		EXPECT_EQ(m4a[3][1], zero);
+		EXPECT_EQ(m4a[3][2], zero);
+		EXPECT_EQ(m4a[3][3], one);
+	}
+
+	TEST_F(MatrixTests1, Matrix_Constructors_And_Accessors_2)
+	{
+		Matrix<2, 2> m2{ Vector<2>{1, 2}, Vector<2>{3, 4} };
+		Matrix<3, 3> m3{ Vector<3>{1, 2, 3}, Vector<3>{4, 5, 6}, Vector<3>{7, 8, 9} };
+		Matrix<4, 4> m4{ Vector<4>{1, 2, 3, 4}, Vector<4>{5, 6, 7, 8}, Vector<4>{9, 10, 11, 12}, Vector<4>{13, 14, 15, 16} };
+
+		EXPECT_EQ(m2[0][0], one);
+		EXPECT_EQ(m2[0][1], two);
+		EXPECT_EQ(m2[1][0], three);
+		EXPECT_EQ(m2[1][1], four);
+
+		EXPECT_EQ(m3[0][0], one);
+		EXPECT_EQ(m3[0][1], two);
+		EXPECT_EQ(m3[0][2], three);
+		EXPECT_EQ(m3[1][0], four);
+		EXPECT_EQ(m3[1][1], five);
+		EXPECT_EQ(m3[1][2], six);
+		EXPECT_EQ(m3[2][0], seven);
+		EXPECT_EQ(m3[2][1], eight);
+		EXPECT_EQ(m3[2][2], nine);
+
+		EXPECT_EQ(m4[0][0], one);
+		EXPECT_EQ(m4[0][1], two);
+		EXPECT_EQ(m4[0][2], three);
+		EXPECT_EQ(m4[0][3], four);
+		EXPECT_EQ(m4[1][0], five);
+		EXPECT_EQ(m4[1][1], six);
+		EXPECT_EQ(m4[1][2], seven);
+		EXPECT_EQ(m4[1][3], eight);
+		EXPECT_EQ(m4[2][0], nine);
+		EXPECT_EQ(m4[2][1], (float)10);
+		EXPECT_EQ(m4[2][2], (float)11);
+		EXPECT_EQ(m4[2][3], (float)12);
+		EXPECT_EQ(m4[3][0], (float)13);
+		EXPECT_EQ(m4[3][1], (float)14);
+		EXPECT_EQ(m4[3][2], (float)15);
+		EXPECT_EQ(m4[3][3], (float)16);
+	}
+
+	TEST_F(MatrixTests1, Matrix_Copy_Constructor_And_Assignment)
+	{
+		Matrix<3, 3> m1{ Vector<3>{1, 2, 3}, Vector<3>{4, 5, 6}, Vector<3>{7, 8, 9} };
+		Matrix<3, 3> m2{ m1 };
+		Matrix<3, 3> m3;
+		m3 = m1;
+
+		m1[1][1] = 0;
+
+		EXPECT_EQ(m2[1][1], five);
+		EXPECT_EQ(m3[1][1], five);
+		EXPECT_EQ(m3[2][0], seven);
+	}
+
+	TEST_F(MatrixTests1, Matrix_Unchecked_Accessors)
+	{
+		Matrix<4, 4> m4{ Vector<4>{1, 2, 3, 4}, Vector<4>{5, 6, 7, 8}, Vector<4>{9, 10, 11, 12}, Vector<4>{13, 14, 15, 16} };
+
+		EXPECT_TRUE((m4.get<2>() == Vector<4>{ 9, 10, 11, 12 }));
+		EXPECT_EQ((m4.get<3, 1>()), (float)14);
+		EXPECT_EQ((m4.get<0, 3>()), (float)4);
+
+		m4.get<1, 2>() = 0;
+		EXPECT_EQ(m4[1][2], zero);
+		EXPECT_EQ(&m4.get<3>(), &m4[3]);
+
+		constexpr Matrix<2, 2> m2{ Vector<2>{1, 2}, Vector<2>{3, 4} };
+		static_assert(m2.get<1, 0>() == 3 && m2.get<0>().y() == 2, "Unchecked accessors should be usable in constant expressions");
+	}
+
+	TEST_F(MatrixTests1, Matrix_Contiguous_Storage)
+	{
+		EXPECT_TRUE((std::is_trivially_copyable<Matrix<4, 4>>::value));
+		EXPECT_EQ(sizeof(Matrix<4, 4>), 16 * sizeof(float));
+		EXPECT_EQ(sizeof(Matrix<3, 3>), 9 * sizeof(float));
+		EXPECT_EQ(alignof(Matrix<4, 4>), (size_t)16);
+
+		Matrix<4, 4> m4{ Vector<4>{1, 2, 3, 4}, Vector<4>{5, 6, 7, 8}, Vector<4>{9, 10, 11, 12}, Vector<4>{13, 14, 15, 16} };
+		const float* data = m4.data();
+
+		// Column-major: consecutive floats walk down a column
+		for (int i = 0; i < 16; ++i)
+			EXPECT_EQ(data[i], (float)(i + 1));
+
+		m4[2][1] = 0;
+		EXPECT_EQ(data[9], zero);
+	}
+
+	TEST_F(MatrixTests1, Matrix_Addition_1)
+	{
+		Matrix<2, 2> m1;
+		m1[0][0] = 1;
+		m1[1][1] = 2;
+
+		Matrix<2, 2> m2;
+		m2[0][1] = 3;
+		m2[1][0] = 4;
 
-		TEST_METHOD(Matrix_Addition_1)
+		EXPECT_EQ(m1[0][0], one);
+		EXPECT_EQ(m1[0][1], zero);
+		EXPECT_EQ(m1[1][0], zero);
+		EXPECT_EQ(m1[1][1], two);
+
+		EXPECT_EQ(m2[0][1], three);
+		EXPECT_EQ(m2[0][0], one);
+		EXPECT_EQ(m2[1][1], one);
+		EXPECT_EQ(m2[1][0], four);
+
+		auto m3 = m1 + m2;
+
+		EXPECT_EQ(m3[0][0], two);
+		EXPECT_EQ(m3[1][1], three);
+		EXPECT_EQ(m3[0][1], three);
+		EXPECT_EQ(m3[1][0], four);
+	}
+
+	TEST_F(MatrixTests1, Matrix_Addition_2)
+	{
+		Matrix<3, 3> m1;
+		m1[0][0] = 1;
+		m1[1][1] = 2;
+		m1[2][2] = 3;
+
+		Matrix<3, 3> m2;
+		m2[0][1] = 4;
+		m2[0][2] = 5;
+		m2[1][0] = 6;
+		m2[1][2] = 7;
+		m2[2][0] = 8;
+		m2[2][1] = 9;
+
+		auto m3 = m1 + m2;
+
+		EXPECT_EQ(m3[0][0], two);
+		EXPECT_EQ(m3[0][1], four);
+		EXPECT_EQ(m3[0][2], five);
+
+		EXPECT_EQ(m3[1][0], six);
+		EXPECT_EQ(m3[1][1], three);
+		EXPECT_EQ(m3[1][2], seven);
+		
+		EXPECT_EQ(m3[2][0], eight);
+		EXPECT_EQ(m3[2][1], nine);
+		EXPECT_EQ(m3[2][2], four);
+	}
+
+	TEST_F(MatrixTests1, Matrix_Matrix_Multiplication_1)
+	{
+		Matrix<2, 2> m1;
+		m1[0][0] = 1;
+		m1[1][1] = 2;
+
+		Matrix<2, 2> m2;
+		m2[0][0] = 3;
+		m2[1][1] = 4;
+
+		auto m3 = m1 * m2;
+
+		EXPECT_EQ(m3[0][0], three);
+		EXPECT_EQ(m3[1][1], eight);
+	}
+
+	TEST_F(MatrixTests1, Matrix_Matrix_Multiplication_2)
+	{
+		Matrix<3, 3> m1;
+		m1[0][0] = 1;
+		m1[1][1] = 2;
+		m1[2][2] = 0;
+		m1[0][1] = 3;
+		m1[2][0] = 2;
+
+		Matrix<3, 3> m2;
+		m2[0][0] = 3;
+		m2[1][1] = 4;
+		m2[2][2] = 0;
+		m2[0][1] = 2;
+		m2[2][0] = 2;
+
+		m1 *= m2;
+
+		EXPECT_EQ(m1[0][0], three);
+		EXPECT_EQ(m1[2][0], two);
+		EXPECT_EQ(m1[0][1], (float)13);
+		EXPECT_EQ(m1[1][1], eight);
+		EXPECT_EQ(m1[2][0], two);
+		EXPECT_EQ(m1[2][1], six);
+	}
+
+	TEST_F(MatrixTests1, Matrix_Matrix_Multiplication_SIMD)
+	{
+		auto m1 = Matrix<4, 4>::Rotation(Vector<3>{ 0.267f, 0.535f, 0.802f }, 0.7f) * Matrix<4, 4>::Translation(Vector<3>{ 1, -2, 3 });
+		Matrix<4, 4> m2{ Vector<4>{1, 2, 3, 4}, Vector<4>{-5, 6, 7, 8}, Vector<4>{9, -10, 11, 12}, Vector<4>{13, 14, -15, 16} };
+
+		auto m3 = m1 * m2;
+
+		Matrix<4, 4> expected;
+		SIMD::Scalar::multiply4x4(m1.data(), m2.data(), expected.data());
+
+		for (int i = 0; i < 4; ++i)
 		{
-			Matrix<2, 2> m1;
-			m1[0][0] = 1;
-			m1[1][1] = 2;
-
-			Matrix<2, 2> m2;
-			m2[0][1] = 3;
-			m2[1][0] = 4;
-
-			Assert::AreEqual(m1[0][0], one);
-			Assert::AreEqual(m1[0][1], zero);
-			Assert::AreEqual(m1[1][0], zero);
-			Assert::AreEqual(m1[1][1], two);
-
-			Assert::AreEqual(m2[0][1], three);
-			Assert::AreEqual(m2[0][0], one);
-			Assert::AreEqual(m2[1][1], one);
-			Assert::AreEqual(m2[1][0], four);
-
-			auto m3 = m1 + m2;
-
-			Assert::AreEqual(m3[0][0], two);
-			Assert::AreEqual(m3[1][1], three);
-			Assert::AreEqual(m3[0][1], three);
-			Assert::AreEqual(m3[1][0], four);
+			for (int j = 0; j < 4; ++j)
+				EXPECT_NEAR(expected[i][j], m3[i][j], 1e-4f);
 		}
+	}
+
+	TEST_F(MatrixTests1, Matrix_Vector_Multiplication_SIMD)
+	{
+		Matrix<4, 4> m1{ Vector<4>{1, 2, 3, 4}, Vector<4>{-5, 6, 7, 8}, Vector<4>{9, -10, 11, 12}, Vector<4>{13, 14, -15, 16} };
+		Vector<4> v1{ 0.5f, -1.5f, 2.25f, 1 };
+
+		auto v2 = m1 * v1;
+
+		Vector<4> expected;
+		SIMD::Scalar::transform4x4(m1.data(), v1.begin(), expected.begin());
+
+		for (int i = 0; i < 4; ++i)
+			EXPECT_NEAR(expected[i], v2[i], 1e-4f);
+
+		// Column 3 holds the translation, so a point picks it up and a direction does not
+		auto m2 = Matrix<4, 4>::Translation(Vector<3>{ 1, 2, 3 });
+		auto v3 = m2 * Vector<4>{ 1, 1, 1, 1 };
+		auto v4 = m2 * Vector<4>{ 1, 1, 1, 0 };
+
+		EXPECT_EQ(v3[0], two);
+		EXPECT_EQ(v3[1], three);
+		EXPECT_EQ(v3[2], four);
+		EXPECT_EQ(v4[0], one);
+		EXPECT_EQ(v4[2], one);
+	}
+
+	TEST_F(MatrixTests1, Matrix_Vector_Multiplication_1)
+	{
+		Matrix<2, 2> m1;
+		m1[0][0] = 1;
+		m1[1][1] = 2;
 
-		TEST_METHOD(Matrix_Addition_2)
+		Vector<2> v1{ 3, 4 };
+
+		auto v2 = m1 * v1;
+
+		EXPECT_EQ(v2[0], (float)3);
+		EXPECT_EQ(v2[1], (float)8);
+	}
+
+	TEST_F(MatrixTests1, Matrix_Vector_Multiplication_2)
+	{
+		Matrix<3, 3> m1;
+
+	}
+
+	TEST_F(MatrixTests1, Matrix_Scale_Matrix)
+	{
+		auto m1 = Matrix<4, 4>::Scale(Vector<3>{2, 4, 8});
+
+		EXPECT_EQ(m1[0][0], two);
+		EXPECT_EQ(m1[1][1], four);
+		EXPECT_EQ(m1[2][2], eight);
+		EXPECT_EQ(m1[0][1], zero);
+		EXPECT_EQ(m1[0][2], zero);
+
+		auto m2 = Matrix<4, 4>::ScaleInverse(m1);
+
+		EXPECT_EQ(m2[0][0], 0.5f);
+		EXPECT_EQ(m2[1][1], 0.25f);
+		EXPECT_EQ(m2[2][2], 0.125f);
+		EXPECT_EQ(m2[0][1], zero);
+		EXPECT_EQ(m2[0][2], zero);
+	}
+
+	TEST_F(MatrixTests1, Matrix_Inverse_4x4)
+	{
+		Matrix<4, 4> m1{ Vector<4>{1, 2, 3, 4}, Vector<4>{-5, 6, 7, 8}, Vector<4>{9, -10, 11, 12}, Vector<4>{13, 14, -15, 16} };
+		auto m2 = Matrix<4, 4>::PerspectiveProjection(60, 1.5f, 0.1f, 100);
+		auto m3 = Matrix<4, 4>::Rotation(Vector<3>{ 0.267f, 0.535f, 0.802f }, 0.7f) * Matrix<4, 4>::Scale(Vector<3>{ 2, 0.5f, 3 });
+
+		for (auto& m : { m1, m2, m3 })
 		{
-			Matrix<3, 3> m1;
-			m1[0][0] = 1;
-			m1[1][1] = 2;
-			m1[2][2] = 3;
-
-			Matrix<3, 3> m2;
-			m2[0][1] = 4;
-			m2[0][2] = 5;
-			m2[1][0] = 6;
-			m2[1][2] = 7;
-			m2[2][0] = 8;
-			m2[2][1] = 9;
-
-			auto m3 = m1 + m2;
-
-			Assert::AreEqual(m3[0][0], two);
-			Assert::AreEqual(m3[0][1], four);
-			Assert::AreEqual(m3[0][2], five);
-
-			Assert::AreEqual(m3[1][0], six);
-			Assert::AreEqual(m3[1][1], three);
-			Assert::AreEqual(m3[1][2], seven);
-			
-			Assert::AreEqual(m3[2][0], eight);
-			Assert::AreEqual(m3[2][1], nine);
-			Assert::AreEqual(m3[2][2], four);
+			expectNearInverse(m, m.inverse(), 1e-5);
+
+			Matrix<4, 4> scalar;
+			SIMD::Scalar::inverse4x4(m.data(), scalar.data());
+			expectNearInverse(m, scalar, 1e-5);
+
+			auto identity = m * m.inverse();
+			for (int i = 0; i < 4; ++i)
+			{
+				for (int j = 0; j < 4; ++j)
+					EXPECT_NEAR(identity[i][j], i == j ? one : zero, 1e-4f);
+			}
 		}
 
-		TEST_METHOD(Matrix_Matrix_Multiplication_1)
-		{
-			Matrix<2, 2> m1;
-			m1[0][0] = 1;
-			m1[1][1] = 2;
+		auto m4 = m1;
+		m4.invert();
+		EXPECT_TRUE(m4 == m1.inverse());
 
-			Matrix<2, 2> m2;
-			m2[0][0] = 3;
-			m2[1][1] = 4;
+		// Two equal columns
+		Matrix<4, 4> singular{ Vector<4>{1, 2, 3, 4}, Vector<4>{1, 2, 3, 4}, Vector<4>{9, -10, 11, 12}, Vector<4>{0, 0, 0, 1} };
+		EXPECT_THROW(singular.inverse(), std::runtime_error);
 
-			auto m3 = m1 * m2;
+		auto m5 = singular;
+		EXPECT_THROW(m5.invert(), std::runtime_error);
+		EXPECT_TRUE(m5 == singular);
+	}
 
-			Assert::AreEqual(m3[0][0], three);
-			Assert::AreEqual(m3[1][1], eight);
-		}
+	TEST_F(MatrixTests1, Matrix_Transpose)
+	{
+		Matrix<3, 3> m3a{ Vector<3>{1, 2, 3}, Vector<3>{4, 5, 6}, Vector<3>{7, 8, 9} };
+		Matrix<4, 4> m4a{ Vector<4>{1, 2, 3, 4}, Vector<4>{5, 6, 7, 8}, Vector<4>{9, 10, 11, 12}, Vector<4>{13, 14, 15, 16} };
+
+		auto m3b = m3a.transposition();
+		auto m4b = m4a.transposition();
 
-		TEST_METHOD(Matrix_Matrix_Multiplication_2)
+		for (int i = 0; i < 4; ++i)
 		{
-			Matrix<3, 3> m1;
-			m1[0][0] = 1;
-			m1[1][1] = 2;
-			m1[2][2] = 0;
-			m1[0][1] = 3;
-			m1[2][0] = 2;
-
-			Matrix<3, 3> m2;
-			m2[0][0] = 3;
-			m2[1][1] = 4;
-			m2[2][2] = 0;
-			m2[0][1] = 2;
-			m2[2][0] = 2;
-
-			m1 *= m2;
-
-			Assert::AreEqual(m1[0][0], three);
-			Assert::AreEqual(m1[2][0], two);
-			Assert::AreEqual(m1[0][1], (float)13);
-			Assert::AreEqual(m1[1][1], eight);
-			Assert::AreEqual(m1[2][0], two);
-			Assert::AreEqual(m1[2][1], six);
+			for (int j = 0; j < 4; ++j)
+			{
+				EXPECT_EQ(m4b[i][j], m4a[j][i]);
+
+				if (i < 3 && j < 3)
+				{
+					EXPECT_EQ(m3b[i][j], m3a[j][i]);
+				}
+			}
 		}
 
-		TEST_METHOD(Matrix_Vector_Multiplication_1)
-		{
-			Matrix<2, 2> m1;
-			m1[0][0] = 1;
-			m1[1][1] = 2;
+		m3a.transpose();
+		m4a.transpose();
+		EXPECT_TRUE(m3a == m3b);
+		EXPECT_TRUE(m4a == m4b);
+
+		m4a.transpose();
+		EXPECT_EQ(m4a[3][0], (float)13);
+	}
+
+	TEST_F(MatrixTests1, Matrix_Move)
+	{
+		// Storage is inline, so a move is a plain copy that never allocates or throws
+		EXPECT_TRUE((std::is_trivially_move_constructible<Matrix<4, 4>>::value));
+		EXPECT_TRUE((std::is_trivially_move_assignable<Matrix<4, 4>>::value));
+		EXPECT_TRUE((std::is_nothrow_move_constructible<Matrix<3, 3>>::value));
+
+		Matrix<3, 3> m3a{ Vector<3>{1, 2, 3}, Vector<3>{4, 5, 6}, Vector<3>{7, 8, 9} };
+		Matrix<3, 3> m3b{ std::move(m3a) };
+		Matrix<3, 3> m3c;
+		m3c = std::move(m3b);
+
+		EXPECT_EQ(m3c[2][1], (float)8);
+	}
+
+	TEST_F(MatrixTests1, Matrix_Affine_Inverse)
+	{
+		auto m1 = Matrix<4, 4>::Translation(Vector<3>{ 1, -2, 3 }) *
+				  Matrix<4, 4>::Rotation(Vector<3>{ 0.267f, 0.535f, 0.802f }, 0.7f) *
+				  Matrix<4, 4>::Scale(Vector<3>{ 2, 0.5f, 3 });
+		Matrix<4, 4> m2{ Vector<4>{1, 2, 3, 0}, Vector<4>{-5, 6, 7, 0}, Vector<4>{9, -10, 11, 0}, Vector<4>{13, 14, -15, 1} };
 
-			Vector<2> v1{ 3, 4 };
+		for (auto& m : { m1, m2 })
+		{
+			auto inverse = m.affineInverse();
+			expectNearInverse(m, inverse, 1e-5);
 
-			auto v2 = m1 * v1;
+			Matrix<4, 4> scalar;
+			SIMD::Scalar::affineInverse4x4(m.data(), scalar.data());
+			expectNearInverse(m, scalar, 1e-5);
 
-			Assert::AreEqual(v2[0], (float)3);
-			Assert::AreEqual(v2[1], (float)8);
+			EXPECT_EQ(inverse[0][3], zero);
+			EXPECT_EQ(inverse[1][3], zero);
+			EXPECT_EQ(inverse[2][3], zero);
+			EXPECT_EQ(inverse[3][3], one);
 		}
 
-		TEST_METHOD(Matrix_Vector_Multiplication_2)
+		// A point moved by the matrix comes back to where it started
+		Vector<4> v1{ 0.5f, -1.5f, 2.25f, 1 };
+		auto v2 = m1.affineInverse() * (m1 * v1);
+
+		for (int i = 0; i < 4; ++i)
+			EXPECT_NEAR(v1[i], v2[i], 1e-5f);
+
+		auto singular = Matrix<4, 4>::Scale(Vector<3>{ 1, 0, 1 });
+		EXPECT_THROW(singular.affineInverse(), std::runtime_error);
+	}
+
+	TEST_F(MatrixTests1, Matrix_Constexpr)
+	{
+		constexpr auto m1 = Matrix<4, 4>::Translation(Vector<3>{ 1, 2, 3 }) * Matrix<4, 4>::Scale(Vector<3>{ 2, 4, 8 });
+		static_assert(m1[0][0] == 2 && m1[2][2] == 8 && m1[3][1] == 2, "Transform constructors and products must be usable in constant expressions");
+
+		constexpr auto v1 = m1 * Vector<4>{ 1, 1, 1, 1 };
+		static_assert(v1 == Vector<4>{ 3, 6, 11, 1 }, "Matrix * Vector must be usable in constant expressions");
+
+		constexpr auto m2 = m1.affineInverse();
+		constexpr auto m3 = m1.inverse();
+		static_assert(m2 == m3, "Inverses must be usable in constant expressions");
+		static_assert(m2 * v1 == Vector<4>{ 1, 1, 1, 1 }, "A point must come back from the inverse transform");
+		static_assert(m1.determinant() == 64, "determinant must be usable in constant expressions");
+
+		constexpr Matrix<3, 3> m4{ Vector<3>{1, 2, 3}, Vector<3>{4, 5, 6}, Vector<3>{7, 8, 10} };
+		static_assert(m4.transposition()[0] == Vector<3>{ 1, 4, 7 }, "transposition must be usable in constant expressions");
+		static_assert((m4 + m4 - m4 * 2.0f) == Matrix<3, 3>{ Vector<3>{}, Vector<3>{}, Vector<3>{} }, "Matrix arithmetic must be usable in constant expressions");
+		static_assert(m4.determinant() == -3, "determinant must be usable in constant expressions");
+		static_assert(Matrix<2, 2>{ Vector<2>{2, 0}, Vector<2>{0, 4} }.inverse()[1][1] == 0.25f, "inverse must be usable in constant expressions");
+
+		constexpr auto m5 = Matrix<4, 4>::OrthographicProjection(-1, 1, 1, -1, 0.5f, 100.5f);
+		static_assert(m5[2][2] == -0.02f, "Projection constructors must be usable in constant expressions");
+
+		// The constant and runtime paths agree
+		auto m6 = Matrix<4, 4>::Translation(Vector<3>{ 1, 2, 3 });
+		m6 = m6 * Matrix<4, 4>::Scale(Vector<3>{ 2, 4, 8 });
+		EXPECT_TRUE(m6 == m1);
+		EXPECT_TRUE(m6.inverse() == m3);
+	}
+
+	TEST_F(MatrixTests1, Matrix_Non_Square)
+	{
+		Matrix<3, 2> m1{ Vector<3>{1, 2, 3}, Vector<3>{4, 5, 6} };
+		Matrix<2, 4> m2{ Vector<2>{1, 0}, Vector<2>{0, 1}, Vector<2>{1, 1}, Vector<2>{2, -1} };
+
+		Matrix<3, 4> m3 = m1 * m2;
+		EXPECT_TRUE(m3[0] == (Vector<3>{ 1, 2, 3 }));
+		EXPECT_TRUE(m3[1] == (Vector<3>{ 4, 5, 6 }));
+		EXPECT_TRUE(m3[2] == (Vector<3>{ 5, 7, 9 }));
+		EXPECT_TRUE(m3[3] == (Vector<3>{ -2, -1, 0 }));
+
+		EXPECT_TRUE((m1 * Vector<2>{ 1, -1 }) == (Vector<3>{ -3, -3, -3 }));
+
+		Matrix<2, 3> m4 = m1.transposition();
+		EXPECT_TRUE(m4[0] == (Vector<2>{ 1, 4 }));
+		EXPECT_TRUE(m4[2] == (Vector<2>{ 3, 6 }));
+		EXPECT_TRUE(m4.transposition() == m1);
+
+		// Ones on the main diagonal only
+		Matrix<2, 3> m5;
+		EXPECT_TRUE(m5[0] == (Vector<2>{ 1, 0 }));
+		EXPECT_TRUE(m5[1] == (Vector<2>{ 0, 1 }));
+		EXPECT_TRUE(m5[2] == (Vector<2>{ 0, 0 }));
+
+		EXPECT_TRUE((m1 + m1) == m1 * 2.0f);
+		EXPECT_THROW((Matrix<3, 2>{ Vector<3>{1, 2, 3} }), std::runtime_error);
+	}
+
+	TEST_F(MatrixTests1, Matrix_Large_Multiplication)
+	{
+		// Sizes around the tile and block sizes of the blocked kernel, including ragged edges
+		const int sizes[][3] = { { 16, 16, 16 }, { 17, 33, 5 }, { 64, 64, 64 }, { 100, 130, 70 }, { 2, 300, 3 } };
+
+		for (const auto& size : sizes)
 		{
-			Matrix<3, 3> m1;
+			int rows = size[0], inner = size[1], cols = size[2];
+			std::vector<float> a(rows * inner), b(inner * cols), expected(rows * cols), actual(rows * cols, -1);
 
+			for (size_t i = 0; i < a.size(); ++i)
+				a[i] = (float)((i * 7) % 11) - 5;
+			for (size_t i = 0; i < b.size(); ++i)
+				b[i] = (float)((i * 5) % 13) * 0.25f - 1;
+
+			SIMD::Scalar::multiply(a.data(), b.data(), expected.data(), rows, inner, cols);
+			SIMD::multiplyBlocked(a.data(), b.data(), actual.data(), rows, inner, cols);
+
+			for (size_t i = 0; i < expected.size(); ++i)
+				EXPECT_NEAR(expected[i], actual[i], 1e-3f) << rows << "x" << inner << "x" << cols << " element " << i;
 		}
 
-		TEST_METHOD(Matrix_Scale_Matrix)
+		// Through Matrix, 24x24 takes the blocked path
+		auto m1 = std::make_unique<Matrix<24, 24>>();
+		auto m2 = std::make_unique<Matrix<24, 24>>();
+		for (int i = 0; i < 24; ++i)
 		{
-			auto m1 = Matrix<4, 4>::Scale(Vector<3>{2, 4, 8});
+			for (int j = 0; j < 24; ++j)
+			{
+				(*m1)[i][j] = (float)(i + 2 * j % 5);
+				(*m2)[i][j] = i == j ? 2.0f : 0.0f;
+			}
+		}
 
-			Assert::AreEqual(m1[0][0], two);
-			Assert::AreEqual(m1[1][1], four);
-			Assert::AreEqual(m1[2][2], eight);
-			Assert::AreEqual(m1[0][1], zero);
-			Assert::AreEqual(m1[0][2], zero);
+		EXPECT_TRUE(*m1 * *m2 == *m1 * 2.0f);
+		EXPECT_TRUE((Matrix<24, 24>() * *m1 == *m1));
+	}
 
-			auto m2 = Matrix<4, 4>::ScaleInverse(m1);
+	TEST_F(MatrixTests1, Matrix_Large_Inverse)
+	{
+		// Diagonally dominant, so well conditioned
+		Matrix<6, 6> m1;
+		for (int i = 0; i < 6; ++i)
+		{
+			for (int j = 0; j < 6; ++j)
+				m1[i][j] = i == j ? 10.0f : (float)((i * 3 + j) % 5) - 2;
+		}
 
-			Assert::AreEqual(m2[0][0], 0.5f);
-			Assert::AreEqual(m2[1][1], 0.25f);
-			Assert::AreEqual(m2[2][2], 0.125f);
-			Assert::AreEqual(m2[0][1], zero);
-			Assert::AreEqual(m2[0][2], zero);
+		auto identity = m1 * m1.inverse();
+		for (int i = 0; i < 6; ++i)
+		{
+			for (int j = 0; j < 6; ++j)
+				EXPECT_NEAR(identity[i][j], i == j ? one : zero, 1e-5f);
 		}
 
-		TEST_METHOD(Matrix_To_String)
+		// Triangular, so the determinant is the product of the diagonal
+		Matrix<5, 5> m2;
+		for (int i = 0; i < 5; ++i)
 		{
-			Matrix<4, 4> m1;
-			
-			std::cout << m1 << std::endl;
+			for (int j = 0; j <= i; ++j)
+				m2[i][j] = i == j ? (float)(i + 1) : 3.0f;
 		}
-	};
-}
\ No newline at end of file
+		EXPECT_NEAR(m2.determinant(), 120.0f, 1e-3f);
+
+		// A zero leading element forces a row swap
+		Matrix<5, 5> m3;
+		m3[0][0] = 0;
+		m3[0][1] = 1;
+		m3[1][0] = 1;
+		m3[1][1] = 0;
+		EXPECT_NEAR(m3.determinant(), -1.0f, 1e-6f);
+		EXPECT_TRUE(m3.inverse() == m3);
+
+		m3[4] = m3[3];
+		EXPECT_EQ(m3.determinant(), zero);
+		EXPECT_THROW(m3.inverse(), std::runtime_error);
+	}
+
+	TEST_F(MatrixTests1, Matrix_To_String)
+	{
+		Matrix<4, 4> m1;
+		
+		std::cout << m1 << std::endl;
+	}
+}
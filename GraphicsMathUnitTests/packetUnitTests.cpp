@@ -0,0 +1,185 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+#include "../GraphicsMathLib/Packet.h"
+
+using namespace GraphicsMath;
+
+namespace GraphicsMathUnitTests
+{
+	class PacketTests1 : public ::testing::Test
+	{
+	protected:
+		const float tolerance = 1e-5f;
+
+		static std::vector<Vector<3>> makeVectors(int count, int seed)
+		{
+			std::vector<Vector<3>> result(count);
+
+			for (int i = 0; i < count; ++i)
+				result[i] = Vector<3>{ (float)((i * 5 + seed) % 9) - 4.0f, (float)(i % 4) + 0.5f, (float)((i + seed) % 3) - 1.25f };
+
+			return result;
+		}
+
+		template<int size>
+		void expectNear(const VectorPacket<size>& packet, const Vector<size>& v, int lane)
+		{
+			for (int c = 0; c < size; ++c)
+				EXPECT_NEAR(packet[c][lane], v[c], tolerance);
+		}
+	};
+
+	TEST_F(PacketTests1, Float8_And_Mask8)
+	{
+		float values[8] = { -3, -2, -1, 0, 1, 2, 3, 4 };
+		Float8 f = Float8::Load(values);
+		Float8 two(2.0f);
+
+		EXPECT_EQ(f[0], -3.0f);
+		EXPECT_EQ(f[7], 4.0f);
+		EXPECT_EQ((f * two + two)[5], 6.0f);
+		EXPECT_EQ((-f)[1], 2.0f);
+		EXPECT_EQ(squareRoot(f)[7], 2.0f);
+		EXPECT_EQ(minimum(f, two)[7], 2.0f);
+		EXPECT_EQ(maximum(f, two)[0], 2.0f);
+
+		Mask8 positive = f > Float8(0.0f);
+		EXPECT_EQ(positive.bits(), 0xF0);
+		EXPECT_TRUE(positive[4]);
+		EXPECT_FALSE(positive[3]);
+		EXPECT_EQ((f <= Float8(0.0f)).bits(), 0x0F);
+		EXPECT_EQ((f == two).bits(), 0x20);
+		EXPECT_EQ((f != two).bits(), 0xDF);
+		EXPECT_EQ((~positive).bits(), 0x0F);
+		EXPECT_EQ((positive & (f < Float8(3.0f))).bits(), 0x30);
+		EXPECT_EQ((positive | (f == Float8(-3.0f))).bits(), 0xF1);
+		EXPECT_TRUE(positive.any());
+		EXPECT_FALSE(positive.all());
+		EXPECT_TRUE(Mask8(true).all());
+		EXPECT_TRUE(Mask8().none());
+
+		Float8 blended = select(positive, f, Float8(0.0f));
+		EXPECT_EQ(blended[2], 0.0f);
+		EXPECT_EQ(blended[6], 3.0f);
+
+		f.setLane(3, 9.0f);
+		EXPECT_EQ(f[3], 9.0f);
+		EXPECT_EQ(f[4], 1.0f);
+
+		EXPECT_THROW(f[8], std::out_of_range);
+		EXPECT_THROW(positive[-1], std::out_of_range);
+	}
+
+	TEST_F(PacketTests1, Vector3x8_Matches_Vector)
+	{
+		std::vector<Vector<3>> a = makeVectors(8, 1), b = makeVectors(8, 4);
+		Vector3x8 pa = Vector3x8::Load(a.data()), pb = Vector3x8::Load(b.data());
+
+		Vector3x8 sum = pa + pb, difference = pa - pb, scaled = pa * Float8(3.0f), cross = pa.crossProduct(pb);
+		Vector3x8 normal = pa.normal();
+		Float8 dot = pa.dotProduct(pb), length = pa.magnitude();
+
+		for (int lane = 0; lane < 8; ++lane)
+		{
+			EXPECT_TRUE(pa.lane(lane) == a[lane]);
+			expectNear(sum, a[lane] + b[lane], lane);
+			expectNear(difference, a[lane] - b[lane], lane);
+			expectNear(scaled, a[lane] * 3.0f, lane);
+			expectNear(cross, a[lane].crossProduct(b[lane]), lane);
+			expectNear(normal, a[lane].normal(), lane);
+			EXPECT_NEAR(dot[lane], a[lane].dotProduct(b[lane]), tolerance);
+			EXPECT_NEAR(length[lane], a[lane].magnitude(), tolerance);
+		}
+
+		// Equality is per lane, over every component
+		Vector3x8 changed = pa;
+		changed.z().setLane(6, 100.0f);
+		EXPECT_EQ((changed == pa).bits(), 0xBF);
+		EXPECT_EQ((changed != pa).bits(), 0x40);
+
+		Vector3x8 broadcast(Vector<3>{ 1, 2, 3 });
+		EXPECT_TRUE((broadcast.lane(5) == Vector<3>{ 1, 2, 3 }));
+		EXPECT_TRUE((select(pa.x() < Float8(0.0f), broadcast, pa).lane(0) == Vector<3>{ 1, 2, 3 }));
+
+		Vector4x8 points = Vector4x8{ pa.x(), pa.y(), pa.z(), Float8(2.0f) };
+		points.homogenize();
+		expectNear(points, Vector<4>{ a[3][0] / 2, a[3][1] / 2, a[3][2] / 2, 2.0f }, 3);
+
+		EXPECT_THROW(pa[3], std::out_of_range);
+	}
+
+	TEST_F(PacketTests1, Gather_And_Scatter)
+	{
+		std::vector<Vector<3>> vectors = makeVectors(40, 2);
+		const int indices[8] = { 39, 0, 7, 7, 12, 30, 1, 25 };
+
+		Vector3x8 gathered = Vector3x8::Gather(vectors.data(), indices);
+		for (int lane = 0; lane < 8; ++lane)
+			EXPECT_TRUE(gathered.lane(lane) == vectors[indices[lane]]);
+
+		std::vector<Vector<3>> stored(8);
+		gathered.store(stored.data());
+		EXPECT_TRUE(stored[0] == vectors[39]);
+
+		// Only the lanes in the mask are written
+		std::vector<Vector<3>> out(40);
+		const int targets[8] = { 0, 5, 10, 15, 20, 25, 30, 35 };
+		Mask8 even = Float8::Load(std::vector<float>{ 1, 0, 1, 0, 1, 0, 1, 0 }.data()) != Float8(0.0f);
+		gathered.scatter(out.data(), targets, even);
+
+		EXPECT_TRUE(out[0] == vectors[39]);
+		EXPECT_TRUE(out[5] == Vector<3>());
+		EXPECT_TRUE(out[30] == vectors[1]);
+		EXPECT_TRUE(out[35] == Vector<3>());
+	}
+
+	TEST_F(PacketTests1, Matrix4x4Batch_Matches_Matrix)
+	{
+		std::vector<Matrix<4, 4>> matrices(8), others(8);
+		for (int i = 0; i < 8; ++i)
+		{
+			matrices[i] = Matrix<4, 4>::Translation(Vector<3>{ (float)i, 1, -2 }) * Matrix<4, 4>::Rotation(Vector<3>{ 0, 1, 0 }, 0.2f * (float)i);
+			others[i] = Matrix<4, 4>::Scale(Vector<3>{ 1, 2, (float)i + 1 });
+		}
+
+		Matrix4x4Batch batch = Matrix4x4Batch::Load(matrices.data());
+		Matrix4x4Batch product = batch * Matrix4x4Batch::Load(others.data());
+		Matrix4x4Batch transposed = batch.transposition();
+
+		std::vector<Vector<3>> points = makeVectors(8, 3);
+		Vector3x8 p = Vector3x8::Load(points.data());
+		Vector4x8 homogenous{ p.x(), p.y(), p.z(), Float8(1.0f) };
+		Vector4x8 transformed = batch * homogenous;
+		Vector3x8 viaPoint = batch.transformPoint(p), viaDirection = batch.transformDirection(p);
+
+		for (int lane = 0; lane < 8; ++lane)
+		{
+			EXPECT_TRUE(batch.lane(lane) == matrices[lane]);
+
+			Matrix<4, 4> expected = matrices[lane] * others[lane];
+			Matrix<4, 4> expectedTranspose = matrices[lane].transposition();
+			for (int c = 0; c < 4; ++c)
+			{
+				expectNear(product[c], expected[c], lane);
+				expectNear(transposed[c], expectedTranspose[c], lane);
+			}
+
+			Vector<4> v = matrices[lane] * Vector<4>{ points[lane][0], points[lane][1], points[lane][2], 1 };
+			expectNear(transformed, v, lane);
+			expectNear(viaPoint, Vector<3>{ v[0], v[1], v[2] }, lane);
+
+			Vector<4> d = matrices[lane] * Vector<4>{ points[lane][0], points[lane][1], points[lane][2], 0 };
+			expectNear(viaDirection, Vector<3>{ d[0], d[1], d[2] }, lane);
+		}
+
+		const int reversed[8] = { 7, 6, 5, 4, 3, 2, 1, 0 };
+		std::vector<Matrix<4, 4>> back(8);
+		Matrix4x4Batch::Gather(matrices.data(), reversed).store(back.data());
+		EXPECT_TRUE(back[0] == matrices[7]);
+		EXPECT_TRUE(back[7] == matrices[0]);
+
+		EXPECT_TRUE((Matrix4x4Batch().lane(2) == Matrix<4, 4>()));
+		EXPECT_TRUE(Matrix4x4Batch(matrices[3]).lane(6) == matrices[3]);
+	}
+}
@@ -0,0 +1,182 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstring>
+#include <vector>
+#include "../GraphicsMathLib/Parallel.h"
+
+using namespace GraphicsMath;
+
+namespace GraphicsMathUnitTests
+{
+	class ParallelTests1 : public ::testing::Test
+	{
+	protected:
+		const float tolerance = 1e-4f;
+
+		static std::vector<Vector<3>> makeVectors(size_t count, float seed)
+		{
+			std::vector<Vector<3>> result(count);
+
+			for (size_t i = 0; i < count; ++i)
+				result[i] = Vector<3>{ seed + (float)(i % 97), 1.0f - (float)(i % 13) * seed, 0.25f + (float)(i % 5) };
+
+			return result;
+		}
+	};
+
+	TEST_F(ParallelTests1, ThreadPool_Parallel_For_Covers_Range)
+	{
+		ThreadPool pool(4);
+		std::vector<int> visits(10007, 0);
+
+		pool.parallelFor(visits.size(), 64, [&](size_t begin, size_t end)
+		{
+			EXPECT_TRUE(begin % 64 == 0);
+			for (size_t i = begin; i < end; ++i)
+				visits[i]++;
+		});
+
+		for (int v : visits)
+			EXPECT_EQ(v, 1);
+	}
+
+	TEST_F(ParallelTests1, ThreadPool_Nested_And_Repeated_Jobs)
+	{
+		ThreadPool pool(3);
+		std::atomic<int> total{ 0 };
+
+		for (int job = 0; job < 20; ++job)
+		{
+			pool.parallelFor(100, 7, [&](size_t begin, size_t end)
+			{
+				total += (int)(end - begin);
+			});
+		}
+
+		EXPECT_EQ(total.load(), 2000);
+	}
+
+	TEST_F(ParallelTests1, ThreadPool_Rethrows_Exceptions)
+	{
+		ThreadPool pool(4);
+		std::atomic<int> chunks{ 0 };
+
+		EXPECT_THROW(pool.parallelFor(1000, 10, [&](size_t begin, size_t)
+		{
+			chunks++;
+			if (begin == 500)
+				throw std::runtime_error("chunk failed");
+		}), std::runtime_error);
+
+		// The failing chunk doesn't stop the others from running
+		EXPECT_EQ(chunks.load(), 100);
+	}
+
+	TEST_F(ParallelTests1, Cache_Aligned_Grain)
+	{
+		EXPECT_EQ(cacheAlignedGrain<float>(1), (size_t)16);
+		EXPECT_EQ(cacheAlignedGrain<Vector<3>>(100), (size_t)112);
+		EXPECT_EQ(cacheAlignedGrain<Vector<4>>(4096), (size_t)4096);
+		EXPECT_EQ((cacheAlignedGrain<Matrix<4, 4>>(3)), (size_t)3);
+	}
+
+	TEST_F(ParallelTests1, Parallel_Dot_Product_Is_Deterministic)
+	{
+		const size_t count = 100003;
+		auto a = makeVectors(count, 0.37f);
+		auto b = makeVectors(count, -1.21f);
+
+		ThreadPool serial(1);
+		float expected = parallelDotProduct(a.data(), b.data(), count, serial);
+
+		for (unsigned threads : { 2u, 3u, 4u, 8u })
+		{
+			ThreadPool pool(threads);
+			float result = parallelDotProduct(a.data(), b.data(), count, pool);
+
+			// Bitwise equal, not just close
+			EXPECT_TRUE(std::memcmp(&expected, &result, sizeof(float)) == 0);
+		}
+
+		double reference = 0;
+		for (size_t i = 0; i < count; ++i)
+			reference += a[i].dotProduct(b[i]);
+
+		EXPECT_NEAR(1.0, (double)expected / reference, 1e-4);
+	}
+
+	TEST_F(ParallelTests1, Parallel_Normalize)
+	{
+		auto v = makeVectors(50000, 0.5f);
+		auto expected = v;
+		for (auto& e : expected)
+			e.normalize();
+
+		ThreadPool pool(4);
+		parallelNormalize(v.data(), v.size(), pool);
+
+		for (size_t i = 0; i < v.size(); ++i)
+			EXPECT_TRUE(v[i] == expected[i]);
+
+		// The policy is a template argument, like Vector::normalize()
+		auto original = makeVectors(50000, 0.5f);
+		auto fast = original;
+		parallelNormalize<MathPolicy::Fast>(fast.data(), fast.size(), pool);
+
+		for (size_t i = 0; i < fast.size(); ++i)
+			EXPECT_TRUE(fast[i] == original[i].normal<MathPolicy::Fast>());
+	}
+
+	TEST_F(ParallelTests1, Parallel_Transform_Vectors_And_Matrices)
+	{
+		const size_t count = 20000;
+		auto m = Matrix<4, 4>::Rotation(Vector<3>{ 0, 0, 1 }, 0.3f) * Matrix<4, 4>::Translation(Vector<3>{ 1, 2, 3 });
+
+		std::vector<Vector<4>> points(count);
+		std::vector<Matrix<4, 4>> matrices(count);
+		for (size_t i = 0; i < count; ++i)
+		{
+			points[i] = Vector<4>{ (float)i, 1, -(float)i, 1 };
+			matrices[i] = Matrix<4, 4>::Scale(Vector<3>{ 1, 2, (float)(i % 9) });
+		}
+
+		ThreadPool pool(4);
+		std::vector<Vector<4>> transformed(count);
+		std::vector<Matrix<4, 4>> products(count);
+		parallelTransform(m, points.data(), transformed.data(), count, pool);
+		parallelMultiply(m, matrices.data(), products.data(), count, pool);
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			EXPECT_TRUE(transformed[i] == m * points[i]);
+			EXPECT_TRUE(products[i] == m * matrices[i]);
+		}
+	}
+
+	TEST_F(ParallelTests1, Parallel_Transform_Points)
+	{
+		const size_t count = 30001;
+		std::vector<float> x(count), y(count), z(count);
+		for (size_t i = 0; i < count; ++i)
+		{
+			x[i] = (float)i;
+			y[i] = 2.0f;
+			z[i] = -(float)i;
+		}
+
+		auto m = Matrix<4, 4>::PerspectiveProjection(60, 1.5f, 0.1f, 100);
+		std::vector<float> sx(count), sy(count), sz(count);
+		std::vector<float> px(count), py(count), pz(count);
+
+		ThreadPool pool(4);
+		transformPoints(m, ConstPointStreams{ x.data(), y.data(), z.data(), nullptr },
+						PointStreams{ sx.data(), sy.data(), sz.data(), nullptr }, count, true);
+		parallelTransformPoints(m, ConstPointStreams{ x.data(), y.data(), z.data(), nullptr },
+								PointStreams{ px.data(), py.data(), pz.data(), nullptr }, count, true, pool);
+
+		EXPECT_TRUE(sx == px);
+		EXPECT_TRUE(sy == py);
+		EXPECT_TRUE(sz == pz);
+	}
+}
@@ -0,0 +1,170 @@
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include "../GraphicsMathLib/Quaternion.h"
+
+using namespace GraphicsMath;
+
+namespace GraphicsMathUnitTests
+{
+	class QuaternionTests1 : public ::testing::Test
+	{
+	protected:
+		const float tolerance = 1e-5f;
+
+		const Vector<3> axis1{ 0.267261f, 0.534522f, 0.801784f };
+		const Vector<3> axis2{ 0, 1, 0 };
+
+		void expectNear(const Matrix<4, 4>& a, const Matrix<4, 4>& b)
+		{
+			for (int i = 0; i < 4; ++i)
+			{
+				for (int j = 0; j < 4; ++j)
+					EXPECT_NEAR(a[i][j], b[i][j], tolerance);
+			}
+		}
+
+		// q and -q are the same rotation
+		void expectSameRotation(const Quaternion& a, const Quaternion& b)
+		{
+			float sign = a.dotProduct(b) < 0 ? -1.0f : 1.0f;
+
+			for (int i = 0; i < 4; ++i)
+				EXPECT_NEAR(a[i], b[i] * sign, tolerance);
+		}
+	};
+
+	TEST_F(QuaternionTests1, Quaternion_Constructors_And_Accessors)
+	{
+		Quaternion q1;
+		Quaternion q2{ 1, 2, 3, 4 };
+
+		EXPECT_EQ(q1[0], 0.0f);
+		EXPECT_EQ(q1[3], 1.0f);
+		EXPECT_EQ(q2[1], 2.0f);
+		EXPECT_EQ(q2[3], 4.0f);
+		EXPECT_TRUE(q2 != q1);
+		EXPECT_TRUE(q1 == Quaternion::Rotation(axis1, 0));
+		EXPECT_EQ(sizeof(Quaternion), 4 * sizeof(float));
+
+		EXPECT_THROW(q1[4], std::out_of_range);
+		EXPECT_THROW(q1[-1], std::out_of_range);
+	}
+
+	TEST_F(QuaternionTests1, Quaternion_To_Matrix)
+	{
+		expectNear(Quaternion::Rotation(axis1, 0.7f).toMatrix(), Matrix<4, 4>::Rotation(axis1, 0.7f));
+		expectNear(Quaternion::Rotation(axis2, -2.5f).toMatrix(), Matrix<4, 4>::Rotation(axis2, -2.5f));
+		expectNear(Quaternion().toMatrix(), Matrix<4, 4>());
+	}
+
+	TEST_F(QuaternionTests1, Quaternion_From_Matrix)
+	{
+		// Angles near 0 and pi exercise every branch of the conversion
+		for (float theta : { 0.0f, 0.7f, 2.0f, 3.1f })
+		{
+			for (auto& axis : { axis1, axis2, Vector<3>{ 1, 0, 0 }, Vector<3>{ 0, 0, 1 } })
+			{
+				auto q = Quaternion::Rotation(axis, theta);
+				expectSameRotation(q, Quaternion::FromMatrix(q.toMatrix()));
+			}
+		}
+	}
+
+	TEST_F(QuaternionTests1, Quaternion_Multiplication)
+	{
+		auto q1 = Quaternion::Rotation(axis1, 0.7f);
+		auto q2 = Quaternion::Rotation(axis2, 1.3f);
+
+		expectNear((q1 * q2).toMatrix(), Matrix<4, 4>::Rotation(axis1, 0.7f) * Matrix<4, 4>::Rotation(axis2, 1.3f));
+
+		Quaternion q4{ 1, -2, 0.5f, 3 };
+		Quaternion expected;
+		SIMD::Scalar::multiplyQuaternion(&q1[0], &q4[0], &expected[0]);
+		expectSameRotation(q1 * q4, expected);
+
+		auto q3 = q1;
+		q3 *= q2;
+		EXPECT_TRUE(q3 == q1 * q2);
+
+		// Rotations about the same axis add
+		expectSameRotation(Quaternion::Rotation(axis1, 0.3f) * Quaternion::Rotation(axis1, 0.4f), q1);
+	}
+
+	TEST_F(QuaternionTests1, Quaternion_Normalization_And_Inverse)
+	{
+		Quaternion q1{ 1, 2, 3, 4 };
+
+		EXPECT_NEAR(q1.squareMagnitude(), 30.0f, tolerance);
+		EXPECT_NEAR(q1.normal().magnitude(), 1.0f, tolerance);
+
+		q1.normalize();
+		EXPECT_NEAR(q1.magnitude(), 1.0f, tolerance);
+
+		auto q2 = Quaternion::Rotation(axis1, 0.7f);
+		expectSameRotation(q2 * q2.conjugate(), Quaternion());
+
+		Quaternion q3{ 1, -2, 0.5f, 3 };
+		expectSameRotation(q3 * q3.inverse(), Quaternion());
+
+		EXPECT_THROW(Quaternion(0, 0, 0, 0).normalize(), std::runtime_error);
+		EXPECT_THROW(Quaternion(0, 0, 0, 0).inverse(), std::runtime_error);
+	}
+
+	TEST_F(QuaternionTests1, Quaternion_Rotate_Vector)
+	{
+		Vector<3> v1{ 0.5f, -1.5f, 2.25f };
+		auto q = Quaternion::Rotation(axis1, 0.7f);
+
+		auto v2 = q.rotate(v1);
+		auto v3 = Matrix<4, 4>::Rotation(axis1, 0.7f) * Vector<4>{ v1[0], v1[1], v1[2], 0 };
+
+		for (int i = 0; i < 3; ++i)
+			EXPECT_NEAR(v2[i], v3[i], tolerance);
+
+		auto v4 = q.conjugate().rotate(v2);
+
+		for (int i = 0; i < 3; ++i)
+			EXPECT_NEAR(v4[i], v1[i], tolerance);
+	}
+
+	TEST_F(QuaternionTests1, Quaternion_Interpolation)
+	{
+		auto q1 = Quaternion::Rotation(axis2, 0.2f);
+		auto q2 = Quaternion::Rotation(axis2, 1.4f);
+
+		expectSameRotation(Quaternion::Slerp(q1, q2, 0), q1);
+		expectSameRotation(Quaternion::Slerp(q1, q2, 1), q2);
+		expectSameRotation(Quaternion::Slerp(q1, q2, 0.25f), Quaternion::Rotation(axis2, 0.5f));
+		expectSameRotation(Quaternion::Nlerp(q1, q2, 0), q1);
+		expectSameRotation(Quaternion::Nlerp(q1, q2, 1), q2);
+
+		// Nlerp stays on the same great circle, only the speed differs
+		auto q3 = Quaternion::Nlerp(q1, q2, 0.25f);
+		EXPECT_NEAR(q3.magnitude(), 1.0f, tolerance);
+		EXPECT_NEAR(q3[0], 0.0f, tolerance);
+		EXPECT_NEAR(q3[2], 0.0f, tolerance);
+
+		// -q2 is the same rotation, so the result must not take the long way round
+		Quaternion q4{ -q2[0], -q2[1], -q2[2], -q2[3] };
+		expectSameRotation(Quaternion::Slerp(q1, q4, 0.25f), Quaternion::Rotation(axis2, 0.5f));
+		expectSameRotation(Quaternion::Nlerp(q1, q4, 0.5f), Quaternion::Nlerp(q1, q2, 0.5f));
+
+		// Nearly identical rotations fall back to nlerp instead of dividing by sin(0)
+		auto q5 = Quaternion::Slerp(q1, q1, 0.5f);
+		expectSameRotation(q5, q1);
+	}
+
+	TEST_F(QuaternionTests1, Quaternion_To_String)
+	{
+		Quaternion q1;
+		Quaternion q2{ 1, -2, 0.5f, 3 };
+
+		EXPECT_EQ(q1.to_string(), "Quaternion (0.000000, 0.000000, 0.000000, 1.000000)");
+		EXPECT_EQ(q2.to_string(), "Quaternion (1.000000, -2.000000, 0.500000, 3.000000)");
+
+		std::ostringstream os;
+		os << q2;
+		EXPECT_EQ(os.str(), q2.to_string() + "\n");
+	}
+}
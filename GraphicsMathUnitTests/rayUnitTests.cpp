@@ -0,0 +1,150 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+#include "../GraphicsMathLib/Ray.h"
+
+using namespace GraphicsMath;
+
+namespace GraphicsMathUnitTests
+{
+	class RayTests1 : public ::testing::Test
+	{
+	protected:
+		const float tolerance = 1e-5f;
+
+		const Vector<3> a{ -1, -1, 2 };
+		const Vector<3> b{ 2, -1, 2 };
+		const Vector<3> c{ -1, 2, 2 };
+
+		// Eight rays from around the origin, some through the triangle and box and some past them
+		static std::vector<Ray> makeRays()
+		{
+			std::vector<Ray> rays;
+			for (int i = 0; i < 24; ++i)
+			{
+				Vector<3> origin{ (float)(i % 3) * 0.1f, 0.0f, (float)(i % 2) * -0.5f };
+				Vector<3> direction{ (float)(i % 6) * 0.3f - 0.8f, (float)(i % 5) * 0.35f - 0.7f, i % 7 == 0 ? -1.0f : 1.0f };
+				rays.push_back(Ray(origin, direction));
+			}
+
+			return rays;
+		}
+	};
+
+	TEST_F(RayTests1, Ray_And_Box)
+	{
+		Ray ray(Vector<3>{ 1, 2, 3 }, Vector<3>{ 0, 2, -4 });
+		EXPECT_TRUE((ray.pointAt(0.5f) == Vector<3>{ 1, 3, 1 }));
+		EXPECT_EQ(ray.inverseDirection()[1], 0.5f);
+		EXPECT_EQ(ray.inverseDirection()[0], INFINITY);
+
+		AABB box;
+		EXPECT_TRUE(box.isEmpty());
+		EXPECT_EQ(box.surfaceArea(), 0.0f);
+
+		box.expand(Vector<3>{ 1, 0, 2 });
+		box.expand(Vector<3>{ -1, 3, 0 });
+		EXPECT_FALSE(box.isEmpty());
+		EXPECT_TRUE((box == AABB(Vector<3>{ -1, 0, 0 }, Vector<3>{ 1, 3, 2 })));
+		EXPECT_TRUE((box.center() == Vector<3>{ 0, 1.5f, 1 }));
+		EXPECT_EQ(box.surfaceArea(), 2.0f * (2 * 3 + 3 * 2 + 2 * 2));
+		EXPECT_TRUE(box.contains(Vector<3>{ 1, 3, 2 }));
+		EXPECT_FALSE(box.contains(Vector<3>{ 0, 3.5f, 1 }));
+
+		AABB other(Vector<3>{ 0, -2, 1 }, Vector<3>{ 0.5f, 0, 1 });
+		box.expand(other);
+		EXPECT_TRUE((box.minimum() == Vector<3>{ -1, -2, 0 }));
+		EXPECT_TRUE(box != other);
+
+		RayPacket packet = RayPacket::Load(makeRays().data());
+		EXPECT_TRUE((packet.lane(3).direction() == makeRays()[3].direction()));
+		EXPECT_TRUE((packet.pointAt(Float8(2.0f)).lane(5) == makeRays()[5].pointAt(2.0f)));
+	}
+
+	TEST_F(RayTests1, Ray_Triangle)
+	{
+		// Through the point a + (b - a) * 0.25 + (c - a) * 0.5
+		Vector<3> target = a + (b - a) * 0.25f + (c - a) * 0.5f;
+		Ray ray(Vector<3>{ 0, 0, -1 }, target - Vector<3>{ 0, 0, -1 });
+		TriangleHit hit = intersectTriangle(ray, a, b, c);
+		EXPECT_TRUE(hit.hit);
+		EXPECT_NEAR(hit.distance, 1.0f, tolerance);
+		EXPECT_NEAR(hit.u, 0.25f, tolerance);
+		EXPECT_NEAR(hit.v, 0.5f, tolerance);
+
+		// Either face, but not behind the origin or past maxDistance
+		EXPECT_TRUE(intersectTriangle(ray, a, c, b).hit);
+		EXPECT_FALSE(intersectTriangle(ray, a, b, c, 0.0f, 0.9f).hit);
+		EXPECT_FALSE(intersectTriangle(Ray(Vector<3>{ 0, 0, 5 }, Vector<3>{ 0, 0, 1 }), a, b, c).hit);
+		EXPECT_TRUE(intersectTriangle(Ray(Vector<3>{ 0, 0, 5 }, Vector<3>{ 0, 0, 1 }), a, b, c, -INFINITY).hit);
+
+		// Outside the edges, parallel to the plane, and a degenerate triangle
+		EXPECT_FALSE(intersectTriangle(Ray(Vector<3>{ 1.5f, 1.5f, 0 }, Vector<3>{ 0, 0, 1 }), a, b, c).hit);
+		EXPECT_FALSE(intersectTriangle(Ray(Vector<3>{ 0, 0, 2 }, Vector<3>{ 1, 0, 0 }), a, b, c).hit);
+		EXPECT_FALSE(intersectTriangle(ray, a, b, b).hit);
+	}
+
+	TEST_F(RayTests1, Ray_Box)
+	{
+		AABB box(Vector<3>{ -1, -1, 1 }, Vector<3>{ 1, 2, 3 });
+
+		BoxHit hit = intersectBox(Ray(Vector<3>{ 0, 0, 0 }, Vector<3>{ 0, 0, 2 }), box);
+		EXPECT_TRUE(hit.hit);
+		EXPECT_EQ(hit.entry, 0.5f);
+		EXPECT_EQ(hit.exit, 1.5f);
+
+		// From inside, through the infinite reciprocal of the zero components
+		hit = intersectBox(Ray(Vector<3>{ 0, 0, 2 }, Vector<3>{ 0, -1, 0 }), box);
+		EXPECT_TRUE(hit.hit);
+		EXPECT_EQ(hit.entry, 0.0f);
+		EXPECT_EQ(hit.exit, 1.0f);
+
+		EXPECT_FALSE(intersectBox(Ray(Vector<3>{ 2, 0, 2 }, Vector<3>{ 0, 1, 0 }), box).hit);
+		EXPECT_FALSE(intersectBox(Ray(Vector<3>{ 0, 0, 0 }, Vector<3>{ 0, 0, -1 }), box).hit);
+		EXPECT_FALSE(intersectBox(Ray(Vector<3>{ 0, 0, 0 }, Vector<3>{ 0, 0, 1 }), box, 0.0f, 0.5f).hit);
+		EXPECT_FALSE(intersectBox(Ray(Vector<3>{ 0, 0, 0 }, Vector<3>{ 3, 0, 1 }), box).hit);
+	}
+
+	TEST_F(RayTests1, Packets_Match_Single_Rays)
+	{
+		std::vector<Ray> rays = makeRays();
+		AABB box(Vector<3>{ -0.5f, -0.5f, 1 }, Vector<3>{ 0.5f, 1, 2 });
+		const Float8 maxDistance(2.5f);
+		int triangleHits = 0, boxHits = 0;
+
+		for (size_t i = 0; i < rays.size(); i += 8)
+		{
+			RayPacket packet = RayPacket::Load(&rays[i]);
+			TriangleHit8 triangles = intersectTriangle(packet, a, b, c, Float8(0.0f), maxDistance);
+			BoxHit8 boxes = intersectBox(packet, box, Float8(0.0f), maxDistance);
+
+			for (int lane = 0; lane < 8; ++lane)
+			{
+				TriangleHit triangle = intersectTriangle(rays[i + lane], a, b, c, 0.0f, 2.5f);
+				ASSERT_EQ(triangles.hit[lane], triangle.hit);
+				if (triangle.hit)
+				{
+					++triangleHits;
+					EXPECT_NEAR(triangles.distance[lane], triangle.distance, tolerance);
+					EXPECT_NEAR(triangles.u[lane], triangle.u, tolerance);
+					EXPECT_NEAR(triangles.v[lane], triangle.v, tolerance);
+				}
+
+				BoxHit single = intersectBox(rays[i + lane], box, 0.0f, 2.5f);
+				ASSERT_EQ(boxes.hit[lane], single.hit);
+				if (single.hit)
+				{
+					++boxHits;
+					EXPECT_NEAR(boxes.entry[lane], single.entry, tolerance);
+					EXPECT_NEAR(boxes.exit[lane], single.exit, tolerance);
+				}
+			}
+		}
+
+		// Both outcomes were exercised
+		EXPECT_GT(triangleHits, 0);
+		EXPECT_LT(triangleHits, (int)rays.size());
+		EXPECT_GT(boxHits, 0);
+		EXPECT_LT(boxHits, (int)rays.size());
+	}
+}
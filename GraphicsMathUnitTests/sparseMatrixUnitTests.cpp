@@ -0,0 +1,245 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+#include "../GraphicsMathLib/SparseMatrix.h"
+
+using namespace GraphicsMath;
+
+namespace GraphicsMathUnitTests
+{
+	class SparseMatrixTests1 : public ::testing::Test
+	{
+	protected:
+		const float tolerance = 1e-4f;
+
+		// Spring stiffness on the edges of a side x side grid of vertices plus mass on the diagonal,
+		// the shape of an implicit cloth step. Symmetric positive definite.
+		static BlockSparseMatrix makeCloth(int side, float mass)
+		{
+			std::vector<BlockTriplet> triplets;
+			const Matrix<3, 3> zero = Matrix<3, 3>() * 0.0f;
+
+			auto addEdge = [&](int i, int j)
+			{
+				Vector<3> d{ (float)(i % 3) * 0.5f, 1.0f, (float)(j % 2) };
+				Matrix<3, 3> k = Matrix<3, 3>();
+				for (int c = 0; c < 3; ++c)
+				{
+					for (int r = 0; r < 3; ++r)
+						k[c][r] += d[r] * d[c];
+				}
+
+				triplets.push_back({ i, i, k });
+				triplets.push_back({ j, j, k });
+				triplets.push_back({ i, j, zero - k });
+				triplets.push_back({ j, i, zero - k });
+			};
+
+			for (int y = 0; y < side; ++y)
+			{
+				for (int x = 0; x < side; ++x)
+				{
+					int v = y * side + x;
+					triplets.push_back({ v, v, Matrix<3, 3>() * mass });
+
+					if (x + 1 < side)
+						addEdge(v, v + 1);
+					if (y + 1 < side)
+						addEdge(v, v + side);
+				}
+			}
+
+			return BlockSparseMatrix::FromTriplets(side * side, side * side, triplets);
+		}
+
+		static std::vector<Vector<3>> makeForces(int count)
+		{
+			std::vector<Vector<3>> result(count);
+
+			for (int i = 0; i < count; ++i)
+				result[i] = Vector<3>{ (float)(i % 7) - 3.0f, 1.0f, (float)(i % 3) };
+
+			return result;
+		}
+
+		static float residual(const BlockSparseMatrix& a, const std::vector<Vector<3>>& b, const std::vector<Vector<3>>& x)
+		{
+			std::vector<Vector<3>> ax(b.size());
+			multiply(a, x.data(), ax.data());
+
+			float rr = 0, bb = 0;
+			for (size_t i = 0; i < b.size(); ++i)
+			{
+				rr += (b[i] - ax[i]).dotProduct(b[i] - ax[i]);
+				bb += b[i].dotProduct(b[i]);
+			}
+
+			return sqrtf(rr / bb);
+		}
+	};
+
+	TEST_F(SparseMatrixTests1, SparseMatrix_From_Triplets)
+	{
+		// Out of order, with duplicates that add up and one that cancels to an explicit zero
+		std::vector<Triplet> triplets = { { 2, 3, 4 }, { 0, 0, 1 }, { 2, 0, 2 }, { 0, 0, 1.5f }, { 1, 2, 3 }, { 2, 3, -1 }, { 1, 1, 5 }, { 1, 1, -5 } };
+		SparseMatrix m = SparseMatrix::FromTriplets(3, 4, triplets);
+
+		EXPECT_EQ(m.rows(), 3);
+		EXPECT_EQ(m.cols(), 4);
+		EXPECT_EQ(m.nonZeros(), (size_t)5);
+		EXPECT_EQ(m(0, 0), 2.5f);
+		EXPECT_EQ(m(2, 3), 3.0f);
+		EXPECT_EQ(m(1, 1), 0.0f);
+		EXPECT_EQ(m(0, 3), 0.0f);
+
+		EXPECT_EQ(m.rowStart()[1], (SparseIndex)1);
+		EXPECT_EQ(m.columns()[1], (SparseIndex)1);
+		EXPECT_EQ(m.columns()[2], (SparseIndex)2);
+
+		DenseMatrix dense = m.toDense();
+		EXPECT_EQ(dense(2, 0), 2.0f);
+		EXPECT_EQ(dense(1, 2), 3.0f);
+
+		EXPECT_THROW(m(3, 0), std::out_of_range);
+		EXPECT_THROW(SparseMatrix::FromTriplets(3, 3, { { 0, 3, 1 } }), std::out_of_range);
+	}
+
+	TEST_F(SparseMatrixTests1, SparseMatrix_Products)
+	{
+		std::vector<Triplet> triplets;
+		for (int i = 0; i < 5000; ++i)
+		{
+			triplets.push_back({ i, (i * 7) % 1000, (float)(i % 5) - 2.0f });
+			triplets.push_back({ i, (i * 13 + 1) % 1000, 0.5f });
+		}
+
+		SparseMatrix m = SparseMatrix::FromTriplets(5000, 1000, triplets);
+		DenseVector x(1000), y(5000);
+		for (int i = 0; i < x.size(); ++i)
+			x[i] = (float)(i % 11) * 0.25f;
+		for (int i = 0; i < y.size(); ++i)
+			y[i] = (float)(i % 3) - 1.0f;
+
+		ThreadPool serial(1);
+		ThreadPool parallel(4);
+		DenseVector out1, out4;
+		multiply(m, x, out1, serial);
+		multiply(m, x, out4, parallel);
+		EXPECT_TRUE(out1 == out4);
+
+		DenseVector expected = m.toDense() * x;
+		for (int i = 0; i < m.rows(); ++i)
+			EXPECT_NEAR(out1[i], expected[i], tolerance);
+
+		// Transposed products, through the CSC view and through an explicit transposition
+		SparseMatrix t = m.transposition();
+		EXPECT_EQ(t.rows(), 1000);
+		EXPECT_EQ(t.nonZeros(), m.nonZeros());
+		EXPECT_EQ(t(7, 1), m(1, 7));
+
+		DenseVector viaCSC, viaCSR;
+		multiplyTransposed(m, y, viaCSC);
+		multiply(t, y, viaCSR);
+		for (int i = 0; i < viaCSC.size(); ++i)
+			EXPECT_NEAR(viaCSC[i], viaCSR[i], tolerance);
+
+		EXPECT_THROW(m * y, std::invalid_argument);
+	}
+
+	TEST_F(SparseMatrixTests1, BlockSparseMatrix_Products)
+	{
+		BlockSparseMatrix a = makeCloth(40, 2.0f);
+		SparseMatrix scalar = a.toScalar();
+
+		EXPECT_EQ(a.rows(), 1600);
+		EXPECT_EQ(scalar.rows(), 4800);
+		EXPECT_EQ(scalar.nonZeros(), a.nonZeroBlocks() * 9);
+		EXPECT_TRUE((a.block(0, 1) == a.block(1, 0)));
+		EXPECT_TRUE((a.block(0, 2) == Matrix<3, 3>() * 0.0f));
+
+		std::vector<Vector<3>> x = makeForces(a.rows());
+		std::vector<Vector<3>> out1(a.rows()), out4(a.rows());
+		ThreadPool serial(1);
+		ThreadPool parallel(4);
+		multiply(a, x.data(), out1.data(), serial);
+		multiply(a, x.data(), out4.data(), parallel);
+
+		DenseVector flat(3 * a.rows());
+		for (int i = 0; i < a.rows(); ++i)
+			flat.setSegment(3 * i, x[i]);
+		DenseVector expected = scalar * flat;
+
+		for (int i = 0; i < a.rows(); ++i)
+		{
+			EXPECT_TRUE(out1[i] == out4[i]);
+			for (int j = 0; j < 3; ++j)
+				EXPECT_NEAR(out1[i][j], expected[3 * i + j], tolerance);
+		}
+	}
+
+	TEST_F(SparseMatrixTests1, Conjugate_Gradient)
+	{
+		// Enough vertices for several parallel chunks
+		BlockSparseMatrix a = makeCloth(100, 0.5f);
+		std::vector<Vector<3>> b = makeForces(a.rows());
+		std::vector<Vector<3>> x1(a.rows()), x4(a.rows());
+
+		ThreadPool serial(1);
+		ThreadPool parallel(4);
+		SolverResult r1 = conjugateGradient(a, b.data(), x1.data(), SolverSettings(), serial);
+		SolverResult r4 = conjugateGradient(a, b.data(), x4.data(), SolverSettings(), parallel);
+
+		EXPECT_TRUE(r1.converged);
+		EXPECT_LE(r1.residual, SolverSettings().tolerance);
+		EXPECT_GT(r1.iterations, 1);
+		EXPECT_EQ(r1.iterations, r4.iterations);
+		EXPECT_TRUE(x1 == x4);
+		EXPECT_LT(residual(a, b, x1), 1e-4f);
+
+		// Giving up early
+		std::vector<Vector<3>> x(a.rows());
+		SolverSettings settings;
+		settings.maxIterations = 3;
+		SolverResult limited = conjugateGradient(a, b.data(), x.data(), settings);
+		EXPECT_FALSE(limited.converged);
+		EXPECT_EQ(limited.iterations, 3);
+
+		// The scalar version on the same system
+		SparseMatrix scalar = a.toScalar();
+		DenseVector flatB(scalar.rows()), flatX;
+		for (int i = 0; i < a.rows(); ++i)
+			flatB.setSegment(3 * i, b[i]);
+
+		SolverResult scalarResult = conjugateGradient(scalar, flatB, flatX);
+		EXPECT_TRUE(scalarResult.converged);
+		EXPECT_LT((scalar * flatX - flatB).magnitude() / flatB.magnitude(), 1e-4f);
+
+		SparseMatrix noDiagonal = SparseMatrix::FromTriplets(2, 2, { { 0, 1, 1 }, { 1, 0, 1 } });
+		EXPECT_THROW(conjugateGradient(noDiagonal, DenseVector{ 1, 1 }, flatX), std::runtime_error);
+	}
+
+	TEST_F(SparseMatrixTests1, Smoothers)
+	{
+		BlockSparseMatrix a = makeCloth(30, 4.0f);
+		std::vector<Vector<3>> b = makeForces(a.rows());
+		std::vector<Vector<3>> jacobiX(a.rows()), seidelX(a.rows());
+
+		float start = residual(a, b, jacobiX);
+		jacobi(a, b.data(), jacobiX.data(), 10);
+		gaussSeidel(a, b.data(), seidelX.data(), 10);
+
+		float afterJacobi = residual(a, b, jacobiX);
+		float afterSeidel = residual(a, b, seidelX);
+		EXPECT_LT(afterJacobi, start * 0.5f);
+		EXPECT_LT(afterSeidel, afterJacobi);
+
+		// Same result for any number of threads
+		std::vector<Vector<3>> x4(a.rows());
+		ThreadPool parallel(4);
+		jacobi(a, b.data(), x4.data(), 10, 2.0f / 3.0f, parallel);
+		EXPECT_TRUE(x4 == jacobiX);
+
+		BlockSparseMatrix singular = BlockSparseMatrix::FromTriplets(2, 2, { { 0, 1, Matrix<3, 3>() } });
+		EXPECT_THROW(gaussSeidel(singular, b.data(), seidelX.data(), 1), std::runtime_error);
+	}
+}
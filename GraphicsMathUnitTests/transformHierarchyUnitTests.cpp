@@ -0,0 +1,223 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <vector>
+#include "../GraphicsMathLib/TransformHierarchy.h"
+
+using namespace GraphicsMath;
+
+namespace GraphicsMathUnitTests
+{
+	class TransformHierarchyTests1 : public ::testing::Test
+	{
+	protected:
+		const float tolerance = 1e-4f;
+		static constexpr std::uint32_t NoParent = TransformHierarchy::NoParent;
+
+		// A tree of count nodes where node i hangs off a node listed after it, so the node numbers
+		// are nowhere near breadth first order. The last node is the only root.
+		static std::vector<std::uint32_t> makeParents(std::uint32_t count)
+		{
+			std::vector<std::uint32_t> parents(count, NoParent);
+			for (std::uint32_t i = 0; i + 1 < count; ++i)
+			{
+				std::uint32_t above = count - 1 - i;
+				parents[i] = count - 1 - (i * 7) % above;
+			}
+
+			return parents;
+		}
+
+		// Local matrices of every kind, varying with the node and the frame
+		static void setLocal(TransformHierarchy& h, std::uint32_t node, int frame)
+		{
+			float t = 0.1f * (float)(node % 17) + 0.01f * frame;
+			switch (node % 4)
+			{
+			case 0:
+				h.setLocal(node, Matrix<4, 4>::Translation(Vector<3>{ t, 1 - t, 0.5f }), TransformKind::Translation);
+				break;
+			case 1:
+				h.setLocal(node, Matrix<4, 4>::Rotation(Vector<3>{ 0.6f, 0, 0.8f }, t), TransformKind::Rotation);
+				break;
+			case 2:
+				h.setLocal(node, Matrix<4, 4>::Translation(Vector<3>{ 0, t, 1 }) * Matrix<4, 4>::Rotation(Vector<3>{ 0, 1, 0 }, 2 * t), TransformKind::Rigid);
+				break;
+			default:
+				h.setLocal(node, Matrix<4, 4>::Scale(Vector<3>{ 1 + t, 1, 0.9f }) * Matrix<4, 4>::Translation(Vector<3>{ t, 0, 0 }));
+				break;
+			}
+		}
+
+		// world = parent's world * local, walking up the tree with operator*
+		static Matrix<4, 4> naiveWorld(const TransformHierarchy& h, std::uint32_t node)
+		{
+			if (h.parent(node) == NoParent)
+				return h.local(node);
+
+			return naiveWorld(h, h.parent(node)) * h.local(node);
+		}
+
+		static void checkWorlds(const TransformHierarchy& h)
+		{
+			for (std::uint32_t node = 0; node < h.size(); ++node)
+				EXPECT_TRUE(h.world(node) == naiveWorld(h, node)) << "node " << node;
+		}
+
+		// Nodes in the subtrees of the given nodes, counting each once
+		static std::size_t subtreeSizes(const std::vector<std::uint32_t>& parents, const std::vector<std::uint32_t>& roots)
+		{
+			std::size_t size = 0;
+			for (std::uint32_t i = 0; i < parents.size(); ++i)
+			{
+				std::uint32_t up = i;
+				while (up != NoParent && std::find(roots.begin(), roots.end(), up) == roots.end())
+					up = parents[up];
+
+				size += up != NoParent;
+			}
+
+			return size;
+		}
+
+		void checkInverse(TransformHierarchy& h, std::uint32_t node) const
+		{
+			Matrix<4, 4> product = h.world(node) * h.inverseWorld(node);
+			for (int c = 0; c < 4; ++c)
+			{
+				for (int r = 0; r < 4; ++r)
+					EXPECT_NEAR(product[c][r], c == r ? 1.0f : 0.0f, tolerance) << "node " << node;
+			}
+		}
+	};
+
+	TEST_F(TransformHierarchyTests1, Breadth_First_Layout)
+	{
+		// Two trees: 5 -> 1 -> { 2, 3 }, 2 -> 4, 3 -> 0, and 6 on its own
+		TransformHierarchy h = TransformHierarchy::FromParents({ 3, 5, 1, 1, 2, NoParent, NoParent });
+		EXPECT_EQ(h.size(), 7u);
+		EXPECT_EQ(h.depth(), 4);
+		EXPECT_EQ(h.parent(0), 3u);
+		EXPECT_EQ(h.parent(5), NoParent);
+		EXPECT_EQ(h.parent(4), 2u);
+
+		// Everything starts as the identity
+		EXPECT_EQ(h.update(), 0u);
+		EXPECT_TRUE((h.world(0) == Matrix<4, 4>()));
+		EXPECT_TRUE((h.inverseWorld(0) == Matrix<4, 4>()));
+
+		// Moving the root moves every node under it and nothing else
+		h.setLocal(5, Matrix<4, 4>::Translation(Vector<3>{ 1, 2, 3 }), TransformKind::Translation);
+		h.setLocal(2, Matrix<4, 4>::Translation(Vector<3>{ 0, 1, 0 }), TransformKind::Translation);
+		EXPECT_EQ(h.update(), 6u);
+		EXPECT_TRUE((h.world(4) == Matrix<4, 4>::Translation(Vector<3>{ 1, 3, 3 })));
+		EXPECT_TRUE((h.world(0) == Matrix<4, 4>::Translation(Vector<3>{ 1, 2, 3 })));
+		EXPECT_TRUE((h.world(6) == Matrix<4, 4>()));
+		EXPECT_TRUE(h.worldKind(4) == TransformKind::Translation);
+
+		EXPECT_THROW(h.world(7), std::out_of_range);
+		EXPECT_THROW(h.setLocal(7, Matrix<4, 4>()), std::out_of_range);
+		EXPECT_THROW(TransformHierarchy::FromParents({ NoParent, 5 }), std::out_of_range);
+		EXPECT_THROW(TransformHierarchy::FromParents({ NoParent, 2, 1 }), std::invalid_argument);
+		EXPECT_THROW(TransformHierarchy::FromParents({ 0 }), std::invalid_argument);
+		EXPECT_EQ(TransformHierarchy::FromParents({}).depth(), 0);
+	}
+
+	TEST_F(TransformHierarchyTests1, Incremental_Update)
+	{
+		const std::uint32_t count = 3000;
+		std::vector<std::uint32_t> parents = makeParents(count);
+		TransformHierarchy h = TransformHierarchy::FromParents(parents);
+		EXPECT_GT(h.depth(), 4);
+
+		for (std::uint32_t node = 0; node < count; ++node)
+			setLocal(h, node, 0);
+
+		EXPECT_EQ(h.update(), count);
+		checkWorlds(h);
+
+		// Change a few scattered nodes, one of them twice and one inside another's subtree; only
+		// their subtrees are recomputed
+		std::vector<std::uint32_t> changed = { 10, 500, 1234, 2996, 77 };
+		for (std::uint32_t node : changed)
+			setLocal(h, node, 1);
+		setLocal(h, 10, 2);
+		setLocal(h, parents[77], 1);
+
+		std::size_t expected = subtreeSizes(parents, { 10, 500, 1234, 2996, 77, parents[77] });
+		EXPECT_LT(expected, (std::size_t)count / 2);
+		EXPECT_EQ(h.update(), expected);
+		EXPECT_EQ(h.update(), 0u);
+		checkWorlds(h);
+
+		// Enough changes for update() to sweep the whole scene instead
+		changed.clear();
+		for (std::uint32_t node = 3; node < count; node += 5)
+		{
+			setLocal(h, node, 3);
+			changed.push_back(node);
+		}
+
+		EXPECT_EQ(h.update(), subtreeSizes(parents, changed));
+		checkWorlds(h);
+	}
+
+	TEST_F(TransformHierarchyTests1, Parallel_Update)
+	{
+		// Wide levels, split into several chunks
+		const std::uint32_t count = 20000;
+		std::vector<std::uint32_t> parents(count);
+		parents[0] = NoParent;
+		for (std::uint32_t i = 1; i < count; ++i)
+			parents[i] = (i - 1) / 8;
+
+		ThreadPool serial(1);
+		ThreadPool parallel(4);
+		TransformHierarchy a = TransformHierarchy::FromParents(parents);
+		TransformHierarchy b = TransformHierarchy::FromParents(parents);
+
+		for (std::uint32_t node = 0; node < count; ++node)
+		{
+			setLocal(a, node, 0);
+			setLocal(b, node, 0);
+		}
+
+		EXPECT_EQ(a.update(serial), count);
+		EXPECT_EQ(b.update(parallel), count);
+		for (std::uint32_t node = 0; node < count; ++node)
+			EXPECT_TRUE(a.world(node) == b.world(node));
+
+		checkWorlds(b);
+	}
+
+	TEST_F(TransformHierarchyTests1, Inverse_World)
+	{
+		// The root is a translation, so the kinds only become more general further down
+		const std::uint32_t count = 401;
+		TransformHierarchy h = TransformHierarchy::FromParents(makeParents(count));
+		for (std::uint32_t node = 0; node < count; ++node)
+			setLocal(h, node, 0);
+		h.update();
+
+		int kinds[5] = {};
+		for (std::uint32_t node = 0; node < count; ++node)
+		{
+			++kinds[static_cast<int>(h.worldKind(node))];
+			checkInverse(h, node);
+		}
+
+		EXPECT_GT(kinds[static_cast<int>(TransformKind::Translation)], 0);
+		EXPECT_GT(kinds[static_cast<int>(TransformKind::Rigid)], 0);
+		EXPECT_GT(kinds[static_cast<int>(TransformKind::Affine)], 0);
+
+		// The cached inverse is kept until the node moves
+		const Matrix<4, 4>* cached = &h.inverseWorld(5);
+		Matrix<4, 4> before = *cached;
+		EXPECT_EQ(&h.inverseWorld(5), cached);
+
+		h.setLocal(5, Matrix<4, 4>::Translation(Vector<3>{ 3, 0, 0 }) * h.local(5), TransformKind::Affine);
+		h.update();
+		EXPECT_FALSE(h.inverseWorld(5) == before);
+		checkInverse(h, 5);
+	}
+}
@@ -0,0 +1,139 @@
+#include <gtest/gtest.h>
+
+#include "../GraphicsMathLib/Transform.h"
+
+using namespace GraphicsMath;
+
+namespace GraphicsMathUnitTests
+{
+	class TransformTests1 : public ::testing::Test
+	{
+	protected:
+		const float tolerance = 1e-4f;
+
+		const Vector<3> axis1{ 0.267261f, 0.534522f, 0.801784f };
+		const Vector<3> axis2{ 0, 1, 0 };
+		const Vector<3> point{ 0.5f, -1.5f, 2.25f };
+
+		void expectNear(const Matrix<4, 4>& a, const Matrix<4, 4>& b)
+		{
+			for (int i = 0; i < 4; ++i)
+			{
+				for (int j = 0; j < 4; ++j)
+					EXPECT_NEAR(a[i][j], b[i][j], tolerance);
+			}
+		}
+
+		void expectNear(const Vector<3>& a, const Vector<3>& b)
+		{
+			for (int i = 0; i < 3; ++i)
+				EXPECT_NEAR(a[i], b[i], tolerance);
+		}
+
+		static Matrix<4, 4> trs(const Vector<3>& t, const Quaternion& q, const Vector<3>& s)
+		{
+			return Matrix<4, 4>::Translation(t) * q.toMatrix() * Matrix<4, 4>::Scale(s);
+		}
+
+		static Vector<3> multiply(const Matrix<4, 4>& m, const Vector<3>& p)
+		{
+			Vector<4> result = m * Vector<4>{ p[0], p[1], p[2], 1 };
+			return Vector<3>{ result[0], result[1], result[2] };
+		}
+	};
+
+	TEST_F(TransformTests1, Transform_Matches_Matrix)
+	{
+		Transform identity;
+		EXPECT_TRUE((identity.toMatrix() == Matrix<4, 4>()));
+		EXPECT_TRUE(identity == Transform(Vector<3>{ 0, 0, 0 }, Quaternion()));
+		EXPECT_LT(sizeof(Transform), sizeof(Matrix<4, 4>));
+
+		Vector<3> t{ 1, -2, 3 }, s{ 2, 0.5f, 1.5f };
+		Quaternion q = Quaternion::Rotation(axis1, 0.7f);
+		Transform a(t, q, s);
+
+		EXPECT_TRUE(a != identity);
+		expectNear(a.toMatrix(), trs(t, q, s));
+		expectNear(a.transformPoint(point), multiply(a.toMatrix(), point));
+		expectNear(a.transformVector(point), a.transformPoint(point) - t);
+		expectNear(a.inverseTransformPoint(a.transformPoint(point)), point);
+	}
+
+	TEST_F(TransformTests1, Transform_Composition)
+	{
+		// Exact when the left hand scale is uniform, whatever the right hand one is
+		Transform a(Vector<3>{ 1, -2, 3 }, Quaternion::Rotation(axis1, 0.7f), Vector<3>{ 2, 2, 2 });
+		Transform b(Vector<3>{ -0.5f, 4, 1 }, Quaternion::Rotation(axis2, -1.3f), Vector<3>{ 0.5f, 3, 1.25f });
+
+		expectNear((a * b).toMatrix(), a.toMatrix() * b.toMatrix());
+		expectNear((a * b).transformPoint(point), a.transformPoint(b.transformPoint(point)));
+
+		Transform c = a;
+		c *= b;
+		EXPECT_TRUE(c == a * b);
+
+		// and when the right hand one doesn't rotate
+		Transform d(Vector<3>{ 3, 0, 1 }, Quaternion(), Vector<3>{ 1, 2, 3 });
+		expectNear((b * d).toMatrix(), b.toMatrix() * d.toMatrix());
+	}
+
+	TEST_F(TransformTests1, Transform_Inverse)
+	{
+		Transform a(Vector<3>{ 1, -2, 3 }, Quaternion::Rotation(axis1, 0.7f), Vector<3>{ 0.5f, 0.5f, 0.5f });
+
+		expectNear(a.inverse().toMatrix(), a.toMatrix().inverse());
+		expectNear((a * a.inverse()).toMatrix(), Matrix<4, 4>());
+		expectNear(a.inverse().transformPoint(a.transformPoint(point)), point);
+
+		// Not exact with a scale that isn't uniform, but inverseTransformPoint() still is
+		Transform b(Vector<3>{ 1, -2, 3 }, Quaternion::Rotation(axis1, 0.7f), Vector<3>{ 2, 0.5f, 1.5f });
+		expectNear(b.inverseTransformPoint(point), multiply(b.toMatrix().inverse(), point));
+
+		EXPECT_THROW(Transform(Vector<3>{ 1, 2, 3 }, Quaternion(), Vector<3>{ 1, 0, 1 }).inverse(), std::runtime_error);
+	}
+
+	TEST_F(TransformTests1, Transform_Decompose)
+	{
+		// Angles near 0 and pi exercise every branch of Quaternion::FromMatrix()
+		for (float theta : { 0.0f, 0.7f, 2.0f, 3.1f })
+		{
+			for (const Vector<3>& axis : { axis1, axis2, Vector<3>{ 1, 0, 0 } })
+			{
+				Vector<3> t{ 1, -2, 3 }, s{ 2, 0.5f, 1.5f };
+				Transform a = Transform::Decompose(trs(t, Quaternion::Rotation(axis, theta), s));
+
+				expectNear(a.translation(), t);
+				expectNear(a.scale(), s);
+				EXPECT_NEAR(a.rotation().magnitude(), 1.0f, tolerance);
+				expectNear(a.toMatrix(), trs(t, Quaternion::Rotation(axis, theta), s));
+			}
+		}
+
+		// A mirror ends up in the z scale
+		Matrix<4, 4> mirrored = trs(Vector<3>{ 0, 1, 0 }, Quaternion::Rotation(axis1, 1.1f), Vector<3>{ -1, 2, 3 });
+		Transform b = Transform::Decompose(mirrored);
+		EXPECT_LT(b.scale()[2], 0.0f);
+		expectNear(b.toMatrix(), mirrored);
+
+		// Shear is dropped, the first column and the plane of the first two are kept
+		Matrix<4, 4> sheared = Quaternion::Rotation(axis2, 0.4f).toMatrix();
+		sheared[1][0] += 0.3f;
+		Transform c = Transform::Decompose(sheared);
+		EXPECT_NEAR(c.rotation().magnitude(), 1.0f, tolerance);
+		expectNear(c.transformVector(Vector<3>{ 1, 0, 0 }), Vector<3>{ sheared[0][0], sheared[0][1], sheared[0][2] });
+		EXPECT_NEAR(c.rotation().rotate(Vector<3>{ 0, 0, 1 }).dotProduct(Vector<3>{ sheared[1][0], sheared[1][1], sheared[1][2] }), 0.0f, tolerance);
+
+		// Zero scales still give a unit rotation that reproduces the matrix
+		for (const Vector<3>& s : { Vector<3>{ 0, 2, 3 }, Vector<3>{ 2, 0, 3 }, Vector<3>{ 2, 3, 0 }, Vector<3>{ 0, 0, 3 }, Vector<3>{ 2, 0, 0 } })
+		{
+			Matrix<4, 4> flat = trs(Vector<3>{ 1, 2, 3 }, Quaternion::Rotation(axis1, 0.7f), s);
+			Transform d = Transform::Decompose(flat);
+			EXPECT_NEAR(d.rotation().magnitude(), 1.0f, tolerance);
+			expectNear(d.toMatrix(), flat);
+		}
+
+		Transform e = Transform::Decompose(Matrix<4, 4>::Translation(Vector<3>{ 1, 2, 3 }) * Matrix<4, 4>::Scale(Vector<3>{ 0, 0, 0 }));
+		EXPECT_TRUE(e == Transform(Vector<3>{ 1, 2, 3 }, Quaternion(), Vector<3>{ 0, 0, 0 }));
+	}
+}
@@ -0,0 +1,202 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+#include "../GraphicsMathLib/VectorStream.h"
+
+using namespace GraphicsMath;
+
+namespace GraphicsMathUnitTests
+{
+	class VectorStreamTests1 : public ::testing::Test
+	{
+	protected:
+		const float tolerance = 1e-5f;
+
+		// Counts either side of every lane width, so the partial last step is always covered
+		const std::vector<size_t> counts = { 0, 1, 3, 4, 7, 8, 9, 17, 100 };
+
+		template<int size>
+		static std::vector<Vector<size>> makeVectors(size_t count, int seed)
+		{
+			std::vector<Vector<size>> result(count);
+
+			for (size_t i = 0; i < count; ++i)
+			{
+				for (int c = 0; c < size; ++c)
+					result[i][c] = (float)((i * 7 + c * 3 + seed) % 11) - 5.0f + 0.25f * (float)c;
+			}
+
+			return result;
+		}
+
+		template<int size>
+		void expectNear(const VectorStreamView<size>& stream, const std::vector<Vector<size>>& expected)
+		{
+			ASSERT_EQ(stream.count(), expected.size());
+
+			for (size_t i = 0; i < expected.size(); ++i)
+			{
+				for (int c = 0; c < size; ++c)
+					EXPECT_NEAR(stream.get(i)[c], expected[i][c], tolerance);
+			}
+		}
+	};
+
+	TEST_F(VectorStreamTests1, VectorStream_Layout)
+	{
+		std::vector<Vector<3>> aos = makeVectors<3>(37, 0);
+		VectorStream<3> stream(aos.data(), aos.size());
+
+		EXPECT_EQ(stream.count(), (size_t)37);
+		for (int c = 0; c < 3; ++c)
+		{
+			EXPECT_EQ(reinterpret_cast<std::uintptr_t>(stream.component(c)) % 64, (std::uintptr_t)0);
+			EXPECT_EQ(stream.component(c)[5], aos[5][c]);
+		}
+		EXPECT_TRUE(stream.get(36) == aos[36]);
+
+		std::vector<Vector<3>> back(aos.size());
+		stream.store(back.data());
+		EXPECT_TRUE(back == aos);
+
+		stream.set(2, Vector<3>{ 1, 2, 3 });
+		EXPECT_TRUE((stream.get(2) == Vector<3>{ 1, 2, 3 }));
+
+		// Copies are deep, moves leave an empty stream
+		VectorStream<3> copy(stream);
+		copy.set(0, Vector<3>{ 9, 9, 9 });
+		EXPECT_TRUE(stream.get(0) == aos[0]);
+
+		VectorStream<3> moved(std::move(copy));
+		EXPECT_EQ(copy.count(), (size_t)0);
+		EXPECT_TRUE((moved.get(0) == Vector<3>{ 9, 9, 9 }));
+
+		moved.resize(40);
+		EXPECT_EQ(moved.count(), (size_t)40);
+		EXPECT_TRUE(moved.get(36) == aos[36]);
+		EXPECT_TRUE(moved.get(39) == Vector<3>());
+
+		EXPECT_THROW(stream.get(37), std::out_of_range);
+		EXPECT_THROW(stream.component(3), std::out_of_range);
+		EXPECT_THROW(stream += moved, std::invalid_argument);
+	}
+
+	TEST_F(VectorStreamTests1, VectorStream_Arithmetic)
+	{
+		for (size_t count : counts)
+		{
+			std::vector<Vector<4>> a = makeVectors<4>(count, 1), b = makeVectors<4>(count, 4);
+			VectorStream<4> sa(a.data(), count), sb(b.data(), count);
+
+			std::vector<Vector<4>> expected(count);
+			for (size_t i = 0; i < count; ++i)
+				expected[i] = (a[i] + b[i] - b[i] * 0.5f) * 2.0f;
+
+			sa += sb;
+			sa.multiplyAdd(sb, -0.5f);
+			sa *= 2.0f;
+			expectNear(sa, expected);
+
+			for (size_t i = 0; i < count; ++i)
+				expected[i] = expected[i] - a[i];
+			sa -= VectorStream<4>(a.data(), count);
+			expectNear(sa, expected);
+		}
+	}
+
+	TEST_F(VectorStreamTests1, VectorStream_Products)
+	{
+		for (size_t count : counts)
+		{
+			std::vector<Vector<3>> a = makeVectors<3>(count, 2), b = makeVectors<3>(count, 5);
+			VectorStream<3> sa(a.data(), count), sb(b.data(), count), cross(count);
+			std::vector<float> dot(count), length(count);
+
+			sa.dotProduct(sb, dot.data());
+			sa.magnitude(length.data());
+			sa.crossProduct(sb, cross);
+
+			std::vector<Vector<3>> expected(count);
+			for (size_t i = 0; i < count; ++i)
+			{
+				EXPECT_NEAR(dot[i], a[i].dotProduct(b[i]), tolerance);
+				EXPECT_NEAR(length[i], a[i].magnitude(), tolerance);
+				expected[i] = a[i].crossProduct(b[i]);
+			}
+			expectNear(cross, expected);
+
+			// The output may be one of the inputs
+			sa.crossProduct(sb, sa);
+			expectNear(sa, expected);
+
+			sb.normalize();
+			for (size_t i = 0; i < count; ++i)
+				expected[i] = b[i].normal();
+			expectNear(sb, expected);
+		}
+	}
+
+	TEST_F(VectorStreamTests1, VectorStream_Homogenize)
+	{
+		for (size_t count : counts)
+		{
+			std::vector<Vector<4>> points = makeVectors<4>(count, 3);
+			for (size_t i = 0; i < count; i += 3)
+				points[i][3] = 0.0f;
+
+			VectorStream<4> stream(points.data(), count);
+			stream.homogenize();
+
+			std::vector<Vector<4>> expected(count);
+			for (size_t i = 0; i < count; ++i)
+				expected[i] = points[i].homogenous();
+			expectNear(stream, expected);
+		}
+
+		// A NaN w spreads to the other components, as in Vector::homogenize(), on every path
+		std::vector<Vector<4>> points = makeVectors<4>(17, 3);
+		points[5][3] = NAN;
+		points[16][3] = NAN;
+
+		VectorStream<4> stream(points.data(), points.size());
+		stream.homogenize();
+		std::vector<Vector<4>> back(points.size());
+		stream.store(back.data());
+
+		for (size_t i : { 5, 16 })
+		{
+			for (int c = 0; c < 3; ++c)
+				EXPECT_TRUE(std::isnan(back[i][c])) << "point " << i;
+		}
+		EXPECT_FALSE(std::isnan(back[6][0]));
+	}
+
+	TEST_F(VectorStreamTests1, VectorStreamView_Planar_Buffers)
+	{
+		const size_t count = 21;
+		std::vector<float> x(count), y(count), z(count);
+		for (size_t i = 0; i < count; ++i)
+		{
+			x[i] = (float)i;
+			y[i] = 1.0f;
+			z[i] = -(float)i;
+		}
+
+		// Works in place on buffers it doesn't own
+		VectorStreamView<3> view({ x.data(), y.data(), z.data() }, count);
+		view *= 2.0f;
+		EXPECT_EQ(x[4], 8.0f);
+		EXPECT_EQ(y[20], 2.0f);
+
+		PointStreams streams = view.points();
+		EXPECT_EQ(streams.x, x.data());
+		EXPECT_EQ(streams.w, nullptr);
+
+		// And hands a stream's storage to transformPoints without copying
+		VectorStream<3> moved(count);
+		transformPoints(Matrix<4, 4>::Translation(Vector<3>{ 1, 2, 3 }), view.points(), moved.points(), count);
+		EXPECT_TRUE((moved.get(4) == Vector<3>{ 9, 4, -5 }));
+	}
+}
@@ -1,10 +1,8 @@
-#include "stdafx.h"
-#include "CppUnitTest.h"
+#include <gtest/gtest.h>
 
 #include <iostream>
-#include "..\GraphicsMathLib\Vector.h"
+#include "../GraphicsMathLib/Vector.h"
 
-using namespace Microsoft::VisualStudio::CppUnitTestFramework;
 using namespace GraphicsMath;
 
 namespace GraphicsMathUnitTests
@@ -20,339 +18,447 @@ namespace GraphicsMathUnitTests
 	const float eight = 8;
 	const float nine = 9;
 
-	TEST_CLASS(VectorTests1)
+	TEST(VectorTests1, Vector_Constructors_And_Accessors_1)
 	{
-	public:
-
-		TEST_METHOD(Vector_Constructors_And_Accessors_1)
-		{
-			Vector<2> v2;
-			Vector<3> v3;
-			Vector<4> v4;
-
-			Assert::AreEqual(v2[0] + v2[1], zero);
-			Assert::AreEqual(v3[0] + v3[1] + v3[2], zero);
-			Assert::AreEqual(v4[0] + v4[1] + v4[2] + v4[3], zero);
-		}
-
-		TEST_METHOD(Vector_Constructors_And_Accessors_2)
-		{
-			Vector<2> v2{ 1, 2 };
-			Vector<3> v3{ 3, 4, 5 };
-			Vector<4> v4{ 6, 7, 8, 9 };
-
-			Assert::AreEqual(v2[0] + v2[1], (float)3);
-			Assert::AreEqual(v3[0] + v3[1] + v3[2], (float)12);
-			Assert::AreEqual(v4[0] + v4[1] + v4[2] + v4[3], (float)30);
-		}
-
-		// TODO: Copy and move constructor and assignment tests
-
-		TEST_METHOD(Vector_Addition_1)
-		{
-			Vector<2> v2a{ 1, 2 };
-			Vector<2> v2b{ 3, 4 };
-			Vector<2> v2c;
-
-			Vector<2> v2d = v2a + v2b;
-			Vector<2> v2e = v2a + v2b + v2c;
-
-			Assert::AreEqual(v2d[0], (float)4);
-			Assert::AreEqual(v2d[1], (float)6);
-
-			Assert::AreEqual(v2e[0], (float)4);
-			Assert::AreEqual(v2e[1], (float)6);
-		}
-
-		TEST_METHOD(Vector_Addition_2)
-		{
-			Vector<3> v3a{ 2.5, -3, 6 };
-			Vector<3> v3b{ 1, -4, 2 };
-			Vector<3> v3c{ -1, 2, -5 };
-
-			Vector<3> v3d = v3a + v3b;
-			Vector<3> v3e = v3a + v3b + v3c;
-
-			Assert::AreEqual(v3d[0], (float)3.5);
-			Assert::AreEqual(v3d[1], (float)-7);
-			Assert::AreEqual(v3d[2], (float)8);
-
-			Assert::AreEqual(v3e[0], (float)2.5);
-			Assert::AreEqual(v3e[1], (float)-5);
-			Assert::AreEqual(v3e[2], (float)3);
-		}
-
-		TEST_METHOD(Vector_Addition_3)
-		{
-			Vector<4> v4a{ 2.5, -3, 6 };
-			Vector<4> v4b{ 1, -4, 2, -1 };
-			Vector<4> v4c{ -1, 2, -5, 10 };
-
-			Vector<4> v4d = v4a + v4b;
-			Vector<4> v4e = v4a + v4b + v4c;
-
-			Assert::AreEqual(v4d[0], (float)3.5);
-			Assert::AreEqual(v4d[1], (float)-7);
-			Assert::AreEqual(v4d[2], (float)8);
-			Assert::AreEqual(v4d[3], (float)-1);
-
-			Assert::AreEqual(v4e[0], (float)2.5);
-			Assert::AreEqual(v4e[1], (float)-5);
-			Assert::AreEqual(v4e[2], (float)3);
-			Assert::AreEqual(v4e[3], (float)9);
-		}
-
-		TEST_METHOD(Vector_Mutating_Addition_1)
-		{
-			Vector<2> v2a{ 1, 2 };
-			Vector<2> v2b{ 3, 4 };
-
-			v2a += v2b;
-
-			Assert::AreEqual(v2a[0], (float)4);
-			Assert::AreEqual(v2a[1], (float)6);
-
-			Assert::AreEqual(v2b[0], (float)3);
-			Assert::AreEqual(v2b[1], (float)4);
-		}
-
-		TEST_METHOD(Vector_Mutating_Addition_2)
-		{
-			Vector<3> v3a{ 1, 2, 3 };
-			Vector<3> v3b{ 4, 5 };
-			Vector<3> v3c{ -1, -3, -5 };
-
-			v3a += v3b;
-
-			Assert::AreEqual(v3a[0], (float)5);
-			Assert::AreEqual(v3a[1], (float)7);
-			Assert::AreEqual(v3a[2], (float)3);
-
-			Assert::AreEqual(v3b[0], (float)4);
-			Assert::AreEqual(v3b[1], (float)5);
-			Assert::AreEqual(v3b[2], zero);
-
-			v3a += v3c;
-
-			Assert::AreEqual(v3a[0], (float)4);
-			Assert::AreEqual(v3a[1], (float)4);
-			Assert::AreEqual(v3a[2], (float)-2);
-		}
-
-		TEST_METHOD(Vector_Subtraction_1)
-		{
-			Vector<4> v4a{ 1, 2, 3 };
-			Vector<4> v4b{ 4, 5, 6, 1 };
-			Vector<4> v4c{ 7, 8, 9, 10 };
-
-			Vector<4> v4d = v4a - v4b;
-			Vector<4> v4e = v4a - v4b - v4c;
-
-			Assert::AreEqual(v4d[0], (float)-3);
-			Assert::AreEqual(v4d[1], (float)-3);
-			Assert::AreEqual(v4d[2], (float)-3);
-			Assert::AreEqual(v4d[3], (float)-1);
-
-			Assert::AreEqual(v4e[0], (float)-10);
-			Assert::AreEqual(v4e[1], (float)-11);
-			Assert::AreEqual(v4e[2], (float)-12);
-			Assert::AreEqual(v4e[3], (float)-11);
-		}
-
-		TEST_METHOD(Vector_Mutating_Subtraction_1)
-		{
-			Vector<3> v3a{ 1, 2, 3 };
-			Vector<3> v3b{ 4, 5 };
-			Vector<3> v3c{ -1, -3, -5 };
-
-			v3a -= v3b;
-
-			Assert::AreEqual(v3a[0], (float)-3);
-			Assert::AreEqual(v3a[1], (float)-3);
-			Assert::AreEqual(v3a[2], (float)3);
-
-			Assert::AreEqual(v3b[0], (float)4);
-			Assert::AreEqual(v3b[1], (float)5);
-			Assert::AreEqual(v3b[2], zero);
-
-			v3a -= v3c;
-
-			Assert::AreEqual(v3a[0], (float)-2);
-			Assert::AreEqual(v3a[1], zero);
-			Assert::AreEqual(v3a[2], (float)8);
-		}
-
-		TEST_METHOD(Vector_Scalar_Multiplication_1)
-		{
-			Vector<4> v4a{ 1, 2, 3, 4 };
-			Vector<4> v4b = v4a * 2;
-			Vector<4> v4c{ v4a };
-			v4c *= 3;
-
-			Assert::AreEqual(v4b[0], (float)2);
-			Assert::AreEqual(v4b[1], (float)4);
-			Assert::AreEqual(v4b[2], (float)6);
-			Assert::AreEqual(v4b[3], (float)8);
-
-			Assert::AreEqual(v4c[0], (float)3);
-			Assert::AreEqual(v4c[1], (float)6);
-			Assert::AreEqual(v4c[2], (float)9);
-			Assert::AreEqual(v4c[3], (float)12);
-		}
-
-		TEST_METHOD(Vector_Vector_Multiplication_1)
-		{
-			Vector<3> v3a{ 1, 2, 3 };
-			Vector<3> v3b{ 4, 5, 6 };
-			Vector<3> v3c{ v3a };
-
-			Vector<3> v3d = v3a * v3b;
-			v3c *= v3b;
-
-			Assert::AreEqual(v3d[0], (float)4);
-			Assert::AreEqual(v3d[1], (float)10);
-			Assert::AreEqual(v3d[2], (float)18);
-
-			Assert::AreEqual(v3c[0], (float)4);
-			Assert::AreEqual(v3c[1], (float)10);
-			Assert::AreEqual(v3c[2], (float)18);
-		}
-
-		TEST_METHOD(Vector_Scalar_Division_1)
-		{
-			Vector<3> v3a{ 2, 4, 6 };
-			float s = 2;
-
-			auto v3b = v3a / s;
-
-			Assert::AreEqual(v3b[0], one);
-			Assert::AreEqual(v3b[1], two);
-			Assert::AreEqual(v3b[2], three);
-		}
-
-
-		TEST_METHOD(Vector_Equality)
-		{
-			Vector<4> v4a{ 1, 2, 3, 4 };
-			Vector<4> v4b{ v4a };
-
-			Assert::IsTrue(v4a == v4b);
-
-			v4b[2] = 0;
-			
-			Assert::IsTrue(v4a != v4b);
-		}
-
-		TEST_METHOD(Vector_GreaterLessThan)
-		{
-			Vector<4> v4a{ 1, 2, 3, 4 };
-			Vector<4> v4b{ 0, 1, 2, 3 };
-			Vector<4> v4c{ 0, 1, 2, 4 };
-			Vector<4> v4d{ 0, 2, 3, 3 };
-
-			Assert::IsTrue(v4a > v4b);
-			Assert::IsFalse(v4b > v4c);
-			Assert::IsTrue(v4c <= v4a);
-
-			Assert::IsTrue(v4a >= v4d);
-			Assert::IsTrue(v4d <= v4a);
-			Assert::IsFalse(v4d < v4a);
-		}
-
-		TEST_METHOD(Vector_Magnitude)
-		{
-			Vector<3> v3a{ 1, 2, 3 };
-			Vector<3> v3b{ -1, -2, -3 };
-			Vector<3> v3c{ 3, 4, 5 };
-
-			Assert::AreEqual(v3a.squareMagnitude(), (float)14);
-			Assert::AreEqual(v3b.squareMagnitude(), (float)14);
-			
-			Assert::AreEqual((int)v3c.magnitude(), (int)sqrt(50));
-		}
-
-		TEST_METHOD(Vector_DotAndCrossProduct)
-		{
-			Vector<3> v3a{ 1, 2, 3 };
-			Vector<3> v3b{ 4, 5, 6 };
-
-			Assert::AreEqual(v3a.dotProduct(v3b), (float)32);
-
-			Vector<3> v3c{ 0, 1, 0 };
-			Vector<3> v3d{ 0, 0, 1 };
-			Vector<3> v3e{ 1, 0, 0 };
-			Vector<3> v3f = v3c.crossProduct(v3d);
-			
-			Assert::AreEqual(v3e[0], v3f[0]);
-			Assert::AreEqual(v3e[1], v3f[1]);
-			Assert::AreEqual(v3e[2], v3f[2]);
-		}
-
-		TEST_METHOD(Vector_Normal_1)
-		{
-			Vector<3> v3a{ 0, 0, 1 };
-
-			auto v3b = v3a.normal();
-			v3a.normalize();
-
-			Assert::AreEqual(v3b[0], zero);
-			Assert::AreEqual(v3b[1], zero);
-			Assert::AreEqual(v3b[2], one);
-
-			Assert::AreEqual(v3a[0], zero);
-			Assert::AreEqual(v3a[1], zero);
-			Assert::AreEqual(v3a[2], one);
-		}
-
-		TEST_METHOD(Vector_Normalize)
-		{
-			Vector<3> v3a{1, 2, 3};
-			std::string s = v3a.to_string();
-			std::cout << s << std::endl;
-			std::cout << "Test string";
-			std::cout << v3a;
-
-			Assert::AreEqual(v3a[0], (float)1);
-		}
-
-		TEST_METHOD(Vector_Dimension_Change_1)
-		{
-			Vector<2> v2{ 1, 2 };
-			auto v3 = higherDimension(v2, 3);
-
-			Assert::AreEqual(v3[0], one);
-			Assert::AreEqual(v3[1], two);
-			Assert::AreEqual(v3[2], three);
-		}
-
-		TEST_METHOD(Vector_Dimension_Change_2)
-		{
-			Vector<3> v3{ 1, 2, 3 };
-			auto v4 = higherDimension(v3, 4);
-
-			Assert::AreEqual(v4[0], one);
-			Assert::AreEqual(v4[1], two);
-			Assert::AreEqual(v4[2], three);
-			Assert::AreEqual(v4[3], four);
-		}
-
-		TEST_METHOD(Vector_Dimension_Change_3)
-		{
-			Vector<3> v3{ 1, 2, 3 };
-			auto v2 = lowerDimension(v3);
-
-			Assert::AreEqual(v2[0], one);
-			Assert::AreEqual(v2[1], two);
-		}
-
-		TEST_METHOD(Vector_Dimension_Change_4)
-		{
-			Vector<4> v4{ 1, 2, 3, 4 };
-			auto v3 = lowerDimension(v4);
-
-			Assert::AreEqual(v3[0], one);
-			Assert::AreEqual(v3[1], two);
-			Assert::AreEqual(v3[2], three);
-		}
-	};
-}
\ No newline at end of file
+		Vector<2> v2;
+		Vector<3> v3;
+		Vector<4> v4;
+
+		EXPECT_EQ(v2[0] + v2[1], zero);
+		EXPECT_EQ(v3[0] + v3[1] + v3[2], zero);
+		EXPECT_EQ(v4[0] + v4[1] + v4[2] + v4[3], zero);
+	}
+
+	TEST(VectorTests1, Vector_Constructors_And_Accessors_2)
+	{
+		Vector<2> v2{ 1, 2 };
+		Vector<3> v3{ 3, 4, 5 };
+		Vector<4> v4{ 6, 7, 8, 9 };
+
+		EXPECT_EQ(v2[0] + v2[1], (float)3);
+		EXPECT_EQ(v3[0] + v3[1] + v3[2], (float)12);
+		EXPECT_EQ(v4[0] + v4[1] + v4[2] + v4[3], (float)30);
+	}
+
+	TEST(VectorTests1, Vector_Constructors_And_Accessors_3)
+	{
+		EXPECT_THROW((Vector<2>{ 1, 2, 3 }), std::out_of_range);
+
+		Vector<3> v3;
+		EXPECT_THROW(v3[3] = 1, std::out_of_range);
+	}
+
+	TEST(VectorTests1, Vector_Unchecked_Accessors)
+	{
+		Vector<4> v4{ 1, 2, 3, 4 };
+		const Vector<3> v3{ 5, 6, 7 };
+
+		EXPECT_EQ(v4.x(), one);
+		EXPECT_EQ(v4.y(), two);
+		EXPECT_EQ(v4.z(), three);
+		EXPECT_EQ(v4.w(), (float)4);
+		EXPECT_EQ(v3.z(), (float)7);
+		EXPECT_EQ(v3.get<1>(), (float)6);
+
+		v4.x() = 9;
+		v4.get<3>() = 8;
+		EXPECT_EQ(v4[0], (float)9);
+		EXPECT_EQ(v4[3], (float)8);
+		EXPECT_EQ(&v4.y(), &v4[1]);
+
+		constexpr Vector<2> v2{ 1, 2 };
+		static_assert(v2.y() == 2 && v2.get<0>() == 1, "Unchecked accessors should be usable in constant expressions");
+	}
+
+	TEST(VectorTests1, Vector_Copy_Constructor_And_Assignment)
+	{
+		Vector<3> v3a{ 1, 2, 3 };
+		Vector<3> v3b{ v3a };
+		Vector<3> v3c;
+		v3c = v3a;
+
+		v3a[0] = 4;
+
+		EXPECT_EQ(v3b[0], one);
+		EXPECT_EQ(v3b[1], two);
+		EXPECT_EQ(v3b[2], three);
+
+		EXPECT_EQ(v3c[0], one);
+		EXPECT_EQ(v3c[1], two);
+		EXPECT_EQ(v3c[2], three);
+	}
+
+	TEST(VectorTests1, Vector_Move_Constructor_And_Assignment)
+	{
+		EXPECT_TRUE(std::is_trivially_move_constructible<Vector<4>>::value);
+		EXPECT_TRUE(std::is_trivially_move_assignable<Vector<4>>::value);
+		EXPECT_TRUE(std::is_nothrow_move_constructible<Vector<3>>::value);
+		EXPECT_TRUE(std::is_nothrow_move_assignable<Vector<2>>::value);
+
+		Vector<3> v3a{ 1, 2, 3 };
+		Vector<3> v3b{ std::move(v3a) };
+		Vector<3> v3c;
+		v3c = std::move(v3b);
+
+		EXPECT_EQ(v3c[0], one);
+		EXPECT_EQ(v3c[2], three);
+	}
+
+	TEST(VectorTests1, Vector_Inline_Storage)
+	{
+		EXPECT_TRUE(std::is_trivially_copyable<Vector<2>>::value);
+		EXPECT_TRUE(std::is_trivially_copyable<Vector<3>>::value);
+		EXPECT_TRUE(std::is_trivially_copyable<Vector<4>>::value);
+
+		EXPECT_EQ(sizeof(Vector<3>), 3 * sizeof(float));
+		EXPECT_EQ(alignof(Vector<4>), 4 * sizeof(float));
+
+		constexpr Vector<4> v4{ 1, 2, 3, 4 };
+		static_assert(v4[3] == 4, "Vector should be usable in constant expressions");
+	}
+
+	TEST(VectorTests1, Vector_Iterators)
+	{
+		Vector<4> v4{ 1, 2, 3, 4 };
+
+		float sum = 0;
+		for (float f : v4)
+			sum += f;
+
+		EXPECT_EQ(sum, (float)10);
+
+		for (auto& f : v4)
+			f *= 2;
+
+		EXPECT_EQ(v4[0], two);
+		EXPECT_EQ(v4[3], eight);
+		EXPECT_EQ((int)std::distance(v4.begin(), v4.end()), 4);
+	}
+
+	TEST(VectorTests1, Vector_Addition_1)
+	{
+		Vector<2> v2a{ 1, 2 };
+		Vector<2> v2b{ 3, 4 };
+		Vector<2> v2c;
+
+		Vector<2> v2d = v2a + v2b;
+		Vector<2> v2e = v2a + v2b + v2c;
+
+		EXPECT_EQ(v2d[0], (float)4);
+		EXPECT_EQ(v2d[1], (float)6);
+
+		EXPECT_EQ(v2e[0], (float)4);
+		EXPECT_EQ(v2e[1], (float)6);
+	}
+
+	TEST(VectorTests1, Vector_Addition_2)
+	{
+		Vector<3> v3a{ 2.5, -3, 6 };
+		Vector<3> v3b{ 1, -4, 2 };
+		Vector<3> v3c{ -1, 2, -5 };
+
+		Vector<3> v3d = v3a + v3b;
+		Vector<3> v3e = v3a + v3b + v3c;
+
+		EXPECT_EQ(v3d[0], (float)3.5);
+		EXPECT_EQ(v3d[1], (float)-7);
+		EXPECT_EQ(v3d[2], (float)8);
+
+		EXPECT_EQ(v3e[0], (float)2.5);
+		EXPECT_EQ(v3e[1], (float)-5);
+		EXPECT_EQ(v3e[2], (float)3);
+	}
+
+	TEST(VectorTests1, Vector_Addition_3)
+	{
+		Vector<4> v4a{ 2.5, -3, 6 };
+		Vector<4> v4b{ 1, -4, 2, -1 };
+		Vector<4> v4c{ -1, 2, -5, 10 };
+
+		Vector<4> v4d = v4a + v4b;
+		Vector<4> v4e = v4a + v4b + v4c;
+
+		EXPECT_EQ(v4d[0], (float)3.5);
+		EXPECT_EQ(v4d[1], (float)-7);
+		EXPECT_EQ(v4d[2], (float)8);
+		EXPECT_EQ(v4d[3], (float)-1);
+
+		EXPECT_EQ(v4e[0], (float)2.5);
+		EXPECT_EQ(v4e[1], (float)-5);
+		EXPECT_EQ(v4e[2], (float)3);
+		EXPECT_EQ(v4e[3], (float)9);
+	}
+
+	TEST(VectorTests1, Vector_Mutating_Addition_1)
+	{
+		Vector<2> v2a{ 1, 2 };
+		Vector<2> v2b{ 3, 4 };
+
+		v2a += v2b;
+
+		EXPECT_EQ(v2a[0], (float)4);
+		EXPECT_EQ(v2a[1], (float)6);
+
+		EXPECT_EQ(v2b[0], (float)3);
+		EXPECT_EQ(v2b[1], (float)4);
+	}
+
+	TEST(VectorTests1, Vector_Mutating_Addition_2)
+	{
+		Vector<3> v3a{ 1, 2, 3 };
+		Vector<3> v3b{ 4, 5 };
+		Vector<3> v3c{ -1, -3, -5 };
+
+		v3a += v3b;
+
+		EXPECT_EQ(v3a[0], (float)5);
+		EXPECT_EQ(v3a[1], (float)7);
+		EXPECT_EQ(v3a[2], (float)3);
+
+		EXPECT_EQ(v3b[0], (float)4);
+		EXPECT_EQ(v3b[1], (float)5);
+		EXPECT_EQ(v3b[2], zero);
+
+		v3a += v3c;
+
+		EXPECT_EQ(v3a[0], (float)4);
+		EXPECT_EQ(v3a[1], (float)4);
+		EXPECT_EQ(v3a[2], (float)-2);
+	}
+
+	TEST(VectorTests1, Vector_Subtraction_1)
+	{
+		Vector<4> v4a{ 1, 2, 3 };
+		Vector<4> v4b{ 4, 5, 6, 1 };
+		Vector<4> v4c{ 7, 8, 9, 10 };
+
+		Vector<4> v4d = v4a - v4b;
+		Vector<4> v4e = v4a - v4b - v4c;
+
+		EXPECT_EQ(v4d[0], (float)-3);
+		EXPECT_EQ(v4d[1], (float)-3);
+		EXPECT_EQ(v4d[2], (float)-3);
+		EXPECT_EQ(v4d[3], (float)-1);
+
+		EXPECT_EQ(v4e[0], (float)-10);
+		EXPECT_EQ(v4e[1], (float)-11);
+		EXPECT_EQ(v4e[2], (float)-12);
+		EXPECT_EQ(v4e[3], (float)-11);
+	}
+
+	TEST(VectorTests1, Vector_Mutating_Subtraction_1)
+	{
+		Vector<3> v3a{ 1, 2, 3 };
+		Vector<3> v3b{ 4, 5 };
+		Vector<3> v3c{ -1, -3, -5 };
+
+		v3a -= v3b;
+
+		EXPECT_EQ(v3a[0], (float)-3);
+		EXPECT_EQ(v3a[1], (float)-3);
+		EXPECT_EQ(v3a[2], (float)3);
+
+		EXPECT_EQ(v3b[0], (float)4);
+		EXPECT_EQ(v3b[1], (float)5);
+		EXPECT_EQ(v3b[2], zero);
+
+		v3a -= v3c;
+
+		EXPECT_EQ(v3a[0], (float)-2);
+		EXPECT_EQ(v3a[1], zero);
+		EXPECT_EQ(v3a[2], (float)8);
+	}
+
+	TEST(VectorTests1, Vector_Scalar_Multiplication_1)
+	{
+		Vector<4> v4a{ 1, 2, 3, 4 };
+		Vector<4> v4b = v4a * 2;
+		Vector<4> v4c{ v4a };
+		v4c *= 3;
+
+		EXPECT_EQ(v4b[0], (float)2);
+		EXPECT_EQ(v4b[1], (float)4);
+		EXPECT_EQ(v4b[2], (float)6);
+		EXPECT_EQ(v4b[3], (float)8);
+
+		EXPECT_EQ(v4c[0], (float)3);
+		EXPECT_EQ(v4c[1], (float)6);
+		EXPECT_EQ(v4c[2], (float)9);
+		EXPECT_EQ(v4c[3], (float)12);
+	}
+
+	TEST(VectorTests1, Vector_Vector_Multiplication_1)
+	{
+		Vector<3> v3a{ 1, 2, 3 };
+		Vector<3> v3b{ 4, 5, 6 };
+		Vector<3> v3c{ v3a };
+
+		Vector<3> v3d = v3a * v3b;
+		v3c *= v3b;
+
+		EXPECT_EQ(v3d[0], (float)4);
+		EXPECT_EQ(v3d[1], (float)10);
+		EXPECT_EQ(v3d[2], (float)18);
+
+		EXPECT_EQ(v3c[0], (float)4);
+		EXPECT_EQ(v3c[1], (float)10);
+		EXPECT_EQ(v3c[2], (float)18);
+	}
+
+	TEST(VectorTests1, Vector_Scalar_Division_1)
+	{
+		Vector<3> v3a{ 2, 4, 6 };
+		float s = 2;
+
+		auto v3b = v3a / s;
+
+		EXPECT_EQ(v3b[0], one);
+		EXPECT_EQ(v3b[1], two);
+		EXPECT_EQ(v3b[2], three);
+	}
+
+	TEST(VectorTests1, Vector_Equality)
+	{
+		Vector<4> v4a{ 1, 2, 3, 4 };
+		Vector<4> v4b{ v4a };
+
+		EXPECT_TRUE(v4a == v4b);
+
+		v4b[2] = 0;
+		
+		EXPECT_TRUE(v4a != v4b);
+	}
+
+	TEST(VectorTests1, Vector_GreaterLessThan)
+	{
+		Vector<4> v4a{ 1, 2, 3, 4 };
+		Vector<4> v4b{ 0, 1, 2, 3 };
+		Vector<4> v4c{ 0, 1, 2, 4 };
+		Vector<4> v4d{ 0, 2, 3, 3 };
+
+		EXPECT_TRUE(v4a > v4b);
+		EXPECT_FALSE(v4b > v4c);
+		EXPECT_TRUE(v4c <= v4a);
+
+		EXPECT_TRUE(v4a >= v4d);
+		EXPECT_TRUE(v4d <= v4a);
+		EXPECT_FALSE(v4d < v4a);
+	}
+
+	TEST(VectorTests1, Vector_Magnitude)
+	{
+		Vector<3> v3a{ 1, 2, 3 };
+		Vector<3> v3b{ -1, -2, -3 };
+		Vector<3> v3c{ 3, 4, 5 };
+
+		EXPECT_EQ(v3a.squareMagnitude(), (float)14);
+		EXPECT_EQ(v3b.squareMagnitude(), (float)14);
+		
+		EXPECT_EQ((int)v3c.magnitude(), (int)sqrt(50));
+	}
+
+	TEST(VectorTests1, Vector_DotAndCrossProduct)
+	{
+		Vector<3> v3a{ 1, 2, 3 };
+		Vector<3> v3b{ 4, 5, 6 };
+
+		EXPECT_EQ(v3a.dotProduct(v3b), (float)32);
+
+		Vector<3> v3c{ 0, 1, 0 };
+		Vector<3> v3d{ 0, 0, 1 };
+		Vector<3> v3e{ 1, 0, 0 };
+		Vector<3> v3f = v3c.crossProduct(v3d);
+		
+		EXPECT_EQ(v3e[0], v3f[0]);
+		EXPECT_EQ(v3e[1], v3f[1]);
+		EXPECT_EQ(v3e[2], v3f[2]);
+	}
+
+	TEST(VectorTests1, Vector_Normal_1)
+	{
+		Vector<3> v3a{ 0, 0, 1 };
+
+		auto v3b = v3a.normal();
+		v3a.normalize();
+
+		EXPECT_EQ(v3b[0], zero);
+		EXPECT_EQ(v3b[1], zero);
+		EXPECT_EQ(v3b[2], one);
+
+		EXPECT_EQ(v3a[0], zero);
+		EXPECT_EQ(v3a[1], zero);
+		EXPECT_EQ(v3a[2], one);
+	}
+
+	TEST(VectorTests1, Vector_Normalize)
+	{
+		Vector<3> v3a{1, 2, 3};
+		std::string s = v3a.to_string();
+		std::cout << s << std::endl;
+		std::cout << "Test string";
+		std::cout << v3a;
+
+		EXPECT_EQ(v3a[0], (float)1);
+	}
+
+	TEST(VectorTests1, Vector_Dimension_Change_1)
+	{
+		Vector<2> v2{ 1, 2 };
+		auto v3 = higherDimension(v2, 3);
+
+		EXPECT_EQ(v3[0], one);
+		EXPECT_EQ(v3[1], two);
+		EXPECT_EQ(v3[2], three);
+	}
+
+	TEST(VectorTests1, Vector_Dimension_Change_2)
+	{
+		Vector<3> v3{ 1, 2, 3 };
+		auto v4 = higherDimension(v3, 4);
+
+		EXPECT_EQ(v4[0], one);
+		EXPECT_EQ(v4[1], two);
+		EXPECT_EQ(v4[2], three);
+		EXPECT_EQ(v4[3], four);
+	}
+
+	TEST(VectorTests1, Vector_Dimension_Change_3)
+	{
+		Vector<3> v3{ 1, 2, 3 };
+		auto v2 = lowerDimension(v3);
+
+		EXPECT_EQ(v2[0], one);
+		EXPECT_EQ(v2[1], two);
+	}
+
+	TEST(VectorTests1, Vector_Dimension_Change_4)
+	{
+		Vector<4> v4{ 1, 2, 3, 4 };
+		auto v3 = lowerDimension(v4);
+
+		EXPECT_EQ(v3[0], one);
+		EXPECT_EQ(v3[1], two);
+		EXPECT_EQ(v3[2], three);
+	}
+
+	TEST(VectorTests1, Vector_Constexpr)
+	{
+		constexpr Vector<3> v1{ 1, 2, 3 };
+		constexpr Vector<3> v2{ 4, 5, 6 };
+
+		constexpr auto v3 = v1 + v2 * 2.0f - 1.0f;
+		static_assert(v3 == Vector<3>{ 8, 11, 14 }, "Vector arithmetic must be usable in constant expressions");
+
+		constexpr auto v4 = v1.crossProduct(v2);
+		static_assert(v4 == Vector<3>{ -3, 6, -3 }, "The cross product must be usable in constant expressions");
+		static_assert(v1.dotProduct(v2) == 32, "The dot product must be usable in constant expressions");
+		static_assert(v1.squareMagnitude() == 14, "squareMagnitude must be usable in constant expressions");
+
+		constexpr auto v5 = Vector<4>{ 2, 4, 6, 2 }.homogenous();
+		static_assert(v5 == Vector<4>{ 1, 2, 3, 2 }, "homogenous must be usable in constant expressions");
+		static_assert(lowerDimension(higherDimension(v1, 1)) == v1, "Dimension changes must be usable in constant expressions");
+
+		EXPECT_EQ(v3[2], (float)14);
+		EXPECT_EQ(v4[1], six);
+	}
+}